@@ -1,38 +1,65 @@
 #pragma once
 
+#include <memory>
 #include <string>
 #include <vector>
 
 
 namespace rg3::cpp
 {
+	/**
+	 * @brief Namespace of type. Joined & split forms are interned (see InternPool): all types of same namespace share one copy.
+	 */
     class CppNamespace
     {
     public:
         CppNamespace();
         CppNamespace(std::string aNamespace);
+        CppNamespace(const CppNamespace&) = default;
+        CppNamespace(CppNamespace&&) noexcept = default;
 
         [[nodiscard]] const std::string& operator[](size_t i) const;
-        [[nodiscard]] std::string& operator[](size_t i);
 
 		CppNamespace& operator=(const CppNamespace&);
+		CppNamespace& operator=(CppNamespace&&) noexcept;
 		CppNamespace& operator/(const std::string&);
 		bool operator==(const CppNamespace& other) const;
 		bool operator!=(const CppNamespace& other) const;
 
-		operator std::string() const { return m_sNamespace; }
+		operator std::string() const { return asString(); }
 
 		void prepend(const std::string& part);
 
-		const std::string& asString() const { return m_sNamespace; }
+		/**
+		 * @brief Replace part of namespace. Joined form is rebuilt from parts. Other namespaces which shared same data are not affected.
+		 * @note Throws std::out_of_range when there is no such part (same as operator[])
+		 */
+		void setPart(size_t i, const std::string& part);
 
-		bool isEmpty() const { return m_vNamespace.empty(); }
+		const std::string& asString() const;
+
+		bool isEmpty() const { return !m_pData || m_pData->vNamespace.empty(); }
+
+		/**
+		 * @brief Amount of distinct namespaces referenced by alive objects
+		 */
+		static std::size_t getInternedNamespacesCount();
 
     private:
-        void parseNamespace();
+		struct Data
+		{
+			std::string sNamespace {};
+			std::vector<std::string> vNamespace {};
+
+			bool operator==(const Data& other) const = default;
+		};
+
+		struct DataHasher;
+
+		void assign(Data&& data);
+        static void parseNamespace(Data& data);
 
     private:
-        std::string m_sNamespace;
-        std::vector<std::string> m_vNamespace;
+		std::shared_ptr<const Data> m_pData { nullptr }; /// nullptr - global namespace
     };
 }
\ No newline at end of file
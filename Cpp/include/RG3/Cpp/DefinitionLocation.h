@@ -1,11 +1,15 @@
 #pragma once
 
 #include <filesystem>
+#include <memory>
 #include <string>
 
 
 namespace rg3::cpp
 {
+	/**
+	 * @brief Location of definition. Path is interned (see InternPool): all locations inside same file share one path.
+	 */
 	class DefinitionLocation
 	{
 	 public:
@@ -21,8 +25,13 @@ namespace rg3::cpp
 		bool operator==(const DefinitionLocation& other) const;
 		bool operator!=(const DefinitionLocation& other) const;
 
+		/**
+		 * @brief Amount of distinct paths referenced by alive locations
+		 */
+		static std::size_t getInternedPathsCount();
+
 	 private:
-		std::filesystem::path m_fsLocation {};
+		std::shared_ptr<const std::filesystem::path> m_pFsLocation { nullptr }; /// nullptr - empty path
 		int m_line { 0 };
 		int m_offset { 0 };
 		bool m_bAngled { false };
@@ -0,0 +1,29 @@
+#pragma once
+
+#include <string_view>
+#include <filesystem>
+#include <string>
+#include <vector>
+
+
+namespace rg3::cpp::utils
+{
+	/**
+	 * @brief Write data into temporary file next to target and replace target by rename: concurrent readers never see partially written file.
+	 * @note Name of temporary file is unique per call, so concurrent writers (threads or processes) never share it. Last rename wins.
+	 * @return false when file could not be written or renamed (temporary file removed)
+	 */
+	bool writeFileAtomic(const std::filesystem::path& path, std::string_view data);
+
+	/**
+	 * @brief Absolute & lexically normal form of path (without access to file system besides current directory). Used as key of file in caches & indices.
+	 * @note When absolute path could not be produced normal form of original path returned
+	 */
+	std::filesystem::path normalizePath(const std::filesystem::path& path);
+
+	/**
+	 * @brief Collect include directives of source text spelled with delimiters ('<vector>', '"my/header.h"') in order of appearance
+	 * @note Only top-level '#include' lines are recognized, conditional blocks and macros are not evaluated
+	 */
+	std::vector<std::string> collectIncludeDirectives(std::string_view sSource);
+}
\ No newline at end of file
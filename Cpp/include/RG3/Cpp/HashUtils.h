@@ -0,0 +1,21 @@
+#pragma once
+
+#include <functional>
+
+
+namespace rg3::cpp::utils
+{
+	template <typename TSeed>
+	inline void hashCombine(TSeed&) {}
+
+	/**
+	 * @brief Mix hashes of all values into seed (boost::hash_combine way). Used for type ids and digests of on-disk caches.
+	 */
+	template <typename TSeed, typename T, typename... Rest>
+	inline void hashCombine(TSeed& seed, const T& v, const Rest&... rest)
+	{
+		std::hash<T> hasher;
+		seed ^= hasher(v) + 0x9e3779b9 + (seed << 6) + (seed >> 2);
+		hashCombine(seed, rest...);
+	}
+}
\ No newline at end of file
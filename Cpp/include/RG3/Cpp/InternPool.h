@@ -0,0 +1,121 @@
+#pragma once
+
+#include <unordered_map>
+#include <functional>
+#include <algorithm>
+#include <cstddef>
+#include <memory>
+#include <array>
+#include <mutex>
+
+
+namespace rg3::cpp
+{
+	/**
+	 * @brief Thread safe pool of immutable values: equal values share one allocation.
+	 *        Pool keeps weak references only, so value lives while any type model object (type, statement, location) refers to it:
+	 *        strings of analyze result are released together with the result.
+	 * @note Key of entry is a pointer to interned value (value is not stored twice). Entry is removed by deleter of value, before value is destroyed.
+	 */
+	template <typename T, typename THasher = std::hash<T>, typename TEqual = std::equal_to<T>>
+	class InternPool
+	{
+	 public:
+		using Handle = std::shared_ptr<const T>;
+
+		static InternPool& get()
+		{
+			// Never destroyed: handles could outlive static objects (and their deleters refer to pool)
+			static auto* s_pPool = new InternPool();
+			return *s_pPool;
+		}
+
+		Handle intern(T value)
+		{
+			const std::size_t iShard = THasher{}(value) % kShardsCount;
+			Shard& shard = m_shards[iShard];
+
+			std::lock_guard<std::mutex> guard { shard.lock };
+
+			if (auto it = shard.entries.find(value); it != shard.entries.end())
+			{
+				if (Handle pAlive = it->second.lock())
+					return pAlive;
+
+				// Last handle is released right now: deleter waits for lock and won't touch new entry
+				shard.entries.erase(it);
+			}
+
+			const T* pValue = new T(std::move(value));
+			Handle pHandle { pValue, [this, iShard](const T* pReleased) { release(iShard, pReleased); } };
+
+			shard.entries.emplace(pValue, pHandle);
+			return pHandle;
+		}
+
+		/**
+		 * @brief Amount of values which are still referenced
+		 */
+		[[nodiscard]] std::size_t getAliveCount() const
+		{
+			std::size_t iCount = 0;
+
+			for (const auto& shard : m_shards)
+			{
+				std::lock_guard<std::mutex> guard { shard.lock };
+				iCount += std::count_if(shard.entries.begin(), shard.entries.end(), [](const auto& entry) { return !entry.second.expired(); });
+			}
+
+			return iCount;
+		}
+
+	 private:
+		static constexpr std::size_t kShardsCount = 16;
+
+		/**
+		 * @brief Hash & compare entries by interned value. Lookup by value doesn't make a copy of it.
+		 */
+		struct KeyHasher
+		{
+			using is_transparent = void;
+
+			std::size_t operator()(const T* pValue) const { return THasher{}(*pValue); }
+			std::size_t operator()(const T& value) const { return THasher{}(value); }
+		};
+
+		struct KeyEqual
+		{
+			using is_transparent = void;
+
+			bool operator()(const T* pLhs, const T* pRhs) const { return TEqual{}(*pLhs, *pRhs); }
+			bool operator()(const T& lhs, const T* pRhs) const { return TEqual{}(lhs, *pRhs); }
+			bool operator()(const T* pLhs, const T& rhs) const { return TEqual{}(*pLhs, rhs); }
+		};
+
+		struct Shard
+		{
+			mutable std::mutex lock;
+			std::unordered_map<const T*, std::weak_ptr<const T>, KeyHasher, KeyEqual> entries {};
+		};
+
+		InternPool() = default;
+
+		void release(std::size_t iShard, const T* pValue)
+		{
+			{
+				Shard& shard = m_shards[iShard];
+				std::lock_guard<std::mutex> guard { shard.lock };
+
+				// Entry could be replaced already by equal value (see intern)
+				if (auto it = shard.entries.find(pValue); it != shard.entries.end() && it->first == pValue)
+				{
+					shard.entries.erase(it);
+				}
+			}
+
+			delete pValue;
+		}
+
+		std::array<Shard, kShardsCount> m_shards {};
+	};
+}
\ No newline at end of file
@@ -16,9 +16,17 @@ namespace rg3::cpp
         TypeBase();
 		virtual ~TypeBase() noexcept = default;
 
-        TypeBase(TypeKind kind, const std::string& name, const std::string& prettyName, const CppNamespace& aNamespace, const DefinitionLocation& aLocation, const Tags& tags);
+		/**
+		 * @note Sink arguments: rvalues are moved into type
+		 */
+        TypeBase(TypeKind kind, std::string name, std::string prettyName, CppNamespace aNamespace, DefinitionLocation aLocation, Tags tags);
 
 		[[nodiscard]] TypeID getID() const;
+
+		/**
+		 * @brief ID of type described by parts (same as getID() of such type): allows to find type by TypeBaseInfo of statement
+		 */
+		[[nodiscard]] static TypeID makeID(TypeKind kind, const std::string& name, const CppNamespace& aNamespace, const DefinitionLocation& aLocation);
 		[[nodiscard]] TypeKind getKind() const;
 		[[nodiscard]] const std::string& getName() const;
 		[[nodiscard]] const CppNamespace& getNamespace() const;
@@ -36,10 +44,10 @@ namespace rg3::cpp
 
 		[[nodiscard]] bool isForwardDeclarable() const;
 
-		void overrideTypeData(const std::string& name, const std::string& prettyName);
-		void overrideTypeData(const std::string& name, const std::string& prettyName, const CppNamespace& aNamespace);
-		void overrideTypeData(const std::string& name, const std::string& prettyName, const CppNamespace& aNamespace, const DefinitionLocation& aLocation);
-		void overrideTypeData(const std::string& name, const std::string& prettyName, const CppNamespace& aNamespace, const DefinitionLocation& aLocation, const Tags& tags);
+		void overrideTypeData(std::string name, std::string prettyName);
+		void overrideTypeData(std::string name, std::string prettyName, CppNamespace aNamespace);
+		void overrideTypeData(std::string name, std::string prettyName, CppNamespace aNamespace, DefinitionLocation aLocation);
+		void overrideTypeData(std::string name, std::string prettyName, CppNamespace aNamespace, DefinitionLocation aLocation, Tags tags);
 
 		void setProducedFromTemplate();
 		void setProducedFromAlias();
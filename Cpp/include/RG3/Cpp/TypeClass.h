@@ -105,10 +105,14 @@ namespace rg3::cpp
 	{
 	 public:
 		TypeClass();
-		TypeClass(const std::string& name, const std::string& prettyName, const CppNamespace& aNamespace, const DefinitionLocation& aLocation, const Tags& tags,
-				  const ClassPropertyVector& aProperties, const ClassFunctionVector& aFunctions, const ClassFriendVector& aFriends,
+
+		/**
+		 * @note Arguments are taken by value: pass rvalues (std::move) of collected members to build type without deep copies
+		 */
+		TypeClass(std::string name, std::string prettyName, CppNamespace aNamespace, DefinitionLocation aLocation, Tags tags,
+				  ClassPropertyVector aProperties, ClassFunctionVector aFunctions, ClassFriendVector aFriends,
 				  bool bIsStruct, bool bTrivialConstructible, bool bHasCopyConstructor, bool bHasCopyAssignOperator, bool bHasMoveConstructor, bool bHasMoveAssignOperator,
-				  const std::vector<ClassParent>& parentTypes);
+				  std::vector<ClassParent> parentTypes);
 
 		[[nodiscard]] const ClassPropertyVector& getProperties() const;
 		[[nodiscard]] ClassPropertyVector& getProperties();
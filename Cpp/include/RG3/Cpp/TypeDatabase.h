@@ -0,0 +1,146 @@
+#pragma once
+
+#include <RG3/Cpp/TypeSerializer.h>
+#include <RG3/Cpp/TypeBase.h>
+
+#include <string_view>
+#include <filesystem>
+#include <optional>
+#include <cstdint>
+#include <memory>
+#include <vector>
+#include <string>
+
+
+namespace rg3::cpp
+{
+	/**
+	 * @brief Compiler issue stored in type database
+	 */
+	struct TypeDatabaseIssue
+	{
+		std::uint8_t iKind { 0 }; /// Value of rg3::llvm::AnalyzerResult::CompilerIssue::IssueKind
+		std::string sSourceFile {};
+		std::uint32_t iLine { 0 };
+		std::uint32_t iColumn { 0 };
+		std::string sMessage {};
+	};
+
+	/**
+	 * @brief Builder of type database file (see TypeDatabase for format)
+	 * @note Writer does not own types: they must be alive until build() or writeToFile()
+	 */
+	class TypeDatabaseWriter
+	{
+	 public:
+		TypeDatabaseWriter();
+
+		void addType(const TypeBase* pType);
+		void addTypes(const std::vector<TypeBasePtr>& vTypes);
+		void addIssue(TypeDatabaseIssue issue);
+
+		[[nodiscard]] std::string build() const;
+
+		/**
+		 * @brief Build database and write it into file (via temporary file, so readers never see partially written database)
+		 */
+		bool writeToFile(const std::filesystem::path& path) const;
+
+	 private:
+		std::vector<const TypeBase*> m_vTypes {};
+		std::vector<TypeDatabaseIssue> m_vIssues {};
+	};
+
+	/**
+	 * @brief Read-only database of analyze result (types & issues).
+	 *        File consists of header and 8-byte aligned sections: strings table (every string stored once), fixed size records of types & issues,
+	 *        index of types sorted by pretty name, links between types (by index in database) and serialized type payloads.
+	 * @note Opened file is memory-mapped: name, kind, location & links of type are available without deserialization. Type is deserialized only by loadType().
+	 * @note Every access is bounds-checked: malformed file is rejected by open() or produces empty results.
+	 */
+	class TypeDatabase
+	{
+	 public:
+		static constexpr std::uint32_t kMagic = 0x44334752; /// 'RG3D'
+		static constexpr std::uint32_t kVersion = 1;
+
+		/**
+		 * @brief Map database file into memory
+		 * @return database or nullptr when file not exists or it is not valid database
+		 */
+		static std::unique_ptr<TypeDatabase> open(const std::filesystem::path& path);
+
+		/**
+		 * @brief Make database from memory buffer (result of TypeDatabaseWriter::build())
+		 * @return database or nullptr when buffer is not valid database
+		 */
+		static std::unique_ptr<TypeDatabase> fromBuffer(std::string buffer);
+
+		~TypeDatabase();
+
+		TypeDatabase(const TypeDatabase&) = delete;
+		TypeDatabase& operator=(const TypeDatabase&) = delete;
+
+		[[nodiscard]] std::uint32_t getTypesCount() const;
+		[[nodiscard]] std::uint32_t getIssuesCount() const;
+
+		[[nodiscard]] TypeKind getTypeKind(std::uint32_t iIndex) const;
+		[[nodiscard]] std::string_view getTypeName(std::uint32_t iIndex) const;
+		[[nodiscard]] std::string_view getTypePrettyName(std::uint32_t iIndex) const;
+		[[nodiscard]] std::string_view getTypeNamespace(std::uint32_t iIndex) const;
+		[[nodiscard]] std::string_view getTypeDefinitionPath(std::uint32_t iIndex) const;
+		[[nodiscard]] std::uint32_t getTypeDefinitionLine(std::uint32_t iIndex) const;
+
+		/**
+		 * @brief Indices of parent types of class which are presented in database
+		 */
+		[[nodiscard]] std::vector<std::uint32_t> getParentTypes(std::uint32_t iIndex) const;
+
+		/**
+		 * @brief Indices of types (presented in database) used by type: types of properties, function arguments & results, underlying type of enum
+		 */
+		[[nodiscard]] std::vector<std::uint32_t> getReferencedTypes(std::uint32_t iIndex) const;
+
+		/**
+		 * @brief Find type by pretty name (binary search over name index)
+		 */
+		[[nodiscard]] std::optional<std::uint32_t> findType(std::string_view sPrettyName) const;
+
+		/**
+		 * @brief Deserialize single type
+		 * @return type or nullptr when index is out of range or payload is malformed
+		 */
+		[[nodiscard]] TypeBasePtr loadType(std::uint32_t iIndex) const;
+
+		/**
+		 * @brief Deserialize all types
+		 * @return false when any type is malformed (vOutTypes is not changed in that case)
+		 */
+		bool loadTypes(std::vector<TypeBasePtr>& vOutTypes) const;
+
+		[[nodiscard]] std::optional<TypeDatabaseIssue> getIssue(std::uint32_t iIndex) const;
+
+	 private:
+		struct Storage;
+
+		explicit TypeDatabase(std::unique_ptr<Storage>&& pStorage);
+
+		bool validate();
+
+		[[nodiscard]] std::string_view getString(std::uint32_t iId) const;
+		[[nodiscard]] std::vector<std::uint32_t> getLinks(std::uint32_t iOffset, std::uint32_t iCount) const;
+
+	 private:
+		std::unique_ptr<Storage> m_pStorage { nullptr };
+		std::string_view m_data {};
+		StringTableView m_strings {};
+		std::uint32_t m_iTypesCount { 0 };
+		std::uint32_t m_iIssuesCount { 0 };
+		std::uint32_t m_iLinksCount { 0 };
+		std::string_view m_typeRecords {};
+		std::string_view m_issueRecords {};
+		std::string_view m_nameIndex {};
+		std::string_view m_links {};
+		std::string_view m_payload {};
+	};
+}
\ No newline at end of file
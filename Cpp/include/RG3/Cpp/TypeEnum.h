@@ -27,14 +27,15 @@ namespace rg3::cpp
 	{
 	 public:
 		TypeEnum();
-		TypeEnum(const std::string& name, const std::string& prettyName, const CppNamespace& aNamespace, const DefinitionLocation& aLocation, const Tags& tags, const EnumEntryVector& aValues, bool bIsScoped, TypeReference underlyingType);
+		TypeEnum(std::string name, std::string prettyName, CppNamespace aNamespace, DefinitionLocation aLocation, Tags tags, EnumEntryVector aValues, bool bIsScoped, TypeReference underlyingType);
 
 		[[nodiscard]] const EnumEntryVector& getEntries() const;
 		[[nodiscard]] EnumEntryVector& getEntries();
 		[[nodiscard]] bool containsValue(EnumEntry::ValueType value) const;
 		[[nodiscard]] std::string_view operator[](EnumEntry::ValueType value) const;
 		[[nodiscard]] bool isScoped() const;
-		[[nodiscard]] TypeReference getUnderlyingType() const;
+		[[nodiscard]] const TypeReference& getUnderlyingType() const;
+		[[nodiscard]] TypeReference& getUnderlyingType();
 
 	 protected:
 		bool doAreSame(const TypeBase* pOther) const override;
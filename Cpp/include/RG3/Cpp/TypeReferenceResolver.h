@@ -0,0 +1,63 @@
+#pragma once
+
+#include <RG3/Cpp/TypeReference.h>
+#include <RG3/Cpp/TypeBaseInfo.h>
+#include <RG3/Cpp/TypeBase.h>
+#include <RG3/Cpp/TypeID.h>
+#include <RG3/Cpp/Tag.h>
+
+#include <unordered_map>
+#include <string_view>
+#include <cstdint>
+#include <cstddef>
+#include <vector>
+
+
+namespace rg3::cpp
+{
+	/**
+	 * @brief Native resolution of type references over analyze result.
+	 *        Index maps pretty name & TypeID to type. Resolver walks underlying types of enums, statements of properties, function results & arguments
+	 *        and type reference arguments of tags (of types, properties, functions & parents) and links them with indexed types.
+	 * @note Indexed types must outlive resolver and resolved references (pointers are not owning) and must not be renamed while indexed
+	 * @note Resolve is parallel: each type is handled by single worker, index is read only during resolve
+	 */
+	class TypeReferenceResolver
+	{
+	 public:
+		struct Stats
+		{
+			std::uint64_t iReferences { 0 }; /// Non-empty references met
+			std::uint64_t iResolved { 0 }; /// References linked with indexed type (including already linked)
+		};
+
+	 public:
+		TypeReferenceResolver();
+
+		/**
+		 * @brief Add type into index. First type wins when pretty name or ID is already indexed (same as merge of results)
+		 */
+		void addType(TypeBase* pType);
+		void addTypes(const std::vector<TypeBasePtr>& vTypes);
+
+		[[nodiscard]] TypeBase* findByName(std::string_view sPrettyName) const;
+		[[nodiscard]] TypeBase* findByID(TypeID id) const;
+		[[nodiscard]] std::size_t getIndexedCount() const;
+
+		/**
+		 * @brief Resolve references of types (types are not required to be indexed)
+		 * @param iWorkers - amount of threads (1 or less - resolve on caller thread)
+		 */
+		Stats resolve(const std::vector<TypeBasePtr>& vTypes, int iWorkers = 1) const;
+		Stats resolve(const std::vector<TypeBase*>& vTypes, int iWorkers = 1) const;
+
+	 private:
+		void resolveType(TypeBase* pType, Stats& stats) const;
+		void resolveTags(Tags& tags, Stats& stats) const;
+		void resolveReference(TypeReference& reference, const TypeBaseInfo* pBaseInfo, Stats& stats) const;
+
+	 private:
+		std::unordered_map<std::string_view, TypeBase*> m_byName {}; /// Keys are views of pretty names of indexed types
+		std::unordered_map<TypeID, TypeBase*> m_byID {};
+	};
+}
\ No newline at end of file
@@ -0,0 +1,125 @@
+#pragma once
+
+#include <RG3/Cpp/TypeBase.h>
+
+#include <unordered_map>
+#include <string_view>
+#include <optional>
+#include <cstdint>
+#include <vector>
+#include <string>
+
+
+namespace rg3::cpp
+{
+	/**
+	 * @brief Builder of interned strings table. Every unique string gets own id (index in table)
+	 */
+	class StringTableBuilder
+	{
+	 public:
+		StringTableBuilder();
+
+		std::uint32_t intern(std::string_view sValue);
+
+		[[nodiscard]] const std::vector<std::string>& getStrings() const;
+
+	 private:
+		std::vector<std::string> m_vStrings {};
+		std::unordered_map<std::string, std::uint32_t> m_ids {};
+	};
+
+	/**
+	 * @brief Read-only view of strings table: array of (u32 offset, u32 length) records & blob of string bytes. Memory is not owned.
+	 */
+	class StringTableView
+	{
+	 public:
+		StringTableView();
+		StringTableView(std::string_view records, std::string_view blob);
+
+		/**
+		 * @return string or std::nullopt when id or record is out of bounds
+		 */
+		[[nodiscard]] std::optional<std::string_view> getString(std::uint32_t iId) const;
+		[[nodiscard]] std::uint32_t getStringsCount() const;
+
+	 private:
+		std::string_view m_records {};
+		std::string_view m_blob {};
+	};
+
+	/**
+	 * @brief Append-only little-endian binary buffer
+	 * @note When strings table is set strings are written as u32 id in that table
+	 */
+	class BinaryWriter
+	{
+	 public:
+		BinaryWriter();
+		explicit BinaryWriter(StringTableBuilder* pStringTable);
+
+		void writeU8(std::uint8_t value);
+		void writeU32(std::uint32_t value);
+		void writeU64(std::uint64_t value);
+		void writeI64(std::int64_t value);
+		void writeF32(float value);
+		void writeBool(bool value);
+		void writeString(std::string_view value);
+
+		[[nodiscard]] const std::string& getBuffer() const;
+		[[nodiscard]] std::string& getBuffer();
+
+	 private:
+		std::string m_buffer {};
+		StringTableBuilder* m_pStringTable { nullptr };
+	};
+
+	/**
+	 * @brief Reader of BinaryWriter buffers. Never reads out of bounds: after first failure every read returns default value and isFailed() returns true.
+	 * @note Strings table must be same as used by writer (strings are read as u32 id when it set)
+	 */
+	class BinaryReader
+	{
+	 public:
+		explicit BinaryReader(std::string_view data);
+		BinaryReader(std::string_view data, const StringTableView* pStringTable);
+
+		std::uint8_t readU8();
+		std::uint32_t readU32();
+		std::uint64_t readU64();
+		std::int64_t readI64();
+		float readF32();
+		bool readBool();
+		std::string readString();
+
+		[[nodiscard]] bool isFailed() const;
+		[[nodiscard]] bool isEOF() const;
+
+	 private:
+		bool readBytes(void* pDest, std::size_t iSize);
+
+	 private:
+		std::string_view m_data {};
+		std::size_t m_iOffset { 0 };
+		bool m_bFailed { false };
+		const StringTableView* m_pStringTable { nullptr };
+	};
+
+	/**
+	 * @brief Serializer of TypeBase, TypeClass & TypeEnum (all properties, functions, tags, parents & friends)
+	 * @note Resolved pointers of TypeReference are not stored: only name of reference
+	 */
+	struct TypeSerializer
+	{
+		static void writeType(BinaryWriter& writer, const TypeBase* pType);
+		static TypeBasePtr readType(BinaryReader& reader);
+
+		static void writeTypes(BinaryWriter& writer, const std::vector<TypeBasePtr>& vTypes);
+
+		/**
+		 * @return false when data is malformed (vOutTypes is not changed in that case)
+		 */
+		static bool readTypes(BinaryReader& reader, std::vector<TypeBasePtr>& vOutTypes);
+	};
+}
\ No newline at end of file
@@ -1,4 +1,5 @@
 #include <RG3/Cpp/CppNamespace.h>
+#include <RG3/Cpp/InternPool.h>
 #include <algorithm>
 #include <utility>
 
@@ -6,66 +7,126 @@
 namespace rg3::cpp
 {
 	static const std::string kNamespaceDelimiter = "::";
+	static const std::string kEmptyNamespace {};
+	static const std::vector<std::string> kEmptyParts {};
+
+	struct CppNamespace::DataHasher
+	{
+		std::size_t operator()(const Data& data) const
+		{
+			return std::hash<std::string>{}(data.sNamespace) ^ data.vNamespace.size();
+		}
+	};
 
     CppNamespace::CppNamespace() = default;
 
 	CppNamespace::CppNamespace(std::string aNamespace)
-		: m_sNamespace(std::move(aNamespace))
 	{
-		parseNamespace();
+		Data data {};
+		data.sNamespace = std::move(aNamespace);
+
+		parseNamespace(data);
+		assign(std::move(data));
 	}
 
 	const std::string& CppNamespace::operator[](size_t i) const
 	{
-		return m_vNamespace.at(i);
+		return (m_pData ? m_pData->vNamespace : kEmptyParts).at(i);
 	}
 
-	std::string& CppNamespace::operator[](size_t i)
+	CppNamespace& CppNamespace::operator=(const rg3::cpp::CppNamespace& copy)
 	{
-		return m_vNamespace.at(i);
+		m_pData = copy.m_pData;
+
+		return *this;
 	}
 
-	CppNamespace& CppNamespace::operator=(const rg3::cpp::CppNamespace& copy)
+	CppNamespace& CppNamespace::operator=(CppNamespace&& move) noexcept
 	{
-		m_sNamespace = copy.m_sNamespace;
-		m_vNamespace = copy.m_vNamespace;
+		m_pData = std::move(move.m_pData);
 
 		return *this;
 	}
 
 	CppNamespace& CppNamespace::operator/(const std::string& part)
 	{
-		if (!m_sNamespace.empty())
-			m_sNamespace.append("::");
+		Data data = m_pData ? *m_pData : Data {};
+
+		if (!data.sNamespace.empty())
+			data.sNamespace.append("::");
 
-		m_sNamespace.append(part);
-		m_vNamespace.push_back(part);
+		data.sNamespace.append(part);
+		data.vNamespace.push_back(part);
 
+		assign(std::move(data));
 		return *this;
 	}
 
 	bool CppNamespace::operator==(const CppNamespace& other) const
 	{
-		return m_sNamespace == other.m_sNamespace;
+		return m_pData == other.m_pData || asString() == other.asString();
 	}
 
 	bool CppNamespace::operator!=(const CppNamespace& other) const
 	{
-		return m_sNamespace != other.m_sNamespace;
+		return !operator==(other);
 	}
 
 	void CppNamespace::prepend(const std::string& part)
 	{
-		m_sNamespace = (m_sNamespace.empty() ? part : part + "::" + m_sNamespace);
-		m_vNamespace.insert(m_vNamespace.begin(), part);
+		Data data = m_pData ? *m_pData : Data {};
+
+		data.sNamespace = (data.sNamespace.empty() ? part : part + "::" + data.sNamespace);
+		data.vNamespace.insert(data.vNamespace.begin(), part);
+
+		assign(std::move(data));
+	}
+
+	void CppNamespace::setPart(size_t i, const std::string& part)
+	{
+		// Data is interned (shared by all equal namespaces): never changed in place
+		Data data = m_pData ? *m_pData : Data {};
+		data.vNamespace.at(i) = part;
+
+		data.sNamespace.clear();
+		for (const auto& namespacePart : data.vNamespace)
+		{
+			if (!data.sNamespace.empty())
+				data.sNamespace.append(kNamespaceDelimiter);
+
+			data.sNamespace.append(namespacePart);
+		}
+
+		assign(std::move(data));
+	}
+
+	const std::string& CppNamespace::asString() const
+	{
+		return m_pData ? m_pData->sNamespace : kEmptyNamespace;
+	}
+
+	std::size_t CppNamespace::getInternedNamespacesCount()
+	{
+		return InternPool<Data, DataHasher>::get().getAliveCount();
+	}
+
+	void CppNamespace::assign(Data&& data)
+	{
+		if (data.sNamespace.empty() && data.vNamespace.empty())
+		{
+			m_pData = nullptr;
+			return;
+		}
+
+		m_pData = InternPool<Data, DataHasher>::get().intern(std::move(data));
 	}
 
-	void CppNamespace::parseNamespace()
+	void CppNamespace::parseNamespace(Data& data)
 	{
-		m_vNamespace.clear();
+		data.vNamespace.clear();
 
 		size_t pos = 0;
-		std::string s = m_sNamespace;
+		std::string s = data.sNamespace;
 		std::string tok;
 
 		while ((pos = s.find(kNamespaceDelimiter)) != std::string::npos)
@@ -75,7 +136,7 @@ namespace rg3::cpp
 			if (tok != "__1")
 #endif
 			{
-				m_vNamespace.push_back(tok);
+				data.vNamespace.push_back(tok);
 			}
 			s.erase(0, pos + kNamespaceDelimiter.length());
 		}
@@ -1,11 +1,36 @@
 #include <RG3/Cpp/DefinitionLocation.h>
+#include <RG3/Cpp/InternPool.h>
 
 
 namespace rg3::cpp
 {
+	namespace location_details
+	{
+		struct PathHasher
+		{
+			std::size_t operator()(const std::filesystem::path& path) const
+			{
+				return std::hash<std::filesystem::path::string_type>{}(path.native());
+			}
+		};
+
+		// Spelling must be kept as is: lexically equal paths ('a/b' & 'a//b') are different entries
+		struct PathEqual
+		{
+			bool operator()(const std::filesystem::path& lhs, const std::filesystem::path& rhs) const
+			{
+				return lhs.native() == rhs.native();
+			}
+		};
+
+		using PathPool = InternPool<std::filesystem::path, PathHasher, PathEqual>;
+
+		static const std::filesystem::path kEmptyPath {};
+	}
+
 	DefinitionLocation::DefinitionLocation() = default;
 	DefinitionLocation::DefinitionLocation(const std::filesystem::path& location, int line, int offset, bool bAngled)
-		: m_fsLocation(location)
+		: m_pFsLocation(location.empty() ? nullptr : location_details::PathPool::get().intern(location))
 		, m_line(line)
 		, m_offset(offset)
 		, m_bAngled(bAngled)
@@ -14,12 +39,12 @@ namespace rg3::cpp
 
 	const std::filesystem::path& DefinitionLocation::getFsLocation() const
 	{
-		return m_fsLocation;
+		return m_pFsLocation ? *m_pFsLocation : location_details::kEmptyPath;
 	}
 
 	std::string DefinitionLocation::getPath() const
 	{
-		return m_fsLocation.string();
+		return getFsLocation().string();
 	}
 
 	int DefinitionLocation::getLine() const
@@ -39,11 +64,16 @@ namespace rg3::cpp
 
 	bool DefinitionLocation::operator==(const DefinitionLocation& other) const
 	{
-		return m_fsLocation == other.m_fsLocation && m_line == other.m_line && m_offset == other.m_offset && m_bAngled == other.m_bAngled;
+		return (m_pFsLocation == other.m_pFsLocation || getFsLocation() == other.getFsLocation()) && m_line == other.m_line && m_offset == other.m_offset && m_bAngled == other.m_bAngled;
 	}
 
 	bool DefinitionLocation::operator!=(const DefinitionLocation& other) const
 	{
 		return !operator==(other);
 	}
+
+	std::size_t DefinitionLocation::getInternedPathsCount()
+	{
+		return location_details::PathPool::get().getAliveCount();
+	}
 }
\ No newline at end of file
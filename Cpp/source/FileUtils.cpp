@@ -0,0 +1,93 @@
+#include <RG3/Cpp/FileUtils.h>
+
+#include <fmt/format.h>
+
+#include <fstream>
+#include <random>
+
+
+namespace rg3::cpp::utils
+{
+	bool writeFileAtomic(const std::filesystem::path& path, std::string_view data)
+	{
+		// Thread id & clock are not unique between processes which write same cache directory
+		thread_local std::mt19937_64 s_engine { std::random_device{}() };
+
+		auto tempPath = path;
+		tempPath += fmt::format(".{:016x}.tmp", s_engine());
+
+		std::error_code ec;
+
+		{
+			std::ofstream file { tempPath, std::ios::out | std::ios::trunc | std::ios::binary };
+			if (!file.is_open())
+				return false;
+
+			file.write(data.data(), static_cast<std::streamsize>(data.size()));
+			if (!file.good())
+			{
+				file.close();
+				std::filesystem::remove(tempPath, ec);
+				return false;
+			}
+		}
+
+		std::filesystem::rename(tempPath, path, ec);
+		if (ec)
+		{
+			std::filesystem::remove(tempPath, ec);
+			return false;
+		}
+
+		return true;
+	}
+
+	std::filesystem::path normalizePath(const std::filesystem::path& path)
+	{
+		std::error_code ec;
+		auto absolutePath = std::filesystem::absolute(path, ec);
+		return (ec ? path : absolutePath).lexically_normal();
+	}
+
+	std::vector<std::string> collectIncludeDirectives(std::string_view sSource)
+	{
+		std::vector<std::string> vIncludes {};
+
+		while (!sSource.empty())
+		{
+			const auto lineEnd = sSource.find('\n');
+			std::string_view view = sSource.substr(0, lineEnd);
+			sSource.remove_prefix(lineEnd == std::string_view::npos ? sSource.size() : lineEnd + 1);
+
+			auto skipSpaces = [&view]() {
+				while (!view.empty() && (view.front() == ' ' || view.front() == '\t'))
+					view.remove_prefix(1);
+			};
+
+			skipSpaces();
+			if (view.empty() || view.front() != '#')
+				continue;
+
+			view.remove_prefix(1);
+			skipSpaces();
+
+			constexpr std::string_view kIncludeDirective = "include";
+			if (!view.starts_with(kIncludeDirective))
+				continue;
+
+			view.remove_prefix(kIncludeDirective.length());
+			skipSpaces();
+
+			if (view.empty() || (view.front() != '<' && view.front() != '"'))
+				continue;
+
+			const auto closePos = view.find(view.front() == '<' ? '>' : '"', 1);
+			if (closePos == std::string_view::npos)
+				continue;
+
+			vIncludes.emplace_back(view.substr(0, closePos + 1));
+		}
+
+		return vIncludes;
+	}
+}
\ No newline at end of file
@@ -1,7 +1,7 @@
 #include <RG3/Cpp/Tag.h>
 #include <utility>
-#include <sstream>
-#include <regex>
+#include <cstdlib>
+#include <cerrno>
 
 
 namespace rg3::cpp
@@ -52,112 +52,159 @@ namespace rg3::cpp
 		return !operator==(other);
 	}
 
-	Tags Tag::parseFromCommentString(std::string_view commentText)
+	namespace tag_parser_details
 	{
-		std::vector<Tag> tags;
-		std::regex tagRegex("@([a-zA-Z_]{1}[a-zA-Z_.0-9]+)(\\([^)]*\\))?");
-		std::smatch tagMatch;
+		/// Same character classes as former regex '@([a-zA-Z_]{1}[a-zA-Z_.0-9]+)(\\([^)]*\\))?' (ASCII only, locale independent)
+		static constexpr bool isNameStart(char c)
+		{
+			return (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || c == '_';
+		}
 
-		auto commentBegin = std::cregex_iterator(commentText.data(), commentText.data() + commentText.size(), tagRegex);
-		auto commentEnd = std::cregex_iterator();
-		for (std::cregex_iterator regexIterator = commentBegin; regexIterator != commentEnd; ++regexIterator)
+		static constexpr bool isNameChar(char c)
 		{
-			auto tagName = std::string((*regexIterator)[1]);
-			auto unprocessedArguments = std::string((*regexIterator)[2]);
+			return isNameStart(c) || (c >= '0' && c <= '9') || c == '.';
+		}
 
-			std::vector<TagArgument> tagArguments {};
+		/**
+		 * @brief Interpret single argument: i64, float, bool, type reference ('@' prefix) or string (in that order)
+		 * @note Number must occupy whole argument (like std::stoll/std::stof with full match check). Out of range numbers are not numbers.
+		 */
+		static void parseArgument(const std::string& sArgument, std::vector<TagArgument>& vArguments)
+		{
+			const char* pBegin = sArgument.c_str();
+			char* pEnd = nullptr;
 
-			if (tagName.empty())
-				continue;
+			errno = 0;
+			const long long iValue = std::strtoll(pBegin, &pEnd, 10);
+			if (pEnd != pBegin && *pEnd == '\0' && errno != ERANGE)
+			{
+				vArguments.emplace_back(static_cast<std::int64_t>(iValue));
+				return;
+			}
 
-			if (!unprocessedArguments.empty())
+			errno = 0;
+			const float fValue = std::strtof(pBegin, &pEnd);
+			if (pEnd != pBegin && *pEnd == '\0' && errno != ERANGE)
 			{
-				// Parse args & fill tags
-				unprocessedArguments.erase(std::remove(unprocessedArguments.begin(), unprocessedArguments.end(), '('), unprocessedArguments.end());
-				unprocessedArguments.erase(std::remove(unprocessedArguments.begin(), unprocessedArguments.end(), ')'), unprocessedArguments.end());
+				vArguments.emplace_back(fValue);
+				return;
+			}
 
-				// Split arguments string by commas
-				std::vector<std::string> argumentStrings;
-				std::istringstream argumentsStream(unprocessedArguments);
+			if (sArgument == "true")
+			{
+				vArguments.emplace_back(true);
+				return;
+			}
 
-				{
-					std::string argumentString;
+			if (sArgument == "false")
+			{
+				vArguments.emplace_back(false);
+				return;
+			}
 
-					while (std::getline(argumentsStream, argumentString, ','))
-					{
-						argumentStrings.push_back(argumentString);
-					}
-				}
+			if (sArgument[0] == '@')
+			{
+				vArguments.emplace_back(TypeReference(sArgument.substr(1)));
+				return;
+			}
 
-				for (auto& argumentString : argumentStrings)
+			vArguments.emplace_back(sArgument);
+		}
+
+		/**
+		 * @brief Split text between parentheses by commas. Every argument: '(' removed, leading spaces removed, quotes removed. Empty arguments are skipped.
+		 */
+		static std::vector<TagArgument> parseArguments(std::string_view sArguments)
+		{
+			std::vector<TagArgument> vArguments {};
+			std::string sBuffer {};
+
+			std::size_t iPos = 0;
+			while (iPos <= sArguments.size())
+			{
+				std::size_t iComma = sArguments.find(',', iPos);
+				if (iComma == std::string_view::npos)
+					iComma = sArguments.size();
+
+				const std::string_view sPiece = sArguments.substr(iPos, iComma - iPos);
+				iPos = iComma + 1;
+
+				sBuffer.clear();
+
+				bool bLeadingSpaces = true;
+				for (char c : sPiece)
 				{
-					//NOTE: Make this code more optimized :thinking:
-					// Remove trailing spaces
-					while (!argumentString.empty() && argumentString[0] == ' ')
-						argumentString.erase(0, 1);
-
-					// Remove escape symbols
-					auto it = argumentString.find('\"');
-					while (it != std::string::npos)
-					{
-						argumentString.erase(it, 1);
-						it = argumentString.find('\"');
-					}
-
-					if (argumentString.empty())
+					if (c == '(')
 						continue;
 
-					// Try to interpret as int64
-					try
-					{
-						size_t pos;
-						int64_t intValue = std::stoll(argumentString, &pos);
-						if (pos == argumentString.size())
-						{
-							tagArguments.emplace_back(intValue);
-							continue;
-						}
-					} catch (const std::invalid_argument&) {
-						// Argument is not an int64_t
-					}
-
-					// Try to parse argument as float
-					try {
-						size_t pos;
-						float floatValue =std::stof(argumentString, &pos);
-						if (pos == argumentString.size()) {
-							tagArguments.emplace_back(floatValue);
-							continue;
-						}
-					} catch (const std::invalid_argument&) {
-						// Argument is not a float
-					}
-
-					// Try to parse argument as bool
-					if (argumentString == "true") {
-						tagArguments.emplace_back(true);
-						continue;
-					} else if (argumentString == "false") {
-						tagArguments.emplace_back(false);
+					if (bLeadingSpaces && c == ' ')
 						continue;
-					}
 
-					if (argumentString[0] == '@')
-					{
-						// Type reference
-						tagArguments.emplace_back(TypeReference(argumentString.substr(1)));
-						continue;
-					}
+					bLeadingSpaces = false;
+
+					if (c != '"')
+						sBuffer.push_back(c);
+				}
+
+				if (!sBuffer.empty())
+				{
+					parseArgument(sBuffer, vArguments);
+				}
+			}
+
+			return vArguments;
+		}
+	}
+
+	Tags Tag::parseFromCommentString(std::string_view commentText)
+	{
+		Tags tags {};
 
-					// Unknown case, save as string
-					tagArguments.emplace_back(argumentString);
+		// Most comments have no tags at all
+		if (commentText.find('@') == std::string_view::npos)
+			return tags;
+
+		const std::size_t iLength = commentText.size();
+		std::size_t iPos = 0;
+
+		while (iPos < iLength)
+		{
+			const std::size_t iAt = commentText.find('@', iPos);
+			if (iAt == std::string_view::npos)
+				break;
+
+			// Name: start char & at least one name char
+			const std::size_t iNameBegin = iAt + 1;
+			if (iNameBegin + 1 >= iLength || !tag_parser_details::isNameStart(commentText[iNameBegin]) || !tag_parser_details::isNameChar(commentText[iNameBegin + 1]))
+			{
+				iPos = iNameBegin;
+				continue;
+			}
+
+			std::size_t iNameEnd = iNameBegin + 2;
+			while (iNameEnd < iLength && tag_parser_details::isNameChar(commentText[iNameEnd]))
+				++iNameEnd;
+
+			iPos = iNameEnd;
+
+			std::vector<TagArgument> vArguments {};
+
+			// Arguments: '(' right after name & closing ')' somewhere after (otherwise tag has no arguments)
+			if (iNameEnd < iLength && commentText[iNameEnd] == '(')
+			{
+				if (const std::size_t iClose = commentText.find(')', iNameEnd + 1); iClose != std::string_view::npos)
+				{
+					vArguments = tag_parser_details::parseArguments(commentText.substr(iNameEnd + 1, iClose - iNameEnd - 1));
+					iPos = iClose + 1;
 				}
 			}
 
-			tags.emplace_back(std::move(tagName), std::move(tagArguments));
+			// Last tag with same name wins
+			std::string sName { commentText.substr(iNameBegin, iNameEnd - iNameBegin) };
+			tags.getTags().insert_or_assign(sName, Tag { sName, vArguments });
 		}
 
-		return Tags(std::move(tags));
+		return tags;
 	}
 
 	Tags::Tags() = default;
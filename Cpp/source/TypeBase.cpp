@@ -1,4 +1,5 @@
 #include <RG3/Cpp/TypeBase.h>
+#include <RG3/Cpp/HashUtils.h>
 
 
 namespace rg3::cpp
@@ -10,34 +11,27 @@ namespace rg3::cpp
 		TF_DECLARED_IN_ANOTHER_TYPE = (1 << 2)
 	};
 
-	namespace utils
-	{
-		inline void hashCombine(TypeID& seed) { }
-
-		template <typename T, typename... Rest>
-		inline void hashCombine(TypeID& seed, const T& v, Rest... rest) {
-			std::hash<T> hasher;
-			seed ^= hasher(v) + 0x9e3779b9 + (seed<<6) + (seed>>2);
-			hashCombine(seed, rest...);
-		}
-	}
-
 	TypeBase::TypeBase() = default;
 
-	TypeBase::TypeBase(TypeKind kind, const std::string& name, const std::string& prettyName, const CppNamespace& aNamespace, const DefinitionLocation& aLocation, const Tags& tags)
+	TypeBase::TypeBase(TypeKind kind, std::string name, std::string prettyName, CppNamespace aNamespace, DefinitionLocation aLocation, Tags tags)
 		: m_kind(kind)
-		, m_name(name)
-		, m_prettyName(prettyName)
-		, m_nameSpace(aNamespace)
-		, m_location(aLocation)
-		, m_tags(tags)
+		, m_name(std::move(name))
+		, m_prettyName(std::move(prettyName))
+		, m_nameSpace(std::move(aNamespace))
+		, m_location(std::move(aLocation))
+		, m_tags(std::move(tags))
 	{
 	}
 
 	TypeID TypeBase::getID() const
+	{
+		return makeID(m_kind, m_name, m_nameSpace, m_location);
+	}
+
+	TypeID TypeBase::makeID(TypeKind kind, const std::string& name, const CppNamespace& aNamespace, const DefinitionLocation& aLocation)
 	{
 		TypeID seed = 0x0;
-		utils::hashCombine(seed, m_kind, m_name, static_cast<std::string>(m_nameSpace), m_location.getFsLocation().string(), m_location.getLine(), m_location.getInLineOffset());
+		utils::hashCombine(seed, kind, name, static_cast<std::string>(aNamespace), aLocation.getFsLocation().string(), aLocation.getLine(), aLocation.getInLineOffset());
 		return seed;
 	}
 
@@ -88,34 +82,34 @@ namespace rg3::cpp
 		return getKind() == TypeKind::TK_STRUCT_OR_CLASS || getKind() == TypeKind::TK_ENUM;
 	}
 
-	void TypeBase::overrideTypeData(const std::string& name, const std::string& prettyName)
+	void TypeBase::overrideTypeData(std::string name, std::string prettyName)
 	{
-		m_name = name;
-		m_prettyName = prettyName;
+		m_name = std::move(name);
+		m_prettyName = std::move(prettyName);
 	}
 
-	void TypeBase::overrideTypeData(const std::string& name, const std::string& prettyName, const rg3::cpp::CppNamespace& aNamespace)
+	void TypeBase::overrideTypeData(std::string name, std::string prettyName, rg3::cpp::CppNamespace aNamespace)
 	{
-		m_name = name;
-		m_prettyName = prettyName;
-		m_nameSpace = aNamespace;
+		m_name = std::move(name);
+		m_prettyName = std::move(prettyName);
+		m_nameSpace = std::move(aNamespace);
 	}
 
-	void TypeBase::overrideTypeData(const std::string& name, const std::string& prettyName, const rg3::cpp::CppNamespace& aNamespace, const rg3::cpp::DefinitionLocation& aLocation)
+	void TypeBase::overrideTypeData(std::string name, std::string prettyName, rg3::cpp::CppNamespace aNamespace, rg3::cpp::DefinitionLocation aLocation)
 	{
-		m_name = name;
-		m_prettyName = prettyName;
-		m_nameSpace = aNamespace;
-		m_location = aLocation;
+		m_name = std::move(name);
+		m_prettyName = std::move(prettyName);
+		m_nameSpace = std::move(aNamespace);
+		m_location = std::move(aLocation);
 	}
 
-	void TypeBase::overrideTypeData(const std::string& name, const std::string& prettyName, const CppNamespace& aNamespace, const DefinitionLocation& aLocation, const Tags& tags)
+	void TypeBase::overrideTypeData(std::string name, std::string prettyName, CppNamespace aNamespace, DefinitionLocation aLocation, Tags tags)
 	{
-		m_name = name;
-		m_prettyName = prettyName;
-		m_nameSpace = aNamespace;
-		m_location = aLocation;
-		m_tags = tags;
+		m_name = std::move(name);
+		m_prettyName = std::move(prettyName);
+		m_nameSpace = std::move(aNamespace);
+		m_location = std::move(aLocation);
+		m_tags = std::move(tags);
 	}
 
 	void TypeBase::setProducedFromTemplate()
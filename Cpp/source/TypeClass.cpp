@@ -54,18 +54,18 @@ namespace rg3::cpp
 
 	TypeClass::TypeClass() = default;
 
-	TypeClass::TypeClass(const std::string& name, const std::string& prettyName, const rg3::cpp::CppNamespace& aNamespace, const rg3::cpp::DefinitionLocation& aLocation, const Tags& tags, const rg3::cpp::ClassPropertyVector& aProperties, const rg3::cpp::ClassFunctionVector& aFunctions, const ClassFriendVector& aFriends, bool bIsStruct, bool bTrivialConstructible, bool bHasCopyConstructor, bool bHasCopyAssignOperator, bool bHasMoveConstructor, bool bHasMoveAssignOperator, const std::vector<ClassParent>& parentTypes)
-		: TypeBase(TypeKind::TK_STRUCT_OR_CLASS, name, prettyName, aNamespace, aLocation, tags)
-		, m_properties(aProperties)
-		, m_functions(aFunctions)
-		, m_friends(aFriends)
+	TypeClass::TypeClass(std::string name, std::string prettyName, rg3::cpp::CppNamespace aNamespace, rg3::cpp::DefinitionLocation aLocation, Tags tags, rg3::cpp::ClassPropertyVector aProperties, rg3::cpp::ClassFunctionVector aFunctions, ClassFriendVector aFriends, bool bIsStruct, bool bTrivialConstructible, bool bHasCopyConstructor, bool bHasCopyAssignOperator, bool bHasMoveConstructor, bool bHasMoveAssignOperator, std::vector<ClassParent> parentTypes)
+		: TypeBase(TypeKind::TK_STRUCT_OR_CLASS, std::move(name), std::move(prettyName), std::move(aNamespace), std::move(aLocation), std::move(tags))
+		, m_properties(std::move(aProperties))
+		, m_functions(std::move(aFunctions))
+		, m_friends(std::move(aFriends))
 		, m_bIsStruct(bIsStruct)
 		, m_bIsTrivialConstructible(bTrivialConstructible)
 		, m_bHasCopyConstructor(bHasCopyConstructor)
 		, m_bHasCopyAssignOperator(bHasCopyAssignOperator)
 		, m_bHasMoveConstructor(bHasMoveConstructor)
 		, m_bHasMoveAssignOperator(bHasMoveAssignOperator)
-		, m_parentTypes(parentTypes)
+		, m_parentTypes(std::move(parentTypes))
 	{
 	}
 
@@ -154,6 +154,6 @@ namespace rg3::cpp
 		if (pOtherClass->getFunctions() != getFunctions())
 			return false;
 
-		return TypeBase::areSame(pOther);
+		return TypeBase::doAreSame(pOther);
 	}
 }
\ No newline at end of file
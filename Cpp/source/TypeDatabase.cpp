@@ -0,0 +1,677 @@
+#include <RG3/Cpp/TypeDatabase.h>
+#include <RG3/Cpp/TypeSerializer.h>
+#include <RG3/Cpp/TypeClass.h>
+#include <RG3/Cpp/TypeEnum.h>
+#include <RG3/Cpp/FileUtils.h>
+
+#include <fmt/format.h>
+
+#include <unordered_map>
+#include <algorithm>
+#include <cstring>
+
+#if defined(_WIN32)
+#	define WIN32_LEAN_AND_MEAN
+#	define NOMINMAX
+#	include <Windows.h>
+#else
+#	include <sys/mman.h>
+#	include <sys/stat.h>
+#	include <fcntl.h>
+#	include <unistd.h>
+#endif
+
+
+namespace rg3::cpp
+{
+	namespace database_details
+	{
+		/**
+		 * @brief Header of database file. All offsets are absolute (from beginning of file)
+		 */
+		struct FileHeader
+		{
+			std::uint32_t iMagic { 0 };
+			std::uint32_t iVersion { 0 };
+			std::uint32_t iStringsCount { 0 };
+			std::uint32_t iTypesCount { 0 };
+			std::uint32_t iIssuesCount { 0 };
+			std::uint32_t iLinksCount { 0 };
+			std::uint64_t iStringRecordsOffset { 0 }; /// iStringsCount x (u32 offset in blob, u32 length)
+			std::uint64_t iStringBlobOffset { 0 };
+			std::uint64_t iStringBlobSize { 0 };
+			std::uint64_t iTypeRecordsOffset { 0 }; /// iTypesCount x TypeRecord
+			std::uint64_t iIssueRecordsOffset { 0 }; /// iIssuesCount x IssueRecord
+			std::uint64_t iNameIndexOffset { 0 }; /// iTypesCount x u32 (index of type), sorted by pretty name
+			std::uint64_t iLinksOffset { 0 }; /// iLinksCount x u32 (index of type)
+			std::uint64_t iPayloadOffset { 0 };
+			std::uint64_t iPayloadSize { 0 };
+			std::uint64_t iFileSize { 0 };
+		};
+
+		struct TypeRecord
+		{
+			std::uint64_t iPayloadOffset { 0 }; /// Offset inside payload section
+			std::uint64_t iPayloadSize { 0 };
+			std::uint32_t iKind { 0 };
+			std::uint32_t iNameId { 0 };
+			std::uint32_t iPrettyNameId { 0 };
+			std::uint32_t iNamespaceId { 0 };
+			std::uint32_t iPathId { 0 };
+			std::uint32_t iLine { 0 };
+			std::uint32_t iParentsOffset { 0 }; /// Index of first link
+			std::uint32_t iParentsCount { 0 };
+			std::uint32_t iReferencesOffset { 0 };
+			std::uint32_t iReferencesCount { 0 };
+		};
+
+		struct IssueRecord
+		{
+			std::uint32_t iKind { 0 };
+			std::uint32_t iFileId { 0 };
+			std::uint32_t iLine { 0 };
+			std::uint32_t iColumn { 0 };
+			std::uint32_t iMessageId { 0 };
+			std::uint32_t iReserved { 0 };
+		};
+
+		static_assert(sizeof(FileHeader) == 104, "FileHeader layout is a part of file format");
+		static_assert(sizeof(TypeRecord) == 56, "TypeRecord layout is a part of file format");
+		static_assert(sizeof(IssueRecord) == 24, "IssueRecord layout is a part of file format");
+
+		constexpr std::size_t kSectionAlignment = 8;
+
+		static void alignBuffer(std::string& buffer)
+		{
+			buffer.resize((buffer.size() + kSectionAlignment - 1) / kSectionAlignment * kSectionAlignment, '\0');
+		}
+
+		template <typename T>
+		static void appendRecord(std::string& buffer, const T& record)
+		{
+			buffer.append(reinterpret_cast<const char*>(&record), sizeof(T));
+		}
+
+		template <typename T>
+		static T readRecord(std::string_view section, std::size_t iIndex)
+		{
+			T record {};
+			std::memcpy(&record, section.data() + iIndex * sizeof(T), sizeof(T));
+			return record;
+		}
+
+		/**
+		 * @return section or std::nullopt when it is out of data
+		 */
+		static std::optional<std::string_view> getSection(std::string_view data, std::uint64_t iOffset, std::uint64_t iSize)
+		{
+			if (iOffset > data.size() || data.size() - iOffset < iSize)
+				return std::nullopt;
+
+			return data.substr(iOffset, iSize);
+		}
+
+		static void collectReferencedNames(const TypeBase* pType, std::vector<std::string_view>& vNames)
+		{
+			auto addStatement = [&vNames](const TypeStatement& statement)
+			{
+				vNames.emplace_back(statement.sBaseInfo.sPrettyName.empty() ? std::string_view { statement.sTypeRef.getRefName() } : std::string_view { statement.sBaseInfo.sPrettyName });
+			};
+
+			if (pType->getKind() == TypeKind::TK_ENUM)
+			{
+				vNames.emplace_back(static_cast<const TypeEnum*>(pType)->getUnderlyingType().getRefName());
+			}
+			else if (pType->getKind() == TypeKind::TK_STRUCT_OR_CLASS)
+			{
+				const auto* pClass = static_cast<const TypeClass*>(pType);
+
+				for (const auto& property : pClass->getProperties())
+				{
+					addStatement(property.sTypeInfo);
+				}
+
+				for (const auto& function : pClass->getFunctions())
+				{
+					addStatement(function.sReturnType);
+
+					for (const auto& argument : function.vArguments)
+					{
+						addStatement(argument.sType);
+					}
+				}
+			}
+		}
+	}
+
+	TypeDatabaseWriter::TypeDatabaseWriter() = default;
+
+	void TypeDatabaseWriter::addType(const TypeBase* pType)
+	{
+		if (pType)
+		{
+			m_vTypes.emplace_back(pType);
+		}
+	}
+
+	void TypeDatabaseWriter::addTypes(const std::vector<TypeBasePtr>& vTypes)
+	{
+		m_vTypes.reserve(m_vTypes.size() + vTypes.size());
+
+		for (const auto& pType : vTypes)
+		{
+			addType(pType.get());
+		}
+	}
+
+	void TypeDatabaseWriter::addIssue(TypeDatabaseIssue issue)
+	{
+		m_vIssues.emplace_back(std::move(issue));
+	}
+
+	std::string TypeDatabaseWriter::build() const
+	{
+		using namespace database_details;
+
+		StringTableBuilder strings {};
+		std::string payload {};
+		std::vector<TypeRecord> vTypeRecords {};
+		std::vector<IssueRecord> vIssueRecords {};
+		std::vector<std::uint32_t> vLinks {};
+
+		// First type with same pretty name wins (same rule as name index)
+		std::unordered_map<std::string_view, std::uint32_t> typeIndices {};
+		for (std::uint32_t i = 0; i < static_cast<std::uint32_t>(m_vTypes.size()); ++i)
+		{
+			typeIndices.try_emplace(m_vTypes[i]->getPrettyName(), i);
+		}
+
+		auto appendLinks = [&vLinks, &typeIndices](const std::vector<std::string_view>& vNames, std::uint32_t& iOffset, std::uint32_t& iCount)
+		{
+			iOffset = static_cast<std::uint32_t>(vLinks.size());
+
+			for (const auto& sName : vNames)
+			{
+				auto it = typeIndices.find(sName);
+				if (it == typeIndices.end())
+					continue;
+
+				if (std::find(vLinks.begin() + iOffset, vLinks.end(), it->second) == vLinks.end())
+				{
+					vLinks.emplace_back(it->second);
+				}
+			}
+
+			iCount = static_cast<std::uint32_t>(vLinks.size()) - iOffset;
+		};
+
+		vTypeRecords.reserve(m_vTypes.size());
+
+		for (const TypeBase* pType : m_vTypes)
+		{
+			BinaryWriter typeWriter { &strings };
+			TypeSerializer::writeType(typeWriter, pType);
+
+			TypeRecord& record = vTypeRecords.emplace_back();
+			record.iPayloadOffset = payload.size();
+			record.iPayloadSize = typeWriter.getBuffer().size();
+			record.iKind = static_cast<std::uint32_t>(pType->getKind());
+			record.iNameId = strings.intern(pType->getName());
+			record.iPrettyNameId = strings.intern(pType->getPrettyName());
+			record.iNamespaceId = strings.intern(pType->getNamespace().asString());
+			record.iPathId = strings.intern(pType->getDefinition().getPath());
+			record.iLine = static_cast<std::uint32_t>(std::max(pType->getDefinition().getLine(), 0));
+
+			payload.append(typeWriter.getBuffer());
+
+			std::vector<std::string_view> vNames {};
+
+			if (pType->getKind() == TypeKind::TK_STRUCT_OR_CLASS)
+			{
+				for (const auto& parent : static_cast<const TypeClass*>(pType)->getParentTypes())
+				{
+					vNames.emplace_back(parent.sTypeBaseInfo.sPrettyName);
+				}
+			}
+
+			appendLinks(vNames, record.iParentsOffset, record.iParentsCount);
+
+			vNames.clear();
+			collectReferencedNames(pType, vNames);
+			appendLinks(vNames, record.iReferencesOffset, record.iReferencesCount);
+		}
+
+		vIssueRecords.reserve(m_vIssues.size());
+
+		for (const auto& issue : m_vIssues)
+		{
+			IssueRecord& record = vIssueRecords.emplace_back();
+			record.iKind = issue.iKind;
+			record.iFileId = strings.intern(issue.sSourceFile);
+			record.iLine = issue.iLine;
+			record.iColumn = issue.iColumn;
+			record.iMessageId = strings.intern(issue.sMessage);
+		}
+
+		std::vector<std::uint32_t> vNameIndex(m_vTypes.size());
+		for (std::uint32_t i = 0; i < static_cast<std::uint32_t>(vNameIndex.size()); ++i)
+		{
+			vNameIndex[i] = i;
+		}
+
+		std::stable_sort(vNameIndex.begin(), vNameIndex.end(), [this](std::uint32_t a, std::uint32_t b) {
+			return m_vTypes[a]->getPrettyName() < m_vTypes[b]->getPrettyName();
+		});
+
+		// Layout
+		FileHeader header {};
+		header.iMagic = TypeDatabase::kMagic;
+		header.iVersion = TypeDatabase::kVersion;
+		header.iStringsCount = static_cast<std::uint32_t>(strings.getStrings().size());
+		header.iTypesCount = static_cast<std::uint32_t>(vTypeRecords.size());
+		header.iIssuesCount = static_cast<std::uint32_t>(vIssueRecords.size());
+		header.iLinksCount = static_cast<std::uint32_t>(vLinks.size());
+
+		std::string result {};
+		result.resize(sizeof(FileHeader), '\0');
+
+		alignBuffer(result);
+		header.iStringRecordsOffset = result.size();
+		{
+			std::uint32_t iBlobOffset = 0;
+
+			for (const auto& sValue : strings.getStrings())
+			{
+				const auto iLength = static_cast<std::uint32_t>(sValue.size());
+				appendRecord(result, iBlobOffset);
+				appendRecord(result, iLength);
+				iBlobOffset += iLength;
+			}
+		}
+
+		alignBuffer(result);
+		header.iStringBlobOffset = result.size();
+		for (const auto& sValue : strings.getStrings())
+		{
+			result.append(sValue);
+		}
+		header.iStringBlobSize = result.size() - header.iStringBlobOffset;
+
+		alignBuffer(result);
+		header.iTypeRecordsOffset = result.size();
+		for (const auto& record : vTypeRecords)
+		{
+			appendRecord(result, record);
+		}
+
+		alignBuffer(result);
+		header.iIssueRecordsOffset = result.size();
+		for (const auto& record : vIssueRecords)
+		{
+			appendRecord(result, record);
+		}
+
+		alignBuffer(result);
+		header.iNameIndexOffset = result.size();
+		for (const auto& iIndex : vNameIndex)
+		{
+			appendRecord(result, iIndex);
+		}
+
+		alignBuffer(result);
+		header.iLinksOffset = result.size();
+		for (const auto& iIndex : vLinks)
+		{
+			appendRecord(result, iIndex);
+		}
+
+		alignBuffer(result);
+		header.iPayloadOffset = result.size();
+		header.iPayloadSize = payload.size();
+		result.append(payload);
+
+		header.iFileSize = result.size();
+		std::memcpy(result.data(), &header, sizeof(FileHeader));
+
+		return result;
+	}
+
+	bool TypeDatabaseWriter::writeToFile(const std::filesystem::path& path) const
+	{
+		return utils::writeFileAtomic(path, build());
+	}
+
+	struct TypeDatabase::Storage
+	{
+		std::string buffer {};
+
+#if defined(_WIN32)
+		HANDLE hFile { INVALID_HANDLE_VALUE };
+		HANDLE hMapping { nullptr };
+#endif
+		const char* pMapped { nullptr };
+		std::size_t iMappedSize { 0 };
+
+		Storage() = default;
+		Storage(const Storage&) = delete;
+		Storage& operator=(const Storage&) = delete;
+
+		~Storage()
+		{
+#if defined(_WIN32)
+			if (pMapped) UnmapViewOfFile(pMapped);
+			if (hMapping) CloseHandle(hMapping);
+			if (hFile != INVALID_HANDLE_VALUE) CloseHandle(hFile);
+#else
+			if (pMapped) munmap(const_cast<char*>(pMapped), iMappedSize);
+#endif
+		}
+
+		[[nodiscard]] std::string_view getData() const
+		{
+			if (pMapped)
+				return { pMapped, iMappedSize };
+
+			return buffer;
+		}
+
+		bool map(const std::filesystem::path& path)
+		{
+#if defined(_WIN32)
+			hFile = CreateFileW(path.c_str(), GENERIC_READ, FILE_SHARE_READ | FILE_SHARE_DELETE, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+			if (hFile == INVALID_HANDLE_VALUE)
+				return false;
+
+			LARGE_INTEGER fileSize {};
+			if (!GetFileSizeEx(hFile, &fileSize) || fileSize.QuadPart < static_cast<LONGLONG>(sizeof(database_details::FileHeader)))
+				return false;
+
+			hMapping = CreateFileMappingW(hFile, nullptr, PAGE_READONLY, 0, 0, nullptr);
+			if (!hMapping)
+				return false;
+
+			pMapped = static_cast<const char*>(MapViewOfFile(hMapping, FILE_MAP_READ, 0, 0, 0));
+			iMappedSize = static_cast<std::size_t>(fileSize.QuadPart);
+			return pMapped != nullptr;
+#else
+			const int iFd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+			if (iFd < 0)
+				return false;
+
+			struct stat fileStat {};
+			if (::fstat(iFd, &fileStat) != 0 || fileStat.st_size < static_cast<off_t>(sizeof(database_details::FileHeader)))
+			{
+				::close(iFd);
+				return false;
+			}
+
+			void* pView = ::mmap(nullptr, static_cast<std::size_t>(fileStat.st_size), PROT_READ, MAP_PRIVATE, iFd, 0);
+			::close(iFd); // mapping keeps file alive
+
+			if (pView == MAP_FAILED)
+				return false;
+
+			pMapped = static_cast<const char*>(pView);
+			iMappedSize = static_cast<std::size_t>(fileStat.st_size);
+			return true;
+#endif
+		}
+	};
+
+	std::unique_ptr<TypeDatabase> TypeDatabase::open(const std::filesystem::path& path)
+	{
+		auto pStorage = std::make_unique<Storage>();
+		if (!pStorage->map(path))
+			return nullptr;
+
+		std::unique_ptr<TypeDatabase> pDatabase { new TypeDatabase(std::move(pStorage)) };
+		if (!pDatabase->validate())
+			return nullptr;
+
+		return pDatabase;
+	}
+
+	std::unique_ptr<TypeDatabase> TypeDatabase::fromBuffer(std::string buffer)
+	{
+		auto pStorage = std::make_unique<Storage>();
+		pStorage->buffer = std::move(buffer);
+
+		std::unique_ptr<TypeDatabase> pDatabase { new TypeDatabase(std::move(pStorage)) };
+		if (!pDatabase->validate())
+			return nullptr;
+
+		return pDatabase;
+	}
+
+	TypeDatabase::TypeDatabase(std::unique_ptr<Storage>&& pStorage) : m_pStorage(std::move(pStorage))
+	{
+		m_data = m_pStorage->getData();
+	}
+
+	TypeDatabase::~TypeDatabase() = default;
+
+	bool TypeDatabase::validate()
+	{
+		using namespace database_details;
+
+		if (m_data.size() < sizeof(FileHeader))
+			return false;
+
+		FileHeader header {};
+		std::memcpy(&header, m_data.data(), sizeof(FileHeader));
+
+		if (header.iMagic != kMagic || header.iVersion != kVersion || header.iFileSize != m_data.size())
+			return false;
+
+		const auto stringRecords = getSection(m_data, header.iStringRecordsOffset, static_cast<std::uint64_t>(header.iStringsCount) * sizeof(std::uint32_t) * 2);
+		const auto stringBlob = getSection(m_data, header.iStringBlobOffset, header.iStringBlobSize);
+		const auto typeRecords = getSection(m_data, header.iTypeRecordsOffset, static_cast<std::uint64_t>(header.iTypesCount) * sizeof(TypeRecord));
+		const auto issueRecords = getSection(m_data, header.iIssueRecordsOffset, static_cast<std::uint64_t>(header.iIssuesCount) * sizeof(IssueRecord));
+		const auto nameIndex = getSection(m_data, header.iNameIndexOffset, static_cast<std::uint64_t>(header.iTypesCount) * sizeof(std::uint32_t));
+		const auto links = getSection(m_data, header.iLinksOffset, static_cast<std::uint64_t>(header.iLinksCount) * sizeof(std::uint32_t));
+		const auto payload = getSection(m_data, header.iPayloadOffset, header.iPayloadSize);
+
+		if (!stringRecords || !stringBlob || !typeRecords || !issueRecords || !nameIndex || !links || !payload)
+			return false;
+
+		m_strings = StringTableView { stringRecords.value(), stringBlob.value() };
+		m_iTypesCount = header.iTypesCount;
+		m_iIssuesCount = header.iIssuesCount;
+		m_iLinksCount = header.iLinksCount;
+		m_typeRecords = typeRecords.value();
+		m_issueRecords = issueRecords.value();
+		m_nameIndex = nameIndex.value();
+		m_links = links.value();
+		m_payload = payload.value();
+		return true;
+	}
+
+	std::uint32_t TypeDatabase::getTypesCount() const
+	{
+		return m_iTypesCount;
+	}
+
+	std::uint32_t TypeDatabase::getIssuesCount() const
+	{
+		return m_iIssuesCount;
+	}
+
+	std::string_view TypeDatabase::getString(std::uint32_t iId) const
+	{
+		return m_strings.getString(iId).value_or(std::string_view {});
+	}
+
+	std::vector<std::uint32_t> TypeDatabase::getLinks(std::uint32_t iOffset, std::uint32_t iCount) const
+	{
+		std::vector<std::uint32_t> vResult {};
+
+		if (iOffset > m_iLinksCount || m_iLinksCount - iOffset < iCount)
+			return vResult;
+
+		vResult.reserve(iCount);
+
+		for (std::uint32_t i = 0; i < iCount; ++i)
+		{
+			const auto iIndex = database_details::readRecord<std::uint32_t>(m_links, iOffset + i);
+			if (iIndex < m_iTypesCount)
+			{
+				vResult.emplace_back(iIndex);
+			}
+		}
+
+		return vResult;
+	}
+
+	TypeKind TypeDatabase::getTypeKind(std::uint32_t iIndex) const
+	{
+		if (iIndex >= m_iTypesCount)
+			return TypeKind::TK_NONE;
+
+		return static_cast<TypeKind>(database_details::readRecord<database_details::TypeRecord>(m_typeRecords, iIndex).iKind);
+	}
+
+	std::string_view TypeDatabase::getTypeName(std::uint32_t iIndex) const
+	{
+		if (iIndex >= m_iTypesCount)
+			return {};
+
+		return getString(database_details::readRecord<database_details::TypeRecord>(m_typeRecords, iIndex).iNameId);
+	}
+
+	std::string_view TypeDatabase::getTypePrettyName(std::uint32_t iIndex) const
+	{
+		if (iIndex >= m_iTypesCount)
+			return {};
+
+		return getString(database_details::readRecord<database_details::TypeRecord>(m_typeRecords, iIndex).iPrettyNameId);
+	}
+
+	std::string_view TypeDatabase::getTypeNamespace(std::uint32_t iIndex) const
+	{
+		if (iIndex >= m_iTypesCount)
+			return {};
+
+		return getString(database_details::readRecord<database_details::TypeRecord>(m_typeRecords, iIndex).iNamespaceId);
+	}
+
+	std::string_view TypeDatabase::getTypeDefinitionPath(std::uint32_t iIndex) const
+	{
+		if (iIndex >= m_iTypesCount)
+			return {};
+
+		return getString(database_details::readRecord<database_details::TypeRecord>(m_typeRecords, iIndex).iPathId);
+	}
+
+	std::uint32_t TypeDatabase::getTypeDefinitionLine(std::uint32_t iIndex) const
+	{
+		if (iIndex >= m_iTypesCount)
+			return 0;
+
+		return database_details::readRecord<database_details::TypeRecord>(m_typeRecords, iIndex).iLine;
+	}
+
+	std::vector<std::uint32_t> TypeDatabase::getParentTypes(std::uint32_t iIndex) const
+	{
+		if (iIndex >= m_iTypesCount)
+			return {};
+
+		const auto record = database_details::readRecord<database_details::TypeRecord>(m_typeRecords, iIndex);
+		return getLinks(record.iParentsOffset, record.iParentsCount);
+	}
+
+	std::vector<std::uint32_t> TypeDatabase::getReferencedTypes(std::uint32_t iIndex) const
+	{
+		if (iIndex >= m_iTypesCount)
+			return {};
+
+		const auto record = database_details::readRecord<database_details::TypeRecord>(m_typeRecords, iIndex);
+		return getLinks(record.iReferencesOffset, record.iReferencesCount);
+	}
+
+	std::optional<std::uint32_t> TypeDatabase::findType(std::string_view sPrettyName) const
+	{
+		std::uint32_t iLow = 0;
+		std::uint32_t iHigh = m_iTypesCount;
+
+		// lower bound over name index
+		while (iLow < iHigh)
+		{
+			const std::uint32_t iMid = iLow + (iHigh - iLow) / 2;
+			const auto iType = database_details::readRecord<std::uint32_t>(m_nameIndex, iMid);
+
+			if (getTypePrettyName(iType) < sPrettyName)
+			{
+				iLow = iMid + 1;
+			}
+			else
+			{
+				iHigh = iMid;
+			}
+		}
+
+		if (iLow >= m_iTypesCount)
+			return std::nullopt;
+
+		const auto iType = database_details::readRecord<std::uint32_t>(m_nameIndex, iLow);
+		if (iType >= m_iTypesCount || getTypePrettyName(iType) != sPrettyName)
+			return std::nullopt;
+
+		return iType;
+	}
+
+	TypeBasePtr TypeDatabase::loadType(std::uint32_t iIndex) const
+	{
+		if (iIndex >= m_iTypesCount)
+			return nullptr;
+
+		const auto record = database_details::readRecord<database_details::TypeRecord>(m_typeRecords, iIndex);
+		const auto payload = database_details::getSection(m_payload, record.iPayloadOffset, record.iPayloadSize);
+		if (!payload.has_value())
+			return nullptr;
+
+		BinaryReader reader { payload.value(), &m_strings };
+		auto pType = TypeSerializer::readType(reader);
+		if (!pType || !reader.isEOF())
+			return nullptr;
+
+		return pType;
+	}
+
+	bool TypeDatabase::loadTypes(std::vector<TypeBasePtr>& vOutTypes) const
+	{
+		std::vector<TypeBasePtr> vTypes {};
+		vTypes.reserve(m_iTypesCount);
+
+		for (std::uint32_t i = 0; i < m_iTypesCount; ++i)
+		{
+			auto pType = loadType(i);
+			if (!pType)
+				return false;
+
+			vTypes.emplace_back(std::move(pType));
+		}
+
+		for (auto& pType : vTypes)
+		{
+			vOutTypes.emplace_back(std::move(pType));
+		}
+
+		return true;
+	}
+
+	std::optional<TypeDatabaseIssue> TypeDatabase::getIssue(std::uint32_t iIndex) const
+	{
+		if (iIndex >= m_iIssuesCount)
+			return std::nullopt;
+
+		const auto record = database_details::readRecord<database_details::IssueRecord>(m_issueRecords, iIndex);
+
+		TypeDatabaseIssue issue {};
+		issue.iKind = static_cast<std::uint8_t>(record.iKind);
+		issue.sSourceFile = std::string { getString(record.iFileId) };
+		issue.iLine = record.iLine;
+		issue.iColumn = record.iColumn;
+		issue.sMessage = std::string { getString(record.iMessageId) };
+		return issue;
+	}
+}
\ No newline at end of file
@@ -23,11 +23,11 @@ namespace rg3::cpp
 
 	TypeEnum::TypeEnum() = default;
 
-	TypeEnum::TypeEnum(const std::string& name, const std::string& prettyName, const CppNamespace& aNamespace, const DefinitionLocation& aLocation, const Tags& tags, const EnumEntryVector& aValues, bool bIsScoped, TypeReference underlyingType)
-		: TypeBase(TypeKind::TK_ENUM, name, prettyName, aNamespace, aLocation, tags)
-		, m_entries(aValues)
+	TypeEnum::TypeEnum(std::string name, std::string prettyName, CppNamespace aNamespace, DefinitionLocation aLocation, Tags tags, EnumEntryVector aValues, bool bIsScoped, TypeReference underlyingType)
+		: TypeBase(TypeKind::TK_ENUM, std::move(name), std::move(prettyName), std::move(aNamespace), std::move(aLocation), std::move(tags))
+		, m_entries(std::move(aValues))
 		, m_bScoped(bIsScoped)
-		, m_rUnderlyingType(underlyingType)
+		, m_rUnderlyingType(std::move(underlyingType))
 	{
 	}
 
@@ -66,7 +66,12 @@ namespace rg3::cpp
 		return m_bScoped;
 	}
 
-	TypeReference TypeEnum::getUnderlyingType() const
+	const TypeReference& TypeEnum::getUnderlyingType() const
+	{
+		return m_rUnderlyingType;
+	}
+
+	TypeReference& TypeEnum::getUnderlyingType()
 	{
 		return m_rUnderlyingType;
 	}
@@ -84,6 +89,6 @@ namespace rg3::cpp
 		const EnumEntryVector& v1 = pOtherEnum->getEntries();
 		const EnumEntryVector& v2 = getEntries();
 
-		return v1 == v2 && TypeBase::areSame(pOther);
+		return v1 == v2 && TypeBase::doAreSame(pOther);
 	}
 }
\ No newline at end of file
@@ -0,0 +1,198 @@
+#include <RG3/Cpp/TypeReferenceResolver.h>
+#include <RG3/Cpp/TypeClass.h>
+#include <RG3/Cpp/TypeEnum.h>
+
+#include <algorithm>
+#include <thread>
+
+
+namespace rg3::cpp
+{
+	TypeReferenceResolver::TypeReferenceResolver() = default;
+
+	void TypeReferenceResolver::addType(TypeBase* pType)
+	{
+		if (!pType || pType->getKind() == TypeKind::TK_NONE)
+			return;
+
+		m_byName.try_emplace(pType->getPrettyName(), pType);
+		m_byID.try_emplace(pType->getID(), pType);
+	}
+
+	void TypeReferenceResolver::addTypes(const std::vector<TypeBasePtr>& vTypes)
+	{
+		m_byName.reserve(m_byName.size() + vTypes.size());
+		m_byID.reserve(m_byID.size() + vTypes.size());
+
+		for (const auto& pType : vTypes)
+		{
+			addType(pType.get());
+		}
+	}
+
+	TypeBase* TypeReferenceResolver::findByName(std::string_view sPrettyName) const
+	{
+		auto it = m_byName.find(sPrettyName);
+		return it != m_byName.end() ? it->second : nullptr;
+	}
+
+	TypeBase* TypeReferenceResolver::findByID(TypeID id) const
+	{
+		auto it = m_byID.find(id);
+		return it != m_byID.end() ? it->second : nullptr;
+	}
+
+	std::size_t TypeReferenceResolver::getIndexedCount() const
+	{
+		return m_byName.size();
+	}
+
+	TypeReferenceResolver::Stats TypeReferenceResolver::resolve(const std::vector<TypeBasePtr>& vTypes, int iWorkers) const
+	{
+		std::vector<TypeBase*> vRawTypes {};
+		vRawTypes.reserve(vTypes.size());
+
+		for (const auto& pType : vTypes)
+		{
+			vRawTypes.push_back(pType.get());
+		}
+
+		return resolve(vRawTypes, iWorkers);
+	}
+
+	TypeReferenceResolver::Stats TypeReferenceResolver::resolve(const std::vector<TypeBase*>& vTypes, int iWorkers) const
+	{
+		const std::size_t iWorkersCount = std::clamp<std::size_t>(static_cast<std::size_t>(std::max(iWorkers, 1)), 1, std::max<std::size_t>(vTypes.size(), 1));
+		const std::size_t iChunkSize = (vTypes.size() + iWorkersCount - 1) / iWorkersCount;
+
+		std::vector<Stats> vStats(iWorkersCount);
+
+		auto fnResolveChunk = [this, &vTypes, &vStats, iChunkSize](std::size_t iWorker) {
+			const std::size_t iBegin = iWorker * iChunkSize;
+			const std::size_t iEnd = std::min(iBegin + iChunkSize, vTypes.size());
+
+			for (std::size_t i = iBegin; i < iEnd; ++i)
+			{
+				resolveType(vTypes[i], vStats[iWorker]);
+			}
+		};
+
+		if (iWorkersCount == 1)
+		{
+			fnResolveChunk(0);
+		}
+		else
+		{
+			std::vector<std::thread> vThreads {};
+			vThreads.reserve(iWorkersCount - 1);
+
+			for (std::size_t iWorker = 1; iWorker < iWorkersCount; ++iWorker)
+			{
+				vThreads.emplace_back(fnResolveChunk, iWorker);
+			}
+
+			fnResolveChunk(0);
+
+			for (auto& thread : vThreads)
+			{
+				thread.join();
+			}
+		}
+
+		Stats total {};
+		for (const auto& stats : vStats)
+		{
+			total.iReferences += stats.iReferences;
+			total.iResolved += stats.iResolved;
+		}
+
+		return total;
+	}
+
+	void TypeReferenceResolver::resolveType(TypeBase* pType, Stats& stats) const
+	{
+		if (!pType)
+			return;
+
+		resolveTags(pType->getTags(), stats);
+
+		if (pType->getKind() == TypeKind::TK_ENUM)
+		{
+			auto* pAsEnum = static_cast<TypeEnum*>(pType); // NOLINT(*-pro-type-static-cast-downcast)
+			resolveReference(pAsEnum->getUnderlyingType(), nullptr, stats);
+			return;
+		}
+
+		if (pType->getKind() != TypeKind::TK_STRUCT_OR_CLASS)
+			return;
+
+		auto* pAsClass = static_cast<TypeClass*>(pType); // NOLINT(*-pro-type-static-cast-downcast)
+
+		for (auto& property : pAsClass->getProperties())
+		{
+			resolveReference(property.sTypeInfo.sTypeRef, &property.sTypeInfo.sBaseInfo, stats);
+			resolveTags(property.vTags, stats);
+		}
+
+		for (auto& function : pAsClass->getFunctions())
+		{
+			resolveReference(function.sReturnType.sTypeRef, &function.sReturnType.sBaseInfo, stats);
+			resolveTags(function.vTags, stats);
+
+			for (auto& argument : function.vArguments)
+			{
+				resolveReference(argument.sType.sTypeRef, &argument.sType.sBaseInfo, stats);
+			}
+		}
+
+		for (auto& parent : pAsClass->getParentTypes())
+		{
+			resolveTags(parent.vTags, stats);
+		}
+	}
+
+	void TypeReferenceResolver::resolveTags(Tags& tags, Stats& stats) const
+	{
+		for (auto& [sName, tag] : tags.getTags())
+		{
+			for (auto& argument : tag.getArguments())
+			{
+				if (TypeReference* pReference = argument.asTypeRefMutable())
+				{
+					resolveReference(*pReference, nullptr, stats);
+				}
+			}
+		}
+	}
+
+	void TypeReferenceResolver::resolveReference(TypeReference& reference, const TypeBaseInfo* pBaseInfo, Stats& stats) const
+	{
+		if (!reference)
+			return;
+
+		++stats.iReferences;
+
+		if (reference.get())
+		{
+			++stats.iResolved;
+			return;
+		}
+
+		// Spelling of reference could differ from pretty name (unqualified name), base info of statement points to exact type
+		TypeBase* pFound = findByName(reference.getRefName());
+
+		if (!pFound && pBaseInfo)
+		{
+			pFound = findByName(pBaseInfo->sPrettyName);
+
+			if (!pFound && !pBaseInfo->sName.empty())
+				pFound = findByID(TypeBase::makeID(pBaseInfo->eKind, pBaseInfo->sName, pBaseInfo->sNameSpace, pBaseInfo->sDefLocation));
+		}
+
+		if (pFound)
+		{
+			reference.setResolvedType(pFound);
+			++stats.iResolved;
+		}
+	}
+}
\ No newline at end of file
@@ -0,0 +1,659 @@
+#include <RG3/Cpp/TypeSerializer.h>
+#include <RG3/Cpp/TypeClass.h>
+#include <RG3/Cpp/TypeEnum.h>
+
+#include <cstring>
+#include <bit>
+
+
+namespace rg3::cpp
+{
+	static_assert(std::endian::native == std::endian::little, "Only little-endian targets are supported by BinaryWriter/BinaryReader");
+
+	StringTableBuilder::StringTableBuilder() = default;
+
+	std::uint32_t StringTableBuilder::intern(std::string_view sValue)
+	{
+		std::string sKey { sValue };
+
+		if (auto it = m_ids.find(sKey); it != m_ids.end())
+			return it->second;
+
+		const auto iId = static_cast<std::uint32_t>(m_vStrings.size());
+		m_vStrings.emplace_back(sKey);
+		m_ids.emplace(std::move(sKey), iId);
+		return iId;
+	}
+
+	const std::vector<std::string>& StringTableBuilder::getStrings() const
+	{
+		return m_vStrings;
+	}
+
+	StringTableView::StringTableView() = default;
+
+	StringTableView::StringTableView(std::string_view records, std::string_view blob) : m_records(records), m_blob(blob)
+	{
+	}
+
+	std::optional<std::string_view> StringTableView::getString(std::uint32_t iId) const
+	{
+		constexpr std::size_t kRecordSize = sizeof(std::uint32_t) * 2;
+
+		if (iId >= getStringsCount())
+			return std::nullopt;
+
+		std::uint32_t iOffset = 0;
+		std::uint32_t iLength = 0;
+		std::memcpy(&iOffset, m_records.data() + iId * kRecordSize, sizeof(iOffset));
+		std::memcpy(&iLength, m_records.data() + iId * kRecordSize + sizeof(iOffset), sizeof(iLength));
+
+		if (iOffset > m_blob.size() || m_blob.size() - iOffset < iLength)
+			return std::nullopt;
+
+		return m_blob.substr(iOffset, iLength);
+	}
+
+	std::uint32_t StringTableView::getStringsCount() const
+	{
+		return static_cast<std::uint32_t>(m_records.size() / (sizeof(std::uint32_t) * 2));
+	}
+
+	BinaryWriter::BinaryWriter() = default;
+
+	BinaryWriter::BinaryWriter(StringTableBuilder* pStringTable) : m_pStringTable(pStringTable)
+	{
+	}
+
+	void BinaryWriter::writeU8(std::uint8_t value)
+	{
+		m_buffer.push_back(static_cast<char>(value));
+	}
+
+	void BinaryWriter::writeU32(std::uint32_t value)
+	{
+		m_buffer.append(reinterpret_cast<const char*>(&value), sizeof(value));
+	}
+
+	void BinaryWriter::writeU64(std::uint64_t value)
+	{
+		m_buffer.append(reinterpret_cast<const char*>(&value), sizeof(value));
+	}
+
+	void BinaryWriter::writeI64(std::int64_t value)
+	{
+		writeU64(static_cast<std::uint64_t>(value));
+	}
+
+	void BinaryWriter::writeF32(float value)
+	{
+		writeU32(std::bit_cast<std::uint32_t>(value));
+	}
+
+	void BinaryWriter::writeBool(bool value)
+	{
+		writeU8(value ? 1 : 0);
+	}
+
+	void BinaryWriter::writeString(std::string_view value)
+	{
+		if (m_pStringTable)
+		{
+			writeU32(m_pStringTable->intern(value));
+			return;
+		}
+
+		writeU32(static_cast<std::uint32_t>(value.size()));
+		m_buffer.append(value.data(), value.size());
+	}
+
+	const std::string& BinaryWriter::getBuffer() const
+	{
+		return m_buffer;
+	}
+
+	std::string& BinaryWriter::getBuffer()
+	{
+		return m_buffer;
+	}
+
+	BinaryReader::BinaryReader(std::string_view data) : m_data(data)
+	{
+	}
+
+	BinaryReader::BinaryReader(std::string_view data, const StringTableView* pStringTable) : m_data(data), m_pStringTable(pStringTable)
+	{
+	}
+
+	bool BinaryReader::readBytes(void* pDest, std::size_t iSize)
+	{
+		if (m_bFailed || m_data.size() - m_iOffset < iSize)
+		{
+			m_bFailed = true;
+			return false;
+		}
+
+		std::memcpy(pDest, m_data.data() + m_iOffset, iSize);
+		m_iOffset += iSize;
+		return true;
+	}
+
+	std::uint8_t BinaryReader::readU8()
+	{
+		std::uint8_t value = 0;
+		readBytes(&value, sizeof(value));
+		return value;
+	}
+
+	std::uint32_t BinaryReader::readU32()
+	{
+		std::uint32_t value = 0;
+		readBytes(&value, sizeof(value));
+		return value;
+	}
+
+	std::uint64_t BinaryReader::readU64()
+	{
+		std::uint64_t value = 0;
+		readBytes(&value, sizeof(value));
+		return value;
+	}
+
+	std::int64_t BinaryReader::readI64()
+	{
+		return static_cast<std::int64_t>(readU64());
+	}
+
+	float BinaryReader::readF32()
+	{
+		return std::bit_cast<float>(readU32());
+	}
+
+	bool BinaryReader::readBool()
+	{
+		return readU8() != 0;
+	}
+
+	std::string BinaryReader::readString()
+	{
+		if (m_pStringTable)
+		{
+			const std::uint32_t iId = readU32();
+			if (m_bFailed)
+				return {};
+
+			if (auto value = m_pStringTable->getString(iId); value.has_value())
+				return std::string { value.value() };
+
+			m_bFailed = true;
+			return {};
+		}
+
+		const std::uint32_t iLength = readU32();
+		if (m_bFailed || m_data.size() - m_iOffset < iLength)
+		{
+			m_bFailed = true;
+			return {};
+		}
+
+		std::string result { m_data.substr(m_iOffset, iLength) };
+		m_iOffset += iLength;
+		return result;
+	}
+
+	bool BinaryReader::isFailed() const
+	{
+		return m_bFailed;
+	}
+
+	bool BinaryReader::isEOF() const
+	{
+		return m_iOffset >= m_data.size();
+	}
+
+	namespace serializer_details
+	{
+		/// Protects reader from huge allocations on malformed input
+		constexpr std::uint32_t kMaxElements = 1u << 20;
+
+		static bool readCount(BinaryReader& reader, std::uint32_t& iCount)
+		{
+			iCount = reader.readU32();
+			return !reader.isFailed() && iCount <= kMaxElements;
+		}
+
+		static void writeLocation(BinaryWriter& writer, const DefinitionLocation& location)
+		{
+			writer.writeString(location.getPath());
+			writer.writeI64(location.getLine());
+			writer.writeI64(location.getInLineOffset());
+			writer.writeBool(location.isAngledPath());
+		}
+
+		static DefinitionLocation readLocation(BinaryReader& reader)
+		{
+			std::string sPath = reader.readString();
+			const auto iLine = static_cast<int>(reader.readI64());
+			const auto iOffset = static_cast<int>(reader.readI64());
+			const bool bAngled = reader.readBool();
+
+			return DefinitionLocation { sPath, iLine, iOffset, bAngled };
+		}
+
+		static void writeTags(BinaryWriter& writer, const Tags& tags)
+		{
+			writer.writeU32(static_cast<std::uint32_t>(tags.getTags().size()));
+
+			for (const auto& [sName, tag] : tags.getTags())
+			{
+				writer.writeString(sName);
+				writer.writeU32(static_cast<std::uint32_t>(tag.getArguments().size()));
+
+				for (const auto& argument : tag.getArguments())
+				{
+					writer.writeU8(static_cast<std::uint8_t>(argument.getHoldedType()));
+
+					switch (argument.getHoldedType())
+					{
+						case TagArgumentType::AT_UNDEFINED: break;
+						case TagArgumentType::AT_BOOL: writer.writeBool(argument.asBool(false)); break;
+						case TagArgumentType::AT_FLOAT: writer.writeF32(argument.asFloat(0.f)); break;
+						case TagArgumentType::AT_I64: writer.writeI64(argument.asI64(0)); break;
+						case TagArgumentType::AT_STRING: writer.writeString(argument.asString({})); break;
+						case TagArgumentType::AT_TYPEREF: writer.writeString(argument.asTypeRef({}).getRefName()); break;
+					}
+				}
+			}
+		}
+
+		static bool readTags(BinaryReader& reader, Tags& tags)
+		{
+			std::uint32_t iTagsCount = 0;
+			if (!readCount(reader, iTagsCount))
+				return false;
+
+			for (std::uint32_t i = 0; i < iTagsCount; ++i)
+			{
+				std::string sName = reader.readString();
+
+				std::uint32_t iArgsCount = 0;
+				if (!readCount(reader, iArgsCount))
+					return false;
+
+				std::vector<TagArgument> vArguments {};
+				vArguments.reserve(iArgsCount);
+
+				for (std::uint32_t j = 0; j < iArgsCount; ++j)
+				{
+					switch (static_cast<TagArgumentType>(reader.readU8()))
+					{
+						case TagArgumentType::AT_UNDEFINED: vArguments.emplace_back(); break;
+						case TagArgumentType::AT_BOOL: vArguments.emplace_back(reader.readBool()); break;
+						case TagArgumentType::AT_FLOAT: vArguments.emplace_back(reader.readF32()); break;
+						case TagArgumentType::AT_I64: vArguments.emplace_back(reader.readI64()); break;
+						case TagArgumentType::AT_STRING: vArguments.emplace_back(reader.readString()); break;
+						case TagArgumentType::AT_TYPEREF: vArguments.emplace_back(TypeReference { reader.readString() }); break;
+						default:
+							return false;
+					}
+				}
+
+				tags.getTags()[sName] = Tag { sName, vArguments };
+			}
+
+			return !reader.isFailed();
+		}
+
+		static void writeBaseInfo(BinaryWriter& writer, const TypeBaseInfo& info)
+		{
+			writer.writeU8(static_cast<std::uint8_t>(info.eKind));
+			writer.writeString(info.sName);
+			writer.writeString(info.sPrettyName);
+			writer.writeString(info.sNameSpace.asString());
+			writeLocation(writer, info.sDefLocation);
+		}
+
+		static TypeBaseInfo readBaseInfo(BinaryReader& reader)
+		{
+			TypeBaseInfo info {};
+			info.eKind = static_cast<TypeKind>(reader.readU8());
+			info.sName = reader.readString();
+			info.sPrettyName = reader.readString();
+			info.sNameSpace = CppNamespace { reader.readString() };
+			info.sDefLocation = readLocation(reader);
+			return info;
+		}
+
+		static void writeStatement(BinaryWriter& writer, const TypeStatement& statement)
+		{
+			writer.writeString(statement.sTypeRef.getRefName());
+			writer.writeBool(statement.sDefinitionLocation.has_value());
+
+			if (statement.sDefinitionLocation.has_value())
+			{
+				writeLocation(writer, statement.sDefinitionLocation.value());
+			}
+
+			writer.writeBool(statement.bIsConst);
+			writer.writeBool(statement.bIsPointer);
+			writer.writeBool(statement.bIsPtrConst);
+			writer.writeBool(statement.bIsReference);
+			writer.writeBool(statement.bIsTemplateSpecialization);
+			writeBaseInfo(writer, statement.sBaseInfo);
+		}
+
+		static TypeStatement readStatement(BinaryReader& reader)
+		{
+			TypeStatement statement {};
+			statement.sTypeRef = TypeReference { reader.readString() };
+
+			if (reader.readBool())
+			{
+				statement.sDefinitionLocation = readLocation(reader);
+			}
+
+			statement.bIsConst = reader.readBool();
+			statement.bIsPointer = reader.readBool();
+			statement.bIsPtrConst = reader.readBool();
+			statement.bIsReference = reader.readBool();
+			statement.bIsTemplateSpecialization = reader.readBool();
+			statement.sBaseInfo = readBaseInfo(reader);
+			return statement;
+		}
+
+		static void writeClassData(BinaryWriter& writer, const TypeClass* pClass)
+		{
+			writer.writeBool(pClass->isStruct());
+			writer.writeBool(pClass->isTrivialConstructible());
+			writer.writeBool(pClass->hasCopyConstructor());
+			writer.writeBool(pClass->hasCopyAssignOperator());
+			writer.writeBool(pClass->hasMoveConstructor());
+			writer.writeBool(pClass->hasMoveAssignOperator());
+
+			writer.writeU32(static_cast<std::uint32_t>(pClass->getProperties().size()));
+			for (const auto& property : pClass->getProperties())
+			{
+				writer.writeString(property.sName);
+				writer.writeString(property.sAlias);
+				writeStatement(writer, property.sTypeInfo);
+				writer.writeU8(static_cast<std::uint8_t>(property.eVisibility));
+				writeTags(writer, property.vTags);
+			}
+
+			writer.writeU32(static_cast<std::uint32_t>(pClass->getFunctions().size()));
+			for (const auto& function : pClass->getFunctions())
+			{
+				writer.writeString(function.sName);
+				writer.writeString(function.sOwnerClassName);
+				writer.writeU8(static_cast<std::uint8_t>(function.eVisibility));
+				writeTags(writer, function.vTags);
+				writeStatement(writer, function.sReturnType);
+
+				writer.writeU32(static_cast<std::uint32_t>(function.vArguments.size()));
+				for (const auto& argument : function.vArguments)
+				{
+					writeStatement(writer, argument.sType);
+					writer.writeString(argument.sArgumentName);
+					writer.writeBool(argument.bHasDefaultValue);
+				}
+
+				writer.writeBool(function.bIsStatic);
+				writer.writeBool(function.bIsConst);
+				writer.writeBool(function.bIsNoExcept);
+			}
+
+			writer.writeU32(static_cast<std::uint32_t>(pClass->getClassFriends().size()));
+			for (const auto& classFriend : pClass->getClassFriends())
+			{
+				writeBaseInfo(writer, classFriend.sFriendTypeInfo);
+			}
+
+			writer.writeU32(static_cast<std::uint32_t>(pClass->getParentTypes().size()));
+			for (const auto& parent : pClass->getParentTypes())
+			{
+				writeBaseInfo(writer, parent.sTypeBaseInfo);
+				writer.writeU8(static_cast<std::uint8_t>(parent.eModifier));
+				writeTags(writer, parent.vTags);
+			}
+		}
+
+		static bool readClassData(BinaryReader& reader, ClassPropertyVector& vProperties, ClassFunctionVector& vFunctions, ClassFriendVector& vFriends, std::vector<ClassParent>& vParents)
+		{
+			std::uint32_t iCount = 0;
+
+			if (!readCount(reader, iCount))
+				return false;
+
+			vProperties.reserve(iCount);
+			for (std::uint32_t i = 0; i < iCount; ++i)
+			{
+				auto& property = vProperties.emplace_back();
+				property.sName = reader.readString();
+				property.sAlias = reader.readString();
+				property.sTypeInfo = readStatement(reader);
+				property.eVisibility = static_cast<ClassEntryVisibility>(reader.readU8());
+
+				if (!readTags(reader, property.vTags))
+					return false;
+			}
+
+			if (!readCount(reader, iCount))
+				return false;
+
+			vFunctions.reserve(iCount);
+			for (std::uint32_t i = 0; i < iCount; ++i)
+			{
+				auto& function = vFunctions.emplace_back();
+				function.sName = reader.readString();
+				function.sOwnerClassName = reader.readString();
+				function.eVisibility = static_cast<ClassEntryVisibility>(reader.readU8());
+
+				if (!readTags(reader, function.vTags))
+					return false;
+
+				function.sReturnType = readStatement(reader);
+
+				std::uint32_t iArgsCount = 0;
+				if (!readCount(reader, iArgsCount))
+					return false;
+
+				function.vArguments.reserve(iArgsCount);
+				for (std::uint32_t j = 0; j < iArgsCount; ++j)
+				{
+					auto& argument = function.vArguments.emplace_back();
+					argument.sType = readStatement(reader);
+					argument.sArgumentName = reader.readString();
+					argument.bHasDefaultValue = reader.readBool();
+				}
+
+				function.bIsStatic = reader.readBool();
+				function.bIsConst = reader.readBool();
+				function.bIsNoExcept = reader.readBool();
+			}
+
+			if (!readCount(reader, iCount))
+				return false;
+
+			vFriends.reserve(iCount);
+			for (std::uint32_t i = 0; i < iCount; ++i)
+			{
+				vFriends.emplace_back(readBaseInfo(reader));
+			}
+
+			if (!readCount(reader, iCount))
+				return false;
+
+			vParents.reserve(iCount);
+			for (std::uint32_t i = 0; i < iCount; ++i)
+			{
+				auto& parent = vParents.emplace_back();
+				parent.sTypeBaseInfo = readBaseInfo(reader);
+				parent.eModifier = static_cast<InheritanceVisibility>(reader.readU8());
+
+				if (!readTags(reader, parent.vTags))
+					return false;
+			}
+
+			return !reader.isFailed();
+		}
+
+		static void writeEnumData(BinaryWriter& writer, const TypeEnum* pEnum)
+		{
+			writer.writeBool(pEnum->isScoped());
+			writer.writeString(pEnum->getUnderlyingType().getRefName());
+
+			writer.writeU32(static_cast<std::uint32_t>(pEnum->getEntries().size()));
+			for (const auto& entry : pEnum->getEntries())
+			{
+				writer.writeString(entry.sName);
+				writer.writeI64(entry.iValue);
+			}
+		}
+	}
+
+	void TypeSerializer::writeType(BinaryWriter& writer, const TypeBase* pType)
+	{
+		writer.writeU8(static_cast<std::uint8_t>(pType->getKind()));
+		writer.writeString(pType->getName());
+		writer.writeString(pType->getPrettyName());
+		writer.writeString(pType->getNamespace().asString());
+		serializer_details::writeLocation(writer, pType->getDefinition());
+		serializer_details::writeTags(writer, pType->getTags());
+		writer.writeBool(pType->isProducedFromTemplate());
+		writer.writeBool(pType->isProducedFromAlias());
+		writer.writeBool(pType->isDeclaredInAnotherType());
+
+		switch (pType->getKind())
+		{
+			case TypeKind::TK_NONE:
+			case TypeKind::TK_TRIVIAL:
+				break;
+			case TypeKind::TK_ENUM:
+				serializer_details::writeEnumData(writer, static_cast<const TypeEnum*>(pType));
+				break;
+			case TypeKind::TK_STRUCT_OR_CLASS:
+				serializer_details::writeClassData(writer, static_cast<const TypeClass*>(pType));
+				break;
+		}
+	}
+
+	TypeBasePtr TypeSerializer::readType(BinaryReader& reader)
+	{
+		const auto eKind = static_cast<TypeKind>(reader.readU8());
+		std::string sName = reader.readString();
+		std::string sPrettyName = reader.readString();
+		CppNamespace aNamespace { reader.readString() };
+		DefinitionLocation aLocation = serializer_details::readLocation(reader);
+
+		Tags tags {};
+		if (!serializer_details::readTags(reader, tags))
+			return nullptr;
+
+		const bool bProducedFromTemplate = reader.readBool();
+		const bool bProducedFromAlias = reader.readBool();
+		const bool bDeclaredInAnotherType = reader.readBool();
+
+		TypeBasePtr pType { nullptr };
+
+		switch (eKind)
+		{
+			case TypeKind::TK_NONE:
+			case TypeKind::TK_TRIVIAL:
+			{
+				pType = std::make_unique<TypeBase>(eKind, std::move(sName), std::move(sPrettyName), std::move(aNamespace), std::move(aLocation), std::move(tags));
+			}
+			break;
+			case TypeKind::TK_ENUM:
+			{
+				const bool bIsScoped = reader.readBool();
+				TypeReference underlyingType { reader.readString() };
+
+				std::uint32_t iCount = 0;
+				if (!serializer_details::readCount(reader, iCount))
+					return nullptr;
+
+				EnumEntryVector vEntries {};
+				vEntries.reserve(iCount);
+
+				for (std::uint32_t i = 0; i < iCount; ++i)
+				{
+					std::string sEntryName = reader.readString();
+					vEntries.emplace_back(sEntryName, reader.readI64());
+				}
+
+				pType = std::make_unique<TypeEnum>(std::move(sName), std::move(sPrettyName), std::move(aNamespace), std::move(aLocation), std::move(tags), std::move(vEntries), bIsScoped, std::move(underlyingType));
+			}
+			break;
+			case TypeKind::TK_STRUCT_OR_CLASS:
+			{
+				const bool bIsStruct = reader.readBool();
+				const bool bTrivialConstructible = reader.readBool();
+				const bool bHasCopyConstructor = reader.readBool();
+				const bool bHasCopyAssignOperator = reader.readBool();
+				const bool bHasMoveConstructor = reader.readBool();
+				const bool bHasMoveAssignOperator = reader.readBool();
+
+				ClassPropertyVector vProperties {};
+				ClassFunctionVector vFunctions {};
+				ClassFriendVector vFriends {};
+				std::vector<ClassParent> vParents {};
+
+				if (!serializer_details::readClassData(reader, vProperties, vFunctions, vFriends, vParents))
+					return nullptr;
+
+				pType = std::make_unique<TypeClass>(std::move(sName), std::move(sPrettyName), std::move(aNamespace), std::move(aLocation), std::move(tags),
+													std::move(vProperties), std::move(vFunctions), std::move(vFriends),
+													bIsStruct, bTrivialConstructible, bHasCopyConstructor, bHasCopyAssignOperator, bHasMoveConstructor, bHasMoveAssignOperator,
+													std::move(vParents));
+			}
+			break;
+			default:
+				return nullptr;
+		}
+
+		if (reader.isFailed())
+			return nullptr;
+
+		if (bProducedFromTemplate) pType->setProducedFromTemplate();
+		if (bProducedFromAlias) pType->setProducedFromAlias();
+		if (bDeclaredInAnotherType) pType->setDeclaredInAnotherType();
+
+		return pType;
+	}
+
+	void TypeSerializer::writeTypes(BinaryWriter& writer, const std::vector<TypeBasePtr>& vTypes)
+	{
+		writer.writeU32(static_cast<std::uint32_t>(vTypes.size()));
+
+		for (const auto& pType : vTypes)
+		{
+			writeType(writer, pType.get());
+		}
+	}
+
+	bool TypeSerializer::readTypes(BinaryReader& reader, std::vector<TypeBasePtr>& vOutTypes)
+	{
+		std::uint32_t iCount = 0;
+		if (!serializer_details::readCount(reader, iCount))
+			return false;
+
+		std::vector<TypeBasePtr> vTypes {};
+		vTypes.reserve(iCount);
+
+		for (std::uint32_t i = 0; i < iCount; ++i)
+		{
+			auto pType = readType(reader);
+			if (!pType)
+				return false;
+
+			vTypes.emplace_back(std::move(pType));
+		}
+
+		for (auto& pType : vTypes)
+		{
+			vOutTypes.emplace_back(std::move(pType));
+		}
+
+		return true;
+	}
+}
\ No newline at end of file
@@ -0,0 +1,81 @@
+#include <RG3/Daemon/DaemonServer.h>
+
+#include <fmt/format.h>
+
+#include <csignal>
+#include <cstdlib>
+#include <cstring>
+#include <string_view>
+
+
+namespace
+{
+	rg3::daemon::DaemonServer* g_pServer { nullptr };
+
+	void onStopSignal(int)
+	{
+		if (g_pServer)
+		{
+			g_pServer->requestStop();
+		}
+	}
+
+	void printUsage()
+	{
+		fmt::print("Usage: rg3d [--socket <path>] [--workers <count>] [--cache-limit <MiB>]\n"
+				   "  --socket       path of unix socket (default: {})\n"
+				   "  --workers      workers per analyze request (default: amount of cpu cores)\n"
+				   "  --cache-limit  memory of cached results, least recently used are evicted (default: {} MiB, 0 - unlimited)\n",
+				   rg3::daemon::UnixSocket::getDefaultSocketPath().string(), rg3::daemon::DaemonServer::Options {}.iResultsMemoryLimit / (1024u * 1024u));
+	}
+}
+
+int main(int argc, char** argv)
+{
+	rg3::daemon::DaemonServer::Options options {};
+	options.socketPath = rg3::daemon::UnixSocket::getDefaultSocketPath();
+
+	for (int i = 1; i < argc; ++i)
+	{
+		const std::string_view sArg { argv[i] };
+
+		if (sArg == "--socket" && i + 1 < argc)
+		{
+			options.socketPath = argv[++i];
+		}
+		else if (sArg == "--workers" && i + 1 < argc)
+		{
+			options.iWorkers = static_cast<std::uint32_t>(std::strtoul(argv[++i], nullptr, 10));
+		}
+		else if (sArg == "--cache-limit" && i + 1 < argc)
+		{
+			options.iResultsMemoryLimit = static_cast<std::size_t>(std::strtoull(argv[++i], nullptr, 10)) * 1024u * 1024u;
+		}
+		else
+		{
+			printUsage();
+			return sArg == "--help" ? EXIT_SUCCESS : EXIT_FAILURE;
+		}
+	}
+
+	rg3::daemon::DaemonServer server { options };
+
+	if (auto error = server.start())
+	{
+		fmt::print(stderr, "rg3d: {}\n", error->message);
+		return EXIT_FAILURE;
+	}
+
+	g_pServer = &server;
+	std::signal(SIGINT, onStopSignal);
+	std::signal(SIGTERM, onStopSignal);
+	std::signal(SIGPIPE, SIG_IGN);
+
+	fmt::print("rg3d: listening on {}\n", options.socketPath.string());
+	std::fflush(stdout);
+
+	server.run();
+	g_pServer = nullptr;
+
+	return EXIT_SUCCESS;
+}
\ No newline at end of file
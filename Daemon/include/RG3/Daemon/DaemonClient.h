@@ -0,0 +1,53 @@
+#pragma once
+
+#include <RG3/Daemon/DaemonSocket.h>
+#include <RG3/Daemon/DaemonProtocol.h>
+
+#include <filesystem>
+#include <variant>
+#include <memory>
+#include <string>
+
+
+namespace rg3::daemon
+{
+	class DaemonClient;
+
+	using DaemonClientResult = std::variant<DaemonError, std::unique_ptr<DaemonClient>>;
+
+	template <typename T>
+	using DaemonResponse = std::variant<DaemonError, T>;
+
+	/**
+	 * @brief Connection to rg3d. Requests are synchronous: single request at a time per client.
+	 */
+	class DaemonClient
+	{
+	 public:
+		/**
+		 * @param socketPath - socket of daemon. Empty - default location (see UnixSocket::getDefaultSocketPath)
+		 */
+		static DaemonClientResult connect(const std::filesystem::path& socketPath = {});
+
+		DaemonResponse<AnalyzeResponse> analyze(const AnalyzeRequest& request);
+		DaemonResponse<rg3::llvm::CodeEvaluateResult> evaluate(const EvaluateRequest& request);
+		DaemonResponse<StatsResponse> getStats();
+
+		/**
+		 * @brief Ask daemon to stop. Connection is not usable after that.
+		 */
+		DaemonResponse<bool> shutdown();
+
+	 private:
+		explicit DaemonClient(UnixSocket&& connection);
+
+		/**
+		 * @brief Send request and wait for response of same kind
+		 * @return payload of response or error (connection errors & MK_ERROR responses of daemon)
+		 */
+		DaemonResponse<std::string> call(MessageKind eKind, std::string_view payload);
+
+	 private:
+		UnixSocket m_connection {};
+	};
+}
\ No newline at end of file
@@ -0,0 +1,90 @@
+#pragma once
+
+#include <RG3/LLVM/CompilerConfig.h>
+#include <RG3/LLVM/CodeAnalyzer.h>
+#include <RG3/LLVM/CodeEvaluator.h>
+#include <RG3/Cpp/TypeSerializer.h>
+
+#include <optional>
+#include <cstdint>
+#include <chrono>
+#include <string>
+#include <vector>
+
+
+namespace rg3::daemon
+{
+	/**
+	 * @brief Kind of frame. Every request is answered by response of same kind or by MK_ERROR.
+	 */
+	enum class MessageKind : std::uint32_t
+	{
+		MK_ERROR = 0,
+		MK_ANALYZE = 1,
+		MK_EVALUATE = 2,
+		MK_STATS = 3,
+		MK_SHUTDOWN = 4
+	};
+
+	struct AnalyzeRequest
+	{
+		rg3::llvm::CompilerConfig compilerConfig {};
+		std::vector<std::string> vHeaders {};
+		std::uint32_t iWorkers { 0 }; /// 0 - use default amount of workers of daemon
+	};
+
+	struct AnalyzeResponse
+	{
+		rg3::llvm::AnalyzerResult::CompilerIssuesVector vIssues {};
+		std::vector<cpp::TypeBasePtr> vFoundTypes {}; /// Unique (by pretty name) types in order of headers
+		std::uint32_t iReusedHeaders { 0 }; /// Headers which results were taken from memory of daemon
+		std::uint32_t iAnalyzedHeaders { 0 };
+		std::chrono::nanoseconds analyzeTime { 0 }; /// Time spent by daemon
+	};
+
+	struct EvaluateRequest
+	{
+		rg3::llvm::CompilerConfig compilerConfig {};
+		std::string sCode {};
+		std::vector<std::string> vCapture {};
+	};
+
+	struct StatsResponse
+	{
+		std::uint64_t iRequests { 0 };
+		std::uint64_t iReusedHeaders { 0 };
+		std::uint64_t iAnalyzedHeaders { 0 };
+		std::uint64_t iCachedResults { 0 }; /// Results of headers kept in memory
+		std::chrono::nanoseconds uptime { 0 };
+	};
+
+	/**
+	 * @brief Payloads of rg3d frames (see UnixSocket::sendFrame). Every read* returns std::nullopt when payload is malformed.
+	 */
+	struct DaemonProtocol
+	{
+		static void writeCompilerConfig(cpp::BinaryWriter& writer, const rg3::llvm::CompilerConfig& config);
+		static rg3::llvm::CompilerConfig readCompilerConfig(cpp::BinaryReader& reader);
+
+		static void writeIssues(cpp::BinaryWriter& writer, const rg3::llvm::AnalyzerResult::CompilerIssuesVector& vIssues);
+		static rg3::llvm::AnalyzerResult::CompilerIssuesVector readIssues(cpp::BinaryReader& reader);
+
+		static std::string writeAnalyzeRequest(const AnalyzeRequest& request);
+		static std::optional<AnalyzeRequest> readAnalyzeRequest(std::string_view payload);
+
+		static std::string writeAnalyzeResponse(const AnalyzeResponse& response);
+		static std::optional<AnalyzeResponse> readAnalyzeResponse(std::string_view payload);
+
+		static std::string writeEvaluateRequest(const EvaluateRequest& request);
+		static std::optional<EvaluateRequest> readEvaluateRequest(std::string_view payload);
+
+		static std::string writeEvaluateResponse(const rg3::llvm::CodeEvaluateResult& response);
+		static std::optional<rg3::llvm::CodeEvaluateResult> readEvaluateResponse(std::string_view payload);
+
+		static std::string writeStatsResponse(const StatsResponse& response);
+		static std::optional<StatsResponse> readStatsResponse(std::string_view payload);
+
+		static std::string writeError(std::string_view sMessage);
+		static std::string readError(std::string_view payload);
+	};
+}
\ No newline at end of file
@@ -0,0 +1,100 @@
+#pragma once
+
+#include <RG3/Daemon/DaemonSocket.h>
+#include <RG3/Daemon/DaemonProtocol.h>
+#include <RG3/LLVM/IncrementalCache.h>
+
+#include <unordered_set>
+#include <filesystem>
+#include <optional>
+#include <cstdint>
+#include <chrono>
+#include <memory>
+#include <atomic>
+#include <thread>
+#include <vector>
+#include <mutex>
+
+
+namespace rg3::daemon
+{
+	/**
+	 * @brief Resident analyzer (rg3d): serves analyze & evaluate requests over local socket and keeps warm state between requests.
+	 *        Compiler environments & preambles are cached by process-wide caches, results of headers are kept in memory
+	 *        and reused while header & its includes are not changed (see IncrementalCache).
+	 * @note Every connection is served by own thread. Analyze requests are executed one by one (each one uses all workers).
+	 */
+	class DaemonServer
+	{
+	 public:
+		struct Options
+		{
+			std::filesystem::path socketPath {};
+			std::uint32_t iWorkers { 0 }; /// Workers per analyze request. 0 - amount of cpu cores
+			std::size_t iResultsMemoryLimit { 512u * 1024u * 1024u }; /// Bytes of serialized results kept between requests (least recently used are evicted). 0 - unlimited
+		};
+
+		explicit DaemonServer(Options options);
+		~DaemonServer();
+
+		DaemonServer(const DaemonServer&) = delete;
+		DaemonServer& operator=(const DaemonServer&) = delete;
+
+		/**
+		 * @brief Start listening on socket
+		 * @return error or std::nullopt when server is ready to run
+		 */
+		std::optional<DaemonError> start();
+
+		/**
+		 * @brief Serve connections until stop() (or shutdown request). Socket file is removed on exit.
+		 */
+		void run();
+
+		/**
+		 * @brief Stop server: close listening socket and all connections. Could be called from any thread.
+		 */
+		void stop();
+
+		/**
+		 * @brief Wake up run() loop which will stop server. Async-signal-safe (no locks), could be called from signal handler.
+		 */
+		void requestStop();
+
+		AnalyzeResponse analyze(const AnalyzeRequest& request);
+		rg3::llvm::CodeEvaluateResult evaluate(const EvaluateRequest& request);
+
+		[[nodiscard]] StatsResponse getStats() const;
+
+	 private:
+		struct Connection
+		{
+			std::thread thread {};
+			std::shared_ptr<std::atomic_bool> pFinished {};
+		};
+
+		void serveConnection(UnixSocket& connection);
+
+		/**
+		 * @brief Join threads of closed connections
+		 */
+		void reapConnections(bool bWaitAll);
+
+	 private:
+		Options m_options {};
+		UnixSocket m_listener {};
+		std::atomic_bool m_bStopping { false };
+		std::chrono::steady_clock::time_point m_startedAt {};
+
+		std::mutex m_connectionsLock;
+		std::vector<Connection> m_vConnections {};
+		std::unordered_set<UnixSocket*> m_activeConnections {};
+
+		std::mutex m_analyzeLock;
+		rg3::llvm::IncrementalCache m_resultsCache { {}, {} }; /// Memory only: results of recently requested headers (bounded by Options::iResultsMemoryLimit)
+
+		std::atomic<std::uint64_t> m_iRequests { 0 };
+		std::atomic<std::uint64_t> m_iReusedHeaders { 0 };
+		std::atomic<std::uint64_t> m_iAnalyzedHeaders { 0 };
+	};
+}
\ No newline at end of file
@@ -0,0 +1,90 @@
+#pragma once
+
+#include <filesystem>
+#include <optional>
+#include <variant>
+#include <cstdint>
+#include <string>
+
+
+namespace rg3::daemon
+{
+	struct DaemonError
+	{
+		std::string message {};
+	};
+
+	/**
+	 * @brief Single frame of rg3d protocol: 12 bytes header (magic, kind & size of payload, little-endian u32) followed by payload
+	 */
+	struct Frame
+	{
+		std::uint32_t iKind { 0 };
+		std::string payload {};
+	};
+
+	class UnixSocket;
+
+	using UnixSocketResult = std::variant<DaemonError, UnixSocket>;
+
+	/**
+	 * @brief Owner of local (Unix-domain) stream socket
+	 * @note Not supported on Windows: every factory returns error
+	 */
+	class UnixSocket
+	{
+	 public:
+		static constexpr std::uint32_t kFrameMagic = 0x50334752; /// 'RG3P'
+		static constexpr std::uint32_t kMaxFrameSize = 1024u * 1024u * 1024u;
+
+		UnixSocket() = default;
+		~UnixSocket();
+
+		UnixSocket(UnixSocket&& other) noexcept;
+		UnixSocket& operator=(UnixSocket&& other) noexcept;
+
+		UnixSocket(const UnixSocket&) = delete;
+		UnixSocket& operator=(const UnixSocket&) = delete;
+
+		/**
+		 * @brief Create listening socket. Stale socket file (left by crashed daemon) is replaced, socket of running daemon is not.
+		 */
+		static UnixSocketResult listen(const std::filesystem::path& socketPath);
+
+		static UnixSocketResult connect(const std::filesystem::path& socketPath);
+
+		/**
+		 * @brief Wait for new connection
+		 * @return connection or std::nullopt when socket was shut down (see shutdown)
+		 */
+		std::optional<UnixSocket> accept();
+
+		bool sendFrame(std::uint32_t iKind, std::string_view payload);
+
+		/**
+		 * @return frame or std::nullopt when connection closed or frame is malformed
+		 */
+		std::optional<Frame> receiveFrame();
+
+		/**
+		 * @brief Wake up threads blocked in accept/receiveFrame of this socket. Socket is still owned (closed by destructor).
+		 */
+		void shutdown();
+
+		[[nodiscard]] bool isValid() const;
+
+		/**
+		 * @brief Default location of rg3d socket: $RG3D_SOCKET, $XDG_RUNTIME_DIR/rg3d.sock or /tmp/rg3d-<uid>.sock
+		 */
+		static std::filesystem::path getDefaultSocketPath();
+
+	 private:
+		explicit UnixSocket(int iDescriptor);
+
+		bool writeAll(const char* pData, std::size_t iSize);
+		bool readAll(char* pData, std::size_t iSize);
+
+	 private:
+		int m_iDescriptor { -1 };
+	};
+}
\ No newline at end of file
@@ -0,0 +1,78 @@
+#include <RG3/Daemon/DaemonClient.h>
+
+#include <fmt/format.h>
+
+
+namespace rg3::daemon
+{
+	namespace client_details
+	{
+		template <typename T>
+		static DaemonResponse<T> decode(DaemonResponse<std::string>&& payload, std::optional<T> (*pReader)(std::string_view))
+		{
+			if (auto* pError = std::get_if<DaemonError>(&payload))
+				return std::move(*pError);
+
+			auto decoded = pReader(std::get<std::string>(payload));
+			if (!decoded.has_value())
+				return DaemonError { "Malformed response of daemon" };
+
+			return std::move(decoded.value());
+		}
+	}
+
+	DaemonClient::DaemonClient(UnixSocket&& connection) : m_connection(std::move(connection))
+	{
+	}
+
+	DaemonClientResult DaemonClient::connect(const std::filesystem::path& socketPath)
+	{
+		auto connectResult = UnixSocket::connect(socketPath.empty() ? UnixSocket::getDefaultSocketPath() : socketPath);
+		if (auto* pError = std::get_if<DaemonError>(&connectResult))
+			return std::move(*pError);
+
+		return std::unique_ptr<DaemonClient>(new DaemonClient(std::move(std::get<UnixSocket>(connectResult))));
+	}
+
+	DaemonResponse<AnalyzeResponse> DaemonClient::analyze(const AnalyzeRequest& request)
+	{
+		return client_details::decode<AnalyzeResponse>(call(MessageKind::MK_ANALYZE, DaemonProtocol::writeAnalyzeRequest(request)), &DaemonProtocol::readAnalyzeResponse);
+	}
+
+	DaemonResponse<rg3::llvm::CodeEvaluateResult> DaemonClient::evaluate(const EvaluateRequest& request)
+	{
+		return client_details::decode<rg3::llvm::CodeEvaluateResult>(call(MessageKind::MK_EVALUATE, DaemonProtocol::writeEvaluateRequest(request)), &DaemonProtocol::readEvaluateResponse);
+	}
+
+	DaemonResponse<StatsResponse> DaemonClient::getStats()
+	{
+		return client_details::decode<StatsResponse>(call(MessageKind::MK_STATS, {}), &DaemonProtocol::readStatsResponse);
+	}
+
+	DaemonResponse<bool> DaemonClient::shutdown()
+	{
+		auto response = call(MessageKind::MK_SHUTDOWN, {});
+		if (auto* pError = std::get_if<DaemonError>(&response))
+			return std::move(*pError);
+
+		return true;
+	}
+
+	DaemonResponse<std::string> DaemonClient::call(MessageKind eKind, std::string_view payload)
+	{
+		if (!m_connection.sendFrame(static_cast<std::uint32_t>(eKind), payload))
+			return DaemonError { "Unable to send request: connection to daemon is closed" };
+
+		auto frame = m_connection.receiveFrame();
+		if (!frame.has_value())
+			return DaemonError { "Connection to daemon is closed" };
+
+		if (frame->iKind == static_cast<std::uint32_t>(MessageKind::MK_ERROR))
+			return DaemonError { DaemonProtocol::readError(frame->payload) };
+
+		if (frame->iKind != static_cast<std::uint32_t>(eKind))
+			return DaemonError { fmt::format("Unexpected response kind {}", frame->iKind) };
+
+		return std::move(frame->payload);
+	}
+}
\ No newline at end of file
@@ -0,0 +1,314 @@
+#include <RG3/Daemon/DaemonProtocol.h>
+
+#include <cstring>
+
+
+namespace rg3::daemon
+{
+	namespace protocol_details
+	{
+		static constexpr std::uint32_t kMaxItems = 1024u * 1024u; // sanity limit of count of items in malformed payload
+
+		static void writeStrings(cpp::BinaryWriter& writer, const std::vector<std::string>& vStrings)
+		{
+			writer.writeU32(static_cast<std::uint32_t>(vStrings.size()));
+			for (const auto& sValue : vStrings)
+			{
+				writer.writeString(sValue);
+			}
+		}
+
+		static std::vector<std::string> readStrings(cpp::BinaryReader& reader)
+		{
+			std::vector<std::string> vStrings {};
+
+			const std::uint32_t iCount = reader.readU32();
+			for (std::uint32_t i = 0; i < iCount && i < kMaxItems && !reader.isFailed(); ++i)
+			{
+				vStrings.emplace_back(reader.readString());
+			}
+
+			return vStrings;
+		}
+
+		static void writeIncludes(cpp::BinaryWriter& writer, const rg3::llvm::IncludeVector& vIncludes)
+		{
+			writer.writeU32(static_cast<std::uint32_t>(vIncludes.size()));
+			for (const auto& include : vIncludes)
+			{
+				writer.writeString(include.sFsLocation.string());
+				writer.writeU8(static_cast<std::uint8_t>(include.eKind));
+				writer.writeBool(include.bIsMacOSFramework);
+			}
+		}
+
+		static rg3::llvm::IncludeVector readIncludes(cpp::BinaryReader& reader)
+		{
+			rg3::llvm::IncludeVector vIncludes {};
+
+			const std::uint32_t iCount = reader.readU32();
+			for (std::uint32_t i = 0; i < iCount && i < kMaxItems && !reader.isFailed(); ++i)
+			{
+				auto& include = vIncludes.emplace_back();
+				include.sFsLocation = reader.readString();
+				include.eKind = static_cast<rg3::llvm::IncludeKind>(reader.readU8());
+				include.bIsMacOSFramework = reader.readBool();
+			}
+
+			return vIncludes;
+		}
+
+		template <typename T>
+		static std::optional<T> finish(cpp::BinaryReader& reader, T&& value)
+		{
+			if (reader.isFailed() || !reader.isEOF())
+				return std::nullopt;
+
+			return std::optional<T> { std::move(value) };
+		}
+	}
+
+	void DaemonProtocol::writeCompilerConfig(cpp::BinaryWriter& writer, const rg3::llvm::CompilerConfig& config)
+	{
+		writer.writeU32(static_cast<std::uint32_t>(config.cppStandard));
+		protocol_details::writeIncludes(writer, config.vIncludes);
+		protocol_details::writeIncludes(writer, config.vSystemIncludes);
+		protocol_details::writeStrings(writer, config.vCompilerArgs);
+		protocol_details::writeStrings(writer, config.vCompilerDefs);
+		writer.writeBool(config.bAllowCollectNonRuntimeTypes);
+		writer.writeBool(config.bSkipFunctionBodies);
+		writer.writeBool(config.bUseDeepAnalysis);
+		protocol_details::writeStrings(writer, config.vPreambleHeaders);
+		writer.writeU32(static_cast<std::uint32_t>(config.eSourceFilter));
+		protocol_details::writeStrings(writer, config.vSourceAllowGlobs);
+		protocol_details::writeStrings(writer, config.vSourceDenyGlobs);
+	}
+
+	rg3::llvm::CompilerConfig DaemonProtocol::readCompilerConfig(cpp::BinaryReader& reader)
+	{
+		rg3::llvm::CompilerConfig config {};
+		config.cppStandard = static_cast<rg3::llvm::CxxStandard>(reader.readU32());
+		config.vIncludes = protocol_details::readIncludes(reader);
+		config.vSystemIncludes = protocol_details::readIncludes(reader);
+		config.vCompilerArgs = protocol_details::readStrings(reader);
+		config.vCompilerDefs = protocol_details::readStrings(reader);
+		config.bAllowCollectNonRuntimeTypes = reader.readBool();
+		config.bSkipFunctionBodies = reader.readBool();
+		config.bUseDeepAnalysis = reader.readBool();
+		config.vPreambleHeaders = protocol_details::readStrings(reader);
+		config.eSourceFilter = static_cast<rg3::llvm::SourceFilter>(reader.readU32());
+		config.vSourceAllowGlobs = protocol_details::readStrings(reader);
+		config.vSourceDenyGlobs = protocol_details::readStrings(reader);
+		return config;
+	}
+
+	void DaemonProtocol::writeIssues(cpp::BinaryWriter& writer, const rg3::llvm::AnalyzerResult::CompilerIssuesVector& vIssues)
+	{
+		writer.writeU32(static_cast<std::uint32_t>(vIssues.size()));
+		for (const auto& issue : vIssues)
+		{
+			writer.writeU8(static_cast<std::uint8_t>(issue.kind));
+			writer.writeString(issue.sSourceFile);
+			writer.writeU32(issue.iLine);
+			writer.writeU32(issue.iColumn);
+			writer.writeString(issue.sMessage);
+		}
+	}
+
+	rg3::llvm::AnalyzerResult::CompilerIssuesVector DaemonProtocol::readIssues(cpp::BinaryReader& reader)
+	{
+		rg3::llvm::AnalyzerResult::CompilerIssuesVector vIssues {};
+
+		const std::uint32_t iCount = reader.readU32();
+		for (std::uint32_t i = 0; i < iCount && i < protocol_details::kMaxItems && !reader.isFailed(); ++i)
+		{
+			auto& issue = vIssues.emplace_back();
+			issue.kind = static_cast<rg3::llvm::AnalyzerResult::CompilerIssue::IssueKind>(reader.readU8());
+			issue.sSourceFile = reader.readString();
+			issue.iLine = reader.readU32();
+			issue.iColumn = reader.readU32();
+			issue.sMessage = reader.readString();
+		}
+
+		return vIssues;
+	}
+
+	std::string DaemonProtocol::writeAnalyzeRequest(const AnalyzeRequest& request)
+	{
+		cpp::BinaryWriter writer {};
+		writeCompilerConfig(writer, request.compilerConfig);
+		protocol_details::writeStrings(writer, request.vHeaders);
+		writer.writeU32(request.iWorkers);
+		return std::move(writer.getBuffer());
+	}
+
+	std::optional<AnalyzeRequest> DaemonProtocol::readAnalyzeRequest(std::string_view payload)
+	{
+		cpp::BinaryReader reader { payload };
+
+		AnalyzeRequest request {};
+		request.compilerConfig = readCompilerConfig(reader);
+		request.vHeaders = protocol_details::readStrings(reader);
+		request.iWorkers = reader.readU32();
+
+		return protocol_details::finish(reader, std::move(request));
+	}
+
+	std::string DaemonProtocol::writeAnalyzeResponse(const AnalyzeResponse& response)
+	{
+		cpp::BinaryWriter writer {};
+		writeIssues(writer, response.vIssues);
+		cpp::TypeSerializer::writeTypes(writer, response.vFoundTypes);
+		writer.writeU32(response.iReusedHeaders);
+		writer.writeU32(response.iAnalyzedHeaders);
+		writer.writeI64(response.analyzeTime.count());
+		return std::move(writer.getBuffer());
+	}
+
+	std::optional<AnalyzeResponse> DaemonProtocol::readAnalyzeResponse(std::string_view payload)
+	{
+		cpp::BinaryReader reader { payload };
+
+		AnalyzeResponse response {};
+		response.vIssues = readIssues(reader);
+
+		if (!cpp::TypeSerializer::readTypes(reader, response.vFoundTypes))
+			return std::nullopt;
+
+		response.iReusedHeaders = reader.readU32();
+		response.iAnalyzedHeaders = reader.readU32();
+		response.analyzeTime = std::chrono::nanoseconds(reader.readI64());
+
+		return protocol_details::finish(reader, std::move(response));
+	}
+
+	std::string DaemonProtocol::writeEvaluateRequest(const EvaluateRequest& request)
+	{
+		cpp::BinaryWriter writer {};
+		writeCompilerConfig(writer, request.compilerConfig);
+		writer.writeString(request.sCode);
+		protocol_details::writeStrings(writer, request.vCapture);
+		return std::move(writer.getBuffer());
+	}
+
+	std::optional<EvaluateRequest> DaemonProtocol::readEvaluateRequest(std::string_view payload)
+	{
+		cpp::BinaryReader reader { payload };
+
+		EvaluateRequest request {};
+		request.compilerConfig = readCompilerConfig(reader);
+		request.sCode = reader.readString();
+		request.vCapture = protocol_details::readStrings(reader);
+
+		return protocol_details::finish(reader, std::move(request));
+	}
+
+	std::string DaemonProtocol::writeEvaluateResponse(const rg3::llvm::CodeEvaluateResult& response)
+	{
+		cpp::BinaryWriter writer {};
+		writeIssues(writer, response.vIssues);
+
+		writer.writeU32(static_cast<std::uint32_t>(response.mOutputs.size()));
+		for (const auto& [sName, value] : response.mOutputs)
+		{
+			writer.writeString(sName);
+			writer.writeU8(static_cast<std::uint8_t>(value.index()));
+
+			std::visit([&writer](auto&& v) {
+				using T = std::decay_t<decltype(v)>;
+
+				if constexpr (std::is_same_v<T, bool>) writer.writeBool(v);
+				else if constexpr (std::is_same_v<T, std::int64_t>) writer.writeI64(v);
+				else if constexpr (std::is_same_v<T, std::uint64_t>) writer.writeU64(v);
+				else if constexpr (std::is_same_v<T, float>) writer.writeF32(v);
+				else if constexpr (std::is_same_v<T, double>)
+				{
+					std::uint64_t iBits = 0;
+					std::memcpy(&iBits, &v, sizeof(iBits));
+					writer.writeU64(iBits);
+				}
+				else writer.writeString(v);
+			}, value);
+		}
+
+		return std::move(writer.getBuffer());
+	}
+
+	std::optional<rg3::llvm::CodeEvaluateResult> DaemonProtocol::readEvaluateResponse(std::string_view payload)
+	{
+		cpp::BinaryReader reader { payload };
+
+		rg3::llvm::CodeEvaluateResult response {};
+		response.vIssues = readIssues(reader);
+
+		const std::uint32_t iCount = reader.readU32();
+		for (std::uint32_t i = 0; i < iCount && i < protocol_details::kMaxItems && !reader.isFailed(); ++i)
+		{
+			std::string sName = reader.readString();
+			rg3::llvm::VariableValue value {};
+
+			switch (reader.readU8())
+			{
+				case 0: value = reader.readBool(); break;
+				case 1: value = reader.readI64(); break;
+				case 2: value = reader.readU64(); break;
+				case 3: value = reader.readF32(); break;
+				case 4:
+				{
+					const std::uint64_t iBits = reader.readU64();
+					double fValue = 0.0;
+					std::memcpy(&fValue, &iBits, sizeof(fValue));
+					value = fValue;
+				}
+				break;
+				case 5: value = reader.readString(); break;
+				default:
+					return std::nullopt;
+			}
+
+			response.mOutputs.emplace(std::move(sName), std::move(value));
+		}
+
+		return protocol_details::finish(reader, std::move(response));
+	}
+
+	std::string DaemonProtocol::writeStatsResponse(const StatsResponse& response)
+	{
+		cpp::BinaryWriter writer {};
+		writer.writeU64(response.iRequests);
+		writer.writeU64(response.iReusedHeaders);
+		writer.writeU64(response.iAnalyzedHeaders);
+		writer.writeU64(response.iCachedResults);
+		writer.writeI64(response.uptime.count());
+		return std::move(writer.getBuffer());
+	}
+
+	std::optional<StatsResponse> DaemonProtocol::readStatsResponse(std::string_view payload)
+	{
+		cpp::BinaryReader reader { payload };
+
+		StatsResponse response {};
+		response.iRequests = reader.readU64();
+		response.iReusedHeaders = reader.readU64();
+		response.iAnalyzedHeaders = reader.readU64();
+		response.iCachedResults = reader.readU64();
+		response.uptime = std::chrono::nanoseconds(reader.readI64());
+
+		return protocol_details::finish(reader, std::move(response));
+	}
+
+	std::string DaemonProtocol::writeError(std::string_view sMessage)
+	{
+		cpp::BinaryWriter writer {};
+		writer.writeString(sMessage);
+		return std::move(writer.getBuffer());
+	}
+
+	std::string DaemonProtocol::readError(std::string_view payload)
+	{
+		cpp::BinaryReader reader { payload };
+		std::string sMessage = reader.readString();
+
+		return reader.isFailed() ? std::string("Malformed error response") : sMessage;
+	}
+}
\ No newline at end of file
@@ -0,0 +1,303 @@
+#include <RG3/Daemon/DaemonServer.h>
+#include <RG3/LLVM/CompilerConfigDetector.h>
+#include <RG3/LLVM/SharedFileCache.h>
+#include <RG3/LLVM/CodeAnalyzer.h>
+#include <RG3/LLVM/CodeEvaluator.h>
+
+#include <fmt/format.h>
+
+#include <unordered_set>
+#include <algorithm>
+
+
+namespace rg3::daemon
+{
+	namespace server_details
+	{
+		static rg3::llvm::AnalyzerResult::CompilerIssue makeIssue(std::string sMessage)
+		{
+			rg3::llvm::AnalyzerResult::CompilerIssue issue {};
+			issue.kind = rg3::llvm::AnalyzerResult::CompilerIssue::IssueKind::IK_ERROR;
+			issue.sSourceFile = "RG3_GLOBAL_SCOPE";
+			issue.sMessage = std::move(sMessage);
+			return issue;
+		}
+	}
+
+	DaemonServer::DaemonServer(Options options) : m_options(std::move(options))
+	{
+		if (m_options.iWorkers == 0)
+		{
+			m_options.iWorkers = std::max(std::thread::hardware_concurrency(), 1u);
+		}
+
+		m_resultsCache.setMemoryLimit(m_options.iResultsMemoryLimit);
+	}
+
+	DaemonServer::~DaemonServer()
+	{
+		stop();
+		reapConnections(true);
+	}
+
+	std::optional<DaemonError> DaemonServer::start()
+	{
+		auto listenResult = UnixSocket::listen(m_options.socketPath);
+		if (auto* pError = std::get_if<DaemonError>(&listenResult))
+			return *pError;
+
+		m_listener = std::move(std::get<UnixSocket>(listenResult));
+		m_startedAt = std::chrono::steady_clock::now();
+		m_bStopping = false;
+
+		return std::nullopt;
+	}
+
+	void DaemonServer::run()
+	{
+		while (!m_bStopping)
+		{
+			auto connection = m_listener.accept();
+			if (!connection.has_value())
+				break;
+
+			reapConnections(false);
+
+			auto pFinished = std::make_shared<std::atomic_bool>(false);
+			auto pConnection = std::make_shared<UnixSocket>(std::move(connection.value()));
+
+			std::lock_guard<std::mutex> guard { m_connectionsLock };
+			if (m_bStopping)
+				break; // stop() already closed active connections: this one will not be served
+
+			m_activeConnections.insert(pConnection.get());
+
+			m_vConnections.push_back(Connection {
+				std::thread([this, pConnection, pFinished]() {
+					serveConnection(*pConnection);
+
+					{
+						std::lock_guard<std::mutex> connectionsGuard { m_connectionsLock };
+						m_activeConnections.erase(pConnection.get());
+					}
+
+					pFinished->store(true);
+				}),
+				pFinished
+			});
+		}
+
+		stop();
+		reapConnections(true);
+
+		std::error_code ec;
+		std::filesystem::remove(m_options.socketPath, ec);
+	}
+
+	void DaemonServer::stop()
+	{
+		requestStop();
+
+		std::lock_guard<std::mutex> guard { m_connectionsLock };
+		for (auto* pConnection : m_activeConnections)
+		{
+			pConnection->shutdown();
+		}
+	}
+
+	void DaemonServer::requestStop()
+	{
+		m_bStopping = true;
+		m_listener.shutdown();
+	}
+
+	void DaemonServer::reapConnections(bool bWaitAll)
+	{
+		std::vector<Connection> vFinished {};
+
+		{
+			std::lock_guard<std::mutex> guard { m_connectionsLock };
+
+			auto it = std::stable_partition(m_vConnections.begin(), m_vConnections.end(), [bWaitAll](const Connection& connection) {
+				return !bWaitAll && !connection.pFinished->load();
+			});
+
+			std::move(it, m_vConnections.end(), std::back_inserter(vFinished));
+			m_vConnections.erase(it, m_vConnections.end());
+		}
+
+		for (auto& connection : vFinished)
+		{
+			if (connection.thread.joinable())
+			{
+				connection.thread.join();
+			}
+		}
+	}
+
+	void DaemonServer::serveConnection(UnixSocket& connection)
+	{
+		while (!m_bStopping)
+		{
+			auto frame = connection.receiveFrame();
+			if (!frame.has_value())
+				break;
+
+			++m_iRequests;
+
+			switch (static_cast<MessageKind>(frame->iKind))
+			{
+				case MessageKind::MK_ANALYZE:
+				{
+					auto request = DaemonProtocol::readAnalyzeRequest(frame->payload);
+					if (!request.has_value())
+					{
+						connection.sendFrame(static_cast<std::uint32_t>(MessageKind::MK_ERROR), DaemonProtocol::writeError("Malformed analyze request"));
+						break;
+					}
+
+					connection.sendFrame(frame->iKind, DaemonProtocol::writeAnalyzeResponse(analyze(request.value())));
+				}
+				break;
+				case MessageKind::MK_EVALUATE:
+				{
+					auto request = DaemonProtocol::readEvaluateRequest(frame->payload);
+					if (!request.has_value())
+					{
+						connection.sendFrame(static_cast<std::uint32_t>(MessageKind::MK_ERROR), DaemonProtocol::writeError("Malformed evaluate request"));
+						break;
+					}
+
+					connection.sendFrame(frame->iKind, DaemonProtocol::writeEvaluateResponse(evaluate(request.value())));
+				}
+				break;
+				case MessageKind::MK_STATS:
+					connection.sendFrame(frame->iKind, DaemonProtocol::writeStatsResponse(getStats()));
+				break;
+				case MessageKind::MK_SHUTDOWN:
+					connection.sendFrame(frame->iKind, {});
+					requestStop();
+				return;
+				default:
+					connection.sendFrame(static_cast<std::uint32_t>(MessageKind::MK_ERROR), DaemonProtocol::writeError(fmt::format("Unknown request kind {}", frame->iKind)));
+				break;
+			}
+		}
+	}
+
+	AnalyzeResponse DaemonServer::analyze(const AnalyzeRequest& request)
+	{
+		const auto startedAt = std::chrono::steady_clock::now();
+		AnalyzeResponse response {};
+
+		// Environment is cached by CompilerEnvironmentCache: detection is cheap after first request
+		auto environmentResult = rg3::llvm::CompilerConfigDetector::detectSystemCompilerEnvironment();
+		if (auto* pError = std::get_if<rg3::llvm::CompilerEnvError>(&environmentResult))
+		{
+			response.vIssues.emplace_back(server_details::makeIssue(fmt::format("RG3|Detect compiler environment failed: {}", pError->message)));
+			return response;
+		}
+
+		const auto& compilerEnv = std::get<rg3::llvm::CompilerEnvironment>(environmentResult);
+		const std::string sConfigDigest = rg3::llvm::IncrementalCache::makeConfigDigest(request.compilerConfig, compilerEnv);
+
+		// Requests are executed one by one: each one uses all workers and validates files of results cache from scratch
+		std::lock_guard<std::mutex> guard { m_analyzeLock };
+		m_resultsCache.resetFileStates();
+
+		// Stat & content cache lives during single request only: files could be changed between requests
+		auto pFileCache = ::llvm::makeIntrusiveRefCnt<rg3::llvm::SharedFileCache>();
+
+		std::vector<rg3::llvm::AnalyzerResult> vResults(request.vHeaders.size());
+		std::atomic<size_t> iNextHeader { 0 };
+		std::atomic<std::uint32_t> iReused { 0 };
+
+		auto workerEntryPoint = [&]() {
+			for (size_t i = iNextHeader++; i < request.vHeaders.size(); i = iNextHeader++)
+			{
+				const std::filesystem::path header { request.vHeaders[i] };
+
+				if (auto cachedResult = m_resultsCache.find(header, sConfigDigest))
+				{
+					vResults[i] = std::move(cachedResult.value());
+					++iReused;
+					continue;
+				}
+
+				rg3::llvm::CodeAnalyzer analyzer { header, request.compilerConfig };
+				analyzer.setCompilerEnvironment(compilerEnv);
+				analyzer.setSharedFileCache(pFileCache);
+				analyzer.setCollectDependencies(true);
+
+				vResults[i] = analyzer.analyze();
+				m_resultsCache.store(header, sConfigDigest, vResults[i]);
+			}
+		};
+
+		const size_t iWorkers = std::min<size_t>(request.iWorkers > 0 ? request.iWorkers : m_options.iWorkers, request.vHeaders.size());
+		std::vector<std::thread> vWorkers {};
+		vWorkers.reserve(iWorkers);
+
+		for (size_t i = 0; i < iWorkers; ++i)
+		{
+			vWorkers.emplace_back(workerEntryPoint);
+		}
+
+		for (auto& worker : vWorkers)
+		{
+			worker.join();
+		}
+
+		// Same merge as AnalyzerContext: order of headers, types are unique by pretty name
+		std::unordered_set<std::string> knownTypes {};
+
+		for (auto& result : vResults)
+		{
+			std::move(result.vIssues.begin(), result.vIssues.end(), std::back_inserter(response.vIssues));
+
+			for (auto& pType : result.vFoundTypes)
+			{
+				if (knownTypes.insert(pType->getPrettyName()).second)
+				{
+					response.vFoundTypes.emplace_back(std::move(pType));
+				}
+			}
+		}
+
+		response.iReusedHeaders = iReused.load();
+		response.iAnalyzedHeaders = static_cast<std::uint32_t>(request.vHeaders.size()) - response.iReusedHeaders;
+		response.analyzeTime = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - startedAt);
+
+		m_iReusedHeaders += response.iReusedHeaders;
+		m_iAnalyzedHeaders += response.iAnalyzedHeaders;
+
+		return response;
+	}
+
+	rg3::llvm::CodeEvaluateResult DaemonServer::evaluate(const EvaluateRequest& request)
+	{
+		auto environmentResult = rg3::llvm::CompilerConfigDetector::detectSystemCompilerEnvironment();
+		if (auto* pError = std::get_if<rg3::llvm::CompilerEnvError>(&environmentResult))
+		{
+			rg3::llvm::CodeEvaluateResult result {};
+			result.vIssues.emplace_back(server_details::makeIssue(fmt::format("RG3|Detect compiler environment failed: {}", pError->message)));
+			return result;
+		}
+
+		rg3::llvm::CodeEvaluator evaluator { request.compilerConfig };
+		evaluator.setCompilerEnvironment(std::get<rg3::llvm::CompilerEnvironment>(environmentResult));
+
+		return evaluator.evaluateCode(request.sCode, request.vCapture);
+	}
+
+	StatsResponse DaemonServer::getStats() const
+	{
+		StatsResponse stats {};
+		stats.iRequests = m_iRequests.load();
+		stats.iReusedHeaders = m_iReusedHeaders.load();
+		stats.iAnalyzedHeaders = m_iAnalyzedHeaders.load();
+		stats.iCachedResults = m_resultsCache.getEntriesCount();
+		stats.uptime = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - m_startedAt);
+		return stats;
+	}
+}
\ No newline at end of file
@@ -0,0 +1,280 @@
+#include <RG3/Daemon/DaemonSocket.h>
+#include <RG3/Cpp/TypeSerializer.h>
+
+#include <fmt/format.h>
+
+#include <cstdlib>
+#include <cstring>
+#include <cerrno>
+
+#ifndef _WIN32
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+#include <fcntl.h>
+#endif
+
+
+namespace rg3::daemon
+{
+	UnixSocket::UnixSocket(int iDescriptor) : m_iDescriptor(iDescriptor)
+	{
+	}
+
+	UnixSocket::~UnixSocket()
+	{
+#ifndef _WIN32
+		if (m_iDescriptor >= 0)
+		{
+			::close(m_iDescriptor);
+		}
+#endif
+	}
+
+	UnixSocket::UnixSocket(UnixSocket&& other) noexcept : m_iDescriptor(other.m_iDescriptor)
+	{
+		other.m_iDescriptor = -1;
+	}
+
+	UnixSocket& UnixSocket::operator=(UnixSocket&& other) noexcept
+	{
+		if (this != &other)
+		{
+			UnixSocket released { std::move(*this) };
+			m_iDescriptor = other.m_iDescriptor;
+			other.m_iDescriptor = -1;
+		}
+
+		return *this;
+	}
+
+#ifdef _WIN32
+	UnixSocketResult UnixSocket::listen(const std::filesystem::path&)
+	{
+		return DaemonError { "Unix-domain sockets are not supported on this platform" };
+	}
+
+	UnixSocketResult UnixSocket::connect(const std::filesystem::path&)
+	{
+		return DaemonError { "Unix-domain sockets are not supported on this platform" };
+	}
+
+	std::optional<UnixSocket> UnixSocket::accept()
+	{
+		return std::nullopt;
+	}
+
+	void UnixSocket::shutdown()
+	{
+	}
+
+	bool UnixSocket::writeAll(const char*, std::size_t)
+	{
+		return false;
+	}
+
+	bool UnixSocket::readAll(char*, std::size_t)
+	{
+		return false;
+	}
+
+	std::filesystem::path UnixSocket::getDefaultSocketPath()
+	{
+		return {};
+	}
+#else
+	namespace socket_details
+	{
+		static std::optional<sockaddr_un> makeAddress(const std::filesystem::path& socketPath)
+		{
+			sockaddr_un address {};
+			address.sun_family = AF_UNIX;
+
+			const std::string sPath = socketPath.string();
+			if (sPath.empty() || sPath.size() >= sizeof(address.sun_path))
+				return std::nullopt;
+
+			std::memcpy(address.sun_path, sPath.c_str(), sPath.size() + 1);
+			return address;
+		}
+
+		/**
+		 * @brief Descriptors must not leak into child processes (system compiler is spawned for environment detection)
+		 */
+		static int setCloseOnExec(int iDescriptor)
+		{
+			if (iDescriptor >= 0)
+			{
+				::fcntl(iDescriptor, F_SETFD, ::fcntl(iDescriptor, F_GETFD) | FD_CLOEXEC);
+			}
+
+			return iDescriptor;
+		}
+
+#ifdef MSG_NOSIGNAL
+		static constexpr int kSendFlags = MSG_NOSIGNAL; // Closed connection must be reported as error instead of SIGPIPE
+#else
+		static constexpr int kSendFlags = 0;
+#endif
+	}
+
+	UnixSocketResult UnixSocket::listen(const std::filesystem::path& socketPath)
+	{
+		const auto address = socket_details::makeAddress(socketPath);
+		if (!address.has_value())
+			return DaemonError { fmt::format("Bad socket path '{}'", socketPath.string()) };
+
+		// Socket file exists: replace it only when nobody listens (left by crashed daemon)
+		if (std::filesystem::exists(socketPath))
+		{
+			if (std::holds_alternative<UnixSocket>(connect(socketPath)))
+				return DaemonError { fmt::format("Daemon is already running on '{}'", socketPath.string()) };
+
+			std::error_code ec;
+			std::filesystem::remove(socketPath, ec);
+		}
+
+		UnixSocket listener { socket_details::setCloseOnExec(::socket(AF_UNIX, SOCK_STREAM, 0)) };
+		if (!listener.isValid())
+			return DaemonError { fmt::format("socket() failed: {}", std::strerror(errno)) };
+
+		if (::bind(listener.m_iDescriptor, reinterpret_cast<const sockaddr*>(&address.value()), sizeof(sockaddr_un)) != 0)
+			return DaemonError { fmt::format("bind('{}') failed: {}", socketPath.string(), std::strerror(errno)) };
+
+		if (::listen(listener.m_iDescriptor, SOMAXCONN) != 0)
+			return DaemonError { fmt::format("listen('{}') failed: {}", socketPath.string(), std::strerror(errno)) };
+
+		return listener;
+	}
+
+	UnixSocketResult UnixSocket::connect(const std::filesystem::path& socketPath)
+	{
+		const auto address = socket_details::makeAddress(socketPath);
+		if (!address.has_value())
+			return DaemonError { fmt::format("Bad socket path '{}'", socketPath.string()) };
+
+		UnixSocket connection { socket_details::setCloseOnExec(::socket(AF_UNIX, SOCK_STREAM, 0)) };
+		if (!connection.isValid())
+			return DaemonError { fmt::format("socket() failed: {}", std::strerror(errno)) };
+
+		if (::connect(connection.m_iDescriptor, reinterpret_cast<const sockaddr*>(&address.value()), sizeof(sockaddr_un)) != 0)
+			return DaemonError { fmt::format("connect('{}') failed: {}", socketPath.string(), std::strerror(errno)) };
+
+		return connection;
+	}
+
+	std::optional<UnixSocket> UnixSocket::accept()
+	{
+		while (isValid())
+		{
+			const int iConnection = socket_details::setCloseOnExec(::accept(m_iDescriptor, nullptr, nullptr));
+			if (iConnection >= 0)
+				return UnixSocket { iConnection };
+
+			if (errno != EINTR && errno != ECONNABORTED)
+				break;
+		}
+
+		return std::nullopt;
+	}
+
+	void UnixSocket::shutdown()
+	{
+		if (isValid())
+		{
+			::shutdown(m_iDescriptor, SHUT_RDWR);
+		}
+	}
+
+	bool UnixSocket::writeAll(const char* pData, std::size_t iSize)
+	{
+		while (iSize > 0)
+		{
+			const ssize_t iWritten = ::send(m_iDescriptor, pData, iSize, socket_details::kSendFlags);
+			if (iWritten < 0 && errno == EINTR)
+				continue;
+
+			if (iWritten <= 0)
+				return false;
+
+			pData += iWritten;
+			iSize -= static_cast<std::size_t>(iWritten);
+		}
+
+		return true;
+	}
+
+	bool UnixSocket::readAll(char* pData, std::size_t iSize)
+	{
+		while (iSize > 0)
+		{
+			const ssize_t iRead = ::recv(m_iDescriptor, pData, iSize, 0);
+			if (iRead < 0 && errno == EINTR)
+				continue;
+
+			if (iRead <= 0)
+				return false;
+
+			pData += iRead;
+			iSize -= static_cast<std::size_t>(iRead);
+		}
+
+		return true;
+	}
+
+	std::filesystem::path UnixSocket::getDefaultSocketPath()
+	{
+		if (const char* pSocket = std::getenv("RG3D_SOCKET"); pSocket && *pSocket)
+			return pSocket;
+
+		if (const char* pRuntimeDir = std::getenv("XDG_RUNTIME_DIR"); pRuntimeDir && *pRuntimeDir)
+			return std::filesystem::path(pRuntimeDir) / "rg3d.sock";
+
+		return std::filesystem::temp_directory_path() / fmt::format("rg3d-{}.sock", ::getuid());
+	}
+#endif
+
+	bool UnixSocket::sendFrame(std::uint32_t iKind, std::string_view payload)
+	{
+		if (!isValid() || payload.size() > kMaxFrameSize)
+			return false;
+
+		cpp::BinaryWriter header {};
+		header.writeU32(kFrameMagic);
+		header.writeU32(iKind);
+		header.writeU32(static_cast<std::uint32_t>(payload.size()));
+
+		return writeAll(header.getBuffer().data(), header.getBuffer().size()) && writeAll(payload.data(), payload.size());
+	}
+
+	std::optional<Frame> UnixSocket::receiveFrame()
+	{
+		if (!isValid())
+			return std::nullopt;
+
+		char headerData[12] {};
+		if (!readAll(headerData, sizeof(headerData)))
+			return std::nullopt;
+
+		cpp::BinaryReader header { std::string_view { headerData, sizeof(headerData) } };
+		const std::uint32_t iMagic = header.readU32();
+
+		Frame frame {};
+		frame.iKind = header.readU32();
+
+		const std::uint32_t iSize = header.readU32();
+		if (iMagic != kFrameMagic || iSize > kMaxFrameSize)
+			return std::nullopt;
+
+		frame.payload.resize(iSize);
+		if (iSize > 0 && !readAll(frame.payload.data(), iSize))
+			return std::nullopt;
+
+		return frame;
+	}
+
+	bool UnixSocket::isValid() const
+	{
+		return m_iDescriptor >= 0;
+	}
+}
\ No newline at end of file
@@ -3,19 +3,28 @@
 
 #include <RG3/Cpp/TypeBase.h>
 #include <RG3/LLVM/CompilerConfig.h>
+#include <RG3/LLVM/AnalyzeStats.h>
 #include <clang/Frontend/FrontendActions.h>
 #include <memory>
+#include <atomic>
+#include <string_view>
 
 
 namespace rg3::llvm::actions
 {
 	struct ExtractTypesFromTUAction : public clang::ASTFrontendAction
 	{
-		ExtractTypesFromTUAction(std::vector<rg3::cpp::TypeBasePtr>& vFoundTypes, const CompilerConfig& cc) : foundTypes(vFoundTypes), compilerConfig(cc) {}
+		ExtractTypesFromTUAction(std::vector<rg3::cpp::TypeBasePtr>& vFoundTypes, const CompilerConfig& cc, AnalyzeStats* pAnalyzeStats = nullptr, const std::atomic_bool* pCancelFlag = nullptr)
+			: foundTypes(vFoundTypes), compilerConfig(cc), pStats(pAnalyzeStats), pCancelled(pCancelFlag) {}
 
+		bool BeginSourceFileAction(clang::CompilerInstance& compilerInstance) override;
 		std::unique_ptr<clang::ASTConsumer> CreateASTConsumer(clang::CompilerInstance& /*compilerInstance*/, clang::StringRef /*file*/) override;
 
+		static constexpr std::string_view kCancelledMessage = "RG3|Analyze cancelled";
+
 		std::vector<rg3::cpp::TypeBasePtr>& foundTypes;
 		const CompilerConfig& compilerConfig;
+		AnalyzeStats* pStats { nullptr }; /// Optional: receives visit time & amount of visited decls
+		const std::atomic_bool* pCancelled { nullptr }; /// Optional: when raised preprocessor stops at next entered file (fatal error) and AST is not visited
 	};
 }
\ No newline at end of file
@@ -0,0 +1,65 @@
+#pragma once
+
+#include <unordered_map>
+#include <filesystem>
+#include <optional>
+#include <cstdint>
+#include <chrono>
+#include <string>
+#include <mutex>
+
+
+namespace rg3::llvm
+{
+	/**
+	 * @brief Measured analyze time of headers from previous runs. Used to schedule most expensive headers first.
+	 * @note History file is a text file: one '<nanoseconds> <absolute path>' line per header.
+	 * @note Methods are thread safe.
+	 */
+	class AnalyzeCostHistory
+	{
+	 public:
+		static constexpr std::uint64_t kIncludeCost = 8 * 1024; /// Cost of single '#include' line (in bytes of source)
+		static constexpr std::uint64_t kMinHeaderCost = 1024; /// Empty headers still cost something: compiler invocation, includes
+
+		explicit AnalyzeCostHistory(std::filesystem::path historyFile);
+
+		/**
+		 * @brief Cheap estimation of analyze cost of header without history: size of file + kIncludeCost per '#include' line
+		 * @return cost in bytes of source (at least kMinHeaderCost)
+		 */
+		static std::uint64_t estimateCost(const std::filesystem::path& header);
+
+		/**
+		 * @brief Load history file
+		 * @return false when file not exists or malformed (history becomes empty)
+		 */
+		bool load();
+
+		/**
+		 * @brief Write history file (when something was recorded)
+		 */
+		bool save();
+
+		/**
+		 * @brief Measured analyze time of header
+		 * @return time or std::nullopt when header was never analyzed
+		 */
+		[[nodiscard]] std::optional<std::chrono::nanoseconds> find(const std::filesystem::path& header) const;
+
+		/**
+		 * @brief Record analyze time of header. Known time is averaged with new one: single slow run doesn't break scheduling.
+		 */
+		void record(const std::filesystem::path& header, std::chrono::nanoseconds duration);
+
+		[[nodiscard]] std::size_t getEntriesCount() const;
+		[[nodiscard]] const std::filesystem::path& getHistoryFile() const;
+
+	 private:
+		std::filesystem::path m_historyFile {};
+
+		mutable std::mutex m_entriesLock;
+		std::unordered_map<std::string, std::int64_t> m_entries {};
+		bool m_bDirty { false };
+	};
+}
\ No newline at end of file
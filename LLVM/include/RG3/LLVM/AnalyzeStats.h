@@ -0,0 +1,39 @@
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+
+
+namespace rg3::llvm
+{
+	/**
+	 * @brief Cost of analyze: time of each phase, memory & amount of work.
+	 *        Collected for each translation unit (see AnalyzerResult::stats), could be summed to get aggregate of whole run.
+	 */
+	struct AnalyzeStats
+	{
+		std::chrono::nanoseconds envDetectionTime { 0 }; /// Detect compiler environment (only when environment was not provided to analyzer)
+		std::chrono::nanoseconds preambleTime { 0 }; /// Load or build precompiled preamble
+		std::chrono::nanoseconds instanceCreationTime { 0 }; /// CompilerInstanceFactory::makeInstance
+		std::chrono::nanoseconds parseTime { 0 }; /// Preprocess, parse & semantic analysis of translation unit
+		std::chrono::nanoseconds visitTime { 0 }; /// Traversal of AST by CxxRouterVisitor
+		std::chrono::nanoseconds totalTime { 0 };
+
+		std::uint64_t iTranslationUnits { 0 };
+		std::uint64_t iDeclsVisited { 0 }; /// Declarations (records, enums & aliases) routed by CxxRouterVisitor
+		std::uint64_t iDeclsPruned { 0 }; /// Declarations skipped with their subtrees by source filter (see CompilerConfig::eSourceFilter)
+		std::uint64_t iDeclsRevisited { 0 }; /// Declarations routed more than once (type of declaration built twice)
+		std::uint64_t iTypesEmitted { 0 };
+		std::uint64_t iPeakRssGrowth { 0 }; /// Growth of process peak resident set size during analyze (bytes). Process wide: parallel analyzers affect each other
+
+		/**
+		 * @brief Sum times & counters. Peak RSS growth is max of both.
+		 */
+		AnalyzeStats& operator+=(const AnalyzeStats& other);
+
+		/**
+		 * @brief Peak resident set size of current process in bytes (0 when platform is not supported)
+		 */
+		static std::uint64_t getProcessPeakRss();
+	};
+}
\ No newline at end of file
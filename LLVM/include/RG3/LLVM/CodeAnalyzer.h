@@ -2,11 +2,16 @@
 
 #include <RG3/LLVM/CompilerConfigDetector.h>
 #include <RG3/LLVM/CompilerConfig.h>
+#include <RG3/LLVM/SharedFileCache.h>
+#include <RG3/LLVM/AnalyzeStats.h>
 #include <RG3/Cpp/TypeBase.h>
 #include <filesystem>
+#include <atomic>
 #include <variant>
 #include <cstdint>
 #include <optional>
+#include <vector>
+#include <string>
 #include <span>
 
 
@@ -29,6 +34,8 @@ namespace rg3::llvm
 
 		CompilerIssuesVector vIssues {};
 		std::vector<cpp::TypeBasePtr> vFoundTypes {};
+		std::vector<std::filesystem::path> vDependencies {}; /// Files read by compiler (source file & transitive includes). Collected only when requested (see CodeAnalyzer::setCollectDependencies)
+		AnalyzeStats stats {}; /// Cost of analyze of translation unit
 
 		explicit operator bool() const;
 	};
@@ -43,13 +50,54 @@ namespace rg3::llvm
 		void setSourceCode(const std::string& sourceCode);
 		void setSourceFile(const std::filesystem::path& sourceFile);
 		void setCompilerEnvironment(const CompilerEnvironment& env);
+
+		/**
+		 * @brief Use shared stat & file content cache instead of real file system. Cache could be shared between multiple analyzers (and threads).
+		 */
+		void setSharedFileCache(::llvm::IntrusiveRefCntPtr<SharedFileCache> pFileCache);
+
+		/**
+		 * @brief Collect absolute paths of all files which were read by compiler into AnalyzerResult::vDependencies
+		 */
+		void setCollectDependencies(bool bCollectDependencies);
+
+		/**
+		 * @brief Flag to abort analyze from another thread. Checked before start and every time when compiler enters file.
+		 *        Cancelled analyze returns no types and issue 'RG3|Analyze cancelled'.
+		 * @note Flag must outlive analyze() call
+		 */
+		void setCancellationFlag(const std::atomic_bool* pCancelled);
+
+		/**
+		 * @brief Check that result was produced by cancelled analyze
+		 */
+		static bool isCancelledResult(const AnalyzerResult& result);
 		CompilerConfig& getCompilerConfig();
 
 		AnalyzerResult analyze();
 
+		/**
+		 * @brief Make source of umbrella translation unit: in-memory buffer which includes every header (by absolute path).
+		 *        Includes which are shared between headers are parsed once per umbrella instead of once per header.
+		 * @note Duplicated headers are included once
+		 */
+		static std::string makeUmbrellaSource(const std::vector<std::filesystem::path>& vHeaders);
+
+		/**
+		 * @brief Split result of umbrella translation unit into results of each header (same order as vHeaders).
+		 *        Types & issues attributed by their definition location. Everything from other files (shared includes) goes to first header.
+		 *        Issues of umbrella buffer itself (like 'file not found') attributed by line of include directive.
+		 *        Stats of umbrella translation unit go to first header.
+		 * @note Result of header depends on its batch: it must not be cached as result of header analyzed alone
+		 */
+		static std::vector<AnalyzerResult> splitUmbrellaResult(AnalyzerResult&& umbrellaResult, const std::vector<std::filesystem::path>& vHeaders);
+
 	 private:
 		std::variant<std::filesystem::path, std::string> m_source;
 		std::optional<CompilerEnvironment> m_env;
 		CompilerConfig m_compilerConfig;
+		::llvm::IntrusiveRefCntPtr<SharedFileCache> m_pFileCache { nullptr };
+		bool m_bCollectDependencies { false };
+		const std::atomic_bool* m_pCancelled { nullptr };
 	};
 }
\ No newline at end of file
@@ -0,0 +1,52 @@
+#pragma once
+
+#include <RG3/Cpp/Tag.h>
+
+#include <clang/AST/DeclBase.h>
+
+#include <unordered_map>
+
+
+namespace rg3::llvm
+{
+	/**
+	 * @brief Memo of comments & parsed tags of declarations of single translation unit.
+	 *        Comment of declaration is looked up, formatted & parsed once: parent classes shared by many derived types,
+	 *        aliases & records built again by annotation based registration reuse the result.
+	 * @note Clang keeps comments of each file sorted by offset (RawCommentList), so the lookup itself is cheap.
+	 *       Expensive part is repeated formatting & tags parsing of same comment, which this cache removes.
+	 * @note Not thread safe: one cache per translation unit (see CollectTypesFromTUConsumer)
+	 */
+	class CommentTagsCache
+	{
+	 public:
+		struct Entry
+		{
+			bool bHasComment { false }; /// Declaration has non empty comment
+			cpp::Tags vTags {};
+		};
+
+	 public:
+		CommentTagsCache() = default;
+
+		/**
+		 * @brief Comment tags of declaration (memoized)
+		 */
+		const Entry& getEntry(const clang::Decl* pDecl);
+
+		/**
+		 * @brief Comment tags of declaration from cache or without memo when cache is not provided
+		 */
+		static Entry lookup(CommentTagsCache* pCache, const clang::Decl* pDecl);
+
+		/**
+		 * @brief Find comment of declaration and parse tags (no memo)
+		 */
+		static Entry makeEntry(const clang::Decl* pDecl);
+
+		[[nodiscard]] std::size_t getEntriesCount() const;
+
+	 private:
+		std::unordered_map<const clang::Decl*, Entry> m_entries {};
+	};
+}
\ No newline at end of file
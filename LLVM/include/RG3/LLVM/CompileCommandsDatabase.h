@@ -0,0 +1,68 @@
+#pragma once
+
+#include <RG3/LLVM/CompilerConfig.h>
+
+#include <filesystem>
+#include <optional>
+#include <variant>
+#include <memory>
+#include <string>
+#include <vector>
+
+
+namespace clang::tooling
+{
+	class CompilationDatabase;
+}
+
+namespace rg3::llvm
+{
+	struct CompileCommandsDatabaseError
+	{
+		std::string message {};
+	};
+
+	class CompileCommandsDatabase;
+
+	using CompileCommandsDatabaseResult = std::variant<CompileCommandsDatabaseError, std::shared_ptr<CompileCommandsDatabase>>;
+
+	/**
+	 * @brief Per-file compiler flags from 'compile_commands.json' (clang JSON compilation database).
+	 *        Headers are usually not listed in database: header takes flags of the most similar translation unit (by path & name, same as clangd does).
+	 * @note Only flags which affect parsing are taken: include directories, macro definitions, C++ standard and forced includes.
+	 *       Other flags of driver (optimization, warnings, outputs, target specific flags) are dropped.
+	 * @note Methods are thread safe (database is read only after load)
+	 */
+	class CompileCommandsDatabase
+	{
+	 public:
+		static CompileCommandsDatabaseResult loadFromFile(const std::filesystem::path& databaseFile);
+
+		~CompileCommandsDatabase();
+
+		CompileCommandsDatabase(const CompileCommandsDatabase&) = delete;
+		CompileCommandsDatabase& operator=(const CompileCommandsDatabase&) = delete;
+
+		/**
+		 * @brief Config of file: base config extended by flags of file (or of its owning translation unit)
+		 * @return config or std::nullopt when database has no commands at all
+		 */
+		[[nodiscard]] std::optional<CompilerConfig> getConfigForFile(const std::filesystem::path& file, const CompilerConfig& baseConfig) const;
+
+		/**
+		 * @brief Apply compiler command line (first argument is compiler executable) to config. Relative paths are resolved against working directory.
+		 */
+		static void applyCommandLine(CompilerConfig& config, const std::vector<std::string>& vCommandLine, const std::filesystem::path& workingDir);
+
+		[[nodiscard]] std::size_t getFilesCount() const;
+		[[nodiscard]] const std::filesystem::path& getDatabaseFile() const;
+
+	 private:
+		CompileCommandsDatabase(std::filesystem::path databaseFile, std::unique_ptr<clang::tooling::CompilationDatabase>&& pDatabase, std::size_t iFilesCount);
+
+	 private:
+		std::filesystem::path m_databaseFile {};
+		std::unique_ptr<clang::tooling::CompilationDatabase> m_pDatabase { nullptr };
+		std::size_t m_iFilesCount { 0 };
+	};
+}
\ No newline at end of file
@@ -9,6 +9,13 @@ namespace rg3::llvm
 	enum class CxxStandard : int { CC_11 = 11, CC_14 = 14, CC_17 = 17, CC_20 = 20, CC_23 = 23, CC_26 = 26, CC_DEFAULT = CC_11 };
 	enum class IncludeKind : int { IK_PROJECT = 0, IK_SYSTEM, IK_C_SYSTEM, IK_SYSROOT, IK_THIRD_PARTY, IK_DEFAULT = IK_PROJECT };
 
+	/**
+	 * @brief Which files are allowed to produce types. Main file is always allowed.
+	 * SF_ALL - every file; SF_SKIP_SYSTEM_HEADERS - every file except system headers; SF_PROJECT_INCLUDES - files under IK_PROJECT includes; SF_MAIN_FILE - only main file
+	 * @note Default keeps behaviour of previous versions (types of every file are collected): filtering is opt-in
+	 */
+	enum class SourceFilter : int { SF_ALL = 0, SF_SKIP_SYSTEM_HEADERS, SF_PROJECT_INCLUDES, SF_MAIN_FILE, SF_DEFAULT = SF_ALL };
+
 
 	struct IncludeInfo
 	{
@@ -18,5 +18,9 @@ namespace rg3::llvm
 		bool bAllowCollectNonRuntimeTypes { false };
 		bool bSkipFunctionBodies { true };
 		bool bUseDeepAnalysis { false };
+		std::vector<std::string> vPreambleHeaders {}; /// Headers (spelled like '<vector>' or '"my/header.h"') which will be precompiled once and loaded by each compiler instance which includes all of them itself (top-level include directives). Types of these headers are not collected!
+		SourceFilter eSourceFilter { SourceFilter::SF_DEFAULT }; /// Declarations of rejected files are skipped before any visitor work (see SourceFileFilter)
+		std::vector<std::string> vSourceAllowGlobs {}; /// When not empty: included file must match at least one glob (like '*/src/*')
+		std::vector<std::string> vSourceDenyGlobs {}; /// Included file which matches any glob (like '*/third_party/*') is rejected
 	};
 }
\ No newline at end of file
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <filesystem>
 #include <string>
 #include <variant>
 
@@ -35,12 +36,31 @@ namespace rg3::llvm
 
 	using CompilerEnvResult = std::variant<CompilerEnvError, CompilerEnvironment>;
 
+	/**
+	 * @brief Options of in-process (clang Driver based) environment detection
+	 */
+	struct InProcessDetectorOptions
+	{
+		std::filesystem::path sGccToolchain {}; /// Same as --gcc-toolchain. Empty - let driver find GCC installation itself
+		std::filesystem::path sResourceDir {}; /// Clang resource dir (builtin headers). Empty - use resource dir of LLVM which RG3 was built with
+		std::string sTriple {}; /// Target triple. Empty - default target triple of host
+	};
+
 	struct CompilerConfigDetector
 	{
 		/**
 		 * @brief Trying to recognize where located system compiler and trying to get all information about it's environment
+		 * @param bUseCache - lookup result in CompilerEnvironmentCache first (and store fresh result there). When false compiler will be invoked anyway.
+		 * @return CompilerEnvError on error, CompilerEnvironment when everything is ok
+		 */
+		static CompilerEnvResult detectSystemCompilerEnvironment(bool bUseCache = true);
+
+		/**
+		 * @brief Compute system include dirs & triple via clang Driver & ToolChain inside current process (without running any external compiler)
+		 * @param options - detector options (GCC toolchain, resource dir, triple)
 		 * @return CompilerEnvError on error, CompilerEnvironment when everything is ok
+		 * @note Environment contains clang builtin headers (from resource dir) instead of GCC builtin headers
 		 */
-		static CompilerEnvResult detectSystemCompilerEnvironment();
+		static CompilerEnvResult detectCompilerEnvironmentInProcess(const InProcessDetectorOptions& options = {});
 	};
 }
\ No newline at end of file
@@ -0,0 +1,95 @@
+#pragma once
+
+#include <RG3/LLVM/CompilerConfigDetector.h>
+
+#include <filesystem>
+#include <unordered_map>
+#include <optional>
+#include <cstdint>
+#include <utility>
+#include <string>
+#include <vector>
+#include <mutex>
+
+
+namespace rg3::llvm
+{
+	/**
+	 * @brief Cache of detected compiler environments. Lives in process memory and (optionally) on disk.
+	 * @note Entry stays valid while compiler executable (path, size, mtime), relevant environment variables and RG3 build are same.
+	 *       On-disk entry also invalidated when any of stored system include directories is not exists anymore.
+	 * @note Compiler version string is not a part of key: it known only after compiler invocation which cache should avoid.
+	 *       Path is canonical (switch of symlinks/alternatives gives another key) and in-place upgrade of driver changes its size or mtime.
+	 * @note On-disk location: $RG3_CACHE_DIR, $XDG_CACHE_HOME/rg3 or $HOME/.cache/rg3 (%LOCALAPPDATA%/rg3 on Windows). Define RG3_NO_DISK_CACHE to keep cache in memory only.
+	 */
+	class CompilerEnvironmentCache
+	{
+	 public:
+		struct Key
+		{
+			std::filesystem::path sCompilerPath {}; /// Canonical path to compiler executable
+			std::int64_t iModificationTime { 0 };
+			std::uintmax_t iFileSize { 0 };
+			std::vector<std::pair<std::string, std::string>> vEnvironment {}; /// Environment variables which affects compiler search paths
+
+			/**
+			 * @brief Build key for compiler executable. Reads file status & environment variables of current process.
+			 * @return std::nullopt when executable not exists or not accessible
+			 */
+			static std::optional<Key> makeForCompiler(const std::filesystem::path& compilerPath);
+
+			/**
+			 * @brief Short hex digest of key. Used as name of on-disk entry.
+			 */
+			[[nodiscard]] std::string getDigest() const;
+
+			bool operator==(const Key& other) const = default;
+		};
+
+		struct Stats
+		{
+			std::size_t iMemoryHits { 0 };
+			std::size_t iDiskHits { 0 };
+			std::size_t iMisses { 0 };
+			std::size_t iInvalidated { 0 };
+		};
+
+	 public:
+		static CompilerEnvironmentCache& getInstance();
+
+		/**
+		 * @brief Find environment for key. Looks up in memory first, then on disk (when enabled).
+		 */
+		std::optional<CompilerEnvironment> find(const Key& key);
+
+		/**
+		 * @brief Store environment in memory & on disk (when enabled). Errors of on-disk storage are ignored.
+		 */
+		void store(const Key& key, const CompilerEnvironment& env);
+
+		/**
+		 * @brief Drop all in-memory entries and all entries from on-disk cache directory
+		 */
+		void invalidate();
+
+		/**
+		 * @brief Override on-disk cache location. Pass std::nullopt to disable on-disk cache.
+		 */
+		void setDiskCacheDirectory(const std::optional<std::filesystem::path>& directory);
+		[[nodiscard]] std::optional<std::filesystem::path> getDiskCacheDirectory() const;
+
+		[[nodiscard]] Stats getStats() const;
+
+	 private:
+		CompilerEnvironmentCache();
+
+		std::optional<CompilerEnvironment> loadFromDisk(const Key& key);
+		void storeOnDisk(const Key& key, const CompilerEnvironment& env) const;
+
+	 private:
+		mutable std::mutex m_lock;
+		std::unordered_map<std::string, std::pair<Key, CompilerEnvironment>> m_entries {};
+		std::optional<std::filesystem::path> m_diskCacheDir {};
+		Stats m_stats {};
+	};
+}
\ No newline at end of file
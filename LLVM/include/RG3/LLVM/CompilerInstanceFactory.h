@@ -1,11 +1,14 @@
 #pragma once
 
 #include <clang/Frontend/CompilerInstance.h>
+#include <llvm/Support/VirtualFileSystem.h>
 
 #include <RG3/LLVM/CompilerConfigDetector.h>
 #include <RG3/LLVM/CompilerConfig.h>
 
 #include <filesystem>
+#include <string_view>
+#include <optional>
 #include <variant>
 #include <string>
 
@@ -14,10 +17,17 @@ namespace rg3::llvm
 {
 	struct CompilerInstanceFactory
 	{
+		/**
+		 * @brief Name of main file when source code passed as in-memory buffer
+		 */
+		static constexpr std::string_view kInMemoryInputName = "id0.hpp";
+
 		static void makeInstance(
 			clang::CompilerInstance* pOutInstance,
 			const std::variant<std::filesystem::path, std::string>& sInput,
 			const CompilerConfig& sCompilerConfig,
-			const CompilerEnvironment* pCompilerEnv = nullptr);
+			const CompilerEnvironment* pCompilerEnv = nullptr,
+			::llvm::IntrusiveRefCntPtr<::llvm::vfs::FileSystem> pFileSystem = nullptr,
+			const std::optional<std::filesystem::path>& sPreamblePCH = std::nullopt);
 	};
 }
\ No newline at end of file
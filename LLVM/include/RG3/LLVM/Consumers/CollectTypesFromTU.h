@@ -1,7 +1,9 @@
 #pragma once
 
 #include <vector>
+#include <atomic>
 #include <RG3/LLVM/CompilerConfig.h>
+#include <RG3/LLVM/AnalyzeStats.h>
 #include <RG3/Cpp/TypeBase.h>
 #include <clang/AST/ASTConsumer.h>
 
@@ -10,11 +12,13 @@ namespace rg3::llvm::consumers
 {
 	struct CollectTypesFromTUConsumer : public clang::ASTConsumer
 	{
-		CollectTypesFromTUConsumer(std::vector<rg3::cpp::TypeBasePtr>& vCollectedTypes, const CompilerConfig& cc);
+		CollectTypesFromTUConsumer(std::vector<rg3::cpp::TypeBasePtr>& vCollectedTypes, const CompilerConfig& cc, AnalyzeStats* pAnalyzeStats = nullptr, const std::atomic_bool* pCancelFlag = nullptr);
 
 		void HandleTranslationUnit(clang::ASTContext& ctx) override;
 
 		std::vector<rg3::cpp::TypeBasePtr>& collectedTypes;
 		const CompilerConfig& compilerConfig;
+		AnalyzeStats* pStats { nullptr };
+		const std::atomic_bool* pCancelled { nullptr };
 	};
 }
\ No newline at end of file
@@ -0,0 +1,79 @@
+#pragma once
+
+#include <unordered_map>
+#include <filesystem>
+#include <variant>
+#include <chrono>
+#include <memory>
+#include <string>
+#include <vector>
+
+
+namespace rg3::llvm
+{
+	struct FileWatcherError
+	{
+		std::string message {};
+	};
+
+	/**
+	 * @brief Changes collected by single FileWatcher::waitChanges call
+	 */
+	struct FileChanges
+	{
+		std::vector<std::filesystem::path> vFiles {}; /// Absolute paths of changed files (unique)
+		std::vector<std::filesystem::path> vCreatedFiles {}; /// Files of vFiles which were created or moved in: they could shadow other files found by include search
+		bool bOverflow { false }; /// Kernel queue overflowed: some changes were lost, everything must be treated as changed
+
+		[[nodiscard]] bool empty() const { return vFiles.empty() && !bOverflow; }
+	};
+
+	class FileWatcher;
+
+	using FileWatcherResult = std::variant<FileWatcherError, std::unique_ptr<FileWatcher>>;
+
+	/**
+	 * @brief Watcher of file changes in set of directories (inotify).
+	 *        Directories are watched instead of files: editors often save file by rename of temporary file, so watch of file would be lost.
+	 * @note Supported only on Linux: create() returns error on other platforms.
+	 */
+	class FileWatcher
+	{
+	 public:
+		static FileWatcherResult create();
+
+		~FileWatcher();
+
+		FileWatcher(const FileWatcher&) = delete;
+		FileWatcher& operator=(const FileWatcher&) = delete;
+
+		/**
+		 * @brief Subscribe to changes of files inside directory (not recursive). Already watched directory is ignored.
+		 * @return false when directory can't be watched (not exists, limit of watches reached)
+		 */
+		bool watchDirectory(const std::filesystem::path& directory);
+
+		/**
+		 * @brief Wait for changes (modified, created, removed or renamed files)
+		 * @param timeout - max time to wait for first change. Negative - wait infinitely
+		 * @param settleTime - changes are collected until there are no new events during this time: save of single file produces few events
+		 * @return changes or empty changes on timeout
+		 */
+		FileChanges waitChanges(std::chrono::milliseconds timeout, std::chrono::milliseconds settleTime = std::chrono::milliseconds(50));
+
+		[[nodiscard]] std::size_t getWatchedDirectoriesCount() const;
+
+	 private:
+		explicit FileWatcher(int iDescriptor);
+
+		/**
+		 * @brief Read all pending events into changes
+		 */
+		void readEvents(FileChanges& changes);
+
+	 private:
+		int m_iDescriptor { -1 };
+		std::unordered_map<int, std::filesystem::path> m_watches {}; /// Watch descriptor -> directory
+		std::unordered_map<std::string, int> m_directories {}; /// Directory -> watch descriptor
+	};
+}
\ No newline at end of file
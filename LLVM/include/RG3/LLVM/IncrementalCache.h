@@ -0,0 +1,149 @@
+#pragma once
+
+#include <RG3/LLVM/CompilerConfigDetector.h>
+#include <RG3/LLVM/CompilerConfig.h>
+#include <RG3/LLVM/CodeAnalyzer.h>
+
+#include <unordered_map>
+#include <filesystem>
+#include <list>
+#include <memory>
+#include <optional>
+#include <cstdint>
+#include <string>
+#include <vector>
+#include <mutex>
+
+
+namespace rg3::llvm
+{
+	/**
+	 * @brief On-disk cache of analyze results for incremental re-analysis.
+	 *        Header is reused while its content, content of every file it read (transitive includes) and compiler config are same.
+	 * @note Cache directory contains 'manifest.txt' (one entry per header: config digest, hashes of header & dependencies)
+	 *       and '<digest>.rg3r' files (issues & serialized types of single header).
+	 * @note Cache with empty directory keeps serialized results in memory only (for long-living processes, see rg3d).
+	 * @note Methods are thread safe: workers could look up & store results concurrently.
+	 */
+	class IncrementalCache
+	{
+	 public:
+		struct FileRecord
+		{
+			std::string sPath {}; /// Absolute path
+			std::uintmax_t iFileSize { 0 };
+			std::int64_t iModificationTime { 0 };
+			std::uint64_t iContentHash { 0 };
+		};
+
+		struct Entry
+		{
+			std::string sConfigDigest {};
+			std::string sResultFile {}; /// Name of result file inside cache directory
+			FileRecord header {};
+			std::vector<FileRecord> vDependencies {};
+			std::shared_ptr<const std::string> pResultData {}; /// Serialized result of memory only cache (not stored in manifest)
+		};
+
+	 public:
+		/**
+		 * @param cacheDir - directory of manifest & results (created on save). Empty - memory only cache
+		 * @param sConfigDigest - digest of config of current run (see makeConfigDigest)
+		 */
+		IncrementalCache(std::filesystem::path cacheDir, std::string sConfigDigest);
+
+		/**
+		 * @brief Stable digest of everything what affects analyze result except source files: compiler config, environment & RG3 build
+		 */
+		static std::string makeConfigDigest(const CompilerConfig& config, const CompilerEnvironment& env);
+
+		/**
+		 * @brief Load manifest from cache directory
+		 * @return false when manifest not exists or malformed (cache becomes empty)
+		 */
+		bool load();
+
+		/**
+		 * @brief Write manifest into cache directory (when something was stored)
+		 */
+		bool save();
+
+		/**
+		 * @brief Find result of header. Header & all its dependencies are validated: size & modification time first, content hash when they are differ.
+		 * @return result or std::nullopt when header must be re-analyzed
+		 */
+		std::optional<AnalyzerResult> find(const std::filesystem::path& header);
+
+		/**
+		 * @brief Store result of header. Result must contain dependencies (see CodeAnalyzer::setCollectDependencies)
+		 */
+		void store(const std::filesystem::path& header, const AnalyzerResult& result);
+
+		/**
+		 * @brief Same as find/store but for header which has own config (differs from config of run, see CompileCommandsDatabase)
+		 */
+		std::optional<AnalyzerResult> find(const std::filesystem::path& header, const std::string& sConfigDigest);
+		void store(const std::filesystem::path& header, const std::string& sConfigDigest, const AnalyzerResult& result);
+
+		/**
+		 * @brief Forget memoized states of files and reused/recomputed lists: call before each run when cache lives longer than single run
+		 */
+		void resetFileStates();
+
+		/**
+		 * @brief Limit size of serialized results kept by memory only cache: least recently used entries are evicted when limit exceeded
+		 * @param iMaxBytes - 0 - unlimited (default)
+		 */
+		void setMemoryLimit(std::size_t iMaxBytes);
+
+		[[nodiscard]] bool isMemoryOnly() const;
+		[[nodiscard]] std::size_t getEntriesCount() const;
+		[[nodiscard]] std::size_t getMemoryUsage() const;
+		[[nodiscard]] const std::filesystem::path& getCacheDirectory() const;
+		[[nodiscard]] std::vector<std::filesystem::path> getReusedHeaders() const;
+		[[nodiscard]] std::vector<std::filesystem::path> getRecomputedHeaders() const;
+
+	 private:
+		struct FileState
+		{
+			bool bExists { false };
+			std::uintmax_t iFileSize { 0 };
+			std::int64_t iModificationTime { 0 };
+			std::optional<std::uint64_t> iContentHash {};
+		};
+
+		/**
+		 * @brief Current state of file. Memoized: every file stat'ed & hashed once per cache instance
+		 */
+		FileState getFileState(const std::string& sPath, bool bNeedHash);
+		std::optional<FileRecord> makeFileRecord(const std::string& sPath);
+		bool isValid(const FileRecord& record);
+
+		/**
+		 * @brief Mark entry as most recently used (memory only cache). m_entriesLock must be held.
+		 */
+		void touchEntry(const std::string& sKey);
+
+		/**
+		 * @brief Drop least recently used entries until memory limit is satisfied. m_entriesLock must be held.
+		 */
+		void evictEntries();
+
+	 private:
+		std::filesystem::path m_cacheDir {};
+		std::string m_sConfigDigest {};
+
+		mutable std::mutex m_entriesLock;
+		std::unordered_map<std::string, Entry> m_entries {};
+		std::vector<std::filesystem::path> m_vReused {};
+		std::vector<std::filesystem::path> m_vRecomputed {};
+		bool m_bDirty { false };
+		std::size_t m_iMemoryLimit { 0 };
+		std::size_t m_iMemoryUsage { 0 }; /// Size of serialized results of memory only cache
+		std::list<std::string> m_lruKeys {}; /// Keys of memory only entries: most recently used first
+		std::unordered_map<std::string, std::list<std::string>::iterator> m_lruPositions {};
+
+		std::mutex m_filesLock;
+		std::unordered_map<std::string, FileState> m_files {};
+	};
+}
\ No newline at end of file
@@ -0,0 +1,103 @@
+#pragma once
+
+#include <RG3/LLVM/CompilerConfigDetector.h>
+#include <RG3/LLVM/CompilerConfig.h>
+#include <RG3/LLVM/SharedFileCache.h>
+
+#include <unordered_map>
+#include <filesystem>
+#include <optional>
+#include <cstdint>
+#include <chrono>
+#include <atomic>
+#include <future>
+#include <string>
+#include <vector>
+#include <memory>
+#include <mutex>
+
+
+namespace rg3::llvm
+{
+	/**
+	 * @brief Builds (once per distinct CompilerConfig + CompilerEnvironment + list of headers) precompiled header from CompilerConfig::vPreambleHeaders.
+	 *        Every compiler instance created with same config loads this PCH instead of parsing these headers again.
+	 * @note PCH files stored in temporary directory of current process and removed when process exits.
+	 * @note Declarations of preamble headers are not collected by analyzer: preamble made for system & third party headers.
+	 * @note PCH is included implicitly before source, so CodeAnalyzer loads it only for translation units which include every preamble header themselves.
+	 * @note Size, mtime & content hash of every file read by PCH build are recorded. PCH is rebuilt when any of them changed.
+	 *       With SharedFileCache inputs are checked once per run (through cache), otherwise on every getOrBuild call.
+	 */
+	class PrecompiledHeaderCache
+	{
+	 public:
+		struct Stats
+		{
+			std::size_t iBuilt { 0 }; /// How much PCH files were built
+			std::size_t iFailed { 0 }; /// How much PCH builds failed
+			std::size_t iUses { 0 }; /// How much compiler instances used PCH
+			std::size_t iRebuilt { 0 }; /// How much PCH files were dropped because one of their inputs changed
+			std::chrono::nanoseconds buildTime { 0 }; /// Total time spent to build PCH files
+			std::chrono::nanoseconds estimatedSavedTime { 0 }; /// Preamble parse time which was not spent by compiler instances (estimation: time to build PCH per each use except first one)
+
+			[[nodiscard]] Stats since(const Stats& before) const;
+		};
+
+		struct InputRecord
+		{
+			std::string sPath {};
+			std::uintmax_t iFileSize { 0 };
+			std::int64_t iModificationTime { 0 };
+			std::uint64_t iContentHash { 0 };
+		};
+
+		struct BuildResult
+		{
+			std::optional<std::filesystem::path> sPCHPath {}; /// std::nullopt when build failed
+			std::string sError {};
+		};
+
+	 public:
+		static PrecompiledHeaderCache& getInstance();
+
+		~PrecompiledHeaderCache();
+
+		/**
+		 * @brief Find or build PCH for config. When same PCH requested from multiple threads at once only one thread builds it, others will wait.
+		 * @param config - compiler config (CompilerConfig::vPreambleHeaders must be not empty)
+		 * @param env - compiler environment
+		 * @param pFileSystem - shared file cache which will be used to build PCH (optional)
+		 */
+		BuildResult getOrBuild(const CompilerConfig& config, const CompilerEnvironment& env, ::llvm::IntrusiveRefCntPtr<SharedFileCache> pFileSystem = nullptr);
+
+		/**
+		 * @brief Remove all built PCH files
+		 */
+		void clear();
+
+		[[nodiscard]] Stats getStats() const;
+
+	 private:
+		PrecompiledHeaderCache() = default;
+
+		struct Entry
+		{
+			BuildResult result {};
+			std::chrono::nanoseconds buildTime { 0 };
+			std::vector<InputRecord> vInputs {}; /// Files read by PCH build
+			mutable std::atomic<std::uint64_t> iValidatedRunId { 0 }; /// Id of SharedFileCache (run) which last saw inputs unchanged (0 - none)
+		};
+
+		static bool areInputsUpToDate(const Entry& entry, SharedFileCache* pFileSystem);
+
+		std::shared_ptr<const Entry> build(const std::string& sKey, const CompilerConfig& config, const CompilerEnvironment& env, ::llvm::IntrusiveRefCntPtr<SharedFileCache> pFileSystem);
+		std::filesystem::path getWorkingDirectory();
+
+	 private:
+		mutable std::mutex m_lock;
+		std::unordered_map<std::string, std::shared_future<std::shared_ptr<const Entry>>> m_entries {};
+		std::optional<std::filesystem::path> m_workingDir {};
+		std::atomic<std::size_t> m_iBuildsCount { 0 };
+		Stats m_stats {};
+	};
+}
\ No newline at end of file
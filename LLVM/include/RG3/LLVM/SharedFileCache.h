@@ -0,0 +1,73 @@
+#pragma once
+
+#include <llvm/ADT/IntrusiveRefCntPtr.h>
+#include <llvm/ADT/StringMap.h>
+#include <llvm/Support/MemoryBuffer.h>
+#include <llvm/Support/VirtualFileSystem.h>
+
+#include <shared_mutex>
+#include <cstdint>
+#include <atomic>
+#include <memory>
+
+
+namespace rg3::llvm
+{
+	/**
+	 * @brief Thread safe stat & file content cache. Shared between all compiler instances of one analyze run.
+	 * @note Cache never re-validates entries: files are expected to stay unchanged while analyze in progress.
+	 *       Negative stat results are cached too (header search probes a lot of non-existing paths).
+	 */
+	class SharedFileCache final : public ::llvm::vfs::ProxyFileSystem
+	{
+	 public:
+		/**
+		 * @brief Content & status of file. Lives while cache alive, opened files just refer to the buffer.
+		 */
+		struct CachedFile
+		{
+			::llvm::vfs::Status status {};
+			std::unique_ptr<::llvm::MemoryBuffer> pBuffer { nullptr };
+		};
+
+		struct Stats
+		{
+			std::size_t iStatHits { 0 };
+			std::size_t iStatMisses { 0 };
+			std::size_t iReadHits { 0 };
+			std::size_t iReadMisses { 0 };
+			std::size_t iCachedBytes { 0 };
+		};
+
+		explicit SharedFileCache(::llvm::IntrusiveRefCntPtr<::llvm::vfs::FileSystem> pUnderlyingFS = ::llvm::vfs::getRealFileSystem());
+
+		::llvm::ErrorOr<::llvm::vfs::Status> status(const ::llvm::Twine& path) override;
+		::llvm::ErrorOr<std::unique_ptr<::llvm::vfs::File>> openFileForRead(const ::llvm::Twine& path) override;
+		bool exists(const ::llvm::Twine& path) override;
+
+		[[nodiscard]] Stats getStats() const;
+
+		/**
+		 * @brief Unique (within process) id of cache. Cache is made per analyze run, so id also identifies run.
+		 */
+		[[nodiscard]] std::uint64_t getId() const;
+
+	 private:
+		std::string makeKey(const ::llvm::Twine& path) const;
+
+	 private:
+		std::uint64_t m_iId { 0 };
+
+		mutable std::shared_mutex m_statLock;
+		::llvm::StringMap<::llvm::ErrorOr<::llvm::vfs::Status>> m_statCache {};
+
+		mutable std::shared_mutex m_contentLock;
+		::llvm::StringMap<std::shared_ptr<const CachedFile>> m_contentCache {};
+
+		std::atomic<std::size_t> m_iStatHits { 0 };
+		std::atomic<std::size_t> m_iStatMisses { 0 };
+		std::atomic<std::size_t> m_iReadHits { 0 };
+		std::atomic<std::size_t> m_iReadMisses { 0 };
+		std::atomic<std::size_t> m_iCachedBytes { 0 };
+	};
+}
\ No newline at end of file
@@ -0,0 +1,56 @@
+#pragma once
+
+#include <RG3/LLVM/CompilerConfig.h>
+
+#include <clang/Basic/SourceManager.h>
+#include <clang/AST/DeclBase.h>
+#include <llvm/Support/GlobPattern.h>
+
+#include <unordered_map>
+#include <filesystem>
+#include <vector>
+
+
+namespace rg3::llvm
+{
+	/**
+	 * @brief Decides which files are allowed to produce types (see CompilerConfig::eSourceFilter, vSourceAllowGlobs & vSourceDenyGlobs).
+	 *        Decision is made once per file (FileID) and memoized: CxxRouterVisitor prunes whole subtree of declaration from rejected file
+	 *        before comment lookup, tag parsing or any other visitor work.
+	 * @note Main file is always accepted. Globs are matched against absolute path with '/' separators. Invalid globs are ignored.
+	 */
+	class SourceFileFilter
+	{
+	 public:
+		SourceFileFilter(const CompilerConfig& compilerConfig, const clang::SourceManager& sourceManager);
+
+		/**
+		 * @brief Filter accepts every file (SF_ALL without globs): nothing to check
+		 */
+		[[nodiscard]] bool isPassThrough() const;
+
+		/**
+		 * @brief Should declaration and all its nested declarations be visited
+		 * @note Declarations without location (translation unit, implicit builtins) are always accepted
+		 */
+		bool isAccepted(const clang::Decl* pDecl);
+
+		/**
+		 * @brief Check included file (not main file, not system header) against mode & globs
+		 */
+		[[nodiscard]] bool isPathAccepted(const std::filesystem::path& path) const;
+
+	 private:
+		bool isFileAccepted(clang::FileID fileId) const;
+
+	 private:
+		const CompilerConfig& m_compilerConfig;
+		const clang::SourceManager& m_sourceManager;
+		std::vector<std::filesystem::path> m_vProjectDirs {};
+		std::vector<::llvm::GlobPattern> m_vAllowGlobs {};
+		std::vector<::llvm::GlobPattern> m_vDenyGlobs {};
+		std::unordered_map<unsigned, bool> m_decisions {}; /// FileID hash -> accepted
+		clang::FileID m_lastFileId {};
+		bool m_bLastDecision { true };
+	};
+}
\ No newline at end of file
@@ -3,6 +3,7 @@
 #include <clang/AST/RecursiveASTVisitor.h>
 #include <clang/AST/ASTConsumer.h>
 
+#include <RG3/LLVM/CommentTagsCache.h>
 #include <RG3/LLVM/CompilerConfig.h>
 #include <RG3/LLVM/Annotations.h>
 #include <RG3/Cpp/TypeClass.h>
@@ -15,7 +16,17 @@ namespace rg3::llvm::visitors
 	class CxxClassTypeVisitor : public clang::RecursiveASTVisitor<CxxClassTypeVisitor>
 	{
 	 public:
-		explicit CxxClassTypeVisitor(const CompilerConfig& cc);
+		/**
+		 * @param pTagsCache - memo of comment tags of translation unit (nullptr - every comment is parsed on lookup)
+		 */
+		explicit CxxClassTypeVisitor(const CompilerConfig& cc, CommentTagsCache* pTagsCache = nullptr);
+
+		/**
+		 * @brief Build type of single record without traversal of its subtree: fields & methods are taken from decl directly.
+		 *        Nested declarations are not touched (CxxRouterVisitor meets them during its own walk).
+		 * @return true when type was built (record is complete definition and could be collected)
+		 */
+		bool collect(clang::CXXRecordDecl* cxxRecordDecl);
 
 		bool VisitCXXRecordDecl(clang::CXXRecordDecl* cxxRecordDecl);
 		bool VisitFieldDecl(clang::FieldDecl* cxxFieldDecl);
@@ -46,5 +57,6 @@ namespace rg3::llvm::visitors
 
 	 private:
 		const CompilerConfig& compilerConfig;
+		CommentTagsCache* m_pTagsCache { nullptr };
 	};
 }
\ No newline at end of file
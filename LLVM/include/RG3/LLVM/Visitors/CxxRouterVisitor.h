@@ -3,10 +3,14 @@
 #include <clang/AST/RecursiveASTVisitor.h>
 #include <clang/AST/ASTConsumer.h>
 
+#include <RG3/LLVM/SourceFileFilter.h>
+#include <RG3/LLVM/CommentTagsCache.h>
 #include <RG3/LLVM/CompilerConfig.h>
 #include <RG3/LLVM/Annotations.h>
 #include <RG3/Cpp/TypeBase.h>
 
+#include <unordered_set>
+#include <cstdint>
 #include <vector>
 
 
@@ -14,19 +18,37 @@ namespace rg3::llvm::visitors
 {
 	/**
 	 * @brief This class handle all types and understand which visitor should handle this type.
-	 *
+	 * @note Router routes every declaration once (checked in every build, see getRevisitedDeclsCount). Builders don't walk nested declarations,
+	 *       except two cases which still traverse AST again: CxxTemplateSpecializationVisitor walks whole template definition of aliased
+	 *       specialization, and handleAnnotationBasedType builds type referenced by annotation which router could also meet on its own.
 	 */
 	class CxxRouterVisitor : public clang::RecursiveASTVisitor<CxxRouterVisitor>
 	{
 	 public:
-		CxxRouterVisitor(std::vector<rg3::cpp::TypeBasePtr>& vFoundTypes, const CompilerConfig& compilerConfig);
+		/**
+		 * @param pSourceFilter - declarations of files rejected by filter are not traversed (nullptr - traverse everything)
+		 * @param pTagsCache - memo of comment tags of translation unit shared by all builders (nullptr - no memo)
+		 */
+		CxxRouterVisitor(std::vector<rg3::cpp::TypeBasePtr>& vFoundTypes, const CompilerConfig& compilerConfig, SourceFileFilter* pSourceFilter = nullptr, CommentTagsCache* pTagsCache = nullptr);
+
+	 public: // traversal
+		bool TraverseDecl(clang::Decl* decl); // Prunes subtree of declaration which located in rejected file
 
 	 public: // visitors
 		bool VisitCXXRecordDecl(clang::CXXRecordDecl* cxxRecordDecl); // For C++ types (struct, class)
 		bool VisitEnumDecl(clang::EnumDecl* enumDecl); // For enumerations
 		bool VisitTypedefNameDecl(clang::TypedefNameDecl* typedefNameDecl); // For aliases (typedef, using)
 
+		[[nodiscard]] std::uint64_t getVisitedDeclsCount() const { return m_iVisitedDecls; }
+		[[nodiscard]] std::uint64_t getPrunedDeclsCount() const { return m_iPrunedDecls; }
+		[[nodiscard]] std::uint64_t getRevisitedDeclsCount() const { return m_iRevisitedDecls; }
+
 	 private:
+		/**
+		 * @brief Count visit of declaration: declaration visited twice means that its type is built twice
+		 */
+		void countVisit(const clang::Decl* pDecl);
+
 		bool handleAnnotationBasedType(const clang::Type* pType,
 									   const rg3::llvm::Annotations& annotation,
 									   const clang::ASTContext& ctx,
@@ -35,5 +57,11 @@ namespace rg3::llvm::visitors
 	 private:
 		const CompilerConfig& m_compilerConfig;
 		std::vector<rg3::cpp::TypeBasePtr>& m_vFoundTypes;
+		SourceFileFilter* m_pSourceFilter { nullptr };
+		CommentTagsCache* m_pTagsCache { nullptr };
+		std::uint64_t m_iVisitedDecls { 0 };
+		std::uint64_t m_iPrunedDecls { 0 };
+		std::uint64_t m_iRevisitedDecls { 0 };
+		std::unordered_set<const clang::Decl*> m_routedDecls {};
 	};
 }
\ No newline at end of file
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <clang/AST/RecursiveASTVisitor.h>
+#include <RG3/LLVM/CommentTagsCache.h>
 #include <RG3/LLVM/CompilerConfig.h>
 #include <RG3/Cpp/DefinitionLocation.h>
 #include <RG3/Cpp/CppNamespace.h>
@@ -47,7 +48,8 @@ namespace rg3::llvm::visitors
 										 clang::ClassTemplateSpecializationDecl* pTemplateSpecialization,
 										 bool bHasProperties, bool bHasFunctions,
 										 PropertyFilterFunc propertyFilterFunc,
-										 FunctionFilterFunc functionFilterFunc);
+										 FunctionFilterFunc functionFilterFunc,
+										 CommentTagsCache* pTagsCache = nullptr);
 
 		bool VisitCXXRecordDecl(clang::CXXRecordDecl* cxxRecordDecl);
 		bool VisitFieldDecl(clang::FieldDecl* cxxFieldDecl);
@@ -55,6 +57,11 @@ namespace rg3::llvm::visitors
 
 		const std::optional<SClassDefInfo>& getClassDefInfo() const;
 
+		/**
+		 * @brief Move collected definition out of visitor (definition must be presented, see getClassDefInfo)
+		 */
+		SClassDefInfo takeClassDefInfo();
+
 	 private:
 		bool tryResolveTemplateType(rg3::cpp::TypeStatement& stmt, const clang::Type* pOriginalType, clang::ASTContext& ctx) const;
 
@@ -67,5 +74,6 @@ namespace rg3::llvm::visitors
 		bool m_bHasFunctions;
 		PropertyFilterFunc m_propertyFilterFunc;
 		FunctionFilterFunc m_functionFilterFunc;
+		CommentTagsCache* m_pTagsCache { nullptr };
 	};
 }
\ No newline at end of file
@@ -5,6 +5,7 @@
 #include <clang/AST/ASTConsumer.h>
 #include <clang/AST/Decl.h>
 
+#include <RG3/LLVM/CommentTagsCache.h>
 #include <RG3/LLVM/CompilerConfig.h>
 #include <RG3/Cpp/TypeBase.h>
 
@@ -18,7 +19,13 @@ namespace rg3::llvm::visitors
 	class CxxTypeVisitor : public clang::RecursiveASTVisitor<CxxTypeVisitor>
 	{
 	 public:
-		CxxTypeVisitor(std::vector<rg3::cpp::TypeBasePtr>& collectedTypes, const CompilerConfig& cc);
+		CxxTypeVisitor(std::vector<rg3::cpp::TypeBasePtr>& collectedTypes, const CompilerConfig& cc, CommentTagsCache* pTagsCache = nullptr);
+
+		/**
+		 * @brief Build enum type without traversal: constants are taken from decl directly
+		 * @return true when type was collected
+		 */
+		bool collectEnum(clang::EnumDecl* enumDecl);
 
 		bool VisitEnumDecl(clang::EnumDecl* enumDecl);
 
@@ -48,5 +55,6 @@ namespace rg3::llvm::visitors
 		std::vector<rg3::cpp::TypeBasePtr>& m_collectedTypes;
 		std::vector<std::int64_t> m_collectedTypeIDs;
 		const CompilerConfig& compilerConfig;
+		CommentTagsCache* m_pTagsCache { nullptr };
 	};
 }
\ No newline at end of file
@@ -1,11 +1,52 @@
 #include <RG3/LLVM/Actions/ExtractTypesFromTU.h>
 #include <RG3/LLVM/Consumers/CollectTypesFromTU.h>
+#include <clang/Frontend/CompilerInstance.h>
+#include <clang/Lex/PPCallbacks.h>
+#include <clang/Lex/Preprocessor.h>
 
 
 namespace rg3::llvm::actions
 {
+	/**
+	 * @brief Checks cancel flag every time when preprocessor enters file. Raised flag produces fatal error: clang doesn't enter includes after it.
+	 */
+	class CancellationCallbacks final : public clang::PPCallbacks
+	{
+	 public:
+		CancellationCallbacks(clang::DiagnosticsEngine& diagnostics, const std::atomic_bool* pCancelled)
+			: m_diagnostics(diagnostics), m_pCancelled(pCancelled)
+		{
+		}
+
+		void FileChanged(clang::SourceLocation loc, FileChangeReason reason, clang::SrcMgr::CharacteristicKind /*fileType*/, clang::FileID /*prevFID*/) override
+		{
+			if (m_bReported || reason != FileChangeReason::EnterFile || !m_pCancelled->load(std::memory_order_relaxed))
+				return;
+
+			m_bReported = true;
+
+			const unsigned iDiagID = m_diagnostics.getCustomDiagID(clang::DiagnosticsEngine::Fatal, "%0");
+			m_diagnostics.Report(loc, iDiagID) << ::llvm::StringRef(ExtractTypesFromTUAction::kCancelledMessage.data(), ExtractTypesFromTUAction::kCancelledMessage.size());
+		}
+
+	 private:
+		clang::DiagnosticsEngine& m_diagnostics;
+		const std::atomic_bool* m_pCancelled { nullptr };
+		bool m_bReported { false };
+	};
+
+	bool ExtractTypesFromTUAction::BeginSourceFileAction(clang::CompilerInstance& compilerInstance)
+	{
+		if (pCancelled)
+		{
+			compilerInstance.getPreprocessor().addPPCallbacks(std::make_unique<CancellationCallbacks>(compilerInstance.getDiagnostics(), pCancelled));
+		}
+
+		return clang::ASTFrontendAction::BeginSourceFileAction(compilerInstance);
+	}
+
 	std::unique_ptr<clang::ASTConsumer> ExtractTypesFromTUAction::CreateASTConsumer(clang::CompilerInstance&, clang::StringRef)
 	{
-		return std::make_unique<consumers::CollectTypesFromTUConsumer>(foundTypes, compilerConfig);
+		return std::make_unique<consumers::CollectTypesFromTUConsumer>(foundTypes, compilerConfig, pStats, pCancelled);
 	}
 }
\ No newline at end of file
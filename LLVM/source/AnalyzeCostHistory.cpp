@@ -0,0 +1,163 @@
+#include <RG3/LLVM/AnalyzeCostHistory.h>
+#include <RG3/Cpp/FileUtils.h>
+
+#include <algorithm>
+#include <fstream>
+#include <sstream>
+#include <string_view>
+
+
+namespace rg3::llvm
+{
+	namespace cost_history_details
+	{
+		static constexpr std::string_view kHistoryMagic = "rg3-cost-history 1";
+	}
+
+	AnalyzeCostHistory::AnalyzeCostHistory(std::filesystem::path historyFile)
+		: m_historyFile(std::move(historyFile))
+	{
+	}
+
+	std::uint64_t AnalyzeCostHistory::estimateCost(const std::filesystem::path& header)
+	{
+		std::error_code ec;
+		const std::uintmax_t iFileSize = std::filesystem::file_size(header, ec);
+		if (ec)
+			return kMinHeaderCost;
+
+		std::uint64_t iIncludes = 0;
+
+		std::ifstream file { header };
+		std::string line {};
+
+		while (std::getline(file, line))
+		{
+			const auto iFirst = line.find_first_not_of(" \t");
+			if (iFirst == std::string::npos || line[iFirst] != '#')
+				continue;
+
+			const auto iDirective = line.find_first_not_of(" \t", iFirst + 1);
+			if (iDirective != std::string::npos && line.compare(iDirective, 7, "include") == 0)
+			{
+				++iIncludes;
+			}
+		}
+
+		return std::max<std::uint64_t>(iFileSize + iIncludes * kIncludeCost, kMinHeaderCost);
+	}
+
+	bool AnalyzeCostHistory::load()
+	{
+		std::lock_guard<std::mutex> guard { m_entriesLock };
+		m_entries.clear();
+		m_bDirty = false;
+
+		std::ifstream file { m_historyFile };
+		if (!file.is_open())
+			return false;
+
+		std::string line {};
+		if (!std::getline(file, line) || line != cost_history_details::kHistoryMagic)
+			return false;
+
+		while (std::getline(file, line))
+		{
+			// <nanoseconds> <path (rest of line)>
+			std::istringstream stream { line };
+			std::int64_t iDuration = 0;
+			std::string sPath {};
+
+			if (!(stream >> iDuration) || iDuration < 0)
+			{
+				m_entries.clear();
+				return false;
+			}
+
+			stream.get(); // separator
+			std::getline(stream, sPath);
+
+			if (sPath.empty())
+			{
+				m_entries.clear();
+				return false;
+			}
+
+			m_entries[sPath] = iDuration;
+		}
+
+		return true;
+	}
+
+	bool AnalyzeCostHistory::save()
+	{
+		std::lock_guard<std::mutex> guard { m_entriesLock };
+
+		if (!m_bDirty)
+			return true;
+
+		std::error_code ec;
+		if (m_historyFile.has_parent_path())
+		{
+			std::filesystem::create_directories(m_historyFile.parent_path(), ec);
+			if (ec)
+				return false;
+		}
+
+		std::ostringstream history {};
+		history << cost_history_details::kHistoryMagic << '\n';
+
+		for (const auto& [sPath, iDuration] : m_entries)
+		{
+			history << iDuration << ' ' << sPath << '\n';
+		}
+
+		// Concurrent runs will never see partially written file (last saved history wins)
+		if (!rg3::cpp::utils::writeFileAtomic(m_historyFile, history.str()))
+			return false;
+
+		m_bDirty = false;
+		return true;
+	}
+
+	std::optional<std::chrono::nanoseconds> AnalyzeCostHistory::find(const std::filesystem::path& header) const
+	{
+		const std::string sKey = rg3::cpp::utils::normalizePath(header).string();
+
+		std::lock_guard<std::mutex> guard { m_entriesLock };
+
+		if (auto it = m_entries.find(sKey); it != m_entries.end())
+		{
+			return std::chrono::nanoseconds(it->second);
+		}
+
+		return std::nullopt;
+	}
+
+	void AnalyzeCostHistory::record(const std::filesystem::path& header, std::chrono::nanoseconds duration)
+	{
+		const std::string sKey = rg3::cpp::utils::normalizePath(header).string();
+		const std::int64_t iDuration = std::max<std::int64_t>(duration.count(), 0);
+
+		std::lock_guard<std::mutex> guard { m_entriesLock };
+
+		auto [it, bInserted] = m_entries.try_emplace(sKey, iDuration);
+		if (!bInserted)
+		{
+			it->second = (it->second + iDuration) / 2;
+		}
+
+		m_bDirty = true;
+	}
+
+	std::size_t AnalyzeCostHistory::getEntriesCount() const
+	{
+		std::lock_guard<std::mutex> guard { m_entriesLock };
+		return m_entries.size();
+	}
+
+	const std::filesystem::path& AnalyzeCostHistory::getHistoryFile() const
+	{
+		return m_historyFile;
+	}
+}
\ No newline at end of file
@@ -0,0 +1,57 @@
+#include <RG3/LLVM/AnalyzeStats.h>
+
+#include <algorithm>
+
+#if defined(_WIN32)
+#	define WIN32_LEAN_AND_MEAN
+#	define NOMINMAX
+#	include <Windows.h>
+#	include <Psapi.h>
+#	pragma comment(lib, "Psapi.lib")
+#else
+#	include <sys/resource.h>
+#endif
+
+
+namespace rg3::llvm
+{
+	AnalyzeStats& AnalyzeStats::operator+=(const AnalyzeStats& other)
+	{
+		envDetectionTime += other.envDetectionTime;
+		preambleTime += other.preambleTime;
+		instanceCreationTime += other.instanceCreationTime;
+		parseTime += other.parseTime;
+		visitTime += other.visitTime;
+		totalTime += other.totalTime;
+
+		iTranslationUnits += other.iTranslationUnits;
+		iDeclsVisited += other.iDeclsVisited;
+		iDeclsPruned += other.iDeclsPruned;
+		iDeclsRevisited += other.iDeclsRevisited;
+		iTypesEmitted += other.iTypesEmitted;
+		iPeakRssGrowth = std::max(iPeakRssGrowth, other.iPeakRssGrowth);
+
+		return *this;
+	}
+
+	std::uint64_t AnalyzeStats::getProcessPeakRss()
+	{
+#if defined(_WIN32)
+		PROCESS_MEMORY_COUNTERS counters {};
+		if (GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters)))
+			return static_cast<std::uint64_t>(counters.PeakWorkingSetSize);
+
+		return 0;
+#else
+		struct rusage usage {};
+		if (getrusage(RUSAGE_SELF, &usage) != 0)
+			return 0;
+
+#	if defined(__APPLE__)
+		return static_cast<std::uint64_t>(usage.ru_maxrss); // bytes
+#	else
+		return static_cast<std::uint64_t>(usage.ru_maxrss) * 1024u; // kilobytes
+#	endif
+#endif
+	}
+}
\ No newline at end of file
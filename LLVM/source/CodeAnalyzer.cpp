@@ -5,11 +5,20 @@
 
 #include <RG3/LLVM/CompilerInstanceFactory.h>
 #include <RG3/LLVM/CompilerConfigDetector.h>
+#include <RG3/LLVM/PrecompiledHeaderCache.h>
 
 #include <RG3/Cpp/TypeClass.h>
+#include <RG3/Cpp/FileUtils.h>
 
+#include <clang/Frontend/Utils.h>
+
+#include <fmt/format.h>
+
+#include <unordered_map>
+#include <unordered_set>
 #include <algorithm>
 #include <utility>
+#include <chrono>
 
 
 namespace rg3::llvm
@@ -54,11 +63,66 @@ namespace rg3::llvm
 		m_env = env;
 	}
 
+	void CodeAnalyzer::setSharedFileCache(::llvm::IntrusiveRefCntPtr<SharedFileCache> pFileCache)
+	{
+		m_pFileCache = std::move(pFileCache);
+	}
+
+	void CodeAnalyzer::setCollectDependencies(bool bCollectDependencies)
+	{
+		m_bCollectDependencies = bCollectDependencies;
+	}
+
+	void CodeAnalyzer::setCancellationFlag(const std::atomic_bool* pCancelled)
+	{
+		m_pCancelled = pCancelled;
+	}
+
+	bool CodeAnalyzer::isCancelledResult(const AnalyzerResult& result)
+	{
+		return std::any_of(result.vIssues.begin(), result.vIssues.end(), [](const AnalyzerResult::CompilerIssue& issue) -> bool {
+			return issue.sMessage == actions::ExtractTypesFromTUAction::kCancelledMessage;
+		});
+	}
+
 	CompilerConfig& CodeAnalyzer::getCompilerConfig()
 	{
 		return m_compilerConfig;
 	}
 
+	/**
+	 * @brief Collects every file read by compiler (system headers & files from precompiled preamble too)
+	 */
+	class AllDependenciesCollector final : public clang::DependencyCollector
+	{
+	 public:
+		explicit AllDependenciesCollector(std::optional<std::filesystem::path> ignoredDirectory)
+			: clang::DependencyCollector(), m_ignoredDirectory(std::move(ignoredDirectory))
+		{
+		}
+
+		bool needSystemDependencies() override
+		{
+			return true;
+		}
+
+		bool sawDependency(::llvm::StringRef sFilename, bool bFromModule, bool bIsSystem, bool bIsModuleFile, bool bIsMissing) override
+		{
+			// In-memory source is not a file
+			if (sFilename == ::llvm::StringRef(CompilerInstanceFactory::kInMemoryInputName.data(), CompilerInstanceFactory::kInMemoryInputName.size()))
+				return false;
+
+			// Umbrella of precompiled preamble: temporary file, preamble headers are reported by themselves
+			if (m_ignoredDirectory.has_value() && std::filesystem::path(sFilename.str()).parent_path() == m_ignoredDirectory.value())
+				return false;
+
+			return clang::DependencyCollector::sawDependency(sFilename, bFromModule, bIsSystem, bIsModuleFile, bIsMissing);
+		}
+
+	 private:
+		std::optional<std::filesystem::path> m_ignoredDirectory {};
+	};
+
 	std::string sourceToString(const std::variant<std::filesystem::path, std::string>& src)
 	{
 		struct
@@ -80,20 +144,122 @@ namespace rg3::llvm
 		return v.repr;
 	};
 
+	/**
+	 * @brief Check that translation unit includes every preamble header itself. Precompiled preamble is included implicitly before source,
+	 *        so unit which does not include these headers would see declarations (and macros) which it never asked for.
+	 * @note Only top-level include directives are checked. Includes of umbrella translation unit are includes of its headers.
+	 */
+	static bool isPreambleIncluded(const std::variant<std::filesystem::path, std::string>& src, const std::vector<std::string>& vPreambleHeaders, ::llvm::vfs::FileSystem& fileSystem)
+	{
+		auto unquote = [](std::string_view sInclude) -> std::string_view {
+			if (sInclude.size() >= 2 && (sInclude.front() == '<' || sInclude.front() == '"'))
+			{
+				return sInclude.substr(1, sInclude.size() - 2);
+			}
+
+			return sInclude;
+		};
+
+		auto collectIncludesOfFile = [&fileSystem](const std::string& sPath, std::vector<std::string>& vIncludes) -> bool {
+			auto buffer = fileSystem.getBufferForFile(sPath, /*FileSize=*/-1, /*RequiresNullTerminator=*/false);
+			if (!buffer)
+				return false;
+
+			auto vFileIncludes = rg3::cpp::utils::collectIncludeDirectives(std::string_view(buffer.get()->getBufferStart(), buffer.get()->getBufferSize()));
+			vIncludes.insert(vIncludes.end(), std::make_move_iterator(vFileIncludes.begin()), std::make_move_iterator(vFileIncludes.end()));
+			return true;
+		};
+
+		std::vector<std::string> vIncludes {};
+
+		if (const auto* pSourcePath = std::get_if<std::filesystem::path>(&src))
+		{
+			if (!collectIncludesOfFile(pSourcePath->string(), vIncludes))
+				return false;
+		}
+		else
+		{
+			const auto vSourceIncludes = rg3::cpp::utils::collectIncludeDirectives(std::get<std::string>(src));
+			vIncludes = vSourceIncludes;
+
+			// Umbrella translation unit (see makeUmbrellaSource) includes headers by absolute path
+			for (const auto& sInclude : vSourceIncludes)
+			{
+				const std::string sPath { unquote(sInclude) };
+				if (sInclude.front() == '"' && std::filesystem::path(sPath).is_absolute())
+				{
+					collectIncludesOfFile(sPath, vIncludes);
+				}
+			}
+		}
+
+		std::unordered_set<std::string_view> includedHeaders {};
+		for (const auto& sInclude : vIncludes)
+		{
+			includedHeaders.insert(unquote(sInclude));
+		}
+
+		return std::all_of(vPreambleHeaders.begin(), vPreambleHeaders.end(), [&includedHeaders, &unquote](const std::string& sHeader) -> bool {
+			return includedHeaders.contains(unquote(sHeader));
+		});
+	}
+
 	AnalyzerResult CodeAnalyzer::analyze()
 	{
+		using Clock = std::chrono::steady_clock;
+
 		AnalyzerResult result;
+		result.stats.iTranslationUnits = 1;
+
+		const auto analyzeStartedAt = Clock::now();
+		const std::uint64_t iPeakRssBefore = AnalyzeStats::getProcessPeakRss();
+
+		auto finishStats = [&result, analyzeStartedAt, iPeakRssBefore]()
+		{
+			const std::uint64_t iPeakRssAfter = AnalyzeStats::getProcessPeakRss();
+
+			result.stats.totalTime = Clock::now() - analyzeStartedAt;
+			result.stats.iTypesEmitted = result.vFoundTypes.size();
+			result.stats.iPeakRssGrowth = iPeakRssAfter > iPeakRssBefore ? iPeakRssAfter - iPeakRssBefore : 0;
+		};
+
+		auto isCancelled = [this]() -> bool
+		{
+			return m_pCancelled && m_pCancelled->load(std::memory_order_relaxed);
+		};
+
+		auto makeCancelledResult = [&result, this, &finishStats]()
+		{
+			result.vFoundTypes.clear();
+
+			if (!isCancelledResult(result))
+			{
+				result.vIssues.emplace_back(AnalyzerResult::CompilerIssue { AnalyzerResult::CompilerIssue::IssueKind::IK_ERROR, sourceToString(m_source), 0, 0, std::string(actions::ExtractTypesFromTUAction::kCancelledMessage) });
+			}
+
+			finishStats();
+		};
+
+		if (isCancelled())
+		{
+			makeCancelledResult();
+			return result;
+		}
 
 		CompilerEnvironment* pCompilerEnv = nullptr;
 
 		// Run platform env detector
 		if (!m_env.has_value())
 		{
+			const auto envDetectionStartedAt = Clock::now();
 			const auto compilerEnvironment = CompilerConfigDetector::detectSystemCompilerEnvironment();
+			result.stats.envDetectionTime = Clock::now() - envDetectionStartedAt;
+
 			if (auto pEnvFailure = std::get_if<CompilerEnvError>(&compilerEnvironment))
 			{
 				// Fatal error
 				result.vIssues.emplace_back(AnalyzerResult::CompilerIssue { AnalyzerResult::CompilerIssue::IssueKind::IK_ERROR, sourceToString(m_source), 0, 0, pEnvFailure->message });
+				finishStats();
 				return result;
 			}
 
@@ -102,8 +268,30 @@ namespace rg3::llvm
 		}
 
 		pCompilerEnv = &m_env.value();
+
+		// Load (or build) precompiled preamble
+		std::optional<std::filesystem::path> sPreamblePCH {};
+		if (!m_compilerConfig.vPreambleHeaders.empty() && isPreambleIncluded(m_source, m_compilerConfig.vPreambleHeaders, m_pFileCache ? *m_pFileCache : *::llvm::vfs::getRealFileSystem()))
+		{
+			const auto preambleStartedAt = Clock::now();
+			auto preambleResult = PrecompiledHeaderCache::getInstance().getOrBuild(m_compilerConfig, *pCompilerEnv, m_pFileCache);
+			result.stats.preambleTime = Clock::now() - preambleStartedAt;
+
+			if (!preambleResult.sPCHPath.has_value())
+			{
+				// Not fatal: just parse everything as usual
+				result.vIssues.emplace_back(AnalyzerResult::CompilerIssue { AnalyzerResult::CompilerIssue::IssueKind::IK_INFO, sourceToString(m_source), 0, 0, fmt::format("RG3|Preamble disabled: {}", preambleResult.sError) });
+			}
+
+			sPreamblePCH = preambleResult.sPCHPath;
+		}
+
 		clang::CompilerInstance compilerInstance {};
-		CompilerInstanceFactory::makeInstance(&compilerInstance, m_source, m_compilerConfig, pCompilerEnv);
+		{
+			const auto instanceStartedAt = Clock::now();
+			CompilerInstanceFactory::makeInstance(&compilerInstance, m_source, m_compilerConfig, pCompilerEnv, m_pFileCache, sPreamblePCH);
+			result.stats.instanceCreationTime = Clock::now() - instanceStartedAt;
+		}
 
 		// Add diagnostics consumer
 		{
@@ -111,13 +299,123 @@ namespace rg3::llvm
 			compilerInstance.getDiagnostics().setClient(errorCollector.release(), false);
 		}
 
+		std::shared_ptr<AllDependenciesCollector> pDependenciesCollector { nullptr };
+		if (m_bCollectDependencies)
+		{
+			pDependenciesCollector = std::make_shared<AllDependenciesCollector>(sPreamblePCH.has_value() ? std::make_optional(sPreamblePCH->parent_path()) : std::nullopt);
+			compilerInstance.addDependencyCollector(pDependenciesCollector);
+		}
+
 		// Run actions
 		{
-			rg3::llvm::actions::ExtractTypesFromTUAction findTypesAction { result.vFoundTypes, m_compilerConfig };
+			const auto actionStartedAt = Clock::now();
+
+			rg3::llvm::actions::ExtractTypesFromTUAction findTypesAction { result.vFoundTypes, m_compilerConfig, &result.stats, m_pCancelled };
 			compilerInstance.ExecuteAction(findTypesAction);
+
+			// Visit is a part of action
+			result.stats.parseTime = std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - actionStartedAt) - result.stats.visitTime;
+		}
+
+		if (isCancelled())
+		{
+			// Partial result: translation unit was not parsed completely
+			makeCancelledResult();
+			return result;
+		}
+
+		if (pDependenciesCollector)
+		{
+			const auto vDependencies = pDependenciesCollector->getDependencies();
+			result.vDependencies.reserve(vDependencies.size());
+
+			for (const auto& sDependency : vDependencies)
+			{
+				result.vDependencies.emplace_back(rg3::cpp::utils::normalizePath(sDependency));
+			}
 		}
 
 		// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+		finishStats();
 		return result;
 	}
+
+	std::string CodeAnalyzer::makeUmbrellaSource(const std::vector<std::filesystem::path>& vHeaders)
+	{
+		std::string sSource {};
+		std::unordered_set<std::string> includedHeaders {};
+
+		for (const auto& header : vHeaders)
+		{
+			// Line N of umbrella is include of header N (see splitUmbrellaResult). Duplicate gives empty line.
+			if (includedHeaders.insert(rg3::cpp::utils::normalizePath(header).string()).second)
+			{
+				sSource.append(fmt::format("#include \"{}\"", std::filesystem::absolute(header).string()));
+			}
+
+			sSource.push_back('\n');
+		}
+
+		return sSource;
+	}
+
+	std::vector<AnalyzerResult> CodeAnalyzer::splitUmbrellaResult(AnalyzerResult&& umbrellaResult, const std::vector<std::filesystem::path>& vHeaders)
+	{
+		std::vector<AnalyzerResult> vResults {};
+		if (vHeaders.empty())
+			return vResults;
+
+		vResults.resize(vHeaders.size());
+
+		std::unordered_map<std::string, size_t> headerIndices {};
+		for (size_t i = 0; i < vHeaders.size(); ++i)
+		{
+			headerIndices.try_emplace(rg3::cpp::utils::normalizePath(vHeaders[i]).string(), i);
+		}
+
+		auto findHeaderIndex = [&headerIndices](const std::filesystem::path& location) -> size_t {
+			if (location.empty())
+				return 0;
+
+			auto it = headerIndices.find(rg3::cpp::utils::normalizePath(location).string());
+			return it != headerIndices.end() ? it->second : 0;
+		};
+
+		for (auto& issue : umbrellaResult.vIssues)
+		{
+			if (issue.sSourceFile == CompilerInstanceFactory::kInMemoryInputName)
+			{
+				// Issue of include directive: line is 1-based index of header
+				const size_t iHeaderIndex = std::clamp<size_t>(issue.iLine > 0 ? issue.iLine - 1 : 0, 0, vHeaders.size() - 1);
+
+				issue.sSourceFile = vHeaders[iHeaderIndex].string();
+				issue.iLine = 0;
+				issue.iColumn = 0;
+				vResults[iHeaderIndex].vIssues.emplace_back(std::move(issue));
+			}
+			else
+			{
+				vResults[findHeaderIndex(issue.sSourceFile)].vIssues.emplace_back(std::move(issue));
+			}
+		}
+
+		for (auto& type : umbrellaResult.vFoundTypes)
+		{
+			const size_t iHeaderIndex = findHeaderIndex(type->getDefinition().getFsLocation());
+			vResults[iHeaderIndex].vFoundTypes.emplace_back(std::move(type));
+		}
+
+		// Don't know which header included what: every header depends on everything what umbrella read
+		for (auto& headerResult : vResults)
+		{
+			headerResult.vDependencies = umbrellaResult.vDependencies;
+		}
+
+		vResults[0].stats = umbrellaResult.stats;
+
+		umbrellaResult.vIssues.clear();
+		umbrellaResult.vFoundTypes.clear();
+
+		return vResults;
+	}
 }
\ No newline at end of file
@@ -0,0 +1,47 @@
+#include <RG3/LLVM/CommentTagsCache.h>
+
+#include <clang/AST/ASTContext.h>
+#include <clang/AST/RawCommentList.h>
+
+
+namespace rg3::llvm
+{
+	const CommentTagsCache::Entry& CommentTagsCache::getEntry(const clang::Decl* pDecl)
+	{
+		if (auto it = m_entries.find(pDecl); it != m_entries.end())
+			return it->second;
+
+		return m_entries.emplace(pDecl, makeEntry(pDecl)).first->second;
+	}
+
+	CommentTagsCache::Entry CommentTagsCache::lookup(CommentTagsCache* pCache, const clang::Decl* pDecl)
+	{
+		if (pCache)
+			return pCache->getEntry(pDecl);
+
+		return makeEntry(pDecl);
+	}
+
+	CommentTagsCache::Entry CommentTagsCache::makeEntry(const clang::Decl* pDecl)
+	{
+		Entry entry {};
+
+		if (!pDecl)
+			return entry;
+
+		const clang::ASTContext& ctx = pDecl->getASTContext();
+		const clang::RawComment* rawComment = ctx.getRawCommentForDeclNoCache(pDecl);
+		if (!rawComment)
+			return entry;
+
+		const std::string rawCommentStr = rawComment->getFormattedText(ctx.getSourceManager(), ctx.getDiagnostics());
+		entry.bHasComment = !rawCommentStr.empty();
+		entry.vTags = cpp::Tag::parseFromCommentString(rawCommentStr);
+		return entry;
+	}
+
+	std::size_t CommentTagsCache::getEntriesCount() const
+	{
+		return m_entries.size();
+	}
+}
\ No newline at end of file
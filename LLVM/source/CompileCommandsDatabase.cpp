@@ -0,0 +1,203 @@
+#include <RG3/LLVM/CompileCommandsDatabase.h>
+
+#include <clang/Tooling/CompilationDatabase.h>
+#include <clang/Tooling/JSONCompilationDatabase.h>
+
+#include <algorithm>
+#include <string_view>
+#include <array>
+
+
+namespace rg3::llvm
+{
+	namespace compile_commands_details
+	{
+		/// Flags without value which are same for driver & compiler invocation and affect parsing
+		static constexpr std::array<std::string_view, 4> kPassThroughFlags = {
+			"-fms-extensions", "-fms-compatibility", "-fchar8_t", "-fno-char8_t"
+		};
+
+		/// Options of driver with separated value which must be dropped together with value
+		static constexpr std::array<std::string_view, 8> kDroppedOptionsWithValue = {
+			"-o", "-x", "-MF", "-MT", "-MQ", "-MJ", "-Xclang", "-Xlinker"
+		};
+
+		static std::optional<CxxStandard> parseStandard(std::string_view sValue)
+		{
+			for (std::string_view sPrefix : { "c++", "gnu++" })
+			{
+				if (sValue.substr(0, sPrefix.size()) != sPrefix)
+					continue;
+
+				const std::string_view sVersion = sValue.substr(sPrefix.size());
+
+				if (sVersion == "11" || sVersion == "0x") return CxxStandard::CC_11;
+				if (sVersion == "14" || sVersion == "1y") return CxxStandard::CC_14;
+				if (sVersion == "17" || sVersion == "1z") return CxxStandard::CC_17;
+				if (sVersion == "20" || sVersion == "2a") return CxxStandard::CC_20;
+				if (sVersion == "23" || sVersion == "2b") return CxxStandard::CC_23;
+				if (sVersion == "26" || sVersion == "2c") return CxxStandard::CC_26;
+			}
+
+			return std::nullopt;
+		}
+	}
+
+	CompileCommandsDatabase::CompileCommandsDatabase(std::filesystem::path databaseFile, std::unique_ptr<clang::tooling::CompilationDatabase>&& pDatabase, std::size_t iFilesCount)
+		: m_databaseFile(std::move(databaseFile))
+		, m_pDatabase(std::move(pDatabase))
+		, m_iFilesCount(iFilesCount)
+	{
+	}
+
+	CompileCommandsDatabase::~CompileCommandsDatabase() = default;
+
+	CompileCommandsDatabaseResult CompileCommandsDatabase::loadFromFile(const std::filesystem::path& databaseFile)
+	{
+		std::string sErrorMessage {};
+
+		auto pJsonDatabase = clang::tooling::JSONCompilationDatabase::loadFromFile(databaseFile.string(), sErrorMessage, clang::tooling::JSONCommandLineSyntax::AutoDetect);
+		if (!pJsonDatabase)
+		{
+			return CompileCommandsDatabaseError { sErrorMessage.empty() ? "Unable to load compilation database" : sErrorMessage };
+		}
+
+		const std::size_t iFilesCount = pJsonDatabase->getAllFiles().size();
+		if (iFilesCount == 0)
+		{
+			return CompileCommandsDatabaseError { "Compilation database has no commands" };
+		}
+
+		// Files which are not listed in database (headers) take command of the most similar listed file
+		auto pDatabase = clang::tooling::inferMissingCompileCommands(std::move(pJsonDatabase));
+
+		return std::shared_ptr<CompileCommandsDatabase>(new CompileCommandsDatabase(databaseFile, std::move(pDatabase), iFilesCount));
+	}
+
+	std::optional<CompilerConfig> CompileCommandsDatabase::getConfigForFile(const std::filesystem::path& file, const CompilerConfig& baseConfig) const
+	{
+		std::error_code ec;
+		const auto absolutePath = std::filesystem::absolute(file, ec);
+
+		const auto vCommands = m_pDatabase->getCompileCommands((ec ? file : absolutePath).lexically_normal().string());
+		if (vCommands.empty())
+			return std::nullopt;
+
+		// Several commands for same file (file is part of multiple targets): first one wins
+		const auto& command = vCommands.front();
+
+		CompilerConfig config = baseConfig;
+		applyCommandLine(config, command.CommandLine, command.Directory);
+
+		return config;
+	}
+
+	void CompileCommandsDatabase::applyCommandLine(CompilerConfig& config, const std::vector<std::string>& vCommandLine, const std::filesystem::path& workingDir)
+	{
+		auto makeAbsolute = [&workingDir](const std::string& sPath) -> std::filesystem::path {
+			const std::filesystem::path path { sPath };
+			return (path.is_absolute() ? path : workingDir / path).lexically_normal();
+		};
+
+		auto addInclude = [&config, &makeAbsolute](const std::string& sPath, IncludeKind eKind) {
+			const auto path = makeAbsolute(sPath);
+
+			const bool bKnown = std::any_of(config.vIncludes.begin(), config.vIncludes.end(), [&path](const IncludeInfo& include) {
+				return include.sFsLocation == path;
+			});
+
+			if (!bKnown)
+			{
+				config.vIncludes.emplace_back(path.string(), eKind);
+			}
+		};
+
+		// First argument is compiler executable
+		for (size_t i = 1; i < vCommandLine.size(); ++i)
+		{
+			const std::string& sArg = vCommandLine[i];
+
+			if (sArg == "--")
+				break; // Only inputs are left
+
+			// Value of option: joined ('-Ifoo') or separated ('-I foo')
+			std::string sValue {};
+			auto takeValue = [&](std::string_view sOption) -> bool {
+				if (sArg == sOption)
+				{
+					if (i + 1 >= vCommandLine.size())
+						return false;
+
+					sValue = vCommandLine[++i];
+					return true;
+				}
+
+				if (sArg.size() > sOption.size() && std::string_view(sArg).substr(0, sOption.size()) == sOption)
+				{
+					sValue = sArg.substr(sOption.size());
+					return true;
+				}
+
+				return false;
+			};
+
+			if (takeValue("-isystem") || takeValue("-idirafter"))
+			{
+				addInclude(sValue, IncludeKind::IK_SYSTEM);
+			}
+			else if (takeValue("-iquote") || takeValue("-I"))
+			{
+				addInclude(sValue, IncludeKind::IK_PROJECT);
+			}
+			else if (takeValue("-D"))
+			{
+				if (std::find(config.vCompilerDefs.begin(), config.vCompilerDefs.end(), sValue) == config.vCompilerDefs.end())
+				{
+					config.vCompilerDefs.emplace_back(std::move(sValue));
+				}
+			}
+			else if (takeValue("-U"))
+			{
+				config.vCompilerArgs.emplace_back("-U" + sValue);
+			}
+			else if (sArg == "-include" || sArg == "-imacros")
+			{
+				if (i + 1 < vCommandLine.size())
+				{
+					config.vCompilerArgs.emplace_back(sArg);
+					config.vCompilerArgs.emplace_back(makeAbsolute(vCommandLine[++i]).string());
+				}
+			}
+			else if (takeValue("-std="))
+			{
+				if (auto standard = compile_commands_details::parseStandard(sValue))
+				{
+					config.cppStandard = standard.value();
+				}
+			}
+			else if (std::find(compile_commands_details::kPassThroughFlags.begin(), compile_commands_details::kPassThroughFlags.end(), sArg) != compile_commands_details::kPassThroughFlags.end())
+			{
+				if (std::find(config.vCompilerArgs.begin(), config.vCompilerArgs.end(), sArg) == config.vCompilerArgs.end())
+				{
+					config.vCompilerArgs.emplace_back(sArg);
+				}
+			}
+			else if (std::find(compile_commands_details::kDroppedOptionsWithValue.begin(), compile_commands_details::kDroppedOptionsWithValue.end(), sArg) != compile_commands_details::kDroppedOptionsWithValue.end())
+			{
+				++i; // drop value too
+			}
+
+			// Everything else (inputs, warnings, optimization, codegen & target flags of driver) doesn't affect collected types
+		}
+	}
+
+	std::size_t CompileCommandsDatabase::getFilesCount() const
+	{
+		return m_iFilesCount;
+	}
+
+	const std::filesystem::path& CompileCommandsDatabase::getDatabaseFile() const
+	{
+		return m_databaseFile;
+	}
+}
\ No newline at end of file
@@ -1,4 +1,17 @@
 #include <RG3/LLVM/CompilerConfigDetector.h>
+#include <RG3/LLVM/CompilerEnvironmentCache.h>
+#include <RG3_Config.h> /// Auto-generated by CMake
+
+#include <clang/Basic/Diagnostic.h>
+#include <clang/Basic/DiagnosticOptions.h>
+#include <clang/Basic/Version.h>
+#include <clang/Driver/Compilation.h>
+#include <clang/Driver/Driver.h>
+#include <clang/Driver/Job.h>
+#include <clang/Driver/Tool.h>
+#include <clang/Frontend/TextDiagnosticBuffer.h>
+#include <llvm/Support/VirtualFileSystem.h>
+#include <llvm/TargetParser/Host.h>
 
 #include <boost/algorithm/string.hpp>
 #include <boost/process.hpp>
@@ -6,6 +19,9 @@
 
 #include <fmt/format.h>
 
+#include <optional>
+#include <array>
+
 
 
 namespace rg3::llvm
@@ -306,7 +322,61 @@ namespace rg3::llvm
 		return std::nullopt;
 	}
 
-	CompilerEnvResult CompilerConfigDetector::detectSystemCompilerEnvironment()
+#if defined(__APPLE__)
+	/**
+	 * @brief Override found paths. Use isysroot as base path and compile three paths:
+	 * ${ISYSROOT}/usr/include/c++/v1
+	 * ${ISYSROOT}/usr/include
+	 * ${ISYSROOT}/System/Library/Frameworks/Kernel.framework/Versions/A/Headers
+	 */
+	std::optional<CompilerEnvError> applyAppleSysrootLayout(CompilerEnvironment& compilerEnvironment)
+	{
+		const auto& incs = compilerEnvironment.config.vSystemIncludes;
+		if (auto it = std::find_if(incs.begin(), incs.end(), [](const rg3::llvm::IncludeInfo& ii) -> bool { return ii.eKind == rg3::llvm::IncludeKind::IK_SYSROOT; }); it != incs.end())
+		{
+			const auto basePath = it->sFsLocation;
+
+			compilerEnvironment.config.vSystemIncludes = {
+				rg3::llvm::IncludeInfo { basePath / "usr" / "include" / "c++" / "v1", rg3::llvm::IncludeKind::IK_SYSTEM },
+				rg3::llvm::IncludeInfo { basePath / "usr" / "include", rg3::llvm::IncludeKind::IK_SYSTEM },
+				rg3::llvm::IncludeInfo { basePath / "System" / "Library" / "Frameworks" / "Kernel.framework" / "Versions" / "A" / "Headers", rg3::llvm::IncludeKind::IK_SYSTEM }
+			};
+
+			return std::nullopt;
+		}
+
+		return CompilerEnvError { "No sysroot found on macOS!", rg3::llvm::CompilerEnvError::ErrorKind::EK_BAD_CLANG_OUTPUT };
+	}
+#endif
+
+	/**
+	 * @brief Find version line of compiler (like 'gcc version 13.2.0 (...)' or 'clang version 18.1.0 (...)') in verbose output
+	 */
+	static std::string findCompilerVersionString(const std::string& response)
+	{
+		constexpr std::array<std::string_view, 2> kVersionMarkers = { "gcc version ", "clang version " };
+
+		for (const auto& marker : kVersionMarkers)
+		{
+			auto it = response.find(marker);
+			if (it == std::string::npos)
+				continue;
+
+			// Take whole line (with vendor prefix like 'Apple clang version' or 'Ubuntu clang version')
+			const auto lineStart = response.rfind('\n', it);
+			const auto lineEnd = response.find('\n', it);
+			const auto startPos = (lineStart == std::string::npos) ? 0 : lineStart + 1;
+
+			std::string versionLine = response.substr(startPos, (lineEnd == std::string::npos ? response.length() : lineEnd) - startPos);
+			boost::algorithm::trim(versionLine);
+
+			return versionLine;
+		}
+
+		return {};
+	}
+
+	CompilerEnvResult CompilerConfigDetector::detectSystemCompilerEnvironment(bool bUseCache)
 	{
 #if defined(_WIN32)
 		constexpr const char* kCompilerInstanceExecutable = "clang++.exe";
@@ -352,6 +422,20 @@ namespace rg3::llvm
 			};
 		}
 
+#if defined(__APPLE__)
+		const std::optional<CompilerEnvironmentCache::Key> cacheKey = CompilerEnvironmentCache::Key::makeForCompiler("/usr/bin/clang++");
+#else
+		const std::optional<CompilerEnvironmentCache::Key> cacheKey = CompilerEnvironmentCache::Key::makeForCompiler(compilerLocation.string());
+#endif
+
+		if (bUseCache && cacheKey.has_value())
+		{
+			if (auto cachedEnvironment = CompilerEnvironmentCache::getInstance().find(cacheKey.value()); cachedEnvironment.has_value())
+			{
+				return std::move(cachedEnvironment.value());
+			}
+		}
+
 #if defined(_WIN32)
 		const std::string response = runShellCommand(compilerLocation, { "''", "|", kCompilerInstanceExecutable, "-x", "c++-header", "-v", "-E", "-" });
 #elif defined(__linux__)
@@ -377,6 +461,8 @@ namespace rg3::llvm
 			return parseResult.value();
 		}
 
+		compilerEnvironment.versionString = findCompilerVersionString(response);
+
 		if (compilerEnvironment.triple.empty())
 		{
 #if defined(__linux__)
@@ -384,7 +470,8 @@ namespace rg3::llvm
 			constexpr std::string_view sTargetDecl = "--target=";
 			if (auto it = response.find(sTargetDecl.data()); it != std::string::npos)
 			{
-				auto nextSpaceIt = response.find(' ', it);
+				// Triple could be last token of line (gcc prints '--target=x86_64-linux-gnu\nThread model: posix')
+				auto nextSpaceIt = response.find_first_of(" \t\r\n", it);
 				const int predictedLength = std::min(static_cast<int>(response.length() - it), static_cast<int>(nextSpaceIt  - (it + sTargetDecl.length())));
 				compilerEnvironment.triple = response.substr(it + sTargetDecl.length(), predictedLength);
 			}
@@ -392,28 +479,158 @@ namespace rg3::llvm
 		}
 
 #if defined(__APPLE__)
-		// Override found paths. Use isysroot as base path and compile three paths:
-		// ${ISYSROOT}/usr/include/c++/v1
-		// ${ISYSROOT}/usr/include
-		// ${ISYSROOT}/System/Library/Frameworks/Kernel.framework/Versions/A/Headers
-		const auto& incs = compilerEnvironment.config.vSystemIncludes;
-		if (auto it = std::find_if(incs.begin(), incs.end(), [](const rg3::llvm::IncludeInfo& ii) -> bool { return ii.eKind == rg3::llvm::IncludeKind::IK_SYSROOT; }); it != incs.end())
+		if (auto sysrootError = applyAppleSysrootLayout(compilerEnvironment); sysrootError.has_value())
 		{
-			const auto basePath = it->sFsLocation;
+			return sysrootError.value();
+		}
+#endif
 
-			compilerEnvironment.config.vSystemIncludes = {
-				rg3::llvm::IncludeInfo { basePath / "usr" / "include" / "c++" / "v1", rg3::llvm::IncludeKind::IK_SYSTEM },
-				rg3::llvm::IncludeInfo { basePath / "usr" / "include", rg3::llvm::IncludeKind::IK_SYSTEM },
-				rg3::llvm::IncludeInfo { basePath / "System" / "Library" / "Frameworks" / "Kernel.framework" / "Versions" / "A" / "Headers", rg3::llvm::IncludeKind::IK_SYSTEM }
+		// Everything is ok, remember & return env
+		if (cacheKey.has_value())
+		{
+			CompilerEnvironmentCache::getInstance().store(cacheKey.value(), compilerEnvironment);
+		}
+
+		return compilerEnvironment;
+	}
+
+	CompilerEnvResult CompilerConfigDetector::detectCompilerEnvironmentInProcess(const InProcessDetectorOptions& options)
+	{
+		// Driver will report about problems (unknown toolchain, bad triple and etc) through diagnostics
+		::llvm::IntrusiveRefCntPtr<clang::DiagnosticOptions> pDiagOptions = new clang::DiagnosticOptions();
+		clang::TextDiagnosticBuffer diagBuffer {};
+		clang::DiagnosticsEngine diagnostics {
+			::llvm::IntrusiveRefCntPtr<clang::DiagnosticIDs>(new clang::DiagnosticIDs()),
+			pDiagOptions,
+			&diagBuffer,
+			false
+		};
+
+		const std::string sTriple = options.sTriple.empty() ? ::llvm::sys::getDefaultTargetTriple() : options.sTriple;
+		const std::filesystem::path sResourceDir = options.sResourceDir.empty() ? std::filesystem::path(RG3_CLANG_RESOURCE_DIR) : options.sResourceDir;
+
+		// Name of executable selects C++ driver mode, it's not required to exist
+		clang::driver::Driver driver { "clang++", sTriple, diagnostics, "rg3 environment detector", ::llvm::vfs::getRealFileSystem() };
+		driver.ResourceDir = sResourceDir.string();
+		driver.setCheckInputsExist(false);
+
+		std::vector<std::string> vDriverArgs { "clang++", "--driver-mode=g++", "-x", "c++-header", "-fsyntax-only" };
+		if (!options.sGccToolchain.empty())
+		{
+			vDriverArgs.emplace_back(fmt::format("--gcc-toolchain={}", options.sGccToolchain.string()));
+		}
+
+		vDriverArgs.emplace_back("rg3_env_probe.hpp");
+
+		std::vector<const char*> vDriverArgsRaw {};
+		vDriverArgsRaw.reserve(vDriverArgs.size());
+
+		for (const auto& arg : vDriverArgs)
+		{
+			vDriverArgsRaw.emplace_back(arg.c_str());
+		}
+
+		std::unique_ptr<clang::driver::Compilation> pCompilation { driver.BuildCompilation(vDriverArgsRaw) };
+		if (!pCompilation || diagnostics.hasErrorOccurred())
+		{
+			std::string sMessage = "Failed to build compilation";
+			if (diagBuffer.err_begin() != diagBuffer.err_end())
+			{
+				sMessage = fmt::format("{}: {}", sMessage, diagBuffer.err_begin()->second);
+			}
+
+			return CompilerEnvError { sMessage, CompilerEnvError::ErrorKind::EK_NO_CLANG_INSTANCE };
+		}
+
+		// With -fsyntax-only there is only one job: clang -cc1. Its arguments contain everything what ToolChain computed for us.
+		const clang::driver::Command* pFrontendCommand = nullptr;
+		for (const auto& job : pCompilation->getJobs())
+		{
+			if (std::string_view(job.getCreator().getName()) == "clang")
+			{
+				pFrontendCommand = &job;
+				break;
+			}
+		}
+
+		if (!pFrontendCommand)
+		{
+			return CompilerEnvError { "Driver did not produce frontend job", CompilerEnvError::ErrorKind::EK_BAD_CLANG_OUTPUT };
+		}
+
+		CompilerEnvironment compilerEnvironment {};
+		compilerEnvironment.versionString = clang::getClangFullVersion();
+		compilerEnvironment.triple = sTriple;
+
+		struct ArgInfo { std::string_view name {}; IncludeKind kind {}; };
+
+		constexpr std::array<ArgInfo, 4> kIncludeArgs {
+			ArgInfo { "-isysroot", IncludeKind::IK_SYSROOT },
+			ArgInfo { "-isystem", IncludeKind::IK_SYSTEM },
+			ArgInfo { "-internal-isystem", IncludeKind::IK_SYSTEM },
+			ArgInfo { "-internal-externc-isystem", IncludeKind::IK_C_SYSTEM }
+		};
+
+		const auto& vFrontendArgs = pFrontendCommand->getArguments();
+		for (size_t i = 0; i < vFrontendArgs.size(); ++i)
+		{
+			const std::string_view arg { vFrontendArgs[i] };
+			const bool bHasValue = (i + 1) < vFrontendArgs.size();
+
+			if (arg == "-triple" && bHasValue)
+			{
+				compilerEnvironment.triple = vFrontendArgs[++i];
+				continue;
+			}
+
+#ifdef __APPLE__
+			constexpr std::string_view sGNUCVersionDecl = "-fgnuc-version=";
+			constexpr std::string_view sTargetSDKVersionDecl = "-target-sdk-version=";
+
+			if (arg.starts_with(sGNUCVersionDecl))
+			{
+				compilerEnvironment.macOS_GNUC_Version = arg.substr(sGNUCVersionDecl.length());
+				continue;
+			}
+
+			if (arg.starts_with(sTargetSDKVersionDecl))
+			{
+				compilerEnvironment.macOS_TargetSDK_Version = arg.substr(sTargetSDKVersionDecl.length());
+				continue;
+			}
+#endif
+
+			auto includeArgIt = std::find_if(kIncludeArgs.begin(), kIncludeArgs.end(), [&arg](const ArgInfo& info) -> bool { return info.name == arg; });
+			if (includeArgIt != kIncludeArgs.end() && bHasValue)
+			{
+				rg3::llvm::IncludeInfo& ii = compilerEnvironment.config.vSystemIncludes.emplace_back();
+				ii.sFsLocation = std::filesystem::path { vFrontendArgs[++i] };
+				ii.eKind = includeArgIt->kind;
+				ii.bIsMacOSFramework = false;
+			}
+		}
+
+		// Without builtin headers (stddef.h, stdarg.h and etc) almost nothing could be parsed
+		if (!std::filesystem::is_directory(sResourceDir / "include"))
+		{
+			return CompilerEnvError {
+				fmt::format("Clang resource dir '{}' not found. Please, specify resource dir or use system compiler detection", sResourceDir.string()),
+				CompilerEnvError::ErrorKind::EK_NO_SYSTEM_INCLUDE_DIRS_FOUND
 			};
 		}
-		else
+
+		if (compilerEnvironment.config.vSystemIncludes.empty())
+		{
+			return CompilerEnvError { "System includes not found", CompilerEnvError::ErrorKind::EK_NO_SYSTEM_INCLUDE_DIRS_FOUND };
+		}
+
+#if defined(__APPLE__)
+		if (auto sysrootError = applyAppleSysrootLayout(compilerEnvironment); sysrootError.has_value())
 		{
-			return CompilerEnvError { "No sysroot found on macOS!", rg3::llvm::CompilerEnvError::ErrorKind::EK_BAD_CLANG_OUTPUT };
+			return sysrootError.value();
 		}
 #endif
 
-		// Everything is ok, return env
 		return compilerEnvironment;
 	}
 }
\ No newline at end of file
@@ -0,0 +1,371 @@
+#include <RG3/LLVM/CompilerEnvironmentCache.h>
+#include <RG3/Cpp/HashUtils.h>
+#include <RG3/Cpp/FileUtils.h>
+#include <RG3_Config.h> /// Auto-generated by CMake
+
+#include <fmt/format.h>
+
+#include <functional>
+#include <fstream>
+#include <sstream>
+#include <cstdlib>
+#include <array>
+
+
+namespace rg3::llvm
+{
+	namespace cache_details
+	{
+		/// Increment when format of on-disk entry changed
+		static constexpr int kEntryFormatVersion = 1;
+		static constexpr std::string_view kEntryMagic = "rg3-compiler-env";
+		static constexpr std::string_view kEntryExtension = ".env";
+
+		/// Variables which change search paths or target of compiler
+		static constexpr std::array<const char*, 9> kRelevantEnvVars = {
+			"CPATH", "C_INCLUDE_PATH", "CPLUS_INCLUDE_PATH", "GCC_EXEC_PREFIX", "COMPILER_PATH",
+			"SDKROOT", "DEVELOPER_DIR", "MACOSX_DEPLOYMENT_TARGET", "INCLUDE"
+		};
+
+		static std::optional<std::string> getEnv(const char* name)
+		{
+			const char* value = std::getenv(name); // NOLINT(*-mt-unsafe)
+			if (value == nullptr)
+				return std::nullopt;
+
+			return std::string(value);
+		}
+
+		static std::optional<std::filesystem::path> resolveDefaultCacheDirectory()
+		{
+			if (getEnv("RG3_NO_DISK_CACHE").has_value())
+				return std::nullopt;
+
+			if (auto dir = getEnv("RG3_CACHE_DIR"); dir.has_value() && !dir->empty())
+				return std::filesystem::path(dir.value());
+
+#if defined(_WIN32)
+			if (auto dir = getEnv("LOCALAPPDATA"); dir.has_value() && !dir->empty())
+				return std::filesystem::path(dir.value()) / "rg3";
+#else
+			if (auto dir = getEnv("XDG_CACHE_HOME"); dir.has_value() && !dir->empty())
+				return std::filesystem::path(dir.value()) / "rg3";
+
+			if (auto dir = getEnv("HOME"); dir.has_value() && !dir->empty())
+				return std::filesystem::path(dir.value()) / ".cache" / "rg3";
+#endif
+
+			return std::nullopt;
+		}
+
+		static std::string serialize(const CompilerEnvironmentCache::Key& key, const CompilerEnvironment& env)
+		{
+			std::ostringstream out;
+
+			out << kEntryMagic << ' ' << kEntryFormatVersion << '\n';
+			out << "build " << RG3_BUILD_HASH << '\n';
+			out << "compiler " << key.sCompilerPath.string() << '\n';
+			out << "mtime " << key.iModificationTime << '\n';
+			out << "size " << key.iFileSize << '\n';
+
+			for (const auto& [name, value] : key.vEnvironment)
+			{
+				out << "env " << name << '=' << value << '\n';
+			}
+
+			out << "triple " << env.triple << '\n';
+			out << "options " << env.options << '\n';
+			out << "version " << env.versionString << '\n';
+#ifdef __APPLE__
+			out << "gnuc " << env.macOS_GNUC_Version << '\n';
+			out << "sdk " << env.macOS_TargetSDK_Version << '\n';
+#endif
+
+			for (const auto& inc : env.config.vSystemIncludes)
+			{
+				out << "include " << static_cast<int>(inc.eKind) << ' ' << (inc.bIsMacOSFramework ? 1 : 0) << ' ' << inc.sFsLocation.string() << '\n';
+			}
+
+			return out.str();
+		}
+
+		/**
+		 * @brief Parse on-disk entry
+		 * @return pair of stored key & environment or std::nullopt when entry malformed or produced by another build of RG3
+		 */
+		static std::optional<std::pair<CompilerEnvironmentCache::Key, CompilerEnvironment>> deserialize(std::istream& in)
+		{
+			CompilerEnvironmentCache::Key key {};
+			CompilerEnvironment env {};
+			std::string line {};
+
+			// Header
+			if (!std::getline(in, line) || line != fmt::format("{} {}", kEntryMagic, kEntryFormatVersion))
+				return std::nullopt;
+
+			if (!std::getline(in, line) || line != fmt::format("build {}", RG3_BUILD_HASH))
+				return std::nullopt;
+
+			while (std::getline(in, line))
+			{
+				const auto spacePos = line.find(' ');
+				if (spacePos == std::string::npos)
+					return std::nullopt;
+
+				const std::string_view field { line.data(), spacePos };
+				const std::string value = line.substr(spacePos + 1);
+
+				if (field == "compiler")
+				{
+					key.sCompilerPath = value;
+				}
+				else if (field == "mtime")
+				{
+					key.iModificationTime = std::stoll(value);
+				}
+				else if (field == "size")
+				{
+					key.iFileSize = std::stoull(value);
+				}
+				else if (field == "env")
+				{
+					const auto eqPos = value.find('=');
+					if (eqPos == std::string::npos)
+						return std::nullopt;
+
+					key.vEnvironment.emplace_back(value.substr(0, eqPos), value.substr(eqPos + 1));
+				}
+				else if (field == "triple")
+				{
+					env.triple = value;
+				}
+				else if (field == "options")
+				{
+					env.options = value;
+				}
+				else if (field == "version")
+				{
+					env.versionString = value;
+				}
+#ifdef __APPLE__
+				else if (field == "gnuc")
+				{
+					env.macOS_GNUC_Version = value;
+				}
+				else if (field == "sdk")
+				{
+					env.macOS_TargetSDK_Version = value;
+				}
+#endif
+				else if (field == "include")
+				{
+					// <kind> <is framework> <path>
+					const auto kindEnd = value.find(' ');
+					if (kindEnd == std::string::npos || kindEnd + 3 > value.size())
+						return std::nullopt;
+
+					IncludeInfo& inc = env.config.vSystemIncludes.emplace_back();
+					inc.eKind = static_cast<IncludeKind>(std::stoi(value.substr(0, kindEnd)));
+					inc.bIsMacOSFramework = value[kindEnd + 1] == '1';
+					inc.sFsLocation = value.substr(kindEnd + 3);
+				}
+				else
+				{
+					return std::nullopt;
+				}
+			}
+
+			return std::make_pair(std::move(key), std::move(env));
+		}
+	}
+
+	std::optional<CompilerEnvironmentCache::Key> CompilerEnvironmentCache::Key::makeForCompiler(const std::filesystem::path& compilerPath)
+	{
+		std::error_code ec;
+		Key key {};
+
+		key.sCompilerPath = std::filesystem::canonical(compilerPath, ec);
+		if (ec)
+			return std::nullopt;
+
+		key.iFileSize = std::filesystem::file_size(key.sCompilerPath, ec);
+		if (ec)
+			return std::nullopt;
+
+		const auto writeTime = std::filesystem::last_write_time(key.sCompilerPath, ec);
+		if (ec)
+			return std::nullopt;
+
+		key.iModificationTime = static_cast<std::int64_t>(writeTime.time_since_epoch().count());
+
+		for (const char* envVar : cache_details::kRelevantEnvVars)
+		{
+			if (auto value = cache_details::getEnv(envVar); value.has_value())
+			{
+				key.vEnvironment.emplace_back(envVar, std::move(value.value()));
+			}
+		}
+
+		return key;
+	}
+
+	std::string CompilerEnvironmentCache::Key::getDigest() const
+	{
+		std::size_t seed = 0x0;
+		rg3::cpp::utils::hashCombine(seed, sCompilerPath.string(), iModificationTime, iFileSize, std::string(RG3_BUILD_HASH));
+
+		for (const auto& [name, value] : vEnvironment)
+		{
+			rg3::cpp::utils::hashCombine(seed, name, value);
+		}
+
+		return fmt::format("{:016x}", seed);
+	}
+
+	CompilerEnvironmentCache& CompilerEnvironmentCache::getInstance()
+	{
+		static CompilerEnvironmentCache s_instance {};
+		return s_instance;
+	}
+
+	CompilerEnvironmentCache::CompilerEnvironmentCache()
+		: m_diskCacheDir(cache_details::resolveDefaultCacheDirectory())
+	{
+	}
+
+	std::optional<CompilerEnvironment> CompilerEnvironmentCache::find(const Key& key)
+	{
+		std::lock_guard<std::mutex> guard { m_lock };
+
+		const std::string digest = key.getDigest();
+		if (auto it = m_entries.find(digest); it != m_entries.end() && it->second.first == key)
+		{
+			++m_stats.iMemoryHits;
+			return it->second.second;
+		}
+
+		if (auto env = loadFromDisk(key); env.has_value())
+		{
+			++m_stats.iDiskHits;
+			m_entries.insert_or_assign(digest, std::make_pair(key, env.value()));
+			return env;
+		}
+
+		++m_stats.iMisses;
+		return std::nullopt;
+	}
+
+	void CompilerEnvironmentCache::store(const Key& key, const CompilerEnvironment& env)
+	{
+		std::lock_guard<std::mutex> guard { m_lock };
+
+		m_entries.insert_or_assign(key.getDigest(), std::make_pair(key, env));
+		storeOnDisk(key, env);
+	}
+
+	void CompilerEnvironmentCache::invalidate()
+	{
+		std::lock_guard<std::mutex> guard { m_lock };
+
+		m_stats.iInvalidated += m_entries.size();
+		m_entries.clear();
+
+		if (!m_diskCacheDir.has_value())
+			return;
+
+		std::error_code ec;
+		for (const auto& entry : std::filesystem::directory_iterator(m_diskCacheDir.value(), ec))
+		{
+			if (entry.path().extension() == cache_details::kEntryExtension)
+			{
+				std::filesystem::remove(entry.path(), ec);
+				++m_stats.iInvalidated;
+			}
+		}
+	}
+
+	void CompilerEnvironmentCache::setDiskCacheDirectory(const std::optional<std::filesystem::path>& directory)
+	{
+		std::lock_guard<std::mutex> guard { m_lock };
+		m_diskCacheDir = directory;
+	}
+
+	std::optional<std::filesystem::path> CompilerEnvironmentCache::getDiskCacheDirectory() const
+	{
+		std::lock_guard<std::mutex> guard { m_lock };
+		return m_diskCacheDir;
+	}
+
+	CompilerEnvironmentCache::Stats CompilerEnvironmentCache::getStats() const
+	{
+		std::lock_guard<std::mutex> guard { m_lock };
+		return m_stats;
+	}
+
+	std::optional<CompilerEnvironment> CompilerEnvironmentCache::loadFromDisk(const Key& key)
+	{
+		if (!m_diskCacheDir.has_value())
+			return std::nullopt;
+
+		const auto entryPath = m_diskCacheDir.value() / (key.getDigest() + std::string(cache_details::kEntryExtension));
+
+		std::ifstream entryFile { entryPath };
+		if (!entryFile.is_open())
+			return std::nullopt;
+
+		std::optional<std::pair<Key, CompilerEnvironment>> stored {};
+
+		try
+		{
+			stored = cache_details::deserialize(entryFile);
+		}
+		catch (const std::exception&)
+		{
+			// std::stoll & co on broken entry
+			stored = std::nullopt;
+		}
+
+		entryFile.close();
+
+		bool bIsValid = stored.has_value() && stored->first == key && !stored->second.config.vSystemIncludes.empty();
+		if (bIsValid)
+		{
+			// Compiler could be updated in place by package manager. Make sure that all include directories still here.
+			std::error_code ec;
+			for (const auto& inc : stored->second.config.vSystemIncludes)
+			{
+				if (!std::filesystem::is_directory(inc.sFsLocation, ec))
+				{
+					bIsValid = false;
+					break;
+				}
+			}
+		}
+
+		if (!bIsValid)
+		{
+			std::error_code ec;
+			std::filesystem::remove(entryPath, ec);
+			++m_stats.iInvalidated;
+			return std::nullopt;
+		}
+
+		return std::move(stored->second);
+	}
+
+	void CompilerEnvironmentCache::storeOnDisk(const Key& key, const CompilerEnvironment& env) const
+	{
+		if (!m_diskCacheDir.has_value())
+			return;
+
+		std::error_code ec;
+		std::filesystem::create_directories(m_diskCacheDir.value(), ec);
+		if (ec)
+			return;
+
+		const auto entryPath = m_diskCacheDir.value() / (key.getDigest() + std::string(cache_details::kEntryExtension));
+
+		// Concurrent readers will never see partially written entry
+		rg3::cpp::utils::writeFileAtomic(entryPath, cache_details::serialize(key, env));
+	}
+}
\ No newline at end of file
@@ -57,22 +57,26 @@ namespace rg3::llvm
 				[](char c) { return c == '\0'; }
 			);
 
-			auto pMemBuffer = ::llvm::MemoryBuffer::getMemBufferCopy(sanitizedBuffer, "id0.hpp");
-			pCompilerInstance->getPreprocessorOpts().addRemappedFile("id0.hpp", pMemBuffer.release());
+			const ::llvm::StringRef sInputName { CompilerInstanceFactory::kInMemoryInputName.data(), CompilerInstanceFactory::kInMemoryInputName.size() };
 
-			compilerOptions.Inputs.push_back(clang::FrontendInputFile("id0.hpp", clang::Language::CXX));
+			auto pMemBuffer = ::llvm::MemoryBuffer::getMemBufferCopy(sanitizedBuffer, sInputName);
+			pCompilerInstance->getPreprocessorOpts().addRemappedFile(sInputName, pMemBuffer.release());
+
+			compilerOptions.Inputs.push_back(clang::FrontendInputFile(sInputName, clang::Language::CXX));
 		}
 	};
 
 	void CompilerInstanceFactory::makeInstance(clang::CompilerInstance* pOutInstance,
 											   const std::variant<std::filesystem::path, std::string>& sInput,
 											   const rg3::llvm::CompilerConfig& sCompilerConfig,
-											   const rg3::llvm::CompilerEnvironment* pCompilerEnv)
+											   const rg3::llvm::CompilerEnvironment* pCompilerEnv,
+											   ::llvm::IntrusiveRefCntPtr<::llvm::vfs::FileSystem> pFileSystem,
+											   const std::optional<std::filesystem::path>& sPreamblePCH)
 	{
 		pOutInstance->createDiagnostics();
 
-		// Set up FileManager and SourceManager
-		pOutInstance->createFileManager();
+		// Set up FileManager and SourceManager (file system could be shared between instances, nullptr - use real FS)
+		pOutInstance->createFileManager(std::move(pFileSystem));
 		pOutInstance->createSourceManager(pOutInstance->getFileManager());
 
 		std::vector<std::string> vProxyArgs = sCompilerConfig.vCompilerArgs;
@@ -245,6 +249,12 @@ namespace rg3::llvm
 		preprocessorOptions.addMacroDef("__GNUC__=4");
 #endif
 
+		// Precompiled preamble (same as -include-pch)
+		if (sPreamblePCH.has_value())
+		{
+			preprocessorOptions.ImplicitPCHInclude = sPreamblePCH->string();
+		}
+
 		// Setup header dirs source
 		clang::HeaderSearchOptions& headerSearchOptions = pOutInstance->getHeaderSearchOpts();
 		{
@@ -1,11 +1,16 @@
 #include <RG3/LLVM/Consumers/CollectTypesFromTU.h>
 #include <RG3/LLVM/Visitors/CxxRouterVisitor.h>
+#include <RG3/LLVM/SourceFileFilter.h>
+#include <RG3/LLVM/CommentTagsCache.h>
+#include <clang/AST/ASTContext.h>
+#include <clang/AST/Decl.h>
+#include <chrono>
 
 
 namespace rg3::llvm::consumers
 {
-	CollectTypesFromTUConsumer::CollectTypesFromTUConsumer(std::vector<rg3::cpp::TypeBasePtr>& vCollectedTypes, const CompilerConfig& cc)
-		: clang::ASTConsumer(), collectedTypes(vCollectedTypes), compilerConfig(cc)
+	CollectTypesFromTUConsumer::CollectTypesFromTUConsumer(std::vector<rg3::cpp::TypeBasePtr>& vCollectedTypes, const CompilerConfig& cc, AnalyzeStats* pAnalyzeStats, const std::atomic_bool* pCancelFlag)
+		: clang::ASTConsumer(), collectedTypes(vCollectedTypes), compilerConfig(cc), pStats(pAnalyzeStats), pCancelled(pCancelFlag)
 	{
 	}
 
@@ -18,7 +23,31 @@ namespace rg3::llvm::consumers
 
 	void CollectTypesFromTUConsumer::HandleTranslationUnit(clang::ASTContext& ctx)
 	{
-		rg3::llvm::visitors::CxxRouterVisitor router { collectedTypes, compilerConfig };
-		router.TraverseDecl(ctx.getTranslationUnitDecl());
+		if (pCancelled && pCancelled->load(std::memory_order_relaxed))
+			return; // Result will be dropped anyway
+
+		const auto visitStartedAt = std::chrono::steady_clock::now();
+
+		SourceFileFilter sourceFilter { compilerConfig, ctx.getSourceManager() };
+		CommentTagsCache tagsCache {};
+		rg3::llvm::visitors::CxxRouterVisitor router { collectedTypes, compilerConfig, &sourceFilter, &tagsCache };
+		clang::TranslationUnitDecl* pTU = ctx.getTranslationUnitDecl();
+
+		if (ctx.getExternalSource() != nullptr)
+		{
+			// Precompiled preamble attached: visit only declarations of this TU. Otherwise whole PCH will be deserialized & collected.
+			std::vector<clang::Decl*> vLocalDecls { pTU->noload_decls_begin(), pTU->noload_decls_end() };
+			ctx.setTraversalScope(vLocalDecls);
+		}
+
+		router.TraverseDecl(pTU);
+
+		if (pStats)
+		{
+			pStats->visitTime += std::chrono::steady_clock::now() - visitStartedAt;
+			pStats->iDeclsVisited += router.getVisitedDeclsCount();
+			pStats->iDeclsPruned += router.getPrunedDeclsCount();
+			pStats->iDeclsRevisited += router.getRevisitedDeclsCount();
+		}
 	}
 }
\ No newline at end of file
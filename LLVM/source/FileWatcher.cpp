@@ -0,0 +1,176 @@
+#include <RG3/LLVM/FileWatcher.h>
+
+#include <algorithm>
+#include <unordered_set>
+#include <cstdint>
+
+#if defined(__linux__)
+#include <sys/inotify.h>
+#include <unistd.h>
+#include <poll.h>
+#include <cerrno>
+#include <cstring>
+#endif
+
+
+namespace rg3::llvm
+{
+#if defined(__linux__)
+	static constexpr std::uint32_t kWatchMask = IN_CLOSE_WRITE | IN_CREATE | IN_DELETE | IN_MOVED_FROM | IN_MOVED_TO | IN_ONLYDIR;
+#endif
+
+	FileWatcher::FileWatcher(int iDescriptor) : m_iDescriptor(iDescriptor)
+	{
+	}
+
+	FileWatcher::~FileWatcher()
+	{
+#if defined(__linux__)
+		if (m_iDescriptor >= 0)
+		{
+			::close(m_iDescriptor);
+		}
+#endif
+	}
+
+	FileWatcherResult FileWatcher::create()
+	{
+#if defined(__linux__)
+		const int iDescriptor = ::inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+		if (iDescriptor < 0)
+		{
+			return FileWatcherError { std::string("inotify_init1 failed: ") + std::strerror(errno) };
+		}
+
+		return std::unique_ptr<FileWatcher>(new FileWatcher(iDescriptor));
+#else
+		return FileWatcherError { "File watching is supported only on Linux" };
+#endif
+	}
+
+	bool FileWatcher::watchDirectory(const std::filesystem::path& directory)
+	{
+#if defined(__linux__)
+		std::error_code ec;
+		auto absoluteDirectory = std::filesystem::absolute(directory, ec);
+		if (ec)
+			return false;
+
+		const std::string sDirectory = absoluteDirectory.lexically_normal().string();
+		if (m_directories.contains(sDirectory))
+			return true;
+
+		const int iWatch = ::inotify_add_watch(m_iDescriptor, sDirectory.c_str(), kWatchMask);
+		if (iWatch < 0)
+			return false;
+
+		m_directories[sDirectory] = iWatch;
+		m_watches[iWatch] = sDirectory;
+		return true;
+#else
+		(void)directory;
+		return false;
+#endif
+	}
+
+	FileChanges FileWatcher::waitChanges(std::chrono::milliseconds timeout, std::chrono::milliseconds settleTime)
+	{
+		FileChanges changes {};
+
+#if defined(__linux__)
+		auto waitEvents = [this](std::chrono::milliseconds waitTime) -> bool {
+			pollfd pollDescriptor { m_iDescriptor, POLLIN, 0 };
+
+			int iResult;
+			do
+			{
+				iResult = ::poll(&pollDescriptor, 1, waitTime.count() < 0 ? -1 : static_cast<int>(waitTime.count()));
+			}
+			while (iResult < 0 && errno == EINTR);
+
+			return iResult > 0 && (pollDescriptor.revents & POLLIN);
+		};
+
+		if (!waitEvents(timeout))
+			return changes;
+
+		// Collect burst of events: editors write, rename & touch files in few steps
+		do
+		{
+			readEvents(changes);
+		}
+		while (waitEvents(settleTime));
+
+		// Unique paths in stable order
+		auto makeUnique = [](std::vector<std::filesystem::path>& vPaths) {
+			std::unordered_set<std::string> seen {};
+			vPaths.erase(std::remove_if(vPaths.begin(), vPaths.end(), [&seen](const std::filesystem::path& path) {
+				return !seen.emplace(path.string()).second;
+			}), vPaths.end());
+		};
+
+		makeUnique(changes.vFiles);
+		makeUnique(changes.vCreatedFiles);
+#else
+		(void)timeout;
+		(void)settleTime;
+#endif
+
+		return changes;
+	}
+
+	std::size_t FileWatcher::getWatchedDirectoriesCount() const
+	{
+		return m_watches.size();
+	}
+
+	void FileWatcher::readEvents(FileChanges& changes)
+	{
+#if defined(__linux__)
+		alignas(inotify_event) char buffer[16 * 1024];
+
+		for (;;)
+		{
+			const ssize_t iRead = ::read(m_iDescriptor, buffer, sizeof(buffer));
+			if (iRead <= 0)
+				break; // EAGAIN: queue drained
+
+			for (ssize_t iOffset = 0; iOffset < iRead;)
+			{
+				const auto* pEvent = reinterpret_cast<const inotify_event*>(buffer + iOffset);
+				iOffset += static_cast<ssize_t>(sizeof(inotify_event) + pEvent->len);
+
+				if (pEvent->mask & IN_Q_OVERFLOW)
+				{
+					changes.bOverflow = true;
+					continue;
+				}
+
+				auto it = m_watches.find(pEvent->wd);
+				if (it == m_watches.end())
+					continue;
+
+				if (pEvent->mask & IN_IGNORED)
+				{
+					// Directory was removed: watch is dropped by kernel
+					m_directories.erase(it->second.string());
+					m_watches.erase(it);
+					continue;
+				}
+
+				if (pEvent->len > 0 && !(pEvent->mask & IN_ISDIR))
+				{
+					changes.vFiles.emplace_back(it->second / std::string(pEvent->name));
+
+					if (pEvent->mask & (IN_CREATE | IN_MOVED_TO))
+					{
+						changes.vCreatedFiles.emplace_back(changes.vFiles.back());
+					}
+				}
+			}
+		}
+#else
+		(void)changes;
+#endif
+	}
+}
\ No newline at end of file
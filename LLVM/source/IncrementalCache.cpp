@@ -0,0 +1,553 @@
+#include <RG3/LLVM/IncrementalCache.h>
+#include <RG3/Cpp/TypeSerializer.h>
+#include <RG3/Cpp/FileUtils.h>
+#include <RG3_Config.h> /// Auto-generated by CMake
+
+#include <llvm/Support/MemoryBuffer.h>
+#include <llvm/Support/xxhash.h>
+
+#include <fmt/format.h>
+
+#include <algorithm>
+#include <fstream>
+#include <sstream>
+
+
+namespace rg3::llvm
+{
+	namespace incremental_details
+	{
+		/// Increment when format of manifest or result file changed
+		static constexpr int kFormatVersion = 1;
+		static constexpr std::string_view kManifestMagic = "rg3-incremental-manifest";
+		static constexpr std::string_view kManifestName = "manifest.txt";
+		static constexpr std::string_view kResultExtension = ".rg3r";
+		static constexpr std::uint32_t kResultMagic = 0x52334752; // 'RG3R'
+
+		static std::uint64_t hashString(std::string_view data)
+		{
+			return ::llvm::xxh3_64bits(::llvm::ArrayRef<std::uint8_t>(reinterpret_cast<const std::uint8_t*>(data.data()), data.size()));
+		}
+
+		static std::string serializeResult(const AnalyzerResult& result)
+		{
+			cpp::BinaryWriter writer {};
+			writer.writeU32(kResultMagic);
+			writer.writeU32(kFormatVersion);
+			writer.writeString(RG3_BUILD_HASH);
+
+			writer.writeU32(static_cast<std::uint32_t>(result.vIssues.size()));
+			for (const auto& issue : result.vIssues)
+			{
+				writer.writeU8(static_cast<std::uint8_t>(issue.kind));
+				writer.writeString(issue.sSourceFile);
+				writer.writeU32(issue.iLine);
+				writer.writeU32(issue.iColumn);
+				writer.writeString(issue.sMessage);
+			}
+
+			cpp::TypeSerializer::writeTypes(writer, result.vFoundTypes);
+			return std::move(writer.getBuffer());
+		}
+
+		static std::optional<AnalyzerResult> deserializeResult(std::string_view data)
+		{
+			cpp::BinaryReader reader { data };
+
+			if (reader.readU32() != kResultMagic || reader.readU32() != kFormatVersion || reader.readString() != RG3_BUILD_HASH)
+				return std::nullopt;
+
+			AnalyzerResult result {};
+
+			const std::uint32_t iIssuesCount = reader.readU32();
+			for (std::uint32_t i = 0; i < iIssuesCount && !reader.isFailed(); ++i)
+			{
+				auto& issue = result.vIssues.emplace_back();
+				issue.kind = static_cast<AnalyzerResult::CompilerIssue::IssueKind>(reader.readU8());
+				issue.sSourceFile = reader.readString();
+				issue.iLine = reader.readU32();
+				issue.iColumn = reader.readU32();
+				issue.sMessage = reader.readString();
+			}
+
+			if (reader.isFailed() || !cpp::TypeSerializer::readTypes(reader, result.vFoundTypes) || !reader.isEOF())
+				return std::nullopt;
+
+			return result;
+		}
+
+		static void writeFileRecord(std::ostream& out, std::string_view sTag, const IncrementalCache::FileRecord& record)
+		{
+			out << sTag << ' ' << record.iFileSize << ' ' << record.iModificationTime << ' ' << fmt::format("{:016x}", record.iContentHash) << ' ' << record.sPath << '\n';
+		}
+
+		static std::optional<IncrementalCache::FileRecord> readFileRecord(std::string_view line)
+		{
+			// <size> <mtime> <hash> <path (rest of line)>
+			std::istringstream stream { std::string(line) };
+			IncrementalCache::FileRecord record {};
+			std::string sHash {};
+
+			if (!(stream >> record.iFileSize >> record.iModificationTime >> sHash))
+				return std::nullopt;
+
+			stream.get(); // separator
+			std::getline(stream, record.sPath);
+
+			if (record.sPath.empty())
+				return std::nullopt;
+
+			try
+			{
+				record.iContentHash = std::stoull(sHash, nullptr, 16);
+			}
+			catch (...)
+			{
+				return std::nullopt;
+			}
+
+			return record;
+		}
+	}
+
+	IncrementalCache::IncrementalCache(std::filesystem::path cacheDir, std::string sConfigDigest)
+		: m_cacheDir(std::move(cacheDir))
+		, m_sConfigDigest(std::move(sConfigDigest))
+	{
+	}
+
+	std::string IncrementalCache::makeConfigDigest(const CompilerConfig& config, const CompilerEnvironment& env)
+	{
+		// Every field separated by '\n': digest must be stable between processes (std::hash is not)
+		std::ostringstream repr {};
+		repr << RG3_BUILD_HASH << '\n'
+			 << static_cast<int>(config.cppStandard) << '\n'
+			 << config.bAllowCollectNonRuntimeTypes << config.bSkipFunctionBodies << config.bUseDeepAnalysis << '\n'
+			 << env.triple << '\n';
+
+		for (const auto& inc : config.vIncludes) repr << "I" << static_cast<int>(inc.eKind) << inc.sFsLocation.string() << '\n';
+		for (const auto& inc : config.vSystemIncludes) repr << "S" << static_cast<int>(inc.eKind) << inc.sFsLocation.string() << '\n';
+		for (const auto& inc : env.config.vSystemIncludes) repr << "E" << static_cast<int>(inc.eKind) << inc.sFsLocation.string() << '\n';
+		for (const auto& arg : config.vCompilerArgs) repr << "A" << arg << '\n';
+		for (const auto& def : config.vCompilerDefs) repr << "D" << def << '\n';
+		for (const auto& header : config.vPreambleHeaders) repr << "P" << header << '\n';
+		repr << "F" << static_cast<int>(config.eSourceFilter) << '\n';
+		for (const auto& glob : config.vSourceAllowGlobs) repr << "G+" << glob << '\n';
+		for (const auto& glob : config.vSourceDenyGlobs) repr << "G-" << glob << '\n';
+
+		return fmt::format("{:016x}", incremental_details::hashString(repr.str()));
+	}
+
+	bool IncrementalCache::load()
+	{
+		std::lock_guard<std::mutex> guard { m_entriesLock };
+		m_entries.clear();
+		m_lruKeys.clear();
+		m_lruPositions.clear();
+		m_iMemoryUsage = 0;
+
+		if (isMemoryOnly())
+			return false;
+
+		std::ifstream manifest { m_cacheDir / incremental_details::kManifestName };
+		if (!manifest.is_open())
+			return false;
+
+		std::string line {};
+		if (!std::getline(manifest, line) || line != fmt::format("{} {}", incremental_details::kManifestMagic, incremental_details::kFormatVersion))
+			return false;
+
+		if (!std::getline(manifest, line) || line != fmt::format("build {}", RG3_BUILD_HASH))
+			return false;
+
+		std::optional<std::pair<std::string, Entry>> current {};
+
+		while (std::getline(manifest, line))
+		{
+			const auto separator = line.find(' ');
+			const std::string_view sTag = std::string_view(line).substr(0, separator);
+			const std::string_view sValue = separator != std::string::npos ? std::string_view(line).substr(separator + 1) : std::string_view {};
+
+			if (sTag == "entry")
+			{
+				// entry <config digest> <result file> <path (rest of line)>
+				std::istringstream stream { std::string(sValue) };
+				Entry entry {};
+				std::string sPath {};
+
+				if (!(stream >> entry.sConfigDigest >> entry.sResultFile))
+				{
+					m_entries.clear();
+					return false;
+				}
+
+				stream.get();
+				std::getline(stream, sPath);
+				current.emplace(std::move(sPath), std::move(entry));
+			}
+			else if ((sTag == "file" || sTag == "dep") && current.has_value())
+			{
+				auto record = incremental_details::readFileRecord(sValue);
+				if (!record.has_value())
+				{
+					m_entries.clear();
+					return false;
+				}
+
+				if (sTag == "file")
+					current->second.header = std::move(record.value());
+				else
+					current->second.vDependencies.emplace_back(std::move(record.value()));
+			}
+			else if (sTag == "end" && current.has_value())
+			{
+				m_entries.insert_or_assign(std::move(current->first), std::move(current->second));
+				current.reset();
+			}
+			else
+			{
+				m_entries.clear();
+				return false;
+			}
+		}
+
+		return true;
+	}
+
+	bool IncrementalCache::save()
+	{
+		std::lock_guard<std::mutex> guard { m_entriesLock };
+
+		if (!m_bDirty || isMemoryOnly())
+			return true;
+
+		std::error_code ec;
+		std::filesystem::create_directories(m_cacheDir, ec);
+		if (ec)
+			return false;
+
+		std::ostringstream manifest {};
+		manifest << incremental_details::kManifestMagic << ' ' << incremental_details::kFormatVersion << '\n';
+		manifest << "build " << RG3_BUILD_HASH << '\n';
+
+		for (const auto& [sPath, entry] : m_entries)
+		{
+			manifest << "entry " << entry.sConfigDigest << ' ' << entry.sResultFile << ' ' << sPath << '\n';
+			incremental_details::writeFileRecord(manifest, "file", entry.header);
+
+			for (const auto& dependency : entry.vDependencies)
+			{
+				incremental_details::writeFileRecord(manifest, "dep", dependency);
+			}
+
+			manifest << "end\n";
+		}
+
+		if (!rg3::cpp::utils::writeFileAtomic(m_cacheDir / incremental_details::kManifestName, manifest.str()))
+			return false;
+
+		m_bDirty = false;
+		return true;
+	}
+
+	std::optional<AnalyzerResult> IncrementalCache::find(const std::filesystem::path& header)
+	{
+		return find(header, m_sConfigDigest);
+	}
+
+	std::optional<AnalyzerResult> IncrementalCache::find(const std::filesystem::path& header, const std::string& sConfigDigest)
+	{
+		const std::string sKey = rg3::cpp::utils::normalizePath(header).string();
+		std::optional<Entry> entry {};
+
+		{
+			std::lock_guard<std::mutex> guard { m_entriesLock };
+
+			if (auto it = m_entries.find(sKey); it != m_entries.end() && it->second.sConfigDigest == sConfigDigest)
+			{
+				entry = it->second;
+			}
+		}
+
+		auto isEntryValid = [this](const Entry& entry) -> bool {
+			if (!isValid(entry.header))
+				return false;
+
+			return std::all_of(entry.vDependencies.begin(), entry.vDependencies.end(), [this](const FileRecord& dependency) -> bool {
+				return isValid(dependency);
+			});
+		};
+
+		std::optional<AnalyzerResult> result {};
+
+		if (entry.has_value() && isEntryValid(entry.value()))
+		{
+			if (entry->pResultData)
+			{
+				result = incremental_details::deserializeResult(*entry->pResultData);
+			}
+			else if (auto buffer = ::llvm::MemoryBuffer::getFile((m_cacheDir / entry->sResultFile).string(), /*IsText=*/false, /*RequiresNullTerminator=*/false))
+			{
+				result = incremental_details::deserializeResult(std::string_view { buffer.get()->getBufferStart(), buffer.get()->getBufferSize() });
+			}
+
+			if (result.has_value())
+			{
+				result->vDependencies.reserve(entry->vDependencies.size());
+
+				for (const auto& dependency : entry->vDependencies)
+				{
+					result->vDependencies.emplace_back(dependency.sPath);
+				}
+			}
+		}
+
+		{
+			std::lock_guard<std::mutex> guard { m_entriesLock };
+			(result.has_value() ? m_vReused : m_vRecomputed).emplace_back(header);
+
+			if (result.has_value() && isMemoryOnly())
+			{
+				touchEntry(sKey);
+			}
+		}
+
+		return result;
+	}
+
+	void IncrementalCache::store(const std::filesystem::path& header, const AnalyzerResult& result)
+	{
+		store(header, m_sConfigDigest, result);
+	}
+
+	void IncrementalCache::store(const std::filesystem::path& header, const std::string& sConfigDigest, const AnalyzerResult& result)
+	{
+		const std::string sKey = rg3::cpp::utils::normalizePath(header).string();
+
+		Entry entry {};
+		entry.sConfigDigest = sConfigDigest;
+		entry.sResultFile = fmt::format("{:016x}{}", incremental_details::hashString(sKey + sConfigDigest), incremental_details::kResultExtension);
+
+		auto headerRecord = makeFileRecord(sKey);
+		if (!headerRecord.has_value())
+			return;
+
+		entry.header = std::move(headerRecord.value());
+		entry.vDependencies.reserve(result.vDependencies.size());
+
+		for (const auto& dependency : result.vDependencies)
+		{
+			const std::string sDependencyPath = dependency.string();
+			if (sDependencyPath == sKey)
+				continue;
+
+			auto record = makeFileRecord(sDependencyPath);
+			if (!record.has_value())
+				return; // Unable to validate it later: don't store at all
+
+			entry.vDependencies.emplace_back(std::move(record.value()));
+		}
+
+		std::error_code ec;
+
+		if (isMemoryOnly())
+		{
+			entry.pResultData = std::make_shared<const std::string>(incremental_details::serializeResult(result));
+		}
+		else
+		{
+			std::filesystem::create_directories(m_cacheDir, ec);
+
+			if (ec || !rg3::cpp::utils::writeFileAtomic(m_cacheDir / entry.sResultFile, incremental_details::serializeResult(result)))
+				return;
+		}
+
+		std::lock_guard<std::mutex> guard { m_entriesLock };
+
+		if (auto it = m_entries.find(sKey); !isMemoryOnly() && it != m_entries.end() && it->second.sResultFile != entry.sResultFile)
+		{
+			// Result of previous config is not needed anymore
+			std::filesystem::remove(m_cacheDir / it->second.sResultFile, ec);
+		}
+
+		if (isMemoryOnly())
+		{
+			if (auto it = m_entries.find(sKey); it != m_entries.end() && it->second.pResultData)
+			{
+				m_iMemoryUsage -= it->second.pResultData->size();
+			}
+
+			m_iMemoryUsage += entry.pResultData->size();
+		}
+
+		m_entries.insert_or_assign(sKey, std::move(entry));
+		m_bDirty = true;
+
+		if (isMemoryOnly())
+		{
+			touchEntry(sKey);
+			evictEntries();
+		}
+	}
+
+	void IncrementalCache::resetFileStates()
+	{
+		{
+			std::lock_guard<std::mutex> guard { m_filesLock };
+			m_files.clear();
+		}
+
+		std::lock_guard<std::mutex> guard { m_entriesLock };
+		m_vReused.clear();
+		m_vRecomputed.clear();
+	}
+
+	void IncrementalCache::setMemoryLimit(std::size_t iMaxBytes)
+	{
+		std::lock_guard<std::mutex> guard { m_entriesLock };
+		m_iMemoryLimit = iMaxBytes;
+		evictEntries();
+	}
+
+	bool IncrementalCache::isMemoryOnly() const
+	{
+		return m_cacheDir.empty();
+	}
+
+	std::size_t IncrementalCache::getEntriesCount() const
+	{
+		std::lock_guard<std::mutex> guard { m_entriesLock };
+		return m_entries.size();
+	}
+
+	std::size_t IncrementalCache::getMemoryUsage() const
+	{
+		std::lock_guard<std::mutex> guard { m_entriesLock };
+		return m_iMemoryUsage;
+	}
+
+	const std::filesystem::path& IncrementalCache::getCacheDirectory() const
+	{
+		return m_cacheDir;
+	}
+
+	std::vector<std::filesystem::path> IncrementalCache::getReusedHeaders() const
+	{
+		std::lock_guard<std::mutex> guard { m_entriesLock };
+		return m_vReused;
+	}
+
+	std::vector<std::filesystem::path> IncrementalCache::getRecomputedHeaders() const
+	{
+		std::lock_guard<std::mutex> guard { m_entriesLock };
+		return m_vRecomputed;
+	}
+
+	void IncrementalCache::touchEntry(const std::string& sKey)
+	{
+		if (auto it = m_lruPositions.find(sKey); it != m_lruPositions.end())
+		{
+			m_lruKeys.splice(m_lruKeys.begin(), m_lruKeys, it->second);
+			return;
+		}
+
+		if (m_entries.contains(sKey))
+		{
+			m_lruKeys.push_front(sKey);
+			m_lruPositions.emplace(sKey, m_lruKeys.begin());
+		}
+	}
+
+	void IncrementalCache::evictEntries()
+	{
+		if (m_iMemoryLimit == 0)
+			return;
+
+		while (m_iMemoryUsage > m_iMemoryLimit && !m_lruKeys.empty())
+		{
+			const std::string& sKey = m_lruKeys.back();
+
+			if (auto it = m_entries.find(sKey); it != m_entries.end())
+			{
+				if (it->second.pResultData)
+				{
+					m_iMemoryUsage -= it->second.pResultData->size();
+				}
+
+				m_entries.erase(it);
+			}
+
+			m_lruPositions.erase(sKey);
+			m_lruKeys.pop_back();
+		}
+	}
+
+	IncrementalCache::FileState IncrementalCache::getFileState(const std::string& sPath, bool bNeedHash)
+	{
+		{
+			std::lock_guard<std::mutex> guard { m_filesLock };
+
+			if (auto it = m_files.find(sPath); it != m_files.end() && (!bNeedHash || it->second.iContentHash.has_value() || !it->second.bExists))
+			{
+				return it->second;
+			}
+		}
+
+		// Not under lock: file IO is slow. Two threads could compute same state, it's fine.
+		FileState state {};
+		std::error_code ec;
+
+		state.iFileSize = std::filesystem::file_size(sPath, ec);
+		if (!ec)
+		{
+			const auto writeTime = std::filesystem::last_write_time(sPath, ec);
+			state.iModificationTime = static_cast<std::int64_t>(writeTime.time_since_epoch().count());
+			state.bExists = !ec;
+		}
+
+		if (state.bExists && bNeedHash)
+		{
+			auto buffer = ::llvm::MemoryBuffer::getFile(sPath, /*IsText=*/false, /*RequiresNullTerminator=*/false);
+			if (buffer)
+			{
+				state.iContentHash = incremental_details::hashString(std::string_view { buffer.get()->getBufferStart(), buffer.get()->getBufferSize() });
+			}
+			else
+			{
+				state.bExists = false;
+			}
+		}
+
+		std::lock_guard<std::mutex> guard { m_filesLock };
+		m_files.insert_or_assign(sPath, state);
+		return state;
+	}
+
+	std::optional<IncrementalCache::FileRecord> IncrementalCache::makeFileRecord(const std::string& sPath)
+	{
+		const FileState state = getFileState(sPath, true);
+		if (!state.bExists || !state.iContentHash.has_value())
+			return std::nullopt;
+
+		FileRecord record {};
+		record.sPath = sPath;
+		record.iFileSize = state.iFileSize;
+		record.iModificationTime = state.iModificationTime;
+		record.iContentHash = state.iContentHash.value();
+		return record;
+	}
+
+	bool IncrementalCache::isValid(const FileRecord& record)
+	{
+		FileState state = getFileState(record.sPath, false);
+		if (!state.bExists || state.iFileSize != record.iFileSize)
+			return false;
+
+		if (state.iModificationTime == record.iModificationTime)
+			return true;
+
+		// Touched, but maybe not changed (checkout, generator which rewrites same content)
+		state = getFileState(record.sPath, true);
+		return state.iContentHash.has_value() && state.iContentHash.value() == record.iContentHash;
+	}
+}
\ No newline at end of file
@@ -0,0 +1,363 @@
+#include <RG3/LLVM/PrecompiledHeaderCache.h>
+#include <RG3/LLVM/CompilerInstanceFactory.h>
+#include <RG3/LLVM/Consumers/CompilerDiagnosticsConsumer.h>
+#include <RG3/LLVM/CodeAnalyzer.h>
+#include <RG3/Cpp/HashUtils.h>
+
+#include <clang/Frontend/CompilerInstance.h>
+#include <clang/Frontend/FrontendActions.h>
+#include <clang/Frontend/Utils.h>
+
+#include <llvm/Support/MemoryBuffer.h>
+#include <llvm/Support/xxhash.h>
+
+#include <fmt/format.h>
+
+#include <functional>
+#include <algorithm>
+#include <fstream>
+#include <thread>
+
+
+namespace rg3::llvm
+{
+	namespace pch_details
+	{
+		/**
+		 * @brief Key of PCH: everything what affects preprocessor & parser state
+		 */
+		static std::string makeKey(const CompilerConfig& config, const CompilerEnvironment& env)
+		{
+			std::size_t seed = 0x0;
+
+			rg3::cpp::utils::hashCombine(seed, static_cast<int>(config.cppStandard), config.bSkipFunctionBodies, env.triple);
+
+			for (const auto& inc : config.vIncludes) rg3::cpp::utils::hashCombine(seed, inc.sFsLocation.string(), static_cast<int>(inc.eKind));
+			for (const auto& inc : config.vSystemIncludes) rg3::cpp::utils::hashCombine(seed, inc.sFsLocation.string(), static_cast<int>(inc.eKind));
+			for (const auto& inc : env.config.vSystemIncludes) rg3::cpp::utils::hashCombine(seed, inc.sFsLocation.string(), static_cast<int>(inc.eKind));
+			for (const auto& arg : config.vCompilerArgs) rg3::cpp::utils::hashCombine(seed, arg);
+			for (const auto& def : config.vCompilerDefs) rg3::cpp::utils::hashCombine(seed, def);
+			for (const auto& header : config.vPreambleHeaders) rg3::cpp::utils::hashCombine(seed, header);
+
+			return fmt::format("{:016x}", seed);
+		}
+
+		/**
+		 * @brief Record state of PCH input file. Content hash used when file was touched but size is same (see IncrementalCache).
+		 * @note File system is SharedFileCache of run when it's used: stat & content of file are read once per run
+		 */
+		static std::optional<PrecompiledHeaderCache::InputRecord> makeInputRecord(::llvm::vfs::FileSystem& fileSystem, const std::string& sPath)
+		{
+			auto status = fileSystem.status(sPath);
+			if (!status)
+				return std::nullopt;
+
+			PrecompiledHeaderCache::InputRecord record {};
+			record.sPath = sPath;
+			record.iFileSize = status->getSize();
+			record.iModificationTime = static_cast<std::int64_t>(status->getLastModificationTime().time_since_epoch().count());
+
+			auto buffer = fileSystem.getBufferForFile(sPath, /*FileSize=*/-1, /*RequiresNullTerminator=*/false);
+			if (!buffer)
+				return std::nullopt;
+
+			record.iContentHash = ::llvm::xxh3_64bits(::llvm::ArrayRef<std::uint8_t>(reinterpret_cast<const std::uint8_t*>(buffer.get()->getBufferStart()), buffer.get()->getBufferSize()));
+			return record;
+		}
+
+		static bool isUpToDate(::llvm::vfs::FileSystem& fileSystem, const PrecompiledHeaderCache::InputRecord& record)
+		{
+			auto status = fileSystem.status(record.sPath);
+			if (!status || status->getSize() != record.iFileSize)
+				return false;
+
+			if (static_cast<std::int64_t>(status->getLastModificationTime().time_since_epoch().count()) == record.iModificationTime)
+				return true;
+
+			// Touched, but maybe not changed
+			const auto actual = makeInputRecord(fileSystem, record.sPath);
+			return actual.has_value() && actual->iContentHash == record.iContentHash;
+		}
+
+		/**
+		 * @brief Collects every file read while PCH is built except umbrella header (it's our own temporary file)
+		 */
+		class InputsCollector final : public clang::DependencyCollector
+		{
+		 public:
+			explicit InputsCollector(std::filesystem::path umbrellaPath)
+				: clang::DependencyCollector(), m_umbrellaPath(std::move(umbrellaPath))
+			{
+			}
+
+			bool needSystemDependencies() override
+			{
+				return true;
+			}
+
+			bool sawDependency(::llvm::StringRef sFilename, bool bFromModule, bool bIsSystem, bool bIsModuleFile, bool bIsMissing) override
+			{
+				if (std::filesystem::path(sFilename.str()) == m_umbrellaPath)
+					return false;
+
+				return clang::DependencyCollector::sawDependency(sFilename, bFromModule, bIsSystem, bIsModuleFile, bIsMissing);
+			}
+
+		 private:
+			std::filesystem::path m_umbrellaPath {};
+		};
+
+		static std::string makeIncludeDirective(const std::string& sHeader)
+		{
+			if (!sHeader.empty() && (sHeader.front() == '<' || sHeader.front() == '"'))
+			{
+				return fmt::format("#include {}\n", sHeader);
+			}
+
+			return fmt::format("#include <{}>\n", sHeader);
+		}
+	}
+
+	PrecompiledHeaderCache::Stats PrecompiledHeaderCache::Stats::since(const Stats& before) const
+	{
+		Stats delta {};
+		delta.iBuilt = iBuilt - before.iBuilt;
+		delta.iFailed = iFailed - before.iFailed;
+		delta.iUses = iUses - before.iUses;
+		delta.iRebuilt = iRebuilt - before.iRebuilt;
+		delta.buildTime = buildTime - before.buildTime;
+		delta.estimatedSavedTime = estimatedSavedTime - before.estimatedSavedTime;
+		return delta;
+	}
+
+	PrecompiledHeaderCache& PrecompiledHeaderCache::getInstance()
+	{
+		static PrecompiledHeaderCache s_instance {};
+		return s_instance;
+	}
+
+	PrecompiledHeaderCache::~PrecompiledHeaderCache()
+	{
+		clear();
+	}
+
+	PrecompiledHeaderCache::BuildResult PrecompiledHeaderCache::getOrBuild(const CompilerConfig& config, const CompilerEnvironment& env, ::llvm::IntrusiveRefCntPtr<SharedFileCache> pFileSystem)
+	{
+		if (config.vPreambleHeaders.empty())
+		{
+			return BuildResult { std::nullopt, "No preamble headers" };
+		}
+
+		const std::string sKey = pch_details::makeKey(config, env);
+
+		std::shared_future<std::shared_ptr<const Entry>> entryFuture {};
+		std::optional<std::promise<std::shared_ptr<const Entry>>> buildPromise {};
+
+		for (;;)
+		{
+			{
+				std::lock_guard<std::mutex> guard { m_lock };
+
+				if (auto it = m_entries.find(sKey); it != m_entries.end())
+				{
+					entryFuture = it->second;
+				}
+				else
+				{
+					// We are first, so we will build it. Others will wait for us.
+					buildPromise.emplace();
+					entryFuture = buildPromise->get_future().share();
+					m_entries.emplace(sKey, entryFuture);
+				}
+			}
+
+			if (buildPromise.has_value())
+			{
+				buildPromise->set_value(build(sKey, config, env, pFileSystem));
+				break;
+			}
+
+			const std::shared_ptr<const Entry>& pBuilt = entryFuture.get();
+			if (areInputsUpToDate(*pBuilt, pFileSystem.get()))
+				break;
+
+			// One of headers changed after build: drop entry (unless somebody already did it) and build again
+			std::lock_guard<std::mutex> guard { m_lock };
+
+			if (auto it = m_entries.find(sKey); it != m_entries.end()
+				&& it->second.wait_for(std::chrono::seconds(0)) == std::future_status::ready
+				&& it->second.get() == pBuilt)
+			{
+				m_entries.erase(it);
+				++m_stats.iRebuilt;
+			}
+		}
+
+		const std::shared_ptr<const Entry> pEntry = entryFuture.get();
+
+		{
+			std::lock_guard<std::mutex> guard { m_lock };
+
+			if (buildPromise.has_value())
+			{
+				m_stats.buildTime += pEntry->buildTime;
+				++(pEntry->result.sPCHPath.has_value() ? m_stats.iBuilt : m_stats.iFailed);
+			}
+
+			if (pEntry->result.sPCHPath.has_value())
+			{
+				++m_stats.iUses;
+
+				if (!buildPromise.has_value())
+				{
+					// Builder parsed these headers instead of us
+					m_stats.estimatedSavedTime += pEntry->buildTime;
+				}
+			}
+		}
+
+		return pEntry->result;
+	}
+
+	bool PrecompiledHeaderCache::areInputsUpToDate(const Entry& entry, SharedFileCache* pFileSystem)
+	{
+		// Files are not expected to change while run in progress: inputs are checked by first compiler instance of run only
+		if (pFileSystem && entry.iValidatedRunId.load(std::memory_order_acquire) == pFileSystem->getId())
+			return true;
+
+		::llvm::IntrusiveRefCntPtr<::llvm::vfs::FileSystem> pInputsFS = pFileSystem ? ::llvm::IntrusiveRefCntPtr<::llvm::vfs::FileSystem>(pFileSystem) : ::llvm::vfs::getRealFileSystem();
+
+		const bool bUpToDate = std::all_of(entry.vInputs.begin(), entry.vInputs.end(), [&pInputsFS](const InputRecord& record) -> bool {
+			return pch_details::isUpToDate(*pInputsFS, record);
+		});
+
+		if (bUpToDate && pFileSystem)
+		{
+			entry.iValidatedRunId.store(pFileSystem->getId(), std::memory_order_release);
+		}
+
+		return bUpToDate;
+	}
+
+	void PrecompiledHeaderCache::clear()
+	{
+		std::lock_guard<std::mutex> guard { m_lock };
+
+		m_entries.clear();
+
+		if (m_workingDir.has_value())
+		{
+			std::error_code ec;
+			std::filesystem::remove_all(m_workingDir.value(), ec);
+			m_workingDir = std::nullopt;
+		}
+	}
+
+	PrecompiledHeaderCache::Stats PrecompiledHeaderCache::getStats() const
+	{
+		std::lock_guard<std::mutex> guard { m_lock };
+		return m_stats;
+	}
+
+	std::filesystem::path PrecompiledHeaderCache::getWorkingDirectory()
+	{
+		std::lock_guard<std::mutex> guard { m_lock };
+
+		if (!m_workingDir.has_value())
+		{
+			// Unique per process: PCH files are not shared between processes
+			const auto uniqueId = std::hash<std::thread::id>{}(std::this_thread::get_id()) ^ static_cast<std::size_t>(std::chrono::steady_clock::now().time_since_epoch().count());
+			m_workingDir = std::filesystem::temp_directory_path() / fmt::format("rg3_pch_{:x}", uniqueId);
+		}
+
+		return m_workingDir.value();
+	}
+
+	std::shared_ptr<const PrecompiledHeaderCache::Entry> PrecompiledHeaderCache::build(const std::string& sKey, const CompilerConfig& config, const CompilerEnvironment& env, ::llvm::IntrusiveRefCntPtr<SharedFileCache> pFileSystem)
+	{
+		auto pEntry = std::make_shared<Entry>();
+		const auto buildStartedAt = std::chrono::steady_clock::now();
+
+		// Inputs are recorded through same file system as compiler reads them: entry is valid for current run
+		::llvm::IntrusiveRefCntPtr<::llvm::vfs::FileSystem> pInputsFS = pFileSystem ? ::llvm::IntrusiveRefCntPtr<::llvm::vfs::FileSystem>(pFileSystem) : ::llvm::vfs::getRealFileSystem();
+		pEntry->iValidatedRunId = pFileSystem ? pFileSystem->getId() : 0;
+
+		// Rebuilt PCH gets new name: compiler instances could still read previous one
+		const std::filesystem::path workingDir = getWorkingDirectory();
+		const std::size_t iGeneration = m_iBuildsCount.fetch_add(1);
+		const std::filesystem::path umbrellaPath = workingDir / fmt::format("{}_{}.hpp", sKey, iGeneration);
+		const std::filesystem::path pchPath = workingDir / fmt::format("{}_{}.pch", sKey, iGeneration);
+
+		std::error_code ec;
+		std::filesystem::create_directories(workingDir, ec);
+		if (ec)
+		{
+			pEntry->result.sError = fmt::format("Failed to create directory '{}': {}", workingDir.string(), ec.message());
+			return pEntry;
+		}
+
+		// Umbrella header: must be real file, PCH refers to it
+		{
+			std::ofstream umbrellaFile { umbrellaPath, std::ios::out | std::ios::trunc };
+			if (!umbrellaFile.is_open())
+			{
+				pEntry->result.sError = fmt::format("Failed to write '{}'", umbrellaPath.string());
+				return pEntry;
+			}
+
+			umbrellaFile << "#pragma once\n";
+
+			for (const auto& sHeader : config.vPreambleHeaders)
+			{
+				umbrellaFile << pch_details::makeIncludeDirective(sHeader);
+			}
+		}
+
+		CompilerConfig pchConfig = config;
+		pchConfig.vPreambleHeaders.clear();
+
+		AnalyzerResult pchResult {};
+		clang::CompilerInstance compilerInstance {};
+		CompilerInstanceFactory::makeInstance(&compilerInstance, umbrellaPath, pchConfig, &env, std::move(pFileSystem));
+		compilerInstance.getFrontendOpts().OutputFile = pchPath.string();
+
+		{
+			auto errorCollector = std::make_unique<consumers::CompilerDiagnosticsConsumer>(pchResult);
+			compilerInstance.getDiagnostics().setClient(errorCollector.release(), true);
+		}
+
+		auto pInputsCollector = std::make_shared<pch_details::InputsCollector>(umbrellaPath);
+		compilerInstance.addDependencyCollector(pInputsCollector);
+
+		clang::GeneratePCHAction generatePCHAction {};
+		const bool bExecuted = compilerInstance.ExecuteAction(generatePCHAction);
+
+		for (const auto& sInput : pInputsCollector->getDependencies())
+		{
+			if (auto record = pch_details::makeInputRecord(*pInputsFS, sInput); record.has_value())
+			{
+				pEntry->vInputs.emplace_back(std::move(record.value()));
+			}
+		}
+
+		pEntry->buildTime = std::chrono::steady_clock::now() - buildStartedAt;
+
+		// Warnings are fine here, only errors make PCH unusable
+		const auto firstError = std::find_if(pchResult.vIssues.begin(), pchResult.vIssues.end(), [](const AnalyzerResult::CompilerIssue& issue) -> bool {
+			return issue.kind == AnalyzerResult::CompilerIssue::IssueKind::IK_ERROR;
+		});
+
+		if (!bExecuted || firstError != pchResult.vIssues.end())
+		{
+			pEntry->result.sError = (firstError != pchResult.vIssues.end())
+				? fmt::format("Failed to build preamble: {} ({}:{})", firstError->sMessage, firstError->sSourceFile, firstError->iLine)
+				: std::string("Failed to build preamble");
+
+			std::filesystem::remove(pchPath, ec);
+			return pEntry;
+		}
+
+		pEntry->result.sPCHPath = pchPath;
+		return pEntry;
+	}
+}
\ No newline at end of file
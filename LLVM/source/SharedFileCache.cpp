@@ -0,0 +1,172 @@
+#include <RG3/LLVM/SharedFileCache.h>
+
+#include <llvm/ADT/SmallString.h>
+#include <llvm/Support/Path.h>
+
+#include <mutex>
+
+
+namespace rg3::llvm
+{
+	namespace
+	{
+		/**
+		 * @brief Opened file which refers to content owned by cache
+		 */
+		class CachedFileHandle final : public ::llvm::vfs::File
+		{
+		 public:
+			CachedFileHandle(std::shared_ptr<const SharedFileCache::CachedFile> pEntry, std::string sName)
+				: m_pEntry(std::move(pEntry))
+				, m_sName(std::move(sName))
+			{
+			}
+
+			::llvm::ErrorOr<::llvm::vfs::Status> status() override
+			{
+				return ::llvm::vfs::Status::copyWithNewName(m_pEntry->status, m_sName);
+			}
+
+			::llvm::ErrorOr<std::string> getName() override
+			{
+				return m_sName;
+			}
+
+			::llvm::ErrorOr<std::unique_ptr<::llvm::MemoryBuffer>> getBuffer(const ::llvm::Twine& name, int64_t /*fileSize*/, bool bRequiresNullTerminator, bool /*bIsVolatile*/) override
+			{
+				// Buffer of entry always null terminated, so it's safe to give it as is
+				return ::llvm::MemoryBuffer::getMemBuffer(m_pEntry->pBuffer->getBuffer(), name.str(), bRequiresNullTerminator);
+			}
+
+			std::error_code close() override
+			{
+				return {};
+			}
+
+		 private:
+			std::shared_ptr<const SharedFileCache::CachedFile> m_pEntry { nullptr };
+			std::string m_sName {};
+		};
+	}
+
+	SharedFileCache::SharedFileCache(::llvm::IntrusiveRefCntPtr<::llvm::vfs::FileSystem> pUnderlyingFS)
+		: ::llvm::vfs::ProxyFileSystem(std::move(pUnderlyingFS))
+	{
+		static std::atomic<std::uint64_t> s_iLastId { 0 };
+		m_iId = ++s_iLastId;
+	}
+
+	::llvm::ErrorOr<::llvm::vfs::Status> SharedFileCache::status(const ::llvm::Twine& path)
+	{
+		const std::string sKey = makeKey(path);
+
+		{
+			std::shared_lock<std::shared_mutex> guard { m_statLock };
+			if (auto it = m_statCache.find(sKey); it != m_statCache.end())
+			{
+				m_iStatHits.fetch_add(1, std::memory_order_relaxed);
+
+				if (!it->second)
+					return it->second.getError();
+
+				return ::llvm::vfs::Status::copyWithNewName(it->second.get(), path.str());
+			}
+		}
+
+		m_iStatMisses.fetch_add(1, std::memory_order_relaxed);
+
+		auto result = ::llvm::vfs::ProxyFileSystem::status(path);
+		{
+			std::unique_lock<std::shared_mutex> guard { m_statLock };
+			m_statCache.try_emplace(sKey, result);
+		}
+
+		return result;
+	}
+
+	::llvm::ErrorOr<std::unique_ptr<::llvm::vfs::File>> SharedFileCache::openFileForRead(const ::llvm::Twine& path)
+	{
+		const std::string sKey = makeKey(path);
+
+		{
+			std::shared_lock<std::shared_mutex> guard { m_contentLock };
+			if (auto it = m_contentCache.find(sKey); it != m_contentCache.end())
+			{
+				m_iReadHits.fetch_add(1, std::memory_order_relaxed);
+				return std::make_unique<CachedFileHandle>(it->second, path.str());
+			}
+		}
+
+		m_iReadMisses.fetch_add(1, std::memory_order_relaxed);
+
+		auto fileOrError = ::llvm::vfs::ProxyFileSystem::openFileForRead(path);
+		if (!fileOrError)
+			return fileOrError.getError();
+
+		auto statusOrError = fileOrError.get()->status();
+		if (!statusOrError)
+			return statusOrError.getError();
+
+		auto bufferOrError = fileOrError.get()->getBuffer(path, static_cast<int64_t>(statusOrError->getSize()), true, false);
+		if (!bufferOrError)
+			return bufferOrError.getError();
+
+		auto pEntry = std::make_shared<CachedFile>();
+		pEntry->status = statusOrError.get();
+		pEntry->pBuffer = std::move(bufferOrError.get());
+
+		std::shared_ptr<const CachedFile> pStoredEntry = nullptr;
+		{
+			// Other thread could read same file at same time, first one wins
+			std::unique_lock<std::shared_mutex> guard { m_contentLock };
+			auto [it, bInserted] = m_contentCache.try_emplace(sKey, std::move(pEntry));
+			if (bInserted)
+			{
+				m_iCachedBytes.fetch_add(it->second->pBuffer->getBufferSize(), std::memory_order_relaxed);
+			}
+
+			pStoredEntry = it->second;
+		}
+
+		{
+			std::unique_lock<std::shared_mutex> guard { m_statLock };
+			m_statCache.try_emplace(sKey, pStoredEntry->status);
+		}
+
+		return std::make_unique<CachedFileHandle>(std::move(pStoredEntry), path.str());
+	}
+
+	bool SharedFileCache::exists(const ::llvm::Twine& path)
+	{
+		auto result = status(path);
+		return result && result->exists();
+	}
+
+	SharedFileCache::Stats SharedFileCache::getStats() const
+	{
+		Stats stats {};
+		stats.iStatHits = m_iStatHits.load(std::memory_order_relaxed);
+		stats.iStatMisses = m_iStatMisses.load(std::memory_order_relaxed);
+		stats.iReadHits = m_iReadHits.load(std::memory_order_relaxed);
+		stats.iReadMisses = m_iReadMisses.load(std::memory_order_relaxed);
+		stats.iCachedBytes = m_iCachedBytes.load(std::memory_order_relaxed);
+		return stats;
+	}
+
+	std::uint64_t SharedFileCache::getId() const
+	{
+		return m_iId;
+	}
+
+	std::string SharedFileCache::makeKey(const ::llvm::Twine& path) const
+	{
+		// Same file could be requested as relative and absolute path (include dirs are absolute, input could be not)
+		::llvm::SmallString<256> sPath {};
+		path.toVector(sPath);
+
+		makeAbsolute(sPath);
+		::llvm::sys::path::remove_dots(sPath, false);
+
+		return std::string(sPath.str());
+	}
+}
\ No newline at end of file
@@ -0,0 +1,143 @@
+#include <RG3/LLVM/SourceFileFilter.h>
+#include <RG3/Cpp/FileUtils.h>
+
+#include <algorithm>
+
+
+namespace rg3::llvm
+{
+	namespace source_filter_details
+	{
+		static std::filesystem::path normalizePath(const std::filesystem::path& path)
+		{
+			auto result = rg3::cpp::utils::normalizePath(path);
+
+			// 'dir/' -> 'dir': trailing separator produces empty element which never matches file path
+			if (!result.has_filename() && result.has_parent_path())
+				result = result.parent_path();
+
+			return result;
+		}
+
+		static bool isPathInside(const std::filesystem::path& path, const std::filesystem::path& dir)
+		{
+			auto [dirIt, pathIt] = std::mismatch(dir.begin(), dir.end(), path.begin(), path.end());
+			return dirIt == dir.end() && pathIt != path.end();
+		}
+
+		static void compileGlobs(const std::vector<std::string>& vGlobs, std::vector<::llvm::GlobPattern>& vOutPatterns)
+		{
+			for (const auto& sGlob : vGlobs)
+			{
+				auto pattern = ::llvm::GlobPattern::create(sGlob);
+				if (pattern)
+				{
+					vOutPatterns.emplace_back(std::move(*pattern));
+				}
+				else
+				{
+					::llvm::consumeError(pattern.takeError());
+				}
+			}
+		}
+
+		static bool matchesAny(const std::vector<::llvm::GlobPattern>& vPatterns, const std::string& sPath)
+		{
+			return std::any_of(vPatterns.begin(), vPatterns.end(), [&sPath](const ::llvm::GlobPattern& pattern) { return pattern.match(sPath); });
+		}
+	}
+
+	SourceFileFilter::SourceFileFilter(const CompilerConfig& compilerConfig, const clang::SourceManager& sourceManager)
+		: m_compilerConfig(compilerConfig), m_sourceManager(sourceManager)
+	{
+		if (m_compilerConfig.eSourceFilter == SourceFilter::SF_PROJECT_INCLUDES)
+		{
+			for (const auto& include : m_compilerConfig.vIncludes)
+			{
+				if (include.eKind == IncludeKind::IK_PROJECT)
+				{
+					m_vProjectDirs.emplace_back(source_filter_details::normalizePath(include.sFsLocation));
+				}
+			}
+		}
+
+		source_filter_details::compileGlobs(m_compilerConfig.vSourceAllowGlobs, m_vAllowGlobs);
+		source_filter_details::compileGlobs(m_compilerConfig.vSourceDenyGlobs, m_vDenyGlobs);
+	}
+
+	bool SourceFileFilter::isPassThrough() const
+	{
+		return m_compilerConfig.eSourceFilter == SourceFilter::SF_ALL && m_vAllowGlobs.empty() && m_vDenyGlobs.empty();
+	}
+
+	bool SourceFileFilter::isAccepted(const clang::Decl* pDecl)
+	{
+		if (!pDecl || isPassThrough())
+			return true;
+
+		const clang::SourceLocation location = pDecl->getLocation();
+		if (location.isInvalid())
+			return true;
+
+		const clang::FileID fileId = m_sourceManager.getFileID(m_sourceManager.getExpansionLoc(location));
+		if (fileId.isInvalid())
+			return true;
+
+		// Siblings almost always come from same file
+		if (fileId == m_lastFileId)
+			return m_bLastDecision;
+
+		auto it = m_decisions.find(fileId.getHashValue());
+		if (it == m_decisions.end())
+		{
+			it = m_decisions.emplace(fileId.getHashValue(), isFileAccepted(fileId)).first;
+		}
+
+		m_lastFileId = fileId;
+		m_bLastDecision = it->second;
+		return m_bLastDecision;
+	}
+
+	bool SourceFileFilter::isPathAccepted(const std::filesystem::path& path) const
+	{
+		const std::filesystem::path normalizedPath = source_filter_details::normalizePath(path);
+
+		switch (m_compilerConfig.eSourceFilter)
+		{
+			case SourceFilter::SF_MAIN_FILE:
+				return false;
+			case SourceFilter::SF_PROJECT_INCLUDES:
+				if (std::none_of(m_vProjectDirs.begin(), m_vProjectDirs.end(), [&normalizedPath](const std::filesystem::path& dir) { return source_filter_details::isPathInside(normalizedPath, dir); }))
+					return false;
+				break;
+			case SourceFilter::SF_ALL:
+			case SourceFilter::SF_SKIP_SYSTEM_HEADERS:
+				break;
+		}
+
+		const std::string sPath = normalizedPath.generic_string();
+
+		if (source_filter_details::matchesAny(m_vDenyGlobs, sPath))
+			return false;
+
+		return m_vAllowGlobs.empty() || source_filter_details::matchesAny(m_vAllowGlobs, sPath);
+	}
+
+	bool SourceFileFilter::isFileAccepted(clang::FileID fileId) const
+	{
+		if (fileId == m_sourceManager.getMainFileID())
+			return true;
+
+		if (m_compilerConfig.eSourceFilter != SourceFilter::SF_ALL && m_sourceManager.isInSystemHeader(m_sourceManager.getLocForStartOfFile(fileId)))
+			return false;
+
+		const auto fileEntry = m_sourceManager.getFileEntryRefForID(fileId);
+		if (!fileEntry)
+		{
+			// Memory buffer without file (predefines, command line): path based rules are not applicable
+			return m_compilerConfig.eSourceFilter == SourceFilter::SF_ALL || m_compilerConfig.eSourceFilter == SourceFilter::SF_SKIP_SYSTEM_HEADERS;
+		}
+
+		return isPathAccepted(std::filesystem::path(fileEntry->getName().str()));
+	}
+}
\ No newline at end of file
@@ -158,9 +158,7 @@ namespace rg3::llvm
 					std::vector<rg3::cpp::TypeBasePtr> vCollected {};
 
 					visitors::CxxTypeVisitor visitor { vCollected, cc };
-					visitor.TraverseDecl(pAsEnumDecl);
-
-					if (!vCollected.empty() && vCollected[0]->getKind() == cpp::TypeKind::TK_ENUM && !vCollected[0]->getPrettyName().empty())
+					if (visitor.collectEnum(pAsEnumDecl) && vCollected[0]->getKind() == cpp::TypeKind::TK_ENUM && !vCollected[0]->getPrettyName().empty())
 					{
 						Utils::getNamePrettyNameAndNamespaceForNamedDecl(pAsEnumDecl, baseInfo.sName, baseInfo.sPrettyName, baseInfo.sNameSpace);
 
@@ -31,11 +31,21 @@ namespace rg3::llvm::visitors
 		rg3::llvm::Utils::fillTypeStatementFromQualType(typeStatement, qt, fieldDecl->getASTContext());
 	}
 
-	CxxClassTypeVisitor::CxxClassTypeVisitor(const rg3::llvm::CompilerConfig& cc)
-		: compilerConfig(cc)
+	CxxClassTypeVisitor::CxxClassTypeVisitor(const rg3::llvm::CompilerConfig& cc, CommentTagsCache* pTagsCache)
+		: compilerConfig(cc), m_pTagsCache(pTagsCache)
 	{
 	}
 
+	bool CxxClassTypeVisitor::collect(clang::CXXRecordDecl* cxxRecordDecl)
+	{
+		if (cxxRecordDecl)
+		{
+			VisitCXXRecordDecl(cxxRecordDecl);
+		}
+
+		return !sClassName.empty();
+	}
+
 	bool CxxClassTypeVisitor::VisitCXXRecordDecl(clang::CXXRecordDecl* cxxRecordDecl)
 	{
 		if (!sClassName.empty())
@@ -45,16 +55,7 @@ namespace rg3::llvm::visitors
 			return true; // skip uncompleted types
 
 		// Extract comment
-		clang::ASTContext& ctx = cxxRecordDecl->getASTContext();
-		clang::SourceManager& sm = ctx.getSourceManager();
-
-		const clang::RawComment* rawComment = ctx.getRawCommentForDeclNoCache(cxxRecordDecl);
-
-		if (rawComment)
-		{
-			const auto rawCommentStr = rawComment->getFormattedText(sm, ctx.getDiagnostics());
-			vTags = cpp::Tag::parseFromCommentString(rawCommentStr);
-		}
+		vTags = CommentTagsCache::lookup(m_pTagsCache, cxxRecordDecl).vTags;
 
 		if (!vTags.hasTag(std::string(rg3::cpp::BuiltinTags::kRuntime)) && !compilerConfig.bAllowCollectNonRuntimeTypes)
 		{
@@ -89,12 +90,8 @@ namespace rg3::llvm::visitors
 			const clang::RecordDecl* recordDecl = baseSpecifier.getType()->getAsRecordDecl();
 			if (recordDecl)
 			{
-				const clang::RawComment* parentClassRawComment = ctx.getRawCommentForDeclNoCache(recordDecl);
-				if (parentClassRawComment)
-				{
-					const auto rawCommentStr = parentClassRawComment->getFormattedText(sm, ctx.getDiagnostics());
-					parent.vTags = cpp::Tag::parseFromCommentString(rawCommentStr);
-				}
+				// Same parent is shared by many derived types: its tags are parsed once per translation unit
+				parent.vTags = CommentTagsCache::lookup(m_pTagsCache, recordDecl).vTags;
 			}
 
 			if (baseSpecifier.isVirtual())
@@ -165,15 +162,7 @@ namespace rg3::llvm::visitors
 		fillTypeStatementFromLLVMEntry(newProperty.sTypeInfo, cxxFieldDecl);
 
 		// Save other info
-		clang::ASTContext& ctx = cxxFieldDecl->getASTContext();
-		clang::SourceManager& sm = ctx.getSourceManager();
-
-		const clang::RawComment* rawComment = ctx.getRawCommentForDeclNoCache(cxxFieldDecl);
-		if (rawComment)
-		{
-			const auto rawCommentStr = rawComment->getFormattedText(sm, ctx.getDiagnostics());
-			newProperty.vTags = cpp::Tag::parseFromCommentString(rawCommentStr);
-		}
+		newProperty.vTags = CommentTagsCache::lookup(m_pTagsCache, cxxFieldDecl).vTags;
 
 		// Override alias if @property provided
 		if (newProperty.vTags.hasTag(std::string(rg3::cpp::BuiltinTags::kProperty)))
@@ -219,14 +208,7 @@ namespace rg3::llvm::visitors
 		newFunction.bIsNoExcept = cxxMethodDecl->getExceptionSpecType() == clang::EST_NoexceptTrue || cxxMethodDecl->getExceptionSpecType() == clang::EST_BasicNoexcept;
 
 		clang::ASTContext& ctx = cxxMethodDecl->getASTContext();
-		clang::SourceManager& sm = ctx.getSourceManager();
-
-		const clang::RawComment* rawComment = ctx.getRawCommentForDeclNoCache(cxxMethodDecl);
-		if (rawComment)
-		{
-			const auto rawCommentStr = rawComment->getFormattedText(sm, ctx.getDiagnostics());
-			newFunction.vTags = cpp::Tag::parseFromCommentString(rawCommentStr);
-		}
+		newFunction.vTags = CommentTagsCache::lookup(m_pTagsCache, cxxMethodDecl).vTags;
 
 		newFunction.eVisibility = Utils::getDeclVisibilityLevel(cxxMethodDecl);
 
@@ -17,13 +17,39 @@
 
 namespace rg3::llvm::visitors
 {
-	CxxRouterVisitor::CxxRouterVisitor(std::vector<rg3::cpp::TypeBasePtr>& vFoundTypes, const CompilerConfig& compilerConfig)
-		: m_compilerConfig(compilerConfig), m_vFoundTypes(vFoundTypes)
+	CxxRouterVisitor::CxxRouterVisitor(std::vector<rg3::cpp::TypeBasePtr>& vFoundTypes, const CompilerConfig& compilerConfig, SourceFileFilter* pSourceFilter, CommentTagsCache* pTagsCache)
+		: m_compilerConfig(compilerConfig), m_vFoundTypes(vFoundTypes), m_pSourceFilter(pSourceFilter), m_pTagsCache(pTagsCache)
 	{
+		if (m_pSourceFilter && m_pSourceFilter->isPassThrough())
+			m_pSourceFilter = nullptr;
+	}
+
+	bool CxxRouterVisitor::TraverseDecl(clang::Decl* decl)
+	{
+		if (m_pSourceFilter && !m_pSourceFilter->isAccepted(decl))
+		{
+			// Whole subtree (namespace of third party header, class with all nested types, etc.) is skipped
+			++m_iPrunedDecls;
+			return true;
+		}
+
+		return clang::RecursiveASTVisitor<CxxRouterVisitor>::TraverseDecl(decl);
+	}
+
+	void CxxRouterVisitor::countVisit(const clang::Decl* pDecl)
+	{
+		++m_iVisitedDecls;
+
+		if (!m_routedDecls.insert(pDecl).second)
+		{
+			++m_iRevisitedDecls;
+		}
 	}
 
 	bool CxxRouterVisitor::VisitCXXRecordDecl(clang::CXXRecordDecl* cxxRecordDecl)
 	{
+		countVisit(cxxRecordDecl);
+
 		// Here we need to know is type templated or not
 		if (auto kind = cxxRecordDecl->getKind(); kind == clang::Decl::Kind::CXXRecord || kind == clang::Decl::Kind::Record)
 		{
@@ -31,28 +57,28 @@ namespace rg3::llvm::visitors
 			// Let's run simple visitor for this
 			if (!cxxRecordDecl->isTemplated())
 			{
-				CxxClassTypeVisitor visitor { m_compilerConfig };
-				visitor.TraverseDecl(cxxRecordDecl);
+				// Nested records & enums are not walked here: router meets each of them once during its own traversal
+				CxxClassTypeVisitor visitor { m_compilerConfig, m_pTagsCache };
 
-				if (!visitor.sClassName.empty())
+				if (visitor.collect(cxxRecordDecl))
 				{
 					m_vFoundTypes.emplace_back(
 						std::make_unique<cpp::TypeClass>(
-							visitor.sClassName,
-							visitor.sClassPrettyName,
-							visitor.sNameSpace,
-							visitor.sDefinitionLocation,
-							visitor.vTags,
-							visitor.foundProperties,
-							visitor.foundFunctions,
-							visitor.foundFriends,
+							std::move(visitor.sClassName),
+							std::move(visitor.sClassPrettyName),
+							std::move(visitor.sNameSpace),
+							std::move(visitor.sDefinitionLocation),
+							std::move(visitor.vTags),
+							std::move(visitor.foundProperties),
+							std::move(visitor.foundFunctions),
+							std::move(visitor.foundFriends),
 							visitor.bIsStruct,
 							visitor.bTriviallyConstructible,
 							visitor.bHasCopyConstructor,
 							visitor.bHasCopyAssignOperator,
 							visitor.bHasMoveConstructor,
 							visitor.bHasMoveAssignOperator,
-							visitor.parentClasses
+							std::move(visitor.parentClasses)
 						)
 					);
 
@@ -131,31 +157,24 @@ namespace rg3::llvm::visitors
 
 	bool CxxRouterVisitor::VisitEnumDecl(clang::EnumDecl* enumDecl)
 	{
-		// Handle simple enum
-		CxxTypeVisitor visitor { m_vFoundTypes, m_compilerConfig };
+		countVisit(enumDecl);
+
+		// Handle simple enum (constants are taken from decl, no nested traversal)
+		CxxTypeVisitor visitor { m_vFoundTypes, m_compilerConfig, m_pTagsCache };
+		visitor.collectEnum(enumDecl);
 
-		// Here we need to traverse this type because enum presented via multiple AST tree nodes
-		visitor.TraverseDecl(enumDecl);
 		return true;
 	}
 
 	bool CxxRouterVisitor::VisitTypedefNameDecl(clang::TypedefNameDecl* typedefNameDecl)
 	{
+		countVisit(typedefNameDecl);
+
 		// Breaking changes from 0.0.2 to 0.0.3: Now all using/typedef instructions produce target type with replaced name. And when type has no any registration points.
 		// So, our typedef must contain runtime tag in this case
-		clang::ASTContext& ctx = typedefNameDecl->getASTContext();
-		clang::SourceManager& sm = ctx.getSourceManager();
-
-		cpp::Tags typeTags;
-		bool bHasComment = false;
-
-		const clang::RawComment* rawComment = ctx.getRawCommentForDeclNoCache(typedefNameDecl);
-		if (rawComment)
-		{
-			std::string rawCommentStr = rawComment->getRawText(sm).data();
-			bHasComment = !rawCommentStr.empty();
-			typeTags = cpp::Tag::parseFromCommentString(rawCommentStr);
-		}
+		CommentTagsCache::Entry comment = CommentTagsCache::lookup(m_pTagsCache, typedefNameDecl);
+		const bool bHasComment = comment.bHasComment;
+		cpp::Tags& typeTags = comment.vTags;
 
 		if ((!bHasComment || !typeTags.hasTag(std::string(cpp::BuiltinTags::kRuntime))) && !m_compilerConfig.bAllowCollectNonRuntimeTypes)
 		{
@@ -208,12 +227,12 @@ namespace rg3::llvm::visitors
 							auto newConfig = m_compilerConfig;
 							newConfig.bAllowCollectNonRuntimeTypes = true; // allow to read type without runtime tag
 
-							CxxTemplateSpecializationVisitor visitor { newConfig, pSpecDecl, false, false, nullptr, nullptr };
+							CxxTemplateSpecializationVisitor visitor { newConfig, pSpecDecl, false, false, nullptr, nullptr, m_pTagsCache };
 							visitor.TraverseDecl(pTargetDecl);
 
 							if (visitor.getClassDefInfo().has_value())
 							{
-								const auto& sClassDefInfo = visitor.getClassDefInfo().value();
+								SClassDefInfo sClassDefInfo = visitor.takeClassDefInfo();
 
 								auto pType = std::make_unique<cpp::TypeClass>(
 												 typedefName, // typedefNameDecl->getNameAsString(),  // I'm not sure that this is correct.
@@ -221,16 +240,16 @@ namespace rg3::llvm::visitors
 												 typedefNamespace,
 												 typedefLocation,
 												 typeTags,
-												 sClassDefInfo.vProperties,
-												 sClassDefInfo.vFunctions,
-												 sClassDefInfo.vFriends,
+												 std::move(sClassDefInfo.vProperties),
+												 std::move(sClassDefInfo.vFunctions),
+												 std::move(sClassDefInfo.vFriends),
 												 sClassDefInfo.bIsStruct,
 												 sClassDefInfo.bTriviallyConstructible,
 												 sClassDefInfo.bHasCopyConstructor,
 												 sClassDefInfo.bHasCopyAssignOperator,
 												 sClassDefInfo.bHasMoveConstructor,
 												 sClassDefInfo.bHasMoveAssignOperator,
-												 sClassDefInfo.vParents);
+												 std::move(sClassDefInfo.vParents));
 
 								pType->setProducedFromTemplate();
 								pType->setProducedFromAlias();
@@ -247,10 +266,9 @@ namespace rg3::llvm::visitors
 				auto newConfig = m_compilerConfig;
 				newConfig.bAllowCollectNonRuntimeTypes = true; // allow to read type without runtime tag
 
-				CxxClassTypeVisitor visitor { newConfig };
-				visitor.TraverseDecl(pUnderlyingDecl);
+				CxxClassTypeVisitor visitor { newConfig, m_pTagsCache };
 
-				if (!visitor.sClassName.empty())
+				if (visitor.collect(::llvm::dyn_cast<clang::CXXRecordDecl>(pUnderlyingDecl)))
 				{
 					auto pType = std::make_unique<cpp::TypeClass>(
 									 typedefNameDecl->getNameAsString(),  // I'm not sure that this is correct.
@@ -258,16 +276,16 @@ namespace rg3::llvm::visitors
 									 typedefNamespace,
 									 typedefLocation,
 									 typeTags,
-									 visitor.foundProperties,
-									 visitor.foundFunctions,
-									 visitor.foundFriends,
+									 std::move(visitor.foundProperties),
+									 std::move(visitor.foundFunctions),
+									 std::move(visitor.foundFriends),
 									 visitor.bIsStruct,
 									 visitor.bTriviallyConstructible,
 									 visitor.bHasCopyConstructor,
 									 visitor.bHasCopyAssignOperator,
 									 visitor.bHasMoveConstructor,
 									 visitor.bHasMoveAssignOperator,
-									 visitor.parentClasses);
+									 std::move(visitor.parentClasses));
 
 					// produced from alias
 					pType->setProducedFromAlias();
@@ -295,12 +313,9 @@ namespace rg3::llvm::visitors
 					newConfig.bAllowCollectNonRuntimeTypes = true;
 
 					std::vector<cpp::TypeBasePtr> vTypes;
-					CxxTypeVisitor visitor { vTypes, newConfig };
+					CxxTypeVisitor visitor { vTypes, newConfig, m_pTagsCache };
 
-					// Need traverse decl because inner decls contains data for enum
-					visitor.TraverseDecl(pEnumDecl);
-
-					if (!vTypes.empty())
+					if (visitor.collectEnum(pEnumDecl))
 					{
 						vTypes[0]->overrideTypeData(
 							typedefNameDecl->getNameAsString(),
@@ -482,7 +497,7 @@ namespace rg3::llvm::visitors
 				auto newConfig = m_compilerConfig;
 				newConfig.bAllowCollectNonRuntimeTypes = true;
 				std::vector<cpp::TypeBasePtr> vFoundTypes {};
-				CxxTypeVisitor visitor { vFoundTypes, newConfig };
+				CxxTypeVisitor visitor { vFoundTypes, newConfig, m_pTagsCache };
 				std::optional<cpp::TypeBaseInfo> sNewBaseInfo = std::nullopt;
 
 				clang::EnumDecl* pEnumDecl = pAsEnum->getDecl();
@@ -530,9 +545,7 @@ namespace rg3::llvm::visitors
 
 				if (pEnumDecl)
 				{
-					visitor.TraverseDecl(pEnumDecl);
-
-					if (!vFoundTypes.empty())
+					if (visitor.collectEnum(pEnumDecl))
 					{
 						if (sNewBaseInfo.has_value())
 						{
@@ -599,7 +612,7 @@ namespace rg3::llvm::visitors
 
 						ExtraPropertiesFilter propertiesFilter { annotation.knownProperties };
 						ExtraFunctionsFilter functionsFilter { annotation.knownFunctions };
-						CxxTemplateSpecializationVisitor visitor { newConfig, pTemplateSpecDecl, !annotation.knownProperties.empty(), !annotation.knownFunctions.empty(), propertiesFilter, functionsFilter };
+						CxxTemplateSpecializationVisitor visitor { newConfig, pTemplateSpecDecl, !annotation.knownProperties.empty(), !annotation.knownFunctions.empty(), propertiesFilter, functionsFilter, m_pTagsCache };
 
 						// Here we need to find a correct specialization, but for glm there are no specialization at all...
 						if (auto* pSpecializedTemplate = pTemplateSpecDecl->getSpecializedTemplate())
@@ -626,25 +639,25 @@ namespace rg3::llvm::visitors
 
 								if (visitor.getClassDefInfo().has_value())
 								{
-									const auto& sClassDef = visitor.getClassDefInfo().value();
+									SClassDefInfo sClassDef = visitor.takeClassDefInfo();
 
 									// Nice, smth found. Need to register type 'as-is' because parent router will override our results if required
 									auto pNewType = std::make_unique<cpp::TypeClass>(
-										sClassDef.sClassName,
-										sClassDef.sPrettyClassName,
-										sClassDef.sNameSpace,
-										sClassDef.sDefLocation,
-										sClassDef.sTags,
-										sClassDef.vProperties,
-										sClassDef.vFunctions,
-										sClassDef.vFriends,
+										std::move(sClassDef.sClassName),
+										std::move(sClassDef.sPrettyClassName),
+										std::move(sClassDef.sNameSpace),
+										std::move(sClassDef.sDefLocation),
+										std::move(sClassDef.sTags),
+										std::move(sClassDef.vProperties),
+										std::move(sClassDef.vFunctions),
+										std::move(sClassDef.vFriends),
 										sClassDef.bIsStruct,
 										sClassDef.bTriviallyConstructible,
 										sClassDef.bHasCopyConstructor,
 										sClassDef.bHasCopyAssignOperator,
 										sClassDef.bHasMoveConstructor,
 										sClassDef.bHasMoveAssignOperator,
-										sClassDef.vParents);
+										std::move(sClassDef.vParents));
 
 									pNewType->setProducedFromTemplate();
 
@@ -657,7 +670,7 @@ namespace rg3::llvm::visitors
 
 										const std::string sOldPrettyTypeName = pNewType->getPrettyName();
 										std::string sName = opaquePtr.getAsString(printingPolicy);
-										std::string sPrettyName = sClassDef.sNameSpace.isEmpty() ? sName : fmt::format("{}::{}", sClassDef.sNameSpace.asString(), sName);
+										std::string sPrettyName = pNewType->getNamespace().isEmpty() ? sName : fmt::format("{}::{}", pNewType->getNamespace().asString(), sName);
 
 										for (auto& func : pNewType->getFunctions())
 										{
@@ -667,7 +680,7 @@ namespace rg3::llvm::visitors
 											}
 										}
 
-										pNewType->overrideTypeData(sName, sPrettyName);
+										pNewType->overrideTypeData(std::move(sName), std::move(sPrettyName));
 									}
 
 									m_vFoundTypes.emplace_back(std::move(pNewType));
@@ -684,29 +697,29 @@ namespace rg3::llvm::visitors
 				// It's record type (actually CXX record)
 				rg3::llvm::CompilerConfig newConfig = m_compilerConfig;
 				newConfig.bAllowCollectNonRuntimeTypes = true; // Yep, it's hack
-				CxxClassTypeVisitor sTypeVisitor { newConfig };
+				CxxClassTypeVisitor sTypeVisitor { newConfig, m_pTagsCache };
 
 				// Ok, let's run
 				if (auto pCxxDecl = ::llvm::dyn_cast<clang::CXXRecordDecl>(pAsRecordType->getDecl()))
 				{
-					sTypeVisitor.TraverseDecl(pCxxDecl);
+					sTypeVisitor.collect(pCxxDecl);
 
 					auto pClassType = std::make_unique<cpp::TypeClass>(
-										  sTypeVisitor.sClassName,
-										  sTypeVisitor.sClassPrettyName,
-										  sTypeVisitor.sNameSpace,
-										  sTypeVisitor.sDefinitionLocation,
-										  sTypeVisitor.vTags,
-										  sTypeVisitor.foundProperties,
-										  sTypeVisitor.foundFunctions,
-										  sTypeVisitor.foundFriends,
+										  std::move(sTypeVisitor.sClassName),
+										  std::move(sTypeVisitor.sClassPrettyName),
+										  std::move(sTypeVisitor.sNameSpace),
+										  std::move(sTypeVisitor.sDefinitionLocation),
+										  std::move(sTypeVisitor.vTags),
+										  std::move(sTypeVisitor.foundProperties),
+										  std::move(sTypeVisitor.foundFunctions),
+										  std::move(sTypeVisitor.foundFriends),
 										  sTypeVisitor.bIsStruct,
 										  sTypeVisitor.bTriviallyConstructible,
 										  sTypeVisitor.bHasCopyConstructor,
 										  sTypeVisitor.bHasCopyAssignOperator,
 										  sTypeVisitor.bHasMoveConstructor,
 										  sTypeVisitor.bHasMoveAssignOperator,
-										  sTypeVisitor.parentClasses);
+										  std::move(sTypeVisitor.parentClasses));
 
 					if (sTypeVisitor.bIsDeclaredInsideAnotherType)
 					{
@@ -10,7 +10,8 @@ namespace rg3::llvm::visitors
 		clang::ClassTemplateSpecializationDecl* pTemplateSpecialization,
 		bool bHasProperties, bool bHasFunctions,
 		PropertyFilterFunc propertyFilterFunc,
-		FunctionFilterFunc functionFilterFunc
+		FunctionFilterFunc functionFilterFunc,
+		CommentTagsCache* pTagsCache
 	)
 		: m_compilerConfig(cc)
 		, m_pSpecialization(pTemplateSpecialization)
@@ -19,6 +20,7 @@ namespace rg3::llvm::visitors
 		, m_bHasFunctions(bHasFunctions)
 		, m_propertyFilterFunc(propertyFilterFunc)
 		, m_functionFilterFunc(functionFilterFunc)
+		, m_pTagsCache(pTagsCache)
 	{
 		// Collect instance cache
 		const clang::TemplateArgumentList& templateArgs = m_pSpecialization->getTemplateArgs();
@@ -53,18 +55,8 @@ namespace rg3::llvm::visitors
 			return true; // skip uncompleted types
 
 		// Extract comment
-		clang::ASTContext& ctx = cxxRecordDecl->getASTContext();
-		clang::SourceManager& sm = ctx.getSourceManager();
-
-		const clang::RawComment* rawComment = ctx.getRawCommentForDeclNoCache(cxxRecordDecl);
-
 		SClassDefInfo& sDef = m_classDefInfo.emplace();
-
-		if (rawComment)
-		{
-			const auto rawCommentStr = rawComment->getFormattedText(sm, ctx.getDiagnostics());
-			sDef.sTags = cpp::Tag::parseFromCommentString(rawCommentStr);
-		}
+		sDef.sTags = CommentTagsCache::lookup(m_pTagsCache, cxxRecordDecl).vTags;
 
 		if (!sDef.sTags.hasTag(std::string(rg3::cpp::BuiltinTags::kRuntime)) && !m_compilerConfig.bAllowCollectNonRuntimeTypes)
 		{
@@ -95,12 +87,7 @@ namespace rg3::llvm::visitors
 			const clang::RecordDecl* recordDecl = baseSpecifier.getType()->getAsRecordDecl();
 			if (recordDecl)
 			{
-				const clang::RawComment* parentClassRawComment = ctx.getRawCommentForDeclNoCache(recordDecl);
-				if (parentClassRawComment)
-				{
-					const auto rawCommentStr = parentClassRawComment->getFormattedText(sm, ctx.getDiagnostics());
-					parent.vTags = cpp::Tag::parseFromCommentString(rawCommentStr);
-				}
+				parent.vTags = CommentTagsCache::lookup(m_pTagsCache, recordDecl).vTags;
 			}
 			
 			if (baseSpecifier.isVirtual())
@@ -190,15 +177,7 @@ namespace rg3::llvm::visitors
 		}
 
 		// Save other info
-		clang::ASTContext& ctx = cxxFieldDecl->getASTContext();
-		clang::SourceManager& sm = ctx.getSourceManager();
-
-		const clang::RawComment* rawComment = ctx.getRawCommentForDeclNoCache(cxxFieldDecl);
-		if (rawComment)
-		{
-			const auto rawCommentStr = rawComment->getFormattedText(sm, ctx.getDiagnostics());
-			newProperty.vTags = cpp::Tag::parseFromCommentString(rawCommentStr);
-		}
+		newProperty.vTags = CommentTagsCache::lookup(m_pTagsCache, cxxFieldDecl).vTags;
 
 		// Restore @property tag if not defined
 		const std::string ksPropTagName { cpp::BuiltinTags::kProperty };
@@ -250,14 +229,7 @@ namespace rg3::llvm::visitors
 			return true; // Ignored
 
 		clang::ASTContext& ctx = cxxMethodDecl->getASTContext();
-		clang::SourceManager& sm = ctx.getSourceManager();
-
-		const clang::RawComment* rawComment = ctx.getRawCommentForDeclNoCache(cxxMethodDecl);
-		if (rawComment)
-		{
-			const auto rawCommentStr = rawComment->getFormattedText(sm, ctx.getDiagnostics());
-			newFunction.vTags = cpp::Tag::parseFromCommentString(rawCommentStr);
-		}
+		newFunction.vTags = CommentTagsCache::lookup(m_pTagsCache, cxxMethodDecl).vTags;
 
 		newFunction.eVisibility = Utils::getDeclVisibilityLevel(cxxMethodDecl);
 
@@ -376,6 +348,13 @@ namespace rg3::llvm::visitors
 		return m_classDefInfo;
 	}
 
+	SClassDefInfo CxxTemplateSpecializationVisitor::takeClassDefInfo()
+	{
+		SClassDefInfo sDef = std::move(m_classDefInfo.value());
+		m_classDefInfo.reset();
+		return sDef;
+	}
+
 	bool CxxTemplateSpecializationVisitor::tryResolveTemplateType(rg3::cpp::TypeStatement& stmt, const clang::Type* pOriginalType, clang::ASTContext& ctx) const
 	{
 		if (!pOriginalType)
@@ -20,26 +20,23 @@
 
 namespace rg3::llvm::visitors
 {
-	static cpp::Tags getTagsForDecl(clang::Decl* pDecl, bool& bHasComment)
+	CxxTypeVisitor::CxxTypeVisitor(std::vector<rg3::cpp::TypeBasePtr>& collectedTypes, const CompilerConfig& cc, CommentTagsCache* pTagsCache) : m_collectedTypes(collectedTypes), compilerConfig(cc), m_pTagsCache(pTagsCache)
 	{
-		// Extract comment
-		clang::ASTContext& ctx = pDecl->getASTContext();
-		clang::SourceManager& sm = ctx.getSourceManager();
+	}
+
+	bool CxxTypeVisitor::collectEnum(clang::EnumDecl* enumDecl)
+	{
+		const size_t iKnownTypes = m_collectedTypes.size();
+
+		if (!enumDecl || !VisitEnumDecl(enumDecl) || m_collectedTypes.size() == iKnownTypes)
+			return false;
 
-		const clang::RawComment* rawComment = ctx.getRawCommentForDeclNoCache(pDecl);
-		if (!rawComment)
+		for (clang::EnumConstantDecl* pConstant : enumDecl->enumerators())
 		{
-			bHasComment = false;
-			return {};
+			VisitEnumConstantDecl(pConstant);
 		}
 
-		std::string rawCommentStr = rawComment->getFormattedText(sm, ctx.getDiagnostics());
-		bHasComment = !rawCommentStr.empty();
-		return cpp::Tag::parseFromCommentString(rawCommentStr);
-	}
-
-	CxxTypeVisitor::CxxTypeVisitor(std::vector<rg3::cpp::TypeBasePtr>& collectedTypes, const CompilerConfig& cc) : m_collectedTypes(collectedTypes), compilerConfig(cc)
-	{
+		return true;
 	}
 
 	bool CxxTypeVisitor::VisitEnumDecl(clang::EnumDecl* enumDecl)
@@ -48,17 +45,16 @@ namespace rg3::llvm::visitors
 			return true; // skip incomplete declarations
 
 		// Extract tags
-		bool bHasComment = false;
-		cpp::Tags tags = getTagsForDecl(enumDecl, bHasComment);
+		CommentTagsCache::Entry comment = CommentTagsCache::lookup(m_pTagsCache, enumDecl);
 
-		if (!bHasComment && !compilerConfig.bAllowCollectNonRuntimeTypes)
+		if (!comment.bHasComment && !compilerConfig.bAllowCollectNonRuntimeTypes)
 		{
 			// skip this decl
 			return true;
 		}
 
 		// Check this somewhere else
-		if (!tags.hasTag(std::string(rg3::cpp::BuiltinTags::kRuntime)) && !compilerConfig.bAllowCollectNonRuntimeTypes)
+		if (!comment.vTags.hasTag(std::string(rg3::cpp::BuiltinTags::kRuntime)) && !compilerConfig.bAllowCollectNonRuntimeTypes)
 			return true;
 
 		// Create entry
@@ -91,20 +87,20 @@ namespace rg3::llvm::visitors
 
 		m_collectedTypes.emplace_back(
 			std::make_unique<rg3::cpp::TypeEnum>(
-				typeName,
-				enumPrettyName,
-				nameSpace,
-				aDefLoc,
-				tags,
-				entries,
+				std::move(typeName),
+				std::move(enumPrettyName),
+				std::move(nameSpace),
+				std::move(aDefLoc),
+				std::move(comment.vTags),
+				std::move(entries),
 				bScoped,
-				underlyingTypeRef
+				std::move(underlyingTypeRef)
 			)
 		);
 
 		m_collectedTypeIDs.emplace_back(enumDecl->getID()); // or use global id?
 
-		if (typeName.find("::") != std::string::npos)
+		if (m_collectedTypes.back()->getName().find("::") != std::string::npos)
 			m_collectedTypes.back()->setDeclaredInAnotherType(); // type name never contains :: when it's not declared inside another type
 
 		return true;
@@ -158,28 +154,27 @@ namespace rg3::llvm::visitors
 	bool CxxTypeVisitor::VisitCXXRecordDecl(clang::CXXRecordDecl* cxxRecordDecl)
 	{
 		// Logic is too huge, we need to move logic into another unit
-		visitors::CxxClassTypeVisitor cppVisitor { compilerConfig };
-		cppVisitor.TraverseDecl(cxxRecordDecl);
+		visitors::CxxClassTypeVisitor cppVisitor { compilerConfig, m_pTagsCache };
 
-		if (!cppVisitor.sClassName.empty())
+		if (cppVisitor.collect(cxxRecordDecl))
 		{
 			m_collectedTypes.emplace_back(
 				std::make_unique<rg3::cpp::TypeClass>(
-					cppVisitor.sClassName,
-					cppVisitor.sClassPrettyName,
-					cppVisitor.sNameSpace,
-					cppVisitor.sDefinitionLocation,
-					cppVisitor.vTags,
-					cppVisitor.foundProperties,
-					cppVisitor.foundFunctions,
-					cppVisitor.foundFriends,
+					std::move(cppVisitor.sClassName),
+					std::move(cppVisitor.sClassPrettyName),
+					std::move(cppVisitor.sNameSpace),
+					std::move(cppVisitor.sDefinitionLocation),
+					std::move(cppVisitor.vTags),
+					std::move(cppVisitor.foundProperties),
+					std::move(cppVisitor.foundFunctions),
+					std::move(cppVisitor.foundFriends),
 					cppVisitor.bIsStruct,
 					cppVisitor.bTriviallyConstructible,
 					cppVisitor.bHasCopyConstructor,
 					cppVisitor.bHasCopyAssignOperator,
 					cppVisitor.bHasMoveConstructor,
 					cppVisitor.bHasMoveAssignOperator,
-					cppVisitor.parentClasses
+					std::move(cppVisitor.parentClasses)
 				)
 			);
 
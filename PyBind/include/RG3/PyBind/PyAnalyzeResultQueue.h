@@ -0,0 +1,83 @@
+#pragma once
+
+#include <RG3/LLVM/CodeAnalyzer.h>
+
+#include <condition_variable>
+#include <filesystem>
+#include <optional>
+#include <atomic>
+#include <deque>
+#include <mutex>
+
+
+namespace rg3::pybind
+{
+	/**
+	 * @brief Native result of single header. Kept in buffer of worker until all workers are done or passed through AnalyzeResultQueue.
+	 */
+	struct HeaderResult
+	{
+		std::filesystem::path header {};
+		rg3::llvm::AnalyzerResult result {};
+	};
+
+	/**
+	 * @brief Bounded queue of results of headers which are not taken by python yet (see PyAnalyzerContext::stream).
+	 *        Workers push results while consumer of stream takes them. Every wait is interrupted when analyze cancelled (see wakeUpAll).
+	 */
+	class AnalyzeResultQueue
+	{
+	 public:
+		/**
+		 * @param pCancelled - cancellation flag of analyze (must outlive queue)
+		 */
+		explicit AnalyzeResultQueue(const std::atomic_bool* pCancelled);
+
+		/**
+		 * @brief Route results of headers into queue instead of buffers of workers
+		 * @param iCapacity - max amount of results in queue: workers are blocked when queue is full
+		 */
+		void enable(size_t iCapacity);
+
+		/**
+		 * @brief Drop results which were not taken and wake up consumer
+		 */
+		void disable();
+
+		[[nodiscard]] bool isEnabled() const;
+
+		/**
+		 * @brief Push result into queue. Blocks while queue is full (back-pressure). Result is dropped when analyze cancelled.
+		 */
+		void push(HeaderResult&& result);
+
+		/**
+		 * @brief Take next result (blocks until result arrived)
+		 * @return result or std::nullopt when all workers are done and queue is drained (or analyze cancelled)
+		 */
+		std::optional<HeaderResult> pop();
+
+		/**
+		 * @brief Mark that workers are done and wait until consumer took every result (or analyze cancelled)
+		 */
+		void finish();
+
+		/**
+		 * @brief Wake up workers blocked on full queue & consumer (call after cancellation flag was set)
+		 */
+		void wakeUpAll();
+
+	 private:
+		[[nodiscard]] bool isCancelled() const;
+
+	 private:
+		const std::atomic_bool* m_pCancelled { nullptr };
+		mutable std::mutex m_lock;
+		std::condition_variable m_notEmptyCV;
+		std::condition_variable m_notFullCV;
+		bool m_bEnabled { false };
+		bool m_bProducersDone { false };
+		size_t m_iCapacity { 1 };
+		std::deque<HeaderResult> m_results {};
+	};
+}
\ No newline at end of file
@@ -0,0 +1,56 @@
+#pragma once
+
+#include <RG3/LLVM/AnalyzeCostHistory.h>
+
+#include <filesystem>
+#include <utility>
+#include <chrono>
+#include <vector>
+
+
+namespace rg3::pybind
+{
+	/**
+	 * @brief Task of run with estimated cost (see PyAnalyzerContext::getSchedulerStats)
+	 */
+	struct ScheduledTask
+	{
+		std::vector<std::filesystem::path> vHeaders {}; /// Single header or headers of umbrella
+		std::size_t iConfigId { 0 }; /// Index of compiler config of run (see PyAnalyzerContext::setCompileCommandsFile)
+		std::chrono::nanoseconds estimatedCost { 0 };
+		std::size_t iHistoryHits { 0 }; /// Headers which cost was taken from history
+	};
+
+	/**
+	 * @brief Plans tasks of run: single headers or umbrella batches, ordered by estimated cost (see PyAnalyzerContext::setUseCostAwareScheduling)
+	 */
+	class AnalyzeScheduler
+	{
+	 public:
+		/**
+		 * @brief Make task per header (or per umbrella batch of headers with same config). Order of headers is kept.
+		 * @param vHeaderConfigIds - config of each header (same order as vHeaders)
+		 * @param iBatchSize - headers per umbrella when bUmbrellaMode is set (0 - pick by cost, see makeUmbrellaBatches)
+		 */
+		static std::vector<ScheduledTask> planTasks(const std::vector<std::filesystem::path>& vHeaders, const std::vector<std::size_t>& vHeaderConfigIds, std::size_t iConfigsCount, bool bUmbrellaMode, int iBatchSize, int iWorkersAmount);
+
+		/**
+		 * @brief Estimate cost of each task and sort them: most expensive first
+		 * @param pHistory - measured time of headers (optional)
+		 */
+		static void orderByCost(std::vector<ScheduledTask>& vTasks, const std::vector<std::filesystem::path>& vHeaders, const rg3::llvm::AnalyzeCostHistory* pHistory);
+
+		/**
+		 * @brief Split headers into umbrella batches (keeps order of headers)
+		 * @param iBatchSize - exact amount of headers per batch. 0 - pack by cost: size of header is used as cost, every worker should get ~2 batches to balance tail of run
+		 */
+		static std::vector<std::vector<std::filesystem::path>> makeUmbrellaBatches(const std::vector<std::filesystem::path>& vHeaders, int iBatchSize, int iWorkersAmount);
+
+		/**
+		 * @brief Estimated analyze cost of headers (same order as vHeaders): measured time from history when header is known,
+		 *        otherwise estimation by size & includes (see AnalyzeCostHistory::estimateCost) converted into time by ratio of known headers
+		 * @return cost & flag 'taken from history' of each header
+		 */
+		static std::vector<std::pair<std::chrono::nanoseconds, bool>> estimateHeadersCost(const std::vector<std::filesystem::path>& vHeaders, const rg3::llvm::AnalyzeCostHistory* pHistory);
+	};
+}
\ No newline at end of file
@@ -0,0 +1,16 @@
+#pragma once
+
+#include <RG3/LLVM/AnalyzeStats.h>
+
+#define BOOST_PYTHON_STATIC_LIB
+#include <boost/python.hpp>
+
+
+namespace rg3::pybind
+{
+	/**
+	 * @brief Put phase times (milliseconds) & counters of stats into dict
+	 * @note Keys: env_detection_ms, preamble_ms, instance_creation_ms, parse_ms, visit_ms, total_ms, translation_units, decls_visited, decls_pruned, types_emitted, peak_rss_growth_bytes
+	 */
+	void fillAnalyzeStatsDict(boost::python::dict& result, const rg3::llvm::AnalyzeStats& stats);
+}
\ No newline at end of file
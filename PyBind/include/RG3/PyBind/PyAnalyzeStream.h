@@ -0,0 +1,31 @@
+#pragma once
+
+#define BOOST_PYTHON_STATIC_LIB
+#include <boost/python.hpp>
+#include <boost/shared_ptr.hpp>
+#include <boost/noncopyable.hpp>
+
+
+namespace rg3::pybind
+{
+	class PyAnalyzerContext;
+
+	/**
+	 * @brief Python iterator over results of headers of running analyze (see PyAnalyzerContext::stream)
+	 * @python Mapped to type AnalyzeStream
+	 */
+	class PyAnalyzeStream : public boost::noncopyable
+	{
+	 public:
+		explicit PyAnalyzeStream(boost::shared_ptr<PyAnalyzerContext> pContext);
+		~PyAnalyzeStream();
+
+		/// Python Magic
+		static boost::python::object __iter__(const boost::python::object& self);
+		boost::python::object __next__();
+
+	 private:
+		boost::shared_ptr<PyAnalyzerContext> m_pContext { nullptr };
+		bool m_bFinished { false };
+	};
+}
\ No newline at end of file
@@ -1,8 +1,13 @@
 #pragma once
 
 #include <RG3/PyBind/PyTypeBase.h>
+#include <RG3/PyBind/PyAnalyzeScheduler.h>
 #include <RG3/LLVM/CodeAnalyzer.h>
 #include <RG3/LLVM/Compiler.h>
+#include <RG3/LLVM/PrecompiledHeaderCache.h>
+#include <RG3/LLVM/FileWatcher.h>
+#include <RG3/Daemon/DaemonProtocol.h>
+#include <RG3/Cpp/TypeReferenceResolver.h>
 
 #define BOOST_PYTHON_STATIC_LIB
 #include <boost/python.hpp>
@@ -10,9 +15,15 @@
 #include <boost/noncopyable.hpp>
 
 #include <atomic>
+#include <chrono>
+#include <optional>
+#include <unordered_map>
 #include <vector>
+#include <thread>
+#include <functional>
 #include <filesystem>
 #include <shared_mutex>
+#include <condition_variable>
 
 
 namespace rg3::pybind
@@ -20,7 +31,7 @@ namespace rg3::pybind
 	/**
 	 * @brief Handle request to analyze multiple header files at once. Single instance could use multiple workers and share types data base between analyzers.
 	 * @note This class is not copyable.
-	 * @note When analyze process running main context thread will be locked (ie analyzer context will wait until all workers will finish their jobs)
+	 * @note analyze() blocks calling thread until all workers will finish their jobs. analyze_async() returns immediately (see wait, cancel & progress)
 	 * @note All produced types will be alive until object is in use
 	 * @python Mapped to type AnalyzerContext
 	 * @example
@@ -75,12 +86,95 @@ namespace rg3::pybind
 		void setEnableDeepAnalysis(bool bEnableDeepAnalysis);
 		bool isDeepAnalysisEnabled() const;
 
+		void setUseInProcessEnvDetection(bool bUseInProcess);
+		bool isInProcessEnvDetectionUsed() const;
+
+		void setGccToolchain(const std::string& sGccToolchain);
+		[[nodiscard]] std::string getGccToolchain() const;
+
+		void setUseSharedFileCache(bool bUseSharedFileCache);
+		bool isSharedFileCacheUsed() const;
+
+		void setPreambleHeaders(const boost::python::list& preambleHeaders);
+		[[nodiscard]] boost::python::list getPreambleHeaders() const;
+
+		void setSourceFilter(rg3::llvm::SourceFilter eSourceFilter);
+		[[nodiscard]] rg3::llvm::SourceFilter getSourceFilter() const;
+
+		void setSourceAllowGlobs(const boost::python::list& allowGlobs);
+		[[nodiscard]] boost::python::list getSourceAllowGlobs() const;
+
+		void setSourceDenyGlobs(const boost::python::list& denyGlobs);
+		[[nodiscard]] boost::python::list getSourceDenyGlobs() const;
+
+		void setUseAutoPreamble(bool bUseAutoPreamble);
+		bool isAutoPreambleUsed() const;
+
+		void setUseUmbrellaMode(bool bUseUmbrellaMode);
+		bool isUmbrellaModeUsed() const;
+
+		void setUmbrellaBatchSize(int iBatchSize);
+		[[nodiscard]] int getUmbrellaBatchSize() const;
+
+		void setIncrementalCacheDir(const std::string& sCacheDir);
+		[[nodiscard]] std::string getIncrementalCacheDir() const;
+
+		void setDaemonSocket(const std::string& sSocketPath);
+		[[nodiscard]] std::string getDaemonSocket() const;
+
+		void setCompileCommandsFile(const std::string& sDatabaseFile);
+		[[nodiscard]] std::string getCompileCommandsFile() const;
+
+		void setCostHistoryFile(const std::string& sHistoryFile);
+		[[nodiscard]] std::string getCostHistoryFile() const;
+
+		void setUseCostAwareScheduling(bool bUseCostAwareScheduling);
+		bool isCostAwareSchedulingUsed() const;
+
+		void setUseWatchMode(bool bUseWatchMode);
+		bool isWatchModeUsed() const;
+
 		boost::python::object pyGetTypeOfTypeReference(const rg3::cpp::TypeReference& typeReference);
 
 		[[nodiscard]] const boost::python::list& getFoundIssues() const;
 		[[nodiscard]] const boost::python::list& getFoundTypes() const;
 		[[nodiscard]] const rg3::llvm::CompilerConfig& getCompilerConfig() const { return m_compilerConfig; }
 
+		/**
+		 * @brief Scheduler counters of last analyze: queue depth (current & peak), idle time and wake ups of each worker,
+		 *        order of tasks with their estimated cost (see setUseCostAwareScheduling)
+		 * @note Returns empty dict while analyze in progress
+		 */
+		[[nodiscard]] boost::python::dict getSchedulerStats() const;
+
+		/**
+		 * @brief Hits & misses of shared file cache (stat calls & file reads) of last analyze
+		 * @note Returns empty dict while analyze in progress or when shared file cache disabled
+		 */
+		[[nodiscard]] boost::python::dict getFileCacheStats() const;
+
+		/**
+		 * @brief Cost of last analyze: wall time, sum of phase times & counters of all translation units, time of conversion into python objects,
+		 *        process peak memory and stats of each translation unit (most expensive first)
+		 * @note Returns empty dict while analyze in progress
+		 */
+		[[nodiscard]] boost::python::dict getStats() const;
+
+		/**
+		 * @brief Precompiled preamble report of last analyze: built & rebuilt PCH files, uses, build time & estimated saved parse time
+		 */
+		[[nodiscard]] boost::python::dict getPreambleStats() const;
+
+		/**
+		 * @brief Headers which results were taken from incremental cache during last analyze
+		 */
+		[[nodiscard]] boost::python::list getReusedHeaders() const;
+
+		/**
+		 * @brief Headers which were analyzed during last analyze (changed or not cached). Empty when incremental cache disabled.
+		 */
+		[[nodiscard]] boost::python::list getRecomputedHeaders() const;
+
 	 public:
 		/**
 		 * @fn analyze
@@ -90,6 +184,65 @@ namespace rg3::pybind
 		 */
 		bool analyze();
 
+		/**
+		 * @fn analyzeAsync
+		 * @brief Start analyze in background thread and return immediately. Results (types, issues & stats) are available when isFinished() is true.
+		 * @param pSelf - context (python object is kept alive until analyze is done)
+		 * @param progressCallback - optional callable(dict) (see getProgress). Called with GIL from background thread when headers completed and once at the end
+		 * @return false when analyze already in progress
+		 */
+		static bool analyzeAsync(const boost::shared_ptr<PyAnalyzerContext>& pSelf, boost::python::object progressCallback);
+
+		/**
+		 * @fn stream
+		 * @brief Start analyze in background (see analyzeAsync) and return iterator over results of headers in order of completion.
+		 *        Each item is dict: header, types (types which were not reported by previous items) & issues.
+		 * @param iMaxPending - max amount of results which are not taken by iterator yet. Workers wait when limit reached (back-pressure)
+		 * @return AnalyzeStream or None when analyze already in progress
+		 * @note Iterator must be consumed: dropped iterator cancels analyze. After last item context contains all results (types, issues & stats)
+		 */
+		static boost::python::object stream(const boost::shared_ptr<PyAnalyzerContext>& pSelf, int iMaxPending);
+
+		/**
+		 * @brief Take next result of stream (GIL released while waiting)
+		 * @return dict or None when stream is drained
+		 */
+		boost::python::object nextStreamResult();
+
+		/**
+		 * @fn wait
+		 * @brief Wait for analyze started by analyzeAsync (GIL is released while waiting)
+		 * @param fTimeoutSeconds - max time to wait. Negative - wait until done
+		 * @return true when analyze is done (or was not started)
+		 */
+		bool wait(double fTimeoutSeconds);
+
+		/**
+		 * @fn waitChanges
+		 * @brief Wait for changes of files which were read by analyze (headers & their includes) or placed in include directories,
+		 *        then re-analyze only headers which (transitively) include changed files. Types & issues of context are updated.
+		 * @param fTimeoutSeconds - max time to wait for changes. Negative - wait until something changed
+		 * @return dict: changed_files, reanalyzed_headers, added & changed (types), removed (pretty names); None on timeout
+		 * @note Available after successful analyze (or analyze_async) with enabled watch mode, raises RuntimeError otherwise. GIL is released while waiting & analyzing.
+		 */
+		boost::python::object waitChanges(double fTimeoutSeconds);
+
+		/**
+		 * @fn cancel
+		 * @brief Drop queued headers and abort running compilers. Headers completed before cancel stay in results, analyze reports 'RG3|Analyze cancelled' issue.
+		 */
+		void cancel();
+
+		/**
+		 * @return result of last finished analyze (same as value returned by analyze())
+		 */
+		[[nodiscard]] bool isLastAnalyzeSucceeded() const;
+
+		/**
+		 * @brief Progress of current (or last) analyze: completed_headers, total_headers, types_found (before deduplication), elapsed_ms, cancelled & finished
+		 */
+		[[nodiscard]] boost::python::dict getProgress() const;
+
 		/**
 		 * @fn isFinished
 		 * @return true if analyzer finished or not started
@@ -97,7 +250,54 @@ namespace rg3::pybind
 		bool isFinished() const;
 
 	 private:
-		bool runAnalyze();
+		/**
+		 * @brief Prepare run: drop python results of previous run (GIL required)
+		 */
+		void beginRun();
+
+		/**
+		 * @brief Detect environment, schedule headers, run workers & merge their results. Doesn't touch python objects (called without GIL)
+		 */
+		bool runNative(const std::function<void()>& onProgress);
+
+		/**
+		 * @brief Analyze given headers (all headers of context or headers affected by changes in watch mode)
+		 */
+		bool runNativeOn(const std::vector<std::filesystem::path>& vHeaders, const std::function<void()>& onProgress);
+
+		/**
+		 * @brief Send headers & config to resident daemon (see setDaemonSocket) and take its results. Doesn't touch python objects (called without GIL)
+		 */
+		bool runOnDaemon();
+
+		/**
+		 * @brief Convert results into python objects, resolve references & collect stats (GIL required)
+		 */
+		bool finishRun(bool bNativeResult);
+
+		/**
+		 * @brief Subscribe to directories of headers, their dependencies & include directories (see setUseWatchMode). Called without GIL.
+		 */
+		void startWatch();
+
+		/**
+		 * @brief Headers (indices in m_headersToPrepare) which read any of changed files
+		 */
+		std::vector<std::size_t> collectAffectedHeaders(const rg3::llvm::FileChanges& changes) const;
+
+		/**
+		 * @brief Re-analyze affected headers, merge them with results of other headers & compute delta. Called without GIL.
+		 */
+		bool runWatchedHeaders(const std::vector<std::size_t>& vAffected);
+
+		/**
+		 * @brief Make python dict of last delta (GIL required)
+		 */
+		boost::python::dict makeWatchDelta(const rg3::llvm::FileChanges& changes) const;
+
+		void reportProgress();
+		void callProgressCallback();
+		void joinAsyncThread();
 
 	 private:
 		struct RuntimeContext;
@@ -107,6 +307,37 @@ namespace rg3::pybind
 		std::vector<std::filesystem::path> m_headersToPrepare {}; /// List of headers which will be prepared
 		rg3::llvm::CompilerConfig m_compilerConfig {}; /// Shared config for all analyzer instances (they 'll use it in read only mode)
 
+		struct DaemonRunStats
+		{
+			std::uint32_t iReusedHeaders { 0 };
+			std::uint32_t iAnalyzedHeaders { 0 };
+			std::chrono::nanoseconds analyzeTime { 0 };
+		};
+
+		/**
+		 * @brief Result of single header kept by watch mode. Types are serialized: merged types are owned by python objects.
+		 */
+		struct WatchedHeader
+		{
+			std::filesystem::path header {};
+			std::vector<std::string> vDependencies {}; /// Absolute paths of files read by compiler
+			std::vector<std::pair<std::string, std::string>> vTypes {}; /// Pretty name & serialized type
+			rg3::llvm::AnalyzerResult::CompilerIssuesVector vIssues {};
+		};
+
+		struct WatchState
+		{
+			std::unique_ptr<rg3::llvm::FileWatcher> pWatcher { nullptr };
+			std::vector<WatchedHeader> vHeaders {}; /// Same order as m_headersToPrepare
+			std::unordered_map<std::string, std::vector<std::size_t>> dependents {}; /// File -> headers which read it
+
+			// Delta of last change
+			std::vector<std::filesystem::path> vReanalyzedHeaders {};
+			std::vector<std::string> vAddedTypes {};
+			std::vector<std::string> vRemovedTypes {};
+			std::vector<std::string> vChangedTypes {};
+		};
+
 		// Found subjects
 		struct PyFoundSubjects
 		{
@@ -124,6 +355,46 @@ namespace rg3::pybind
 
 		int m_iWorkersAmount { 2 }; /// How much workers allowed to be used. Note: value must be in range [1, N) where N - count of cpu cores * 2
 		bool m_bIgnoreRuntimeTag { false }; /// Should code gen use all possible types or not
+		bool m_bInProcessEnvDetection { false }; /// Detect compiler environment via clang Driver instead of running system compiler
+		std::filesystem::path m_sGccToolchain {}; /// GCC installation for in-process detection (--gcc-toolchain)
+		bool m_bUseSharedFileCache { true }; /// Share stat & file content cache between all workers of single run
+		bool m_bUseAutoPreamble { false }; /// Precompile angled includes which are common for most of headers
+		bool m_bUseUmbrellaMode { false }; /// Analyze batches of headers inside single umbrella translation unit
+		int m_iUmbrellaBatchSize { 0 }; /// Headers per umbrella. 0 - pick batches by cost (file size) & amount of workers
+		std::filesystem::path m_sIncrementalCacheDir {}; /// Directory of incremental cache (manifest & results). Empty - disabled
+		std::filesystem::path m_sDaemonSocket {}; /// Socket of rg3d which will analyze headers instead of this process. Empty - analyze locally
+		std::optional<DaemonRunStats> m_lastDaemonStats {}; /// Counters of last run on daemon
+		std::filesystem::path m_sCompileCommandsFile {}; /// compile_commands.json with per-file flags (applied over m_compilerConfig). Empty - same config for every header
+		std::size_t m_iLastConfigsCount { 0 }; /// Distinct compiler configs of last run
+		std::filesystem::path m_sCostHistoryFile {}; /// File of measured analyze time of headers. Empty - costs are estimated on each run
+		bool m_bUseCostAwareScheduling { true }; /// Run most expensive tasks first
+		std::vector<ScheduledTask> m_vLastSchedule {}; /// Tasks of last run in order of scheduling
+		bool m_bUseWatchMode { false }; /// Keep results & dependencies of headers after analyze and watch files for changes (see waitChanges)
+		std::unique_ptr<WatchState> m_pWatchState { nullptr }; /// Watch of last successful analyze (when watch mode enabled)
+		std::vector<std::filesystem::path> m_vReusedHeaders {}; /// Headers reused from incremental cache during last run
+		std::vector<std::filesystem::path> m_vRecomputedHeaders {}; /// Headers analyzed during last run (when incremental cache enabled)
+		std::vector<std::string> m_vLastPreambleHeaders {}; /// Preamble headers of last run (user listed + auto detected)
+		rg3::llvm::PrecompiledHeaderCache::Stats m_preambleStats {}; /// Preamble stats of last run
+		rg3::llvm::AnalyzeStats m_lastRunStats {}; /// Sum of stats of translation units of last run (totalTime - wall time of run)
+		std::chrono::nanoseconds m_conversionTime { 0 }; /// Time spent to convert results of last run into python objects
+		std::chrono::nanoseconds m_referenceResolutionTime { 0 }; /// Time spent to resolve type references of last run natively (deep analysis only)
+		rg3::cpp::TypeReferenceResolver::Stats m_referenceStats {};
+		std::size_t m_iCachedHeaders { 0 }; /// Headers reused from incremental cache during last run
+		boost::python::list m_pyTranslationUnitStats {}; /// Stats of each translation unit of last run
+
+		// Run state
+		rg3::llvm::AnalyzerResult::CompilerIssuesVector m_vRunIssues {}; /// Issues of run itself (not of headers): environment detection, cancel
+		std::chrono::steady_clock::time_point m_runStartedAt {};
+		std::chrono::nanoseconds m_envDetectionTime { 0 };
+		std::uint64_t m_iRunPeakRssBefore { 0 };
+		bool m_bLastRunResult { false };
+
+		// Async run
+		std::thread m_asyncThread {};
+		std::mutex m_asyncMtx;
+		std::condition_variable m_asyncCV;
+		bool m_bAsyncDone { true }; /// Guarded by m_asyncMtx
+		boost::python::object m_pyProgressCallback {};
 	};
 }
 //PyAnalyzerContext
\ No newline at end of file
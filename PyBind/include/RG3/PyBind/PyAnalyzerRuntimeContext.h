@@ -0,0 +1,338 @@
+#pragma once
+
+#include <RG3/PyBind/PyAnalyzerContext.h>
+#include <RG3/PyBind/PyAnalyzeResultQueue.h>
+#include <RG3/PyBind/PyTypeBase.h>
+#include <RG3/LLVM/CodeAnalyzer.h>
+#include <RG3/LLVM/SharedFileCache.h>
+#include <RG3/LLVM/IncrementalCache.h>
+#include <RG3/LLVM/AnalyzeCostHistory.h>
+#include <RG3/Cpp/TransactionGuard.h>
+#include <RG3/Cpp/TypeReferenceResolver.h>
+#include <condition_variable>
+#include <functional>
+#include <atomic>
+#include <shared_mutex>
+#include <optional>
+#include <variant>
+#include <chrono>
+#include <thread>
+#include <deque>
+#include <mutex>
+
+
+namespace rg3::pybind
+{
+	/**
+	 * Run analyze on specific file
+	 */
+	struct AnalyzeHeaderTask
+	{
+		std::filesystem::path headerPath;
+		rg3::llvm::CompilerConfig compilerConfig;
+	};
+
+	/**
+	 * Run analyze on batch of files inside single (umbrella) translation unit
+	 */
+	struct AnalyzeUmbrellaTask
+	{
+		std::vector<std::filesystem::path> vHeaders;
+		rg3::llvm::CompilerConfig compilerConfig;
+	};
+
+	using ContextTask = std::variant<AnalyzeHeaderTask, AnalyzeUmbrellaTask>;
+
+	class IRuntimeContextBaseOperations
+	{
+	 public:
+		virtual ~IRuntimeContextBaseOperations() noexcept = default;
+
+		/**
+		 * @brief Drop all pending tasks and re-open queue for new tasks
+		 */
+		virtual void clearTasks() = 0;
+
+		/**
+		 * @brief Push task into queue and wake up one of idle workers
+		 */
+		virtual void pushTask(ContextTask&& task) = 0;
+
+		/**
+		 * @brief Mark queue as closed: no more tasks will be pushed. Idle workers will leave their loops when queue become empty.
+		 */
+		virtual void closeTasks() = 0;
+
+		/**
+		 * @brief Take task without waiting
+		 * @return task or std::nullopt when queue is empty
+		 */
+		virtual std::optional<ContextTask> takeTask() = 0;
+	};
+
+	/**
+	 * @brief Release GIL while guard alive (native work of workers & resolvers)
+	 */
+	struct PyGuard final : boost::noncopyable
+	{
+		PyGuard();
+		~PyGuard();
+
+	 private:
+		PyThreadState* m_state { nullptr };
+	};
+
+	/**
+	 * @brief Task queue, workers & merged results of PyAnalyzerContext. Shared by sources of context (core, watch mode & stream), not a part of python API.
+	 */
+	struct PyAnalyzerContext::RuntimeContext : public IRuntimeContextBaseOperations
+	{
+	 public:
+		using Storage = std::deque<ContextTask>;
+		using Clock = std::chrono::steady_clock;
+
+		/**
+		 * @brief Scheduler counters of single worker. Updated only under lockMtx.
+		 */
+		struct WorkerStats
+		{
+			Clock::duration idleTime { Clock::duration::zero() }; /// How long worker was blocked on empty queue
+			size_t iTasksTaken { 0 }; /// How much tasks worker took from queue
+			size_t iWakeUps { 0 }; /// How much times worker was woken up (includes spurious wake ups)
+		};
+
+		/**
+		 * @brief Cost of single translation unit (header or umbrella of headers) or of header reused from incremental cache
+		 */
+		struct TranslationUnitStats
+		{
+			std::vector<std::filesystem::path> vHeaders {};
+			rg3::llvm::AnalyzeStats stats {};
+			bool bFromCache { false };
+		};
+
+		/**
+		 * @brief Progress of current run (see PyAnalyzerContext::getProgress)
+		 */
+		struct Progress
+		{
+			size_t iCompletedHeaders { 0 };
+			size_t iFoundTypes { 0 }; /// Before deduplication
+		};
+
+		/**
+		 * @brief Shared state of queue. Transaction works with same state under same lock.
+		 */
+		struct QueueState
+		{
+			Storage tasks {};
+			bool bClosed { false };
+			size_t iQueueDepthPeak { 0 };
+		};
+
+	 private:
+		std::mutex lockMtx;
+		std::condition_variable tasksCV;
+		QueueState queue;
+		std::vector<std::thread> workers;
+		std::vector<WorkerStats> workersStats;
+		std::vector<std::vector<HeaderResult>> workersResults; /// Buffer of each worker. Accessed only by its worker while workers are running
+		std::vector<std::vector<WatchedHeader>> workersSnapshots; /// Results of headers kept by watch mode (buffer of each worker)
+		bool bCollectSnapshots { false };
+		std::atomic_bool bCancelled { false };
+		std::atomic<size_t> iCompletedHeaders { 0 };
+		std::atomic<size_t> iFoundTypes { 0 };
+		AnalyzeResultQueue resultQueue { &bCancelled }; /// Results of headers taken by stream (see PyAnalyzerContext::stream)
+		std::mutex progressMtx;
+		std::condition_variable progressCV; /// Notified when header completed or worker finished
+		size_t iFinishedWorkers { 0 }; /// Guarded by progressMtx
+		rg3::llvm::AnalyzerResult::CompilerIssuesVector vMergedIssues {};
+		std::vector<cpp::TypeBasePtr> vMergedTypes {}; /// Unique (by pretty name) types of all workers
+		std::optional<rg3::llvm::CompilerEnvironment> m_compilerEnv {};
+		::llvm::IntrusiveRefCntPtr<rg3::llvm::SharedFileCache> m_pFileCache { nullptr };
+		std::shared_ptr<rg3::llvm::IncrementalCache> m_pIncrementalCache { nullptr };
+
+		std::mutex statsMtx;
+		std::vector<TranslationUnitStats> vTranslationUnitStats {};
+		std::chrono::nanoseconds conversionTime { 0 }; /// Time spent to convert native results into python objects (under GIL)
+		std::chrono::nanoseconds referenceResolutionTime { 0 }; /// Time spent to resolve type references natively (see resolveNativeReferences)
+		cpp::TypeReferenceResolver::Stats referenceStats {};
+		cpp::TypeReferenceResolver streamResolver {}; /// Index of types published by stream during run. Guarded by lockMutex of storage
+
+		PyFoundSubjects* pAnalyzerStorage{ nullptr };
+
+		static void pushTaskImpl(QueueState& state, ContextTask&& task);
+
+		static std::optional<ContextTask> takeTaskImpl(QueueState& state);
+
+		static void clearTasksImpl(QueueState& state);
+
+	 public:
+		class Transaction : public cpp::TransactionGuard<std::mutex>, public IRuntimeContextBaseOperations
+		{
+			QueueState& m_state;
+			std::condition_variable& m_cv;
+
+		 public:
+			explicit Transaction(std::mutex& mutex, std::condition_variable& cv, QueueState& state);
+
+			~Transaction();
+
+			void clearTasks() override;
+
+			void pushTask(ContextTask&& task) override;
+
+			void closeTasks() override;
+
+			std::optional<ContextTask> takeTask() override;
+		};
+
+	 public:
+		explicit RuntimeContext(PyFoundSubjects* pSubject);
+
+		~RuntimeContext();
+
+		void clearTasks() override;
+
+		void pushTask(ContextTask&& task) override;
+
+		void closeTasks() override;
+
+		std::optional<ContextTask> takeTask() override;
+
+		/**
+		 * @brief Take task or block current thread until new task arrived or queue closed
+		 * @param iWorkerId - index of worker (used to account idle time)
+		 * @return task or std::nullopt when queue closed and there are no more tasks
+		 */
+		std::optional<ContextTask> waitTask(size_t iWorkerId);
+
+		Transaction startTransaction();
+
+		void setCompilerEnvironment(const rg3::llvm::CompilerEnvironment& compilerEnv);
+
+		void setSharedFileCache(::llvm::IntrusiveRefCntPtr<rg3::llvm::SharedFileCache> pFileCache);
+
+		[[nodiscard]] const ::llvm::IntrusiveRefCntPtr<rg3::llvm::SharedFileCache>& getSharedFileCache() const;
+
+		/**
+		 * @brief Keep serialized results & dependencies of headers for watch mode (see takeSnapshots). Ignored by stream.
+		 */
+		void setCollectSnapshots(bool bCollect);
+
+		/**
+		 * @brief Take snapshots of headers collected by workers
+		 * @note Call only when workers are done (after waitAll)
+		 */
+		std::vector<WatchedHeader> takeSnapshots();
+
+		void setIncrementalCache(std::shared_ptr<rg3::llvm::IncrementalCache> pIncrementalCache);
+
+		[[nodiscard]] const std::shared_ptr<rg3::llvm::IncrementalCache>& getIncrementalCache() const;
+
+		bool runWorkers(int workersAmount);
+
+		/**
+		 * @brief Wait until all workers are done
+		 * @param onProgress - optional: called (from current thread) when amount of completed headers changed
+		 */
+		void waitAll(const std::function<void()>& onProgress = nullptr);
+
+		boost::python::dict getSchedulerStats();
+
+		/**
+		 * @brief Merge buffers of workers: order results by position of header in vHeaders (output does not depend on scheduling)
+		 *        and deduplicate types by pretty name. Doesn't touch python objects, so could be called without GIL.
+		 * @note Call only when workers are done (after waitAll)
+		 */
+		void mergeWorkersResults(const std::vector<std::filesystem::path>& vHeaders);
+
+		/**
+		 * @brief Take results which were merged outside of this context (by rg3d)
+		 */
+		void setMergedResults(rg3::llvm::AnalyzerResult::CompilerIssuesVector&& vIssues, std::vector<cpp::TypeBasePtr>&& vTypes);
+
+		/**
+		 * @brief Convert merged results into python objects (single batch under GIL)
+		 * @note Call after mergeWorkersResults, GIL must be held
+		 */
+		void publishMergedResults();
+
+		/**
+		 * @brief Make python object of type and store it in found types (GIL & write lock of storage required)
+		 * @return object or nullptr when type is not supported or type with same pretty name already stored
+		 */
+		boost::shared_ptr<PyTypeBase> publishType(cpp::TypeBasePtr&& type);
+
+		[[nodiscard]] AnalyzeResultQueue& getResultQueue();
+
+		/**
+		 * @brief Convert result of single header into python dict: header, types (not seen before in this run) & issues (GIL required)
+		 * @param bResolveReferences - link type references of new types with types published before & types of this header (before they become visible)
+		 */
+		boost::python::dict publishStreamResult(HeaderResult&& headerResult, bool bResolveReferences);
+
+		/**
+		 * @brief Forget types published by stream (call when storage is cleared)
+		 */
+		void clearStreamIndex();
+
+		void onHeaderCompleted(size_t iTypes);
+
+		void resetProgress();
+
+		[[nodiscard]] Progress getProgress() const;
+
+		/**
+		 * @brief Drop queued tasks and abort running compilers. Workers skip tasks taken after this call.
+		 */
+		void cancel();
+
+		[[nodiscard]] bool isCancelled() const;
+
+		void clearAnalyzeStats();
+
+		void addTranslationUnitStats(TranslationUnitStats&& unitStats);
+
+		void addConversionTime(std::chrono::nanoseconds duration);
+
+		/**
+		 * @brief Sum of stats of all translation units (cached headers are not counted)
+		 */
+		rg3::llvm::AnalyzeStats getTotalAnalyzeStats();
+
+		/**
+		 * @brief Stats of each translation unit: most expensive first
+		 */
+		boost::python::list getTranslationUnitStats();
+
+		std::chrono::nanoseconds getConversionTime();
+
+		std::chrono::nanoseconds getReferenceResolutionTime();
+
+		cpp::TypeReferenceResolver::Stats getReferenceStats();
+
+		size_t getCachedHeadersCount();
+
+		/**
+		 * @brief Store measured time of analyzed translation units into history. Time of umbrella is split equally between its headers.
+		 * @note Headers reused from incremental cache are not recorded: their time is not a cost of analyze
+		 */
+		void recordCostHistory(rg3::llvm::AnalyzeCostHistory& history);
+
+		/**
+		 * @brief Link type references of merged types with native types (in parallel, without GIL) before they are converted into python objects.
+		 *        Types which were published by stream are indexed instead of merged duplicates (duplicates are dropped by publishMergedResults).
+		 *        Streamed types are only read: their references were linked by publishStreamResult before they became visible to python code.
+		 * @note Call after mergeWorkersResults, GIL must be held (it is released while references are resolved)
+		 */
+		void resolveNativeReferences(int iWorkers);
+
+		void resolveReferences();
+
+	 private:
+		static WatchedHeader makeSnapshot(const std::filesystem::path& header, const rg3::llvm::AnalyzerResult& analyzeResult);
+
+		void workerEntryPoint(size_t iWorkerId, const std::optional<rg3::llvm::CompilerEnvironment>& sCompilerEnvironment);
+	};
+}
\ No newline at end of file
@@ -11,5 +11,9 @@ namespace rg3::pybind
 		static boost::python::str getRuntimeInfo();
 
 		static boost::python::object detectSystemIncludeSources();
+		static boost::python::object detectSystemIncludeSourcesInProcess(const std::string& sGccToolchain);
+
+		static void invalidateCompilerEnvironmentCache();
+		static boost::python::dict getCompilerEnvironmentCacheStats();
 	};
 }
\ No newline at end of file
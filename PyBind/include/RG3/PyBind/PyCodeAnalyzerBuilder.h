@@ -3,6 +3,7 @@
 #include <RG3/LLVM/CodeAnalyzer.h>
 #include <RG3/PyBind/PyTypeBase.h>
 #include <unordered_map>
+#include <chrono>
 
 #define BOOST_PYTHON_STATIC_LIB  // required because we using boost.python as static library
 #include <boost/python.hpp>
@@ -43,6 +44,11 @@ namespace rg3::pybind
 		const boost::python::list& getFoundTypes() const;
 		const boost::python::list& getFoundIssues() const;
 
+		/**
+		 * @brief Phase times & counters of last analyze (see rg3::llvm::AnalyzeStats) and time of conversion into python objects
+		 */
+		[[nodiscard]] boost::python::dict getStats() const;
+
 		[[nodiscard]] const rg3::llvm::CompilerConfig& getCompilerConfig() const;
 
 	 private:
@@ -50,5 +56,7 @@ namespace rg3::pybind
 		std::unordered_map<std::string, boost::shared_ptr<PyTypeBase>> m_mFoundTypesMap {};
 		boost::python::list m_foundTypes {};
 		boost::python::list m_foundIssues {};
+		rg3::llvm::AnalyzeStats m_lastStats {};
+		std::chrono::nanoseconds m_conversionTime { 0 };
 	};
 }
\ No newline at end of file
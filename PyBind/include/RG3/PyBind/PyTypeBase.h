@@ -6,11 +6,15 @@
 
 #include <RG3/Cpp/TypeBase.h>
 
+#include <optional>
+
 
 namespace rg3::pybind
 {
 	/**
 	 * @brief Python representation of cpp::TypeBase. See bindings in PyBind.cpp
+	 * @note Python objects of type (str, lists of members) are made on first access, not in constructor: most of scripts read only few fields of few types.
+	 *       Python calls are made under GIL, so lazy members need no extra synchronization.
 	 */
 	class PyTypeBase : public boost::noncopyable
 	{
@@ -39,7 +43,6 @@ namespace rg3::pybind
 
 	 protected:
 		boost::shared_ptr<cpp::TypeBase> m_base { nullptr };
-		boost::python::str m_str { "null" };
-		boost::python::str m_repr { "null" };
+		mutable std::optional<boost::python::str> m_str {}; /// Made on first access (same object for str & repr)
 	};
 }
\ No newline at end of file
@@ -6,6 +6,9 @@
 #include <RG3/Cpp/TypeClass.h>
 #include <RG3/PyBind/PyTypeBase.h>
 
+#include <optional>
+#include <vector>
+
 
 namespace rg3::pybind
 {
@@ -29,13 +32,21 @@ namespace rg3::pybind
 		[[nodiscard]] bool pyHasMoveConstructor() const;
 		[[nodiscard]] bool pyHasMoveAssignOperator() const;
 
+	 public: // Resolver only
+		/**
+		 * @brief Set python objects of parent classes (same order as cpp::TypeClass::getParentTypes, nullptr - unknown parent).
+		 *        Applied to parent_types when they are made (or right now if they are already made).
+		 */
+		void setResolvedParentClasses(std::vector<boost::shared_ptr<PyTypeClass>>&& vParentClasses);
+
 	 private:
 		[[nodiscard]] cpp::TypeClass* getBase();
 	 	[[nodiscard]] const cpp::TypeClass* getBase() const;
 
 	 private:
-		boost::python::list m_properties {};
-		boost::python::list m_functions {};
-		boost::python::list m_parents {};
+		mutable std::optional<boost::python::list> m_properties {}; /// Made on first access
+		mutable std::optional<boost::python::list> m_functions {}; /// Made on first access
+		mutable std::optional<boost::python::list> m_parents {}; /// Made on first access
+		std::vector<boost::shared_ptr<PyTypeClass>> m_vResolvedParents {};
 	};
 }
\ No newline at end of file
@@ -0,0 +1,52 @@
+#pragma once
+
+#include <RG3/Cpp/TypeDatabase.h>
+
+#include <unordered_map>
+#include <cstdint>
+#include <memory>
+#include <string>
+
+#define BOOST_PYTHON_STATIC_LIB  // required because we using boost.python as static library
+#include <boost/python.hpp>
+#include <boost/shared_ptr.hpp>
+#include <boost/noncopyable.hpp>
+
+
+namespace rg3::pybind
+{
+	/**
+	 * @brief Python view of memory-mapped type database (see rg3::cpp::TypeDatabase)
+	 */
+	class PyTypeDatabase : public boost::noncopyable
+	{
+	 public:
+		explicit PyTypeDatabase(std::unique_ptr<cpp::TypeDatabase>&& pDatabase);
+
+		/**
+		 * @return database or None when file is not valid type database
+		 */
+		static boost::python::object open(const std::string& sPath);
+
+		/**
+		 * @brief Write types (CppBaseType & subclasses) and issues (CppCompilerIssue) into database file
+		 */
+		static bool write(const std::string& sPath, const boost::python::list& types, const boost::python::list& issues);
+
+		[[nodiscard]] std::uint32_t getTypesCount() const;
+		[[nodiscard]] boost::python::list getTypeNames() const;
+		[[nodiscard]] boost::python::list getIssues() const;
+
+		/**
+		 * @return type or None when type not found. Type deserialized on first access only
+		 */
+		boost::python::object findType(const std::string& sPrettyName);
+		boost::python::object getType(std::uint32_t iIndex);
+		boost::python::list getParentTypes(std::uint32_t iIndex);
+		boost::python::list loadTypes();
+
+	 private:
+		std::unique_ptr<cpp::TypeDatabase> m_pDatabase { nullptr };
+		std::unordered_map<std::uint32_t, boost::python::object> m_loadedTypes {};
+	};
+}
\ No newline at end of file
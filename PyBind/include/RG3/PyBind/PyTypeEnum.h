@@ -6,6 +6,8 @@
 #include <RG3/Cpp/TypeEnum.h>
 #include <RG3/PyBind/PyTypeBase.h>
 
+#include <optional>
+
 
 namespace rg3::pybind
 {
@@ -28,7 +30,7 @@ namespace rg3::pybind
 		const cpp::TypeEnum* getBase() const;
 
 	 private:
-		boost::python::list m_entries;
-		boost::python::str m_underlyingType;
+		mutable std::optional<boost::python::list> m_entries {}; /// Made on first access
+		mutable std::optional<boost::python::str> m_underlyingType {}; /// Made on first access
 	};
 }
\ No newline at end of file
@@ -2,7 +2,7 @@
 This file contains all public available symbols & definitions for PyBind (rg3py.pyd)
 Follow PyBind/source/PyBind.cpp for details
 """
-from typing import List, Union, Optional, Dict
+from typing import List, Union, Optional, Dict, Callable
 
 
 class CppStandard:
@@ -53,6 +53,14 @@ class CppIncludeKind:
     IK_DEFAULT = IK_PROJECT
 
 
+class SourceFilter:
+    SF_ALL = 0
+    SF_SKIP_SYSTEM_HEADERS = 1
+    SF_PROJECT_INCLUDES = 2
+    SF_MAIN_FILE = 3
+    SF_DEFAULT = SF_ALL
+
+
 class CppIncludeInfo:
     def __init__(self, path: str, kind: CppIncludeKind): ...
 
@@ -334,6 +342,9 @@ class CodeAnalyzer:
     @property
     def issues(self) -> List[CppCompilerIssue]: ...
 
+    @property
+    def stats(self) -> Dict[str, any]: ...
+
     @property
     def definitions(self) -> List[str]: ...
 
@@ -401,6 +412,81 @@ class AnalyzerContext:
     @property
     def deep_analysis(self) -> bool: ...
 
+    @property
+    def in_process_env_detection(self) -> bool: ...
+
+    @property
+    def gcc_toolchain(self) -> str: ...
+
+    @property
+    def shared_file_cache(self) -> bool: ...
+
+    @property
+    def file_cache_stats(self) -> Dict[str, int]: ...
+
+    @property
+    def umbrella_mode(self) -> bool: ...
+
+    @property
+    def umbrella_batch_size(self) -> int: ...
+
+    @property
+    def incremental_cache_dir(self) -> str: ...
+
+    @property
+    def compile_commands(self) -> str: ...
+
+    @property
+    def cost_history_file(self) -> str: ...
+
+    @property
+    def cost_aware_scheduling(self) -> bool: ...
+
+    @property
+    def daemon_socket(self) -> str: ...
+
+    @property
+    def watch_mode(self) -> bool: ...
+
+    @property
+    def reused_headers(self) -> List[str]: ...
+
+    @property
+    def recomputed_headers(self) -> List[str]: ...
+
+    @property
+    def preamble_headers(self) -> List[str]: ...
+
+    @property
+    def source_filter(self) -> SourceFilter: ...
+
+    @property
+    def source_allow_globs(self) -> List[str]: ...
+
+    @property
+    def source_deny_globs(self) -> List[str]: ...
+
+    @property
+    def auto_preamble(self) -> bool: ...
+
+    @property
+    def preamble_stats(self) -> Dict[str, any]: ...
+
+    @property
+    def scheduler_stats(self) -> Dict[str, any]: ...
+
+    @property
+    def stats(self) -> Dict[str, any]: ...
+
+    @property
+    def progress(self) -> Dict[str, any]: ...
+
+    @property
+    def finished(self) -> bool: ...
+
+    @property
+    def succeeded(self) -> bool: ...
+
     def set_workers_count(self, count: int): ...
 
     def set_headers(self, headers: List[str]): ...
@@ -411,13 +497,31 @@ class AnalyzerContext:
 
     def set_compiler_defs(self, defs: List[str]): ...
 
+    def set_preamble_headers(self, headers: List[str]): ...
+
     def get_type_by_reference(self, ref: CppTypeReference) -> Optional[CppBaseType]: ...
 
     def analyze(self) -> bool: ...
 
+    def analyze_async(self, progress_callback: Optional[Callable[[Dict[str, any]], None]] = None) -> bool: ...
+
+    def stream(self, max_pending: int = 16) -> Optional[AnalyzeStream]: ...
+
+    def wait(self, timeout: float = -1.0) -> bool: ...
+
+    def wait_changes(self, timeout: float = -1.0) -> Dict[str, any]|None: ...
+
+    def cancel(self): ...
+
     def make_evaluator(self) -> CodeEvaluator: ...
 
 
+class AnalyzeStream:
+    def __iter__(self) -> AnalyzeStream: ...
+
+    def __next__(self) -> Dict[str, any]: ...
+
+
 class CodeEvaluator:
     def __init__(self): ...
 
@@ -433,6 +537,21 @@ class CodeEvaluator:
     def make_from_system_env() -> CodeEvaluator|None: ...
 
 
+class DaemonClient:
+    @staticmethod
+    def connect(socket_path: str = "") -> DaemonClient: ...
+
+    @staticmethod
+    def default_socket_path() -> str: ...
+
+    @property
+    def stats(self) -> Dict[str, any]: ...
+
+    def eval(self, evaluator: CodeEvaluator, code: str, capture: List[str]) -> Union[List[CppCompilerIssue], Dict[str, any]]: ...
+
+    def shutdown(self): ...
+
+
 class CppCompilerIssueKind:
     IK_NONE = 0
     IK_WARNING = 1
@@ -455,6 +574,30 @@ class CppTypeReference:
     @property
     def name(self) -> str: ...
 
+class TypeDatabase:
+    @staticmethod
+    def open(path: str) -> Optional[TypeDatabase]: ...
+
+    @staticmethod
+    def write(path: str, types: List[CppBaseType], issues: List[CppCompilerIssue]) -> bool: ...
+
+    @property
+    def types_count(self) -> int: ...
+
+    @property
+    def type_names(self) -> List[str]: ...
+
+    @property
+    def issues(self) -> List[CppCompilerIssue]: ...
+
+    def find_type(self, pretty_name: str) -> Optional[CppBaseType]: ...
+
+    def get_type(self, index: int) -> Optional[CppBaseType]: ...
+
+    def get_parent_types(self, index: int) -> List[CppBaseType]: ...
+
+    def load_types(self) -> List[CppBaseType]: ...
+
 class ClangRuntime:
     @staticmethod
     def get_version() -> str: ...
@@ -462,3 +605,12 @@ class ClangRuntime:
     @staticmethod
     def detect_system_include_sources() -> Union[str, List[str]]: ...
 
+    @staticmethod
+    def detect_system_include_sources_in_process(gcc_toolchain: str) -> Union[str, List[str]]: ...
+
+    @staticmethod
+    def invalidate_compiler_env_cache(): ...
+
+    @staticmethod
+    def get_compiler_env_cache_stats() -> Dict[str, any]: ...
+
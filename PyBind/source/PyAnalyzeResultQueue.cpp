@@ -0,0 +1,87 @@
+#include <RG3/PyBind/PyAnalyzeResultQueue.h>
+
+#include <algorithm>
+
+
+namespace rg3::pybind
+{
+	AnalyzeResultQueue::AnalyzeResultQueue(const std::atomic_bool* pCancelled)
+		: m_pCancelled(pCancelled)
+	{
+	}
+
+	void AnalyzeResultQueue::enable(size_t iCapacity)
+	{
+		std::lock_guard<std::mutex> guard { m_lock };
+		m_bEnabled = true;
+		m_bProducersDone = false;
+		m_iCapacity = std::max<size_t>(iCapacity, 1);
+		m_results.clear();
+	}
+
+	void AnalyzeResultQueue::disable()
+	{
+		std::lock_guard<std::mutex> guard { m_lock };
+		m_bEnabled = false;
+		m_bProducersDone = true;
+		m_results.clear();
+		m_notEmptyCV.notify_all();
+	}
+
+	bool AnalyzeResultQueue::isEnabled() const
+	{
+		std::lock_guard<std::mutex> guard { m_lock };
+		return m_bEnabled;
+	}
+
+	void AnalyzeResultQueue::push(HeaderResult&& result)
+	{
+		std::unique_lock<std::mutex> guard { m_lock };
+		m_notFullCV.wait(guard, [this]() { return m_results.size() < m_iCapacity || isCancelled(); });
+
+		if (isCancelled())
+			return;
+
+		m_results.emplace_back(std::move(result));
+		m_notEmptyCV.notify_one();
+	}
+
+	std::optional<HeaderResult> AnalyzeResultQueue::pop()
+	{
+		std::unique_lock<std::mutex> guard { m_lock };
+		m_notEmptyCV.wait(guard, [this]() { return !m_results.empty() || m_bProducersDone || isCancelled(); });
+
+		if (m_results.empty() || isCancelled())
+		{
+			m_notFullCV.notify_all(); // drained: wake up finish
+			return std::nullopt;
+		}
+
+		auto result = std::move(m_results.front());
+		m_results.pop_front();
+		m_notFullCV.notify_all();
+
+		return std::make_optional(std::move(result));
+	}
+
+	void AnalyzeResultQueue::finish()
+	{
+		std::unique_lock<std::mutex> guard { m_lock };
+		m_bProducersDone = true;
+		m_notEmptyCV.notify_all();
+
+		m_notFullCV.wait(guard, [this]() { return m_results.empty() || isCancelled(); });
+	}
+
+	void AnalyzeResultQueue::wakeUpAll()
+	{
+		std::lock_guard<std::mutex> guard { m_lock };
+		m_notFullCV.notify_all();
+		m_notEmptyCV.notify_all();
+	}
+
+	bool AnalyzeResultQueue::isCancelled() const
+	{
+		return m_pCancelled && m_pCancelled->load(std::memory_order_relaxed);
+	}
+}
\ No newline at end of file
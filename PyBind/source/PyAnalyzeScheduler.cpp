@@ -0,0 +1,182 @@
+#include <RG3/PyBind/PyAnalyzeScheduler.h>
+
+#include <unordered_map>
+#include <algorithm>
+#include <optional>
+#include <string>
+
+
+namespace rg3::pybind
+{
+	std::vector<ScheduledTask> AnalyzeScheduler::planTasks(const std::vector<std::filesystem::path>& vHeaders, const std::vector<std::size_t>& vHeaderConfigIds, std::size_t iConfigsCount, bool bUmbrellaMode, int iBatchSize, int iWorkersAmount)
+	{
+		std::vector<ScheduledTask> vTasks {};
+
+		if (bUmbrellaMode)
+		{
+			// Umbrella is a single translation unit: only headers with same config could share it
+			for (std::size_t iConfigId = 0; iConfigId < iConfigsCount; ++iConfigId)
+			{
+				std::vector<std::filesystem::path> vConfigHeaders {};
+				for (std::size_t i = 0; i < vHeaders.size(); ++i)
+				{
+					if (vHeaderConfigIds[i] == iConfigId)
+					{
+						vConfigHeaders.push_back(vHeaders[i]);
+					}
+				}
+
+				for (auto& vBatch : makeUmbrellaBatches(vConfigHeaders, iBatchSize, iWorkersAmount))
+				{
+					vTasks.push_back(ScheduledTask { std::move(vBatch), iConfigId });
+				}
+			}
+		}
+		else
+		{
+			for (std::size_t i = 0; i < vHeaders.size(); ++i)
+			{
+				vTasks.push_back(ScheduledTask { { vHeaders[i] }, vHeaderConfigIds[i] });
+			}
+		}
+
+		return vTasks;
+	}
+
+	void AnalyzeScheduler::orderByCost(std::vector<ScheduledTask>& vTasks, const std::vector<std::filesystem::path>& vHeaders, const rg3::llvm::AnalyzeCostHistory* pHistory)
+	{
+		const auto vCosts = estimateHeadersCost(vHeaders, pHistory);
+
+		std::unordered_map<std::string, std::size_t> headerIds {};
+		headerIds.reserve(vHeaders.size());
+
+		for (std::size_t i = 0; i < vHeaders.size(); ++i)
+		{
+			headerIds.try_emplace(vHeaders[i].string(), i);
+		}
+
+		for (auto& task : vTasks)
+		{
+			for (const auto& header : task.vHeaders)
+			{
+				const auto& [cost, bFromHistory] = vCosts[headerIds[header.string()]];
+
+				task.estimatedCost += cost;
+				task.iHistoryHits += bFromHistory ? 1 : 0;
+			}
+		}
+
+		// Longest first: expensive task taken at the end of run keeps all other workers idle
+		std::stable_sort(vTasks.begin(), vTasks.end(), [](const ScheduledTask& a, const ScheduledTask& b) {
+			return a.estimatedCost > b.estimatedCost;
+		});
+	}
+
+	std::vector<std::vector<std::filesystem::path>> AnalyzeScheduler::makeUmbrellaBatches(const std::vector<std::filesystem::path>& vHeaders, int iBatchSize, int iWorkersAmount)
+	{
+		constexpr size_t kMaxAutoBatchHeaders = 32;
+		constexpr std::uintmax_t kMinHeaderCost = 1024; // empty headers still cost something: compiler invocation, includes
+
+		std::vector<std::vector<std::filesystem::path>> vBatches {};
+
+		if (iBatchSize > 0)
+		{
+			for (size_t i = 0; i < vHeaders.size(); i += static_cast<size_t>(iBatchSize))
+			{
+				const auto itEnd = vHeaders.begin() + static_cast<std::ptrdiff_t>(std::min(vHeaders.size(), i + static_cast<size_t>(iBatchSize)));
+				vBatches.emplace_back(vHeaders.begin() + static_cast<std::ptrdiff_t>(i), itEnd);
+			}
+
+			return vBatches;
+		}
+
+		std::vector<std::uintmax_t> vCosts {};
+		vCosts.reserve(vHeaders.size());
+
+		std::uintmax_t iTotalCost = 0;
+		for (const auto& header : vHeaders)
+		{
+			std::error_code ec;
+			const std::uintmax_t iFileSize = std::filesystem::file_size(header, ec);
+
+			vCosts.push_back(std::max(ec ? 0 : iFileSize, kMinHeaderCost));
+			iTotalCost += vCosts.back();
+		}
+
+		const std::uintmax_t iTargetBatches = static_cast<std::uintmax_t>(std::max(iWorkersAmount, 1)) * 2;
+		const std::uintmax_t iBatchBudget = std::max<std::uintmax_t>((iTotalCost + iTargetBatches - 1) / iTargetBatches, 1);
+
+		std::uintmax_t iBatchCost = 0;
+		for (size_t i = 0; i < vHeaders.size(); ++i)
+		{
+			if (vBatches.empty() || iBatchCost >= iBatchBudget || vBatches.back().size() >= kMaxAutoBatchHeaders)
+			{
+				vBatches.emplace_back();
+				iBatchCost = 0;
+			}
+
+			vBatches.back().push_back(vHeaders[i]);
+			iBatchCost += vCosts[i];
+		}
+
+		return vBatches;
+	}
+
+	std::vector<std::pair<std::chrono::nanoseconds, bool>> AnalyzeScheduler::estimateHeadersCost(const std::vector<std::filesystem::path>& vHeaders, const rg3::llvm::AnalyzeCostHistory* pHistory)
+	{
+		constexpr double kDefaultNsPerCostUnit = 1000.0; // ~1ms per KB of source when nothing is known yet
+
+		std::vector<std::optional<std::chrono::nanoseconds>> vMeasured {};
+		vMeasured.reserve(vHeaders.size());
+
+		for (const auto& header : vHeaders)
+		{
+			vMeasured.emplace_back(pHistory ? pHistory->find(header) : std::nullopt);
+		}
+
+		const bool bHasUnknown = std::any_of(vMeasured.begin(), vMeasured.end(), [](const auto& measured) { return !measured.has_value(); });
+
+		// Estimations of known headers are required too: they calibrate cost units of unknown headers
+		std::vector<std::uint64_t> vEstimated(vHeaders.size(), 0);
+		double fNsPerCostUnit = kDefaultNsPerCostUnit;
+
+		if (bHasUnknown)
+		{
+			std::chrono::nanoseconds knownTime { 0 };
+			std::uint64_t iKnownCost = 0;
+
+			for (size_t i = 0; i < vHeaders.size(); ++i)
+			{
+				vEstimated[i] = rg3::llvm::AnalyzeCostHistory::estimateCost(vHeaders[i]);
+
+				if (vMeasured[i].has_value())
+				{
+					knownTime += vMeasured[i].value();
+					iKnownCost += vEstimated[i];
+				}
+			}
+
+			if (iKnownCost > 0 && knownTime.count() > 0)
+			{
+				fNsPerCostUnit = static_cast<double>(knownTime.count()) / static_cast<double>(iKnownCost);
+			}
+		}
+
+		std::vector<std::pair<std::chrono::nanoseconds, bool>> vCosts {};
+		vCosts.reserve(vHeaders.size());
+
+		for (size_t i = 0; i < vHeaders.size(); ++i)
+		{
+			if (vMeasured[i].has_value())
+			{
+				vCosts.emplace_back(vMeasured[i].value(), true);
+			}
+			else
+			{
+				vCosts.emplace_back(std::chrono::nanoseconds(static_cast<std::int64_t>(static_cast<double>(vEstimated[i]) * fNsPerCostUnit)), false);
+			}
+		}
+
+		return vCosts;
+	}
+}
\ No newline at end of file
@@ -0,0 +1,25 @@
+#include <RG3/PyBind/PyAnalyzeStats.h>
+
+
+namespace rg3::pybind
+{
+	static double toMilliseconds(std::chrono::nanoseconds duration)
+	{
+		return std::chrono::duration<double, std::milli>(duration).count();
+	}
+
+	void fillAnalyzeStatsDict(boost::python::dict& result, const rg3::llvm::AnalyzeStats& stats)
+	{
+		result["env_detection_ms"] = toMilliseconds(stats.envDetectionTime);
+		result["preamble_ms"] = toMilliseconds(stats.preambleTime);
+		result["instance_creation_ms"] = toMilliseconds(stats.instanceCreationTime);
+		result["parse_ms"] = toMilliseconds(stats.parseTime);
+		result["visit_ms"] = toMilliseconds(stats.visitTime);
+		result["total_ms"] = toMilliseconds(stats.totalTime);
+		result["translation_units"] = stats.iTranslationUnits;
+		result["decls_visited"] = stats.iDeclsVisited;
+		result["decls_pruned"] = stats.iDeclsPruned;
+		result["types_emitted"] = stats.iTypesEmitted;
+		result["peak_rss_growth_bytes"] = stats.iPeakRssGrowth;
+	}
+}
\ No newline at end of file
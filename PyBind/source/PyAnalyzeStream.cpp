@@ -0,0 +1,79 @@
+#include <RG3/PyBind/PyAnalyzeStream.h>
+#include <RG3/PyBind/PyAnalyzerContext.h>
+#include <RG3/PyBind/PyAnalyzerRuntimeContext.h>
+#include <algorithm>
+#include <optional>
+
+
+namespace rg3::pybind
+{
+	PyAnalyzeStream::PyAnalyzeStream(boost::shared_ptr<PyAnalyzerContext> pContext)
+		: m_pContext(std::move(pContext))
+	{
+	}
+
+	PyAnalyzeStream::~PyAnalyzeStream()
+	{
+		if (!m_bFinished && m_pContext)
+		{
+			// Nobody will take results: don't leave workers blocked on full stream
+			m_pContext->cancel();
+		}
+	}
+
+	boost::python::object PyAnalyzeStream::__iter__(const boost::python::object& self)
+	{
+		return self;
+	}
+
+	boost::python::object PyAnalyzeStream::__next__()
+	{
+		if (!m_bFinished)
+		{
+			boost::python::object result = m_pContext->nextStreamResult();
+			if (!result.is_none())
+			{
+				return result;
+			}
+
+			// Drained: wait until context finished (types resolved & stats collected)
+			m_pContext->wait(-1.0);
+			m_bFinished = true;
+		}
+
+		PyErr_SetNone(PyExc_StopIteration);
+		boost::python::throw_error_already_set();
+		return {};
+	}
+
+	boost::python::object PyAnalyzerContext::stream(const boost::shared_ptr<PyAnalyzerContext>& pSelf, int iMaxPending)
+	{
+		if (!pSelf || !pSelf->isFinished())
+			return {};
+
+		pSelf->m_pContext->getResultQueue().enable(static_cast<size_t>(std::max(iMaxPending, 1)));
+
+		if (!analyzeAsync(pSelf, {}))
+		{
+			pSelf->m_pContext->getResultQueue().disable();
+			return {};
+		}
+
+		return boost::python::object(boost::shared_ptr<PyAnalyzeStream>(new PyAnalyzeStream(pSelf)));
+	}
+
+	boost::python::object PyAnalyzerContext::nextStreamResult()
+	{
+		std::optional<HeaderResult> headerResult {};
+
+		{
+			PyGuard pyGuard {};
+			headerResult = m_pContext->getResultQueue().pop();
+		}
+
+		if (!headerResult.has_value())
+			return {};
+
+		return m_pContext->publishStreamResult(std::move(headerResult.value()), m_compilerConfig.bUseDeepAnalysis);
+	}
+}
\ No newline at end of file
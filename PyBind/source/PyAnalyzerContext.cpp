@@ -1,348 +1,73 @@
 #include <RG3/PyBind/PyAnalyzerContext.h>
-#include <RG3/PyBind/PyClassParent.h>
-#include <RG3/PyBind/PyTypeBase.h>
-#include <RG3/PyBind/PyTypeClass.h>
-#include <RG3/PyBind/PyTypeEnum.h>
-#include <RG3/LLVM/CodeAnalyzer.h>
+#include <RG3/PyBind/PyAnalyzerRuntimeContext.h>
+#include <RG3/PyBind/PyAnalyzeScheduler.h>
+#include <RG3/PyBind/PyAnalyzeStats.h>
 #include <RG3/LLVM/CompilerConfigDetector.h>
-#include <RG3/Cpp/TransactionGuard.h>
-#include <RG3/Cpp/TypeClass.h>
-#include <RG3/Cpp/TypeEnum.h>
+#include <RG3/LLVM/CompileCommandsDatabase.h>
+#include <RG3/Cpp/FileUtils.h>
+#include <RG3/Daemon/DaemonClient.h>
 #include <fmt/format.h>
-#include <optional>
-#include <variant>
+#include <functional>
+#include <unordered_set>
+#include <unordered_map>
+#include <algorithm>
+#include <fstream>
+#include <iterator>
+#include <chrono>
 #include <thread>
-#include <deque>
 #include <mutex>
 
 
 namespace rg3::pybind
 {
 	/**
-	 * Do nothing (default command)
+	 * @brief Find angled includes (like '#include <vector>') which are used by at least half of headers
+	 * @note Only top-level '#include <...>' lines are recognized, conditional blocks are not evaluated
 	 */
-	using NullTask = std::nullptr_t;
-
-	/**
-	 * Stop current thread. Just return from internal loop
-	 */
-	struct StopWorkerTask
-	{
-	};
-
-	/**
-	 * Run analyze on specific file
-	 */
-	struct AnalyzeHeaderTask
-	{
-		std::filesystem::path headerPath;
-		rg3::llvm::CompilerConfig compilerConfig;
-	};
-
-	using ContextTask = std::variant<NullTask, StopWorkerTask, AnalyzeHeaderTask>;
-
-	class IRuntimeContextBaseOperations
-	{
-	 public:
-		virtual ~IRuntimeContextBaseOperations() noexcept = default;
-
-		virtual void clearTasks() = 0;
-		virtual void pushTask(ContextTask&& task) = 0;
-		virtual std::optional<ContextTask> takeTask() = 0;
-	};
-
-	struct PyGuard final : boost::noncopyable
-	{
-		PyGuard()
-		{
-			m_state = PyEval_SaveThread();
-		}
-
-		~PyGuard()
-		{
-			PyEval_RestoreThread(m_state);
-			m_state = nullptr;
-		}
-
-	 private:
-		PyThreadState* m_state { nullptr };
-	};
-
-	struct PyGILGuard final : boost::noncopyable
-	{
-		PyGILState_STATE m_gs;
-
-		PyGILGuard()
-		{
-			m_gs = PyGILState_Ensure();
-		}
-
-		~PyGILGuard()
-		{
-			PyGILState_Release(m_gs);
-		}
-	};
-
-	struct PyAnalyzerContext::RuntimeContext : public IRuntimeContextBaseOperations
+	static std::vector<std::string> detectCommonAngledIncludes(const std::vector<std::filesystem::path>& vHeaders)
 	{
-	 public:
-		using Storage = std::deque<ContextTask>;
-
-	 private:
-		std::mutex lockMtx;
-		Storage tasks;
-		std::vector<std::thread> workers;
-		std::optional<rg3::llvm::CompilerEnvironment> m_compilerEnv {};
-
-		PyFoundSubjects* pAnalyzerStorage{ nullptr };
-
-	 public:
-		class Transaction : public cpp::TransactionGuard<std::mutex>, public IRuntimeContextBaseOperations
-		{
-			Storage& m_storage;
-
-		 public:
-			explicit Transaction(std::mutex& mutex, Storage& storage) : cpp::TransactionGuard<std::mutex>(mutex), m_storage(storage)
-			{
-			}
-
-			~Transaction() = default;
-
-			void clearTasks() override
-			{
-				m_storage.clear();
-			}
-
-			void pushTask(ContextTask&& task) override
-			{
-				m_storage.emplace_back(std::move(task));
-			}
-
-			std::optional<ContextTask> takeTask() override
-			{
-				if (m_storage.empty())
-					return std::nullopt;
-
-				auto task = m_storage.front();
-				m_storage.pop_front();
-
-				return std::make_optional(std::move(task));
-			}
-		};
-
-	 public:
-		explicit RuntimeContext(PyFoundSubjects* pSubject) : pAnalyzerStorage(pSubject) {}
-		~RuntimeContext() = default;
-
-		void clearTasks() override
-		{
-			std::lock_guard<std::mutex> guard { lockMtx };
-			tasks.clear();
-		}
-
-		void pushTask(ContextTask&& task) override
-		{
-			std::lock_guard<std::mutex> guard { lockMtx };
-			tasks.emplace_back(std::move(task));
-		}
-
-		std::optional<ContextTask> takeTask() override
-		{
-			std::lock_guard<std::mutex> guard { lockMtx };
-			if (tasks.empty())
-				return std::nullopt;
-
-			auto task = tasks.front();
-			tasks.pop_front();
-
-			return std::make_optional(std::move(task));
-		}
-
-		Transaction startTransaction()
-		{
-			return Transaction(lockMtx, tasks);
-		}
+		constexpr size_t kMaxPreambleHeaders = 64;
 
-		void setCompilerEnvironment(const rg3::llvm::CompilerEnvironment& compilerEnv)
-		{
-			m_compilerEnv = compilerEnv;
-		}
+		std::unordered_map<std::string, size_t> includesUsage {};
+		std::vector<std::string> vIncludesOrder {}; // first seen order: keeps relative order of includes
 
-		bool runWorkers(int workersAmount)
+		for (const auto& header : vHeaders)
 		{
-			if (workersAmount <= 1)
-				return false;
-
-			workers.clear();
-			workers.reserve(workersAmount);
-
-			for (int i = 0; i < workersAmount; i++)
-			{
-				std::thread worker {
-					[this, iWorkerIndex = static_cast<size_t>(i)]() {
-						workerEntryPoint(iWorkerIndex, m_compilerEnv);
-					}
-				};
-
-				workers.emplace_back(std::move(worker));
-			}
-
-			return true;
-		}
+			std::ifstream headerFile { header };
+			if (!headerFile.is_open())
+				continue;
 
-		void waitAll()
-		{
-			for (auto& worker : workers)
-			{
-				worker.join();
-			}
-			// now we've done
-		}
+			const std::string sContent { std::istreambuf_iterator<char>(headerFile), std::istreambuf_iterator<char>() };
+			std::unordered_set<std::string> seenInHeader {};
 
-		void resolveReferences()
-		{
-			const size_t amountOfTypes = boost::python::len(pAnalyzerStorage->pyFoundTypes);
-			for (size_t typeId = 0; typeId < amountOfTypes; ++typeId)
+			for (auto& sInclude : rg3::cpp::utils::collectIncludeDirectives(sContent))
 			{
-				boost::python::object typeObj = pAnalyzerStorage->pyFoundTypes[typeId];
-				boost::python::extract<boost::shared_ptr<PyTypeClass>> classExtraction(typeObj);
+				if (sInclude.front() != '<')
+					continue;
 
-				if (classExtraction.check())
+				if (seenInHeader.insert(sInclude).second)
 				{
-					const boost::shared_ptr<PyTypeClass>& pAsClass = classExtraction();
-
-					// Need to resolve parent refs
-					const boost::python::list& parents = pAsClass->pyGetClassParentTypeRefs();
-					const size_t amountOfParents = boost::python::len(parents);
-
-					for (size_t parentId = 0; parentId < amountOfParents; ++parentId)
+					if (includesUsage[sInclude]++ == 0)
 					{
-						boost::python::object parentObj = parents[parentId];
-						boost::python::extract<boost::shared_ptr<PyClassParent>> classParentExtraction(parentObj);
-						if (classParentExtraction.check())
-						{
-							const boost::shared_ptr<PyClassParent>& pClassParent = classParentExtraction();
-
-							auto it = pAnalyzerStorage->vFoundTypeInstances.find(pClassParent->getBaseInfo().sPrettyName);
-							if (it != pAnalyzerStorage->vFoundTypeInstances.end())
-							{
-								// Resolved!
-								pClassParent->setParentClassDataReference(boost::static_pointer_cast<PyTypeClass>(it->second));
-							}
-						}
+						vIncludesOrder.emplace_back(std::move(sInclude));
 					}
 				}
 			}
 		}
 
-	 private:
-		void workerEntryPoint(size_t iWorkerId, const std::optional<rg3::llvm::CompilerEnvironment>& sCompilerEnvironment)
-		{
-			struct Visitor
-			{
-				bool* stopFlag;
-				PyFoundSubjects* pAnalyzerStorage { nullptr };
-				std::optional<rg3::llvm::CompilerEnvironment> sCompilerEnv { std::nullopt };
-
-				void operator()(NullTask)
-				{
-					// Do nothing
-				}
-
-				void operator()(const StopWorkerTask& task)
-				{
-					// Stop current loop
-					if (stopFlag != nullptr)
-					{
-						(*stopFlag) = true;
-					}
-				}
-
-				void operator()(const AnalyzeHeaderTask& analyzeHeader)
-				{
-					// Do analyze stub
-					rg3::llvm::CodeAnalyzer codeAnalyzer { analyzeHeader.headerPath, analyzeHeader.compilerConfig };
-					if (sCompilerEnv.has_value())
-					{
-						// set environment from cache
-						codeAnalyzer.setCompilerEnvironment(sCompilerEnv.value());
-					}
-
-					rg3::llvm::AnalyzerResult analyzeResult = codeAnalyzer.analyze();
-
-					{
-						// Write results (write lock)
-						std::unique_lock<std::shared_mutex> guard { pAnalyzerStorage->lockMutex };
-						PyGILGuard gilGuard {};
-
-						for (const auto& issue : analyzeResult.vIssues)
-						{
-							pAnalyzerStorage->pyFoundIssues.append(issue);
-						}
-
-						// Iterate over types and trying to push 'em into types db
-						for (auto&& type : analyzeResult.vFoundTypes)
-						{
-							// Note: here we need to assume that type is complete type without any issues, otherwise this type should be ignored!
-							switch (type->getKind())
-							{
-								case cpp::TypeKind::TK_NONE:
-									// Unsupported yet, lost, yep
-									break;
-								case cpp::TypeKind::TK_TRIVIAL:
-								{
-									auto object = boost::shared_ptr<PyTypeBase>(new PyTypeBase(std::move(type)));
-									auto [_iter, bInserted] = pAnalyzerStorage->vFoundTypeInstances.try_emplace(object->getNative()->getPrettyName(), object);
-
-									if (bInserted)
-									{
-										pAnalyzerStorage->pyFoundTypes.append(object);
-									}
-								}
-								break;
-								case cpp::TypeKind::TK_ENUM:
-								{
-									auto object = boost::shared_ptr<PyTypeEnum>(new PyTypeEnum(std::move(type)));
-									auto [_iter, bInserted] = pAnalyzerStorage->vFoundTypeInstances.try_emplace(object->getNative()->getPrettyName(), object);
-
-									if (bInserted)
-									{
-										pAnalyzerStorage->pyFoundTypes.append(object);
-									}
-								}
-								break;
-								case cpp::TypeKind::TK_STRUCT_OR_CLASS:
-								{
-									auto object = boost::shared_ptr<PyTypeClass>(new PyTypeClass(std::move(type)));
-									auto [_iter, bInserted] = pAnalyzerStorage->vFoundTypeInstances.try_emplace(object->getNative()->getPrettyName(), object);
-
-									if (bInserted)
-									{
-
-										pAnalyzerStorage->pyFoundTypes.append(object);
-									}
-								}
-								break;
-							}
-						}
-					}
-				}
-			};
-
+		const size_t iThreshold = std::max<size_t>(2, (vHeaders.size() + 1) / 2);
+		std::vector<std::string> vResult {};
 
-			bool bShouldStop = false;
-			Visitor v { &bShouldStop, pAnalyzerStorage, sCompilerEnvironment };
-
-			while (!bShouldStop)
+		for (const auto& sInclude : vIncludesOrder)
+		{
+			if (includesUsage[sInclude] >= iThreshold && vResult.size() < kMaxPreambleHeaders)
 			{
-				// Try to extract task or take null task to do nothing
-				auto task = takeTask().value_or(NullTask());
-
-				// Run task
-				std::visit(v, task);
+				vResult.emplace_back(sInclude);
 			}
 		}
-	};
+
+		return vResult;
+	}
 
 	PyAnalyzerContext::PyAnalyzerContext()
 	{
@@ -351,6 +76,8 @@ namespace rg3::pybind
 
 	PyAnalyzerContext::~PyAnalyzerContext()
 	{
+		// Async thread keeps context alive until it's done, so here thread is finished (or it is current thread)
+		joinAsyncThread();
 	}
 
 	void PyAnalyzerContext::setWorkersCount(int workersCount)
@@ -372,6 +99,7 @@ namespace rg3::pybind
 			return;
 
 		m_headersToPrepare.clear();
+		m_pWatchState.reset(); // Watched results are bound to headers of analyze
 
 		for (int i = 0; i < boost::python::len(headers); i++)
 		{
@@ -506,8 +234,43 @@ namespace rg3::pybind
 		return m_compilerConfig.bUseDeepAnalysis;
 	}
 
+	void PyAnalyzerContext::setUseInProcessEnvDetection(bool bUseInProcess)
+	{
+		if (m_bInProgress.load(std::memory_order_relaxed))
+			return;
+
+		m_bInProcessEnvDetection = bUseInProcess;
+	}
+
+	bool PyAnalyzerContext::isInProcessEnvDetectionUsed() const
+	{
+		return m_bInProcessEnvDetection;
+	}
+
+	void PyAnalyzerContext::setGccToolchain(const std::string& sGccToolchain)
+	{
+		if (m_bInProgress.load(std::memory_order_relaxed))
+			return;
+
+		m_sGccToolchain = sGccToolchain;
+	}
+
+	std::string PyAnalyzerContext::getGccToolchain() const
+	{
+		return m_sGccToolchain.string();
+	}
+
 	boost::python::object PyAnalyzerContext::pyGetTypeOfTypeReference(const rg3::cpp::TypeReference& typeReference)
 	{
+		// Linked by native resolution (deep analysis): name of reference could be spelled differently than pretty name of type
+		if (const rg3::cpp::TypeBase* pResolved = typeReference.get())
+		{
+			if (auto it = m_pySubjects.vFoundTypeInstances.find(pResolved->getPrettyName()); it != m_pySubjects.vFoundTypeInstances.end() && it->second->getNative().get() == pResolved)
+			{
+				return boost::python::object(it->second);
+			}
+		}
+
 		// Try to find by type name
 		if (auto it = m_pySubjects.vFoundTypeInstances.find(typeReference.getRefName()); it != m_pySubjects.vFoundTypeInstances.end())
 		{
@@ -542,82 +305,869 @@ namespace rg3::pybind
 
 	bool PyAnalyzerContext::analyze()
 	{
-		if (m_bInProgress)
+		if (m_bInProgress.exchange(true))
 			return false;
 
-		bool bResult = false;
+		// Previous async run is finished (flag was dropped), but its thread could be still alive
+		joinAsyncThread();
+
+		beginRun();
+
+		bool bNativeResult = false;
+		{
+			PyGuard pyGuard {};
+			bNativeResult = runNative(nullptr);
+		}
 
-		m_bInProgress = true;
-		bResult = runAnalyze();
+		m_bLastRunResult = finishRun(bNativeResult);
 		m_bInProgress = false;
 
-		return bResult;
+		return m_bLastRunResult;
 	}
 
-	bool PyAnalyzerContext::isFinished() const
+	bool PyAnalyzerContext::analyzeAsync(const boost::shared_ptr<PyAnalyzerContext>& pSelf, boost::python::object progressCallback)
 	{
-		return m_bInProgress == false;
-	}
+		if (!pSelf || pSelf->m_bInProgress.exchange(true))
+			return false;
 
-	bool PyAnalyzerContext::runAnalyze()
-	{
-		// Cleanup known types
-		m_pySubjects.pyFoundTypes = {};
-		m_pySubjects.pyFoundIssues = {};
-		m_pySubjects.vFoundTypeInstances.clear();
-		bool bResult = false;
+		PyAnalyzerContext* self = pSelf.get();
 
-		// Collect compiler environment
-		auto environmentExtractResult = rg3::llvm::CompilerConfigDetector::detectSystemCompilerEnvironment();
-		if (rg3::llvm::CompilerEnvError* pError = std::get_if<rg3::llvm::CompilerEnvError>(&environmentExtractResult))
-		{
-			rg3::llvm::AnalyzerResult::CompilerIssue issue;
-			issue.kind = rg3::llvm::AnalyzerResult::CompilerIssue::IssueKind::IK_ERROR;
-			issue.sSourceFile = "RG3_GLOBAL_SCOPE";
-			issue.sMessage = fmt::format("RG3|Detect compiler environment failed: {}", pError->message);
+		self->joinAsyncThread();
 
-			m_pySubjects.pyFoundIssues.append(issue);
-			return false;
+		self->beginRun();
+		self->m_pyProgressCallback = std::move(progressCallback);
+		self->m_bLastRunResult = false;
+
+		{
+			std::lock_guard<std::mutex> guard { self->m_asyncMtx };
+			self->m_bAsyncDone = false;
 		}
 
-		// Set environment to minimize future clang invocations
-		m_pContext->setCompilerEnvironment(*std::get_if<rg3::llvm::CompilerEnvironment>(&environmentExtractResult));
+		// Thread owns reference to python object of context: context stays alive until analyze is done even when script dropped it
+		self->m_asyncThread = std::thread([self, pKeepAlive = pSelf]() mutable {
+			const bool bHasCallback = !self->m_pyProgressCallback.is_none();
+			const bool bNativeResult = self->runNative(bHasCallback ? std::function<void()>([self]() { self->reportProgress(); }) : nullptr);
 
-		// Create tasks
-		{
-			PyGuard pyGuard {};
+			const PyGILState_STATE gilState = PyGILState_Ensure();
+
+			self->m_bLastRunResult = self->finishRun(bNativeResult);
 
+			if (bHasCallback)
 			{
-				auto transaction = m_pContext->startTransaction();
-				transaction.clearTasks();
+				// Final report: everything is done
+				self->callProgressCallback();
+			}
 
-				// Spawn worker tasks
-				for (const auto& header : m_headersToPrepare)
-				{
-					transaction.pushTask(AnalyzeHeaderTask{header, m_compilerConfig});
-				}
+			self->m_pyProgressCallback = {};
 
-				// And spawn 'stop' tasks. +2 should be enough
-				for (size_t i = 0; i < m_iWorkersAmount; i++)
-				{
-					transaction.pushTask(StopWorkerTask{});
-				}
+			{
+				std::lock_guard<std::mutex> guard { self->m_asyncMtx };
+				self->m_bAsyncDone = true;
+				self->m_bInProgress = false;
 			}
 
-			// Re-create workers and run analyze
-			if (m_pContext->runWorkers(m_iWorkersAmount))
+			self->m_asyncCV.notify_all();
+
+			// Could destroy context (last reference): don't touch it after this line
+			pKeepAlive.reset();
+			PyGILState_Release(gilState);
+		});
+
+		return true;
+	}
+
+	bool PyAnalyzerContext::wait(double fTimeoutSeconds)
+	{
+		if (!m_asyncThread.joinable())
+			return true; // Nothing to wait
+
+		bool bDone = false;
+
+		{
+			PyGuard pyGuard {};
+			std::unique_lock<std::mutex> guard { m_asyncMtx };
+
+			auto isDone = [this]() -> bool { return m_bAsyncDone; };
+
+			if (fTimeoutSeconds < 0.0)
+			{
+				m_asyncCV.wait(guard, isDone);
+				bDone = true;
+			}
+			else
 			{
-				m_pContext->waitAll();
-				bResult = true;
+				bDone = m_asyncCV.wait_for(guard, std::chrono::duration<double>(fTimeoutSeconds), isDone);
 			}
 		}
 
-		// Need to do this outside of GIL guard
-		if (bResult && m_compilerConfig.bUseDeepAnalysis)
+		if (bDone)
 		{
-			m_pContext->resolveReferences();
+			joinAsyncThread();
 		}
 
-		return bResult;
+		return bDone;
+	}
+
+	void PyAnalyzerContext::cancel()
+	{
+		if (!m_bInProgress.load(std::memory_order_relaxed))
+			return;
+
+		m_pContext->cancel();
+	}
+
+	bool PyAnalyzerContext::isLastAnalyzeSucceeded() const
+	{
+		return isFinished() && m_bLastRunResult;
+	}
+
+	boost::python::dict PyAnalyzerContext::getProgress() const
+	{
+		boost::python::dict result {};
+
+		const auto progress = m_pContext->getProgress();
+		result["completed_headers"] = progress.iCompletedHeaders;
+		result["total_headers"] = m_headersToPrepare.size();
+		result["types_found"] = progress.iFoundTypes;
+		result["elapsed_ms"] = m_runStartedAt == std::chrono::steady_clock::time_point {} ? 0.0 : std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - m_runStartedAt).count();
+		result["cancelled"] = m_pContext->isCancelled();
+		result["finished"] = isFinished();
+
+		return result;
+	}
+
+	void PyAnalyzerContext::reportProgress()
+	{
+		// Called from async thread (without GIL)
+		const PyGILState_STATE gilState = PyGILState_Ensure();
+		callProgressCallback();
+		PyGILState_Release(gilState);
+	}
+
+	void PyAnalyzerContext::callProgressCallback()
+	{
+		try
+		{
+			m_pyProgressCallback(getProgress());
+		}
+		catch (const boost::python::error_already_set&)
+		{
+			// Exception of callback must not break analyze: print it like unhandled exception in thread
+			PyErr_Print();
+		}
+	}
+
+	void PyAnalyzerContext::joinAsyncThread()
+	{
+		if (!m_asyncThread.joinable())
+			return;
+
+		if (m_asyncThread.get_id() == std::this_thread::get_id())
+		{
+			// Last reference to context was dropped by async thread itself
+			m_asyncThread.detach();
+			return;
+		}
+
+		m_asyncThread.join();
+	}
+
+	void PyAnalyzerContext::setUseSharedFileCache(bool bUseSharedFileCache)
+	{
+		if (m_bInProgress.load(std::memory_order_relaxed))
+			return;
+
+		m_bUseSharedFileCache = bUseSharedFileCache;
+	}
+
+	bool PyAnalyzerContext::isSharedFileCacheUsed() const
+	{
+		return m_bUseSharedFileCache;
+	}
+
+	void PyAnalyzerContext::setPreambleHeaders(const boost::python::list& preambleHeaders)
+	{
+		if (m_bInProgress.load(std::memory_order_relaxed))
+			return;
+
+		m_compilerConfig.vPreambleHeaders.clear();
+
+		for (int i = 0; i < boost::python::len(preambleHeaders); i++)
+		{
+			m_compilerConfig.vPreambleHeaders.emplace_back(boost::python::extract<std::string>(preambleHeaders[i]));
+		}
+	}
+
+	boost::python::list PyAnalyzerContext::getPreambleHeaders() const
+	{
+		boost::python::list result;
+
+		for (const auto& preambleHeader : m_compilerConfig.vPreambleHeaders)
+		{
+			result.append(preambleHeader);
+		}
+
+		return result;
+	}
+
+	void PyAnalyzerContext::setSourceFilter(rg3::llvm::SourceFilter eSourceFilter)
+	{
+		if (m_bInProgress.load(std::memory_order_relaxed))
+			return;
+
+		m_compilerConfig.eSourceFilter = eSourceFilter;
 	}
+
+	rg3::llvm::SourceFilter PyAnalyzerContext::getSourceFilter() const
+	{
+		return m_compilerConfig.eSourceFilter;
+	}
+
+	void PyAnalyzerContext::setSourceAllowGlobs(const boost::python::list& allowGlobs)
+	{
+		if (m_bInProgress.load(std::memory_order_relaxed))
+			return;
+
+		m_compilerConfig.vSourceAllowGlobs.clear();
+
+		for (int i = 0; i < boost::python::len(allowGlobs); i++)
+		{
+			m_compilerConfig.vSourceAllowGlobs.emplace_back(boost::python::extract<std::string>(allowGlobs[i]));
+		}
+	}
+
+	boost::python::list PyAnalyzerContext::getSourceAllowGlobs() const
+	{
+		boost::python::list result;
+
+		for (const auto& sGlob : m_compilerConfig.vSourceAllowGlobs)
+		{
+			result.append(sGlob);
+		}
+
+		return result;
+	}
+
+	void PyAnalyzerContext::setSourceDenyGlobs(const boost::python::list& denyGlobs)
+	{
+		if (m_bInProgress.load(std::memory_order_relaxed))
+			return;
+
+		m_compilerConfig.vSourceDenyGlobs.clear();
+
+		for (int i = 0; i < boost::python::len(denyGlobs); i++)
+		{
+			m_compilerConfig.vSourceDenyGlobs.emplace_back(boost::python::extract<std::string>(denyGlobs[i]));
+		}
+	}
+
+	boost::python::list PyAnalyzerContext::getSourceDenyGlobs() const
+	{
+		boost::python::list result;
+
+		for (const auto& sGlob : m_compilerConfig.vSourceDenyGlobs)
+		{
+			result.append(sGlob);
+		}
+
+		return result;
+	}
+
+	void PyAnalyzerContext::setUseAutoPreamble(bool bUseAutoPreamble)
+	{
+		if (m_bInProgress.load(std::memory_order_relaxed))
+			return;
+
+		m_bUseAutoPreamble = bUseAutoPreamble;
+	}
+
+	bool PyAnalyzerContext::isAutoPreambleUsed() const
+	{
+		return m_bUseAutoPreamble;
+	}
+
+	void PyAnalyzerContext::setUseUmbrellaMode(bool bUseUmbrellaMode)
+	{
+		if (m_bInProgress.load(std::memory_order_relaxed))
+			return;
+
+		m_bUseUmbrellaMode = bUseUmbrellaMode;
+	}
+
+	bool PyAnalyzerContext::isUmbrellaModeUsed() const
+	{
+		return m_bUseUmbrellaMode;
+	}
+
+	void PyAnalyzerContext::setUmbrellaBatchSize(int iBatchSize)
+	{
+		if (m_bInProgress.load(std::memory_order_relaxed))
+			return;
+
+		m_iUmbrellaBatchSize = std::max(iBatchSize, 0);
+	}
+
+	int PyAnalyzerContext::getUmbrellaBatchSize() const
+	{
+		return m_iUmbrellaBatchSize;
+	}
+
+	void PyAnalyzerContext::setIncrementalCacheDir(const std::string& sCacheDir)
+	{
+		if (m_bInProgress.load(std::memory_order_relaxed))
+			return;
+
+		m_sIncrementalCacheDir = sCacheDir;
+	}
+
+	std::string PyAnalyzerContext::getIncrementalCacheDir() const
+	{
+		return m_sIncrementalCacheDir.string();
+	}
+
+	void PyAnalyzerContext::setDaemonSocket(const std::string& sSocketPath)
+	{
+		if (m_bInProgress.load(std::memory_order_relaxed))
+			return;
+
+		m_sDaemonSocket = sSocketPath;
+	}
+
+	std::string PyAnalyzerContext::getDaemonSocket() const
+	{
+		return m_sDaemonSocket.string();
+	}
+
+	void PyAnalyzerContext::setCompileCommandsFile(const std::string& sDatabaseFile)
+	{
+		if (m_bInProgress.load(std::memory_order_relaxed))
+			return;
+
+		m_sCompileCommandsFile = sDatabaseFile;
+	}
+
+	std::string PyAnalyzerContext::getCompileCommandsFile() const
+	{
+		return m_sCompileCommandsFile.string();
+	}
+
+	void PyAnalyzerContext::setCostHistoryFile(const std::string& sHistoryFile)
+	{
+		if (m_bInProgress.load(std::memory_order_relaxed))
+			return;
+
+		m_sCostHistoryFile = sHistoryFile;
+	}
+
+	std::string PyAnalyzerContext::getCostHistoryFile() const
+	{
+		return m_sCostHistoryFile.string();
+	}
+
+	void PyAnalyzerContext::setUseCostAwareScheduling(bool bUseCostAwareScheduling)
+	{
+		if (m_bInProgress.load(std::memory_order_relaxed))
+			return;
+
+		m_bUseCostAwareScheduling = bUseCostAwareScheduling;
+	}
+
+	bool PyAnalyzerContext::isCostAwareSchedulingUsed() const
+	{
+		return m_bUseCostAwareScheduling;
+	}
+
+	void PyAnalyzerContext::setUseWatchMode(bool bUseWatchMode)
+	{
+		if (m_bInProgress.load(std::memory_order_relaxed))
+			return;
+
+		m_bUseWatchMode = bUseWatchMode;
+
+		if (!m_bUseWatchMode)
+		{
+			m_pWatchState.reset();
+		}
+	}
+
+	bool PyAnalyzerContext::isWatchModeUsed() const
+	{
+		return m_bUseWatchMode;
+	}
+
+	boost::python::list PyAnalyzerContext::getReusedHeaders() const
+	{
+		boost::python::list result {};
+
+		for (const auto& header : m_vReusedHeaders)
+		{
+			result.append(header.string());
+		}
+
+		return result;
+	}
+
+	boost::python::list PyAnalyzerContext::getRecomputedHeaders() const
+	{
+		boost::python::list result {};
+
+		for (const auto& header : m_vRecomputedHeaders)
+		{
+			result.append(header.string());
+		}
+
+		return result;
+	}
+
+	boost::python::dict PyAnalyzerContext::getPreambleStats() const
+	{
+		boost::python::dict result {};
+
+		if (!isFinished())
+		{
+			return result;
+		}
+
+		boost::python::list headers {};
+		for (const auto& header : m_vLastPreambleHeaders)
+		{
+			headers.append(header);
+		}
+
+		result["headers"] = headers;
+		result["built"] = m_preambleStats.iBuilt;
+		result["failed"] = m_preambleStats.iFailed;
+		result["uses"] = m_preambleStats.iUses;
+		result["rebuilt"] = m_preambleStats.iRebuilt;
+		result["build_ms"] = std::chrono::duration<double, std::milli>(m_preambleStats.buildTime).count();
+		result["estimated_saved_ms"] = std::chrono::duration<double, std::milli>(m_preambleStats.estimatedSavedTime).count();
+
+		return result;
+	}
+
+	boost::python::dict PyAnalyzerContext::getFileCacheStats() const
+	{
+		boost::python::dict result {};
+
+		if (!isFinished() || !m_pContext->getSharedFileCache())
+		{
+			return result;
+		}
+
+		const auto stats = m_pContext->getSharedFileCache()->getStats();
+		result["stat_hits"] = stats.iStatHits;
+		result["stat_misses"] = stats.iStatMisses;
+		result["read_hits"] = stats.iReadHits;
+		result["read_misses"] = stats.iReadMisses;
+		result["cached_bytes"] = stats.iCachedBytes;
+
+		return result;
+	}
+
+	boost::python::dict PyAnalyzerContext::getSchedulerStats() const
+	{
+		if (!isFinished())
+		{
+			return {};
+		}
+
+		boost::python::dict result = m_pContext->getSchedulerStats();
+		boost::python::list schedule {};
+		size_t iHistoryHits = 0;
+
+		for (size_t i = 0; i < m_vLastSchedule.size(); ++i)
+		{
+			const auto& task = m_vLastSchedule[i];
+
+			boost::python::list headers {};
+			for (const auto& header : task.vHeaders)
+			{
+				headers.append(header.string());
+			}
+
+			boost::python::dict taskDict {};
+			taskDict["order"] = i;
+			taskDict["headers"] = headers;
+			taskDict["estimated_ms"] = std::chrono::duration<double, std::milli>(task.estimatedCost).count();
+			taskDict["history_hits"] = task.iHistoryHits;
+			taskDict["config"] = task.iConfigId;
+			schedule.append(taskDict);
+
+			iHistoryHits += task.iHistoryHits;
+		}
+
+		result["cost_aware"] = m_bUseCostAwareScheduling;
+		result["configs"] = m_iLastConfigsCount;
+		result["history_hits"] = iHistoryHits;
+		result["schedule"] = schedule;
+
+		return result;
+	}
+
+	boost::python::dict PyAnalyzerContext::getStats() const
+	{
+		boost::python::dict result {};
+
+		if (!isFinished())
+		{
+			return result;
+		}
+
+		fillAnalyzeStatsDict(result, m_lastRunStats);
+		result["conversion_ms"] = std::chrono::duration<double, std::milli>(m_conversionTime).count();
+		result["cached_headers"] = m_iCachedHeaders;
+		result["reference_resolution_ms"] = std::chrono::duration<double, std::milli>(m_referenceResolutionTime).count();
+		result["references"] = m_referenceStats.iReferences;
+		result["references_resolved"] = m_referenceStats.iResolved;
+		result["peak_rss_bytes"] = rg3::llvm::AnalyzeStats::getProcessPeakRss();
+		result["translation_units_stats"] = m_pyTranslationUnitStats;
+
+		if (m_lastDaemonStats.has_value())
+		{
+			boost::python::dict daemonStats {};
+			daemonStats["reused_headers"] = m_lastDaemonStats->iReusedHeaders;
+			daemonStats["analyzed_headers"] = m_lastDaemonStats->iAnalyzedHeaders;
+			daemonStats["analyze_ms"] = std::chrono::duration<double, std::milli>(m_lastDaemonStats->analyzeTime).count();
+			result["daemon"] = daemonStats;
+		}
+
+		return result;
+	}
+
+	bool PyAnalyzerContext::isFinished() const
+	{
+		return m_bInProgress == false;
+	}
+
+	void PyAnalyzerContext::beginRun()
+	{
+		// Cleanup known types
+		m_pySubjects.pyFoundTypes = {};
+		m_pySubjects.pyFoundIssues = {};
+		m_pySubjects.vFoundTypeInstances.clear();
+
+		m_pContext->clearStreamIndex();
+		m_pContext->clearAnalyzeStats();
+		m_pContext->resetProgress();
+		m_lastRunStats = {};
+		m_conversionTime = std::chrono::nanoseconds::zero();
+		m_referenceResolutionTime = std::chrono::nanoseconds::zero();
+		m_referenceStats = {};
+		m_iCachedHeaders = 0;
+		m_pyTranslationUnitStats = {};
+		m_vRunIssues.clear();
+		m_lastDaemonStats.reset();
+
+		m_runStartedAt = std::chrono::steady_clock::now();
+		m_iRunPeakRssBefore = rg3::llvm::AnalyzeStats::getProcessPeakRss();
+	}
+
+	bool PyAnalyzerContext::runNative(const std::function<void()>& onProgress)
+	{
+		// Watch of previous analyze is replaced
+		m_pWatchState.reset();
+
+		if (!m_sDaemonSocket.empty())
+		{
+			return runOnDaemon();
+		}
+
+		m_pContext->setCollectSnapshots(m_bUseWatchMode);
+
+		const bool bResult = runNativeOn(m_headersToPrepare, onProgress);
+		if (bResult && m_bUseWatchMode && !m_pContext->isCancelled() && !m_pContext->getResultQueue().isEnabled())
+		{
+			startWatch();
+		}
+
+		m_pContext->setCollectSnapshots(false);
+		return bResult;
+	}
+
+	bool PyAnalyzerContext::runNativeOn(const std::vector<std::filesystem::path>& vHeaders, const std::function<void()>& onProgress)
+	{
+		bool bResult = false;
+
+		// Collect compiler environment
+		rg3::llvm::CompilerEnvResult environmentExtractResult {};
+		if (m_bInProcessEnvDetection)
+		{
+			rg3::llvm::InProcessDetectorOptions detectorOptions {};
+			detectorOptions.sGccToolchain = m_sGccToolchain;
+
+			environmentExtractResult = rg3::llvm::CompilerConfigDetector::detectCompilerEnvironmentInProcess(detectorOptions);
+		}
+		else
+		{
+			environmentExtractResult = rg3::llvm::CompilerConfigDetector::detectSystemCompilerEnvironment();
+		}
+
+		m_envDetectionTime = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - m_runStartedAt);
+
+		if (rg3::llvm::CompilerEnvError* pError = std::get_if<rg3::llvm::CompilerEnvError>(&environmentExtractResult))
+		{
+			rg3::llvm::AnalyzerResult::CompilerIssue issue;
+			issue.kind = rg3::llvm::AnalyzerResult::CompilerIssue::IssueKind::IK_ERROR;
+			issue.sSourceFile = "RG3_GLOBAL_SCOPE";
+			issue.sMessage = fmt::format("RG3|Detect compiler environment failed: {}", pError->message);
+
+			m_vRunIssues.emplace_back(std::move(issue));
+			return false;
+		}
+
+		// Set environment to minimize future clang invocations
+		m_pContext->setCompilerEnvironment(*std::get_if<rg3::llvm::CompilerEnvironment>(&environmentExtractResult));
+
+		// Compilation database: per-file flags
+		std::shared_ptr<rg3::llvm::CompileCommandsDatabase> pCompileCommands { nullptr };
+		if (!m_sCompileCommandsFile.empty())
+		{
+			auto databaseResult = rg3::llvm::CompileCommandsDatabase::loadFromFile(m_sCompileCommandsFile);
+			if (auto* pError = std::get_if<rg3::llvm::CompileCommandsDatabaseError>(&databaseResult))
+			{
+				rg3::llvm::AnalyzerResult::CompilerIssue issue;
+				issue.kind = rg3::llvm::AnalyzerResult::CompilerIssue::IssueKind::IK_ERROR;
+				issue.sSourceFile = m_sCompileCommandsFile.string();
+				issue.sMessage = fmt::format("RG3|Load compilation database failed: {}", pError->message);
+
+				m_vRunIssues.emplace_back(std::move(issue));
+				return false;
+			}
+
+			pCompileCommands = std::move(std::get<std::shared_ptr<rg3::llvm::CompileCommandsDatabase>>(databaseResult));
+		}
+
+		// Fresh file cache for each run: files could be changed between runs
+		m_pContext->setSharedFileCache(m_bUseSharedFileCache ? ::llvm::makeIntrusiveRefCnt<rg3::llvm::SharedFileCache>() : nullptr);
+
+		// Collect preamble headers: user listed + common includes
+		rg3::llvm::CompilerConfig runConfig = m_compilerConfig;
+		if (m_bUseAutoPreamble)
+		{
+			for (auto& sInclude : detectCommonAngledIncludes(vHeaders))
+			{
+				if (std::find(runConfig.vPreambleHeaders.begin(), runConfig.vPreambleHeaders.end(), sInclude) == runConfig.vPreambleHeaders.end())
+				{
+					runConfig.vPreambleHeaders.emplace_back(std::move(sInclude));
+				}
+			}
+		}
+
+		m_vLastPreambleHeaders = runConfig.vPreambleHeaders;
+
+		// Incremental cache: reuse results of headers which are not changed since previous run
+		std::shared_ptr<rg3::llvm::IncrementalCache> pIncrementalCache { nullptr };
+		if (!m_sIncrementalCacheDir.empty())
+		{
+			const auto& compilerEnv = *std::get_if<rg3::llvm::CompilerEnvironment>(&environmentExtractResult);
+
+			pIncrementalCache = std::make_shared<rg3::llvm::IncrementalCache>(m_sIncrementalCacheDir, rg3::llvm::IncrementalCache::makeConfigDigest(runConfig, compilerEnv));
+			pIncrementalCache->load();
+		}
+
+		m_pContext->setIncrementalCache(pIncrementalCache);
+		const auto preambleStatsBefore = rg3::llvm::PrecompiledHeaderCache::getInstance().getStats();
+
+		// Per-file configs from compilation database. Headers with same config share umbrella batches and caches (preamble & incremental cache are keyed by config).
+		std::vector<rg3::llvm::CompilerConfig> vRunConfigs { runConfig };
+		std::vector<size_t> vHeaderConfigIds(vHeaders.size(), 0);
+
+		if (pCompileCommands)
+		{
+			const auto& compilerEnv = *std::get_if<rg3::llvm::CompilerEnvironment>(&environmentExtractResult);
+
+			vRunConfigs.clear();
+			std::unordered_map<std::string, size_t> configIds {};
+
+			for (size_t i = 0; i < vHeaders.size(); ++i)
+			{
+				auto headerConfig = pCompileCommands->getConfigForFile(vHeaders[i], runConfig).value_or(runConfig);
+				auto [it, bInserted] = configIds.try_emplace(rg3::llvm::IncrementalCache::makeConfigDigest(headerConfig, compilerEnv), vRunConfigs.size());
+
+				if (bInserted)
+				{
+					vRunConfigs.emplace_back(std::move(headerConfig));
+				}
+
+				vHeaderConfigIds[i] = it->second;
+			}
+		}
+
+		m_iLastConfigsCount = vRunConfigs.size();
+
+		// Cost history: measured analyze time of headers from previous runs
+		std::unique_ptr<rg3::llvm::AnalyzeCostHistory> pCostHistory { nullptr };
+		if (!m_sCostHistoryFile.empty())
+		{
+			pCostHistory = std::make_unique<rg3::llvm::AnalyzeCostHistory>(m_sCostHistoryFile);
+			pCostHistory->load();
+		}
+
+		// Plan tasks
+		m_vLastSchedule = AnalyzeScheduler::planTasks(vHeaders, vHeaderConfigIds, vRunConfigs.size(), m_bUseUmbrellaMode, m_iUmbrellaBatchSize, m_iWorkersAmount);
+
+		if (m_bUseCostAwareScheduling)
+		{
+			AnalyzeScheduler::orderByCost(m_vLastSchedule, vHeaders, pCostHistory.get());
+		}
+
+		// Create tasks
+		{
+			auto transaction = m_pContext->startTransaction();
+			transaction.clearTasks();
+
+			// Spawn worker tasks
+			for (const auto& task : m_vLastSchedule)
+			{
+				if (m_bUseUmbrellaMode)
+				{
+					transaction.pushTask(AnalyzeUmbrellaTask{task.vHeaders, vRunConfigs[task.iConfigId]});
+				}
+				else
+				{
+					transaction.pushTask(AnalyzeHeaderTask{task.vHeaders.front(), vRunConfigs[task.iConfigId]});
+				}
+			}
+
+			// No more tasks. Workers will stop when queue become empty
+			transaction.closeTasks();
+		}
+
+		// Re-create workers and run analyze
+		if (m_pContext->runWorkers(m_iWorkersAmount))
+		{
+			m_pContext->waitAll(onProgress);
+
+			if (m_pContext->getResultQueue().isEnabled())
+			{
+				// Results must be taken by consumer of stream before run will be finished
+				m_pContext->getResultQueue().finish();
+			}
+
+			m_pContext->mergeWorkersResults(vHeaders);
+			bResult = true;
+
+			// Times of cancelled run are partial: they would spoil history
+			if (pCostHistory && !m_pContext->isCancelled())
+			{
+				m_pContext->recordCostHistory(*pCostHistory);
+				pCostHistory->save();
+			}
+		}
+
+		m_preambleStats = rg3::llvm::PrecompiledHeaderCache::getInstance().getStats().since(preambleStatsBefore);
+
+		m_vReusedHeaders.clear();
+		m_vRecomputedHeaders.clear();
+
+		if (pIncrementalCache)
+		{
+			pIncrementalCache->save();
+
+			m_vReusedHeaders = pIncrementalCache->getReusedHeaders();
+			m_vRecomputedHeaders = pIncrementalCache->getRecomputedHeaders();
+			m_pContext->setIncrementalCache(nullptr);
+		}
+
+		return bResult;
+	}
+
+	bool PyAnalyzerContext::runOnDaemon()
+	{
+		auto reportError = [this](std::string sMessage) -> bool {
+			rg3::llvm::AnalyzerResult::CompilerIssue issue;
+			issue.kind = rg3::llvm::AnalyzerResult::CompilerIssue::IssueKind::IK_ERROR;
+			issue.sSourceFile = "RG3_GLOBAL_SCOPE";
+			issue.sMessage = std::move(sMessage);
+
+			m_vRunIssues.emplace_back(std::move(issue));
+			return false;
+		};
+
+		auto clientResult = rg3::daemon::DaemonClient::connect(m_sDaemonSocket);
+		if (auto* pError = std::get_if<rg3::daemon::DaemonError>(&clientResult))
+		{
+			return reportError(fmt::format("RG3|Connect to daemon failed: {}", pError->message));
+		}
+
+		// Working directory of daemon is not same: every path must be absolute
+		rg3::daemon::AnalyzeRequest request {};
+		request.compilerConfig = m_compilerConfig;
+		request.iWorkers = static_cast<std::uint32_t>(m_iWorkersAmount);
+
+		for (auto& include : request.compilerConfig.vIncludes)
+		{
+			include.sFsLocation = std::filesystem::absolute(include.sFsLocation);
+		}
+
+		request.vHeaders.reserve(m_headersToPrepare.size());
+		for (const auto& header : m_headersToPrepare)
+		{
+			request.vHeaders.emplace_back(std::filesystem::absolute(header).lexically_normal().string());
+		}
+
+		auto response = std::get<std::unique_ptr<rg3::daemon::DaemonClient>>(clientResult)->analyze(request);
+		if (auto* pError = std::get_if<rg3::daemon::DaemonError>(&response))
+		{
+			return reportError(fmt::format("RG3|Daemon request failed: {}", pError->message));
+		}
+
+		auto& analyzeResponse = std::get<rg3::daemon::AnalyzeResponse>(response);
+		m_lastDaemonStats = DaemonRunStats { analyzeResponse.iReusedHeaders, analyzeResponse.iAnalyzedHeaders, analyzeResponse.analyzeTime };
+		m_pContext->setMergedResults(std::move(analyzeResponse.vIssues), std::move(analyzeResponse.vFoundTypes));
+
+		return true;
+	}
+
+	bool PyAnalyzerContext::finishRun(bool bNativeResult)
+	{
+		bool bResult = bNativeResult;
+
+		if (m_pContext->isCancelled())
+		{
+			rg3::llvm::AnalyzerResult::CompilerIssue issue;
+			issue.kind = rg3::llvm::AnalyzerResult::CompilerIssue::IssueKind::IK_ERROR;
+			issue.sSourceFile = "RG3_GLOBAL_SCOPE";
+			issue.sMessage = "RG3|Analyze cancelled";
+
+			m_vRunIssues.emplace_back(std::move(issue));
+			bResult = false;
+		}
+
+		for (const auto& issue : m_vRunIssues)
+		{
+			m_pySubjects.pyFoundIssues.append(issue);
+		}
+
+		if (bResult && m_compilerConfig.bUseDeepAnalysis)
+		{
+			m_pContext->resolveNativeReferences(m_iWorkersAmount);
+		}
+
+		// Single conversion of all results into python objects (GIL is held here)
+		m_pContext->publishMergedResults();
+		m_pContext->getResultQueue().disable();
+
+		if (bResult && m_compilerConfig.bUseDeepAnalysis)
+		{
+			m_pContext->resolveReferences();
+		}
+
+		// Stats of run: translation units are analyzed in parallel, so sum of their times is not same as wall time
+		m_lastRunStats = m_pContext->getTotalAnalyzeStats();
+		m_lastRunStats.envDetectionTime += m_envDetectionTime;
+		m_lastRunStats.totalTime = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - m_runStartedAt);
+
+		const std::uint64_t iPeakRssAfter = rg3::llvm::AnalyzeStats::getProcessPeakRss();
+		m_lastRunStats.iPeakRssGrowth = iPeakRssAfter > m_iRunPeakRssBefore ? iPeakRssAfter - m_iRunPeakRssBefore : 0;
+
+		m_conversionTime = m_pContext->getConversionTime();
+		m_referenceResolutionTime = m_pContext->getReferenceResolutionTime();
+		m_referenceStats = m_pContext->getReferenceStats();
+		m_iCachedHeaders = m_pContext->getCachedHeadersCount();
+		m_pyTranslationUnitStats = m_pContext->getTranslationUnitStats();
+
+		return bResult;
+	}
+
 }
\ No newline at end of file
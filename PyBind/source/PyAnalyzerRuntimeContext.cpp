@@ -0,0 +1,928 @@
+#include <RG3/PyBind/PyAnalyzerRuntimeContext.h>
+#include <RG3/PyBind/PyAnalyzeStats.h>
+#include <RG3/PyBind/PyTypeClass.h>
+#include <RG3/PyBind/PyTypeEnum.h>
+#include <RG3/Cpp/TypeSerializer.h>
+#include <RG3/Cpp/TypeClass.h>
+#include <RG3/Cpp/TypeEnum.h>
+#include <unordered_set>
+#include <unordered_map>
+#include <algorithm>
+#include <iterator>
+#include <limits>
+
+
+namespace rg3::pybind
+{
+	PyGuard::PyGuard()
+	{
+		m_state = PyEval_SaveThread();
+	}
+
+	PyGuard::~PyGuard()
+	{
+		PyEval_RestoreThread(m_state);
+		m_state = nullptr;
+	}
+
+	void PyAnalyzerContext::RuntimeContext::pushTaskImpl(QueueState& state, ContextTask&& task)
+	{
+		state.tasks.emplace_back(std::move(task));
+		state.iQueueDepthPeak = std::max(state.iQueueDepthPeak, state.tasks.size());
+	}
+
+	std::optional<ContextTask> PyAnalyzerContext::RuntimeContext::takeTaskImpl(QueueState& state)
+	{
+		if (state.tasks.empty())
+			return std::nullopt;
+
+		auto task = std::move(state.tasks.front());
+		state.tasks.pop_front();
+
+		return std::make_optional(std::move(task));
+	}
+
+	void PyAnalyzerContext::RuntimeContext::clearTasksImpl(QueueState& state)
+	{
+		state.tasks.clear();
+		state.bClosed = false;
+		state.iQueueDepthPeak = 0;
+	}
+
+	PyAnalyzerContext::RuntimeContext::Transaction::Transaction(std::mutex& mutex, std::condition_variable& cv, QueueState& state)
+		: cpp::TransactionGuard<std::mutex>(mutex), m_state(state), m_cv(cv)
+	{
+	}
+
+	PyAnalyzerContext::RuntimeContext::Transaction::~Transaction()
+	{
+		// Wake up everybody: new tasks or queue closed. Notify under lock is fine here, transaction is rare operation.
+		m_cv.notify_all();
+	}
+
+	void PyAnalyzerContext::RuntimeContext::Transaction::clearTasks()
+	{
+		clearTasksImpl(m_state);
+	}
+
+	void PyAnalyzerContext::RuntimeContext::Transaction::pushTask(ContextTask&& task)
+	{
+		pushTaskImpl(m_state, std::move(task));
+	}
+
+	void PyAnalyzerContext::RuntimeContext::Transaction::closeTasks()
+	{
+		m_state.bClosed = true;
+	}
+
+	std::optional<ContextTask> PyAnalyzerContext::RuntimeContext::Transaction::takeTask()
+	{
+		return takeTaskImpl(m_state);
+	}
+
+	PyAnalyzerContext::RuntimeContext::RuntimeContext(PyFoundSubjects* pSubject) : pAnalyzerStorage(pSubject)
+	{
+	}
+
+	PyAnalyzerContext::RuntimeContext::~RuntimeContext()
+	{
+		// Don't leave workers blocked on queue
+		closeTasks();
+
+		for (auto& worker : workers)
+		{
+			if (worker.joinable())
+				worker.join();
+		}
+	}
+
+	void PyAnalyzerContext::RuntimeContext::clearTasks()
+	{
+		std::lock_guard<std::mutex> guard { lockMtx };
+		clearTasksImpl(queue);
+	}
+
+	void PyAnalyzerContext::RuntimeContext::pushTask(ContextTask&& task)
+	{
+		{
+			std::lock_guard<std::mutex> guard { lockMtx };
+			pushTaskImpl(queue, std::move(task));
+		}
+
+		tasksCV.notify_one();
+	}
+
+	void PyAnalyzerContext::RuntimeContext::closeTasks()
+	{
+		{
+			std::lock_guard<std::mutex> guard { lockMtx };
+			queue.bClosed = true;
+		}
+
+		tasksCV.notify_all();
+	}
+
+	std::optional<ContextTask> PyAnalyzerContext::RuntimeContext::takeTask()
+	{
+		std::lock_guard<std::mutex> guard { lockMtx };
+		return takeTaskImpl(queue);
+	}
+
+	std::optional<ContextTask> PyAnalyzerContext::RuntimeContext::waitTask(size_t iWorkerId)
+	{
+		std::unique_lock<std::mutex> guard { lockMtx };
+		WorkerStats& stats = workersStats[iWorkerId];
+
+		if (queue.tasks.empty() && !queue.bClosed)
+		{
+			const auto idleStartedAt = Clock::now();
+
+			while (queue.tasks.empty() && !queue.bClosed)
+			{
+				tasksCV.wait(guard);
+				++stats.iWakeUps;
+			}
+
+			stats.idleTime += Clock::now() - idleStartedAt;
+		}
+
+		auto task = takeTaskImpl(queue);
+		if (task.has_value())
+		{
+			++stats.iTasksTaken;
+		}
+
+		return task;
+	}
+
+	PyAnalyzerContext::RuntimeContext::Transaction PyAnalyzerContext::RuntimeContext::startTransaction()
+	{
+		return Transaction(lockMtx, tasksCV, queue);
+	}
+
+	void PyAnalyzerContext::RuntimeContext::setCompilerEnvironment(const rg3::llvm::CompilerEnvironment& compilerEnv)
+	{
+		m_compilerEnv = compilerEnv;
+	}
+
+	void PyAnalyzerContext::RuntimeContext::setSharedFileCache(::llvm::IntrusiveRefCntPtr<rg3::llvm::SharedFileCache> pFileCache)
+	{
+		m_pFileCache = std::move(pFileCache);
+	}
+
+	const ::llvm::IntrusiveRefCntPtr<rg3::llvm::SharedFileCache>& PyAnalyzerContext::RuntimeContext::getSharedFileCache() const
+	{
+		return m_pFileCache;
+	}
+
+	void PyAnalyzerContext::RuntimeContext::setCollectSnapshots(bool bCollect)
+	{
+		bCollectSnapshots = bCollect;
+	}
+
+	std::vector<PyAnalyzerContext::WatchedHeader> PyAnalyzerContext::RuntimeContext::takeSnapshots()
+	{
+		std::vector<WatchedHeader> vSnapshots {};
+
+		for (auto& workerSnapshots : workersSnapshots)
+		{
+			std::move(workerSnapshots.begin(), workerSnapshots.end(), std::back_inserter(vSnapshots));
+		}
+
+		workersSnapshots.clear();
+		return vSnapshots;
+	}
+
+	void PyAnalyzerContext::RuntimeContext::setIncrementalCache(std::shared_ptr<rg3::llvm::IncrementalCache> pIncrementalCache)
+	{
+		m_pIncrementalCache = std::move(pIncrementalCache);
+	}
+
+	const std::shared_ptr<rg3::llvm::IncrementalCache>& PyAnalyzerContext::RuntimeContext::getIncrementalCache() const
+	{
+		return m_pIncrementalCache;
+	}
+
+	bool PyAnalyzerContext::RuntimeContext::runWorkers(int workersAmount)
+	{
+		if (workersAmount <= 1)
+			return false;
+
+		workers.clear();
+		workers.reserve(workersAmount);
+
+		{
+			std::lock_guard<std::mutex> guard { lockMtx };
+			workersStats.assign(workersAmount, WorkerStats {});
+		}
+
+		workersResults.clear();
+		workersResults.resize(workersAmount);
+		workersSnapshots.clear();
+		workersSnapshots.resize(workersAmount);
+
+		{
+			std::lock_guard<std::mutex> guard { progressMtx };
+			iFinishedWorkers = 0;
+		}
+
+		for (int i = 0; i < workersAmount; i++)
+		{
+			std::thread worker {
+				[this, iWorkerIndex = static_cast<size_t>(i)]() {
+					workerEntryPoint(iWorkerIndex, m_compilerEnv);
+				}
+			};
+
+			workers.emplace_back(std::move(worker));
+		}
+
+		return true;
+	}
+
+	void PyAnalyzerContext::RuntimeContext::waitAll(const std::function<void()>& onProgress)
+	{
+		// Workers will leave their loops when queue will be drained
+		closeTasks();
+
+		if (onProgress)
+		{
+			std::unique_lock<std::mutex> guard { progressMtx };
+			size_t iReportedHeaders = 0;
+
+			while (iFinishedWorkers < workers.size())
+			{
+				// Timeout: progress notification could be lost between check & wait (counters are not guarded by progressMtx)
+				progressCV.wait_for(guard, std::chrono::milliseconds(100));
+
+				const size_t iCompleted = iCompletedHeaders.load(std::memory_order_relaxed);
+				if (iCompleted != iReportedHeaders)
+				{
+					iReportedHeaders = iCompleted;
+
+					guard.unlock();
+					onProgress();
+					guard.lock();
+				}
+			}
+		}
+
+		for (auto& worker : workers)
+		{
+			worker.join();
+		}
+
+		workers.clear();
+		// now we've done
+	}
+
+	boost::python::dict PyAnalyzerContext::RuntimeContext::getSchedulerStats()
+	{
+		std::lock_guard<std::mutex> guard { lockMtx };
+
+		boost::python::dict result {};
+		boost::python::list workersList {};
+
+		Clock::duration totalIdleTime { Clock::duration::zero() };
+		size_t iTotalWakeUps = 0;
+
+		for (const auto& stats : workersStats)
+		{
+			boost::python::dict workerStats {};
+			workerStats["idle_ms"] = std::chrono::duration<double, std::milli>(stats.idleTime).count();
+			workerStats["tasks"] = stats.iTasksTaken;
+			workerStats["wakeups"] = stats.iWakeUps;
+			workersList.append(workerStats);
+
+			totalIdleTime += stats.idleTime;
+			iTotalWakeUps += stats.iWakeUps;
+		}
+
+		result["queue_depth"] = queue.tasks.size();
+		result["queue_depth_peak"] = queue.iQueueDepthPeak;
+		result["idle_ms"] = std::chrono::duration<double, std::milli>(totalIdleTime).count();
+		result["wakeups"] = iTotalWakeUps;
+		result["workers"] = workersList;
+
+		return result;
+	}
+
+	void PyAnalyzerContext::RuntimeContext::mergeWorkersResults(const std::vector<std::filesystem::path>& vHeaders)
+	{
+		std::unordered_map<std::string, size_t> headerOrder {};
+		headerOrder.reserve(vHeaders.size());
+
+		for (size_t i = 0; i < vHeaders.size(); ++i)
+		{
+			headerOrder.try_emplace(vHeaders[i].string(), i);
+		}
+
+		std::vector<HeaderResult*> vResults {};
+		for (auto& workerResults : workersResults)
+		{
+			for (auto& headerResult : workerResults)
+			{
+				vResults.push_back(&headerResult);
+			}
+		}
+
+		auto getOrder = [&headerOrder](const HeaderResult* pResult) -> size_t {
+			auto it = headerOrder.find(pResult->header.string());
+			return it != headerOrder.end() ? it->second : std::numeric_limits<size_t>::max();
+		};
+
+		std::stable_sort(vResults.begin(), vResults.end(), [&getOrder](const HeaderResult* a, const HeaderResult* b) {
+			return getOrder(a) < getOrder(b);
+		});
+
+		vMergedIssues.clear();
+		vMergedTypes.clear();
+
+		std::unordered_set<std::string> knownTypes {};
+
+		for (auto* pResult : vResults)
+		{
+			for (auto& issue : pResult->result.vIssues)
+			{
+				vMergedIssues.emplace_back(std::move(issue));
+			}
+
+			for (auto& type : pResult->result.vFoundTypes)
+			{
+				// Note: here we need to assume that type is complete type without any issues, otherwise this type should be ignored!
+				if (type->getKind() == cpp::TypeKind::TK_NONE)
+					continue; // Unsupported yet, lost, yep
+
+				if (knownTypes.emplace(type->getPrettyName()).second)
+				{
+					vMergedTypes.emplace_back(std::move(type));
+				}
+			}
+		}
+
+		workersResults.clear();
+	}
+
+	void PyAnalyzerContext::RuntimeContext::setMergedResults(rg3::llvm::AnalyzerResult::CompilerIssuesVector&& vIssues, std::vector<cpp::TypeBasePtr>&& vTypes)
+	{
+		vMergedIssues = std::move(vIssues);
+		vMergedTypes = std::move(vTypes);
+	}
+
+	void PyAnalyzerContext::RuntimeContext::publishMergedResults()
+	{
+		std::unique_lock<std::shared_mutex> guard { pAnalyzerStorage->lockMutex };
+		const auto conversionStartedAt = Clock::now();
+
+		for (const auto& issue : vMergedIssues)
+		{
+			pAnalyzerStorage->pyFoundIssues.append(issue);
+		}
+
+		pAnalyzerStorage->vFoundTypeInstances.reserve(pAnalyzerStorage->vFoundTypeInstances.size() + vMergedTypes.size());
+
+		for (auto&& type : vMergedTypes)
+		{
+			publishType(std::move(type));
+		}
+
+		vMergedIssues.clear();
+		vMergedTypes.clear();
+
+		addConversionTime(std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - conversionStartedAt));
+	}
+
+	boost::shared_ptr<PyTypeBase> PyAnalyzerContext::RuntimeContext::publishType(cpp::TypeBasePtr&& type)
+	{
+		std::string sPrettyName = type->getPrettyName();
+		if (pAnalyzerStorage->vFoundTypeInstances.contains(sPrettyName))
+			return nullptr;
+
+		boost::shared_ptr<PyTypeBase> object { nullptr };
+
+		switch (type->getKind())
+		{
+			case cpp::TypeKind::TK_NONE:
+				break;
+			case cpp::TypeKind::TK_TRIVIAL:
+				object = boost::shared_ptr<PyTypeBase>(new PyTypeBase(std::move(type)));
+				break;
+			case cpp::TypeKind::TK_ENUM:
+				object = boost::shared_ptr<PyTypeEnum>(new PyTypeEnum(std::move(type)));
+				break;
+			case cpp::TypeKind::TK_STRUCT_OR_CLASS:
+				object = boost::shared_ptr<PyTypeClass>(new PyTypeClass(std::move(type)));
+				break;
+		}
+
+		if (!object)
+			return nullptr;
+
+		pAnalyzerStorage->pyFoundTypes.append(object);
+		pAnalyzerStorage->vFoundTypeInstances.try_emplace(std::move(sPrettyName), object);
+
+		return object;
+	}
+
+	AnalyzeResultQueue& PyAnalyzerContext::RuntimeContext::getResultQueue()
+	{
+		return resultQueue;
+	}
+
+	boost::python::dict PyAnalyzerContext::RuntimeContext::publishStreamResult(HeaderResult&& headerResult, bool bResolveReferences)
+	{
+		std::unique_lock<std::shared_mutex> guard { pAnalyzerStorage->lockMutex };
+
+		if (bResolveReferences)
+		{
+			// Published types are visible to python code: link references before publish, they are never written after
+			const auto resolveStartedAt = Clock::now();
+			std::vector<cpp::TypeBase*> vTypesToResolve {};
+			vTypesToResolve.reserve(headerResult.result.vFoundTypes.size());
+
+			for (const auto& pType : headerResult.result.vFoundTypes)
+			{
+				if (pType && !pAnalyzerStorage->vFoundTypeInstances.contains(pType->getPrettyName()))
+				{
+					streamResolver.addType(pType.get());
+					vTypesToResolve.push_back(pType.get());
+				}
+			}
+
+			const auto stats = streamResolver.resolve(vTypesToResolve);
+
+			std::lock_guard<std::mutex> statsGuard { statsMtx };
+			referenceResolutionTime += std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - resolveStartedAt);
+			referenceStats.iReferences += stats.iReferences;
+			referenceStats.iResolved += stats.iResolved;
+		}
+
+		const auto conversionStartedAt = Clock::now();
+
+		boost::python::list types {};
+		boost::python::list issues {};
+
+		for (const auto& issue : headerResult.result.vIssues)
+		{
+			pAnalyzerStorage->pyFoundIssues.append(issue);
+			issues.append(issue);
+		}
+
+		for (auto& type : headerResult.result.vFoundTypes)
+		{
+			if (auto object = publishType(std::move(type)))
+			{
+				types.append(object);
+			}
+		}
+
+		boost::python::dict result {};
+		result["header"] = headerResult.header.string();
+		result["types"] = types;
+		result["issues"] = issues;
+
+		addConversionTime(std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - conversionStartedAt));
+		return result;
+	}
+
+	void PyAnalyzerContext::RuntimeContext::clearStreamIndex()
+	{
+		std::unique_lock<std::shared_mutex> guard { pAnalyzerStorage->lockMutex };
+		streamResolver = {};
+	}
+
+	void PyAnalyzerContext::RuntimeContext::onHeaderCompleted(size_t iTypes)
+	{
+		iCompletedHeaders.fetch_add(1, std::memory_order_relaxed);
+		iFoundTypes.fetch_add(iTypes, std::memory_order_relaxed);
+		progressCV.notify_all();
+	}
+
+	void PyAnalyzerContext::RuntimeContext::resetProgress()
+	{
+		bCancelled = false;
+		iCompletedHeaders = 0;
+		iFoundTypes = 0;
+	}
+
+	PyAnalyzerContext::RuntimeContext::Progress PyAnalyzerContext::RuntimeContext::getProgress() const
+	{
+		return Progress { iCompletedHeaders.load(std::memory_order_relaxed), iFoundTypes.load(std::memory_order_relaxed) };
+	}
+
+	void PyAnalyzerContext::RuntimeContext::cancel()
+	{
+		bCancelled = true;
+
+		{
+			std::lock_guard<std::mutex> guard { lockMtx };
+			queue.tasks.clear();
+		}
+
+		tasksCV.notify_all();
+
+		// Wake up workers blocked on full stream & consumer
+		resultQueue.wakeUpAll();
+	}
+
+	bool PyAnalyzerContext::RuntimeContext::isCancelled() const
+	{
+		return bCancelled.load(std::memory_order_relaxed);
+	}
+
+	void PyAnalyzerContext::RuntimeContext::clearAnalyzeStats()
+	{
+		std::lock_guard<std::mutex> guard { statsMtx };
+		vTranslationUnitStats.clear();
+		conversionTime = std::chrono::nanoseconds::zero();
+		referenceResolutionTime = std::chrono::nanoseconds::zero();
+		referenceStats = {};
+	}
+
+	void PyAnalyzerContext::RuntimeContext::addTranslationUnitStats(TranslationUnitStats&& unitStats)
+	{
+		std::lock_guard<std::mutex> guard { statsMtx };
+		vTranslationUnitStats.emplace_back(std::move(unitStats));
+	}
+
+	void PyAnalyzerContext::RuntimeContext::addConversionTime(std::chrono::nanoseconds duration)
+	{
+		std::lock_guard<std::mutex> guard { statsMtx };
+		conversionTime += duration;
+	}
+
+	rg3::llvm::AnalyzeStats PyAnalyzerContext::RuntimeContext::getTotalAnalyzeStats()
+	{
+		std::lock_guard<std::mutex> guard { statsMtx };
+
+		rg3::llvm::AnalyzeStats total {};
+		for (const auto& unitStats : vTranslationUnitStats)
+		{
+			total += unitStats.stats;
+		}
+
+		return total;
+	}
+
+	boost::python::list PyAnalyzerContext::RuntimeContext::getTranslationUnitStats()
+	{
+		std::lock_guard<std::mutex> guard { statsMtx };
+
+		std::vector<const TranslationUnitStats*> vSorted {};
+		vSorted.reserve(vTranslationUnitStats.size());
+
+		for (const auto& unitStats : vTranslationUnitStats)
+		{
+			vSorted.push_back(&unitStats);
+		}
+
+		std::stable_sort(vSorted.begin(), vSorted.end(), [](const TranslationUnitStats* a, const TranslationUnitStats* b) {
+			return a->stats.totalTime > b->stats.totalTime;
+		});
+
+		boost::python::list result {};
+
+		for (const auto* pUnitStats : vSorted)
+		{
+			boost::python::list headers {};
+			for (const auto& header : pUnitStats->vHeaders)
+			{
+				headers.append(header.string());
+			}
+
+			boost::python::dict unitDict {};
+			unitDict["headers"] = headers;
+			unitDict["from_cache"] = pUnitStats->bFromCache;
+			fillAnalyzeStatsDict(unitDict, pUnitStats->stats);
+
+			result.append(unitDict);
+		}
+
+		return result;
+	}
+
+	std::chrono::nanoseconds PyAnalyzerContext::RuntimeContext::getConversionTime()
+	{
+		std::lock_guard<std::mutex> guard { statsMtx };
+		return conversionTime;
+	}
+
+	std::chrono::nanoseconds PyAnalyzerContext::RuntimeContext::getReferenceResolutionTime()
+	{
+		std::lock_guard<std::mutex> guard { statsMtx };
+		return referenceResolutionTime;
+	}
+
+	cpp::TypeReferenceResolver::Stats PyAnalyzerContext::RuntimeContext::getReferenceStats()
+	{
+		std::lock_guard<std::mutex> guard { statsMtx };
+		return referenceStats;
+	}
+
+	size_t PyAnalyzerContext::RuntimeContext::getCachedHeadersCount()
+	{
+		std::lock_guard<std::mutex> guard { statsMtx };
+		return static_cast<size_t>(std::count_if(vTranslationUnitStats.begin(), vTranslationUnitStats.end(), [](const TranslationUnitStats& unitStats) { return unitStats.bFromCache; }));
+	}
+
+	void PyAnalyzerContext::RuntimeContext::recordCostHistory(rg3::llvm::AnalyzeCostHistory& history)
+	{
+		std::lock_guard<std::mutex> guard { statsMtx };
+
+		for (const auto& unitStats : vTranslationUnitStats)
+		{
+			if (unitStats.bFromCache || unitStats.vHeaders.empty())
+				continue;
+
+			const auto headerTime = unitStats.stats.totalTime / static_cast<std::int64_t>(unitStats.vHeaders.size());
+			for (const auto& header : unitStats.vHeaders)
+			{
+				history.record(header, headerTime);
+			}
+		}
+	}
+
+	void PyAnalyzerContext::RuntimeContext::resolveNativeReferences(int iWorkers)
+	{
+		const auto startedAt = Clock::now();
+		cpp::TypeReferenceResolver::Stats stats {};
+
+		{
+			PyGuard noGil {};
+			std::shared_lock<std::shared_mutex> guard { pAnalyzerStorage->lockMutex };
+
+			cpp::TypeReferenceResolver resolver {};
+			std::vector<cpp::TypeBase*> vTypesToResolve {};
+			vTypesToResolve.reserve(vMergedTypes.size());
+
+			// Storage contains only types published by stream during this run (it's cleared when run begins).
+			// They are indexed, but not resolved again: python code could read them right now (references to types of later headers are found by name)
+			for (const auto& [sPrettyName, pObject] : pAnalyzerStorage->vFoundTypeInstances)
+			{
+				resolver.addType(pObject->getNative().get());
+			}
+
+			for (const auto& pType : vMergedTypes)
+			{
+				if (!pAnalyzerStorage->vFoundTypeInstances.contains(pType->getPrettyName()))
+				{
+					resolver.addType(pType.get());
+					vTypesToResolve.push_back(pType.get());
+				}
+			}
+
+			stats = resolver.resolve(vTypesToResolve, iWorkers);
+		}
+
+		std::lock_guard<std::mutex> guard { statsMtx };
+		referenceResolutionTime += std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - startedAt);
+		referenceStats.iReferences += stats.iReferences;
+		referenceStats.iResolved += stats.iResolved;
+	}
+
+	void PyAnalyzerContext::RuntimeContext::resolveReferences()
+	{
+		const size_t amountOfTypes = boost::python::len(pAnalyzerStorage->pyFoundTypes);
+		for (size_t typeId = 0; typeId < amountOfTypes; ++typeId)
+		{
+			boost::python::object typeObj = pAnalyzerStorage->pyFoundTypes[typeId];
+			boost::python::extract<boost::shared_ptr<PyTypeClass>> classExtraction(typeObj);
+
+			if (classExtraction.check())
+			{
+				const boost::shared_ptr<PyTypeClass>& pAsClass = classExtraction();
+				const auto* pNativeClass = static_cast<const cpp::TypeClass*>(pAsClass->getNative().get()); // NOLINT(*-pro-type-static-cast-downcast)
+
+				// Need to resolve parent refs (by native info: parent_types list is made on first access)
+				const auto& vParents = pNativeClass->getParentTypes();
+				if (vParents.empty())
+					continue;
+
+				std::vector<boost::shared_ptr<PyTypeClass>> vResolvedParents(vParents.size());
+
+				for (size_t parentId = 0; parentId < vParents.size(); ++parentId)
+				{
+					auto it = pAnalyzerStorage->vFoundTypeInstances.find(vParents[parentId].sTypeBaseInfo.sPrettyName);
+					if (it != pAnalyzerStorage->vFoundTypeInstances.end() && it->second->pyGetTypeKind() == cpp::TypeKind::TK_STRUCT_OR_CLASS)
+					{
+						// Resolved!
+						vResolvedParents[parentId] = boost::static_pointer_cast<PyTypeClass>(it->second);
+					}
+				}
+
+				pAsClass->setResolvedParentClasses(std::move(vResolvedParents));
+			}
+		}
+	}
+
+	PyAnalyzerContext::WatchedHeader PyAnalyzerContext::RuntimeContext::makeSnapshot(const std::filesystem::path& header, const rg3::llvm::AnalyzerResult& analyzeResult)
+	{
+		WatchedHeader snapshot {};
+		snapshot.header = header;
+		snapshot.vIssues = analyzeResult.vIssues;
+		snapshot.vDependencies.reserve(analyzeResult.vDependencies.size());
+
+		for (const auto& dependency : analyzeResult.vDependencies)
+		{
+			snapshot.vDependencies.emplace_back(dependency.string());
+		}
+
+		for (const auto& type : analyzeResult.vFoundTypes)
+		{
+			if (type->getKind() == cpp::TypeKind::TK_NONE)
+				continue; // Same as merge: not reported
+
+			cpp::BinaryWriter writer {};
+			cpp::TypeSerializer::writeType(writer, type.get());
+			snapshot.vTypes.emplace_back(type->getPrettyName(), std::move(writer.getBuffer()));
+		}
+
+		return snapshot;
+	}
+
+	void PyAnalyzerContext::RuntimeContext::workerEntryPoint(size_t iWorkerId, const std::optional<rg3::llvm::CompilerEnvironment>& sCompilerEnvironment)
+	{
+		struct Visitor
+		{
+			std::vector<HeaderResult>* pResults { nullptr };
+			std::vector<WatchedHeader>* pSnapshots { nullptr };
+			std::optional<rg3::llvm::CompilerEnvironment> sCompilerEnv { std::nullopt };
+			::llvm::IntrusiveRefCntPtr<rg3::llvm::SharedFileCache> pFileCache { nullptr };
+			std::shared_ptr<rg3::llvm::IncrementalCache> pIncrementalCache { nullptr };
+			RuntimeContext* pOwner { nullptr };
+			bool bStream { false };
+
+			void operator()(const AnalyzeHeaderTask& analyzeHeader)
+			{
+				if (pOwner->isCancelled())
+					return;
+
+				if (auto cachedResult = findCachedResult(analyzeHeader.headerPath, analyzeHeader.compilerConfig))
+				{
+					pOwner->addTranslationUnitStats(TranslationUnitStats { { analyzeHeader.headerPath }, {}, true });
+					storeResult(analyzeHeader.headerPath, std::move(cachedResult.value()));
+					return;
+				}
+
+				analyzeHeaderAndStore(analyzeHeader.headerPath, analyzeHeader.compilerConfig);
+			}
+
+			void operator()(const AnalyzeUmbrellaTask& analyzeUmbrella)
+			{
+				if (pOwner->isCancelled())
+					return;
+
+				// Reuse what we can, only changed headers go to umbrella
+				std::vector<std::filesystem::path> vHeaders {};
+				vHeaders.reserve(analyzeUmbrella.vHeaders.size());
+
+				for (const auto& header : analyzeUmbrella.vHeaders)
+				{
+					if (auto cachedResult = findCachedResult(header, analyzeUmbrella.compilerConfig))
+					{
+						pOwner->addTranslationUnitStats(TranslationUnitStats { { header }, {}, true });
+						storeResult(header, std::move(cachedResult.value()));
+					}
+					else
+					{
+						vHeaders.push_back(header);
+					}
+				}
+
+				if (vHeaders.empty())
+					return;
+
+				rg3::llvm::AnalyzerResult umbrellaResult = analyzeSource(rg3::llvm::CodeAnalyzer { rg3::llvm::CodeAnalyzer::makeUmbrellaSource(vHeaders), analyzeUmbrella.compilerConfig });
+				pOwner->addTranslationUnitStats(TranslationUnitStats { vHeaders, umbrellaResult.stats, false });
+
+				if (rg3::llvm::CodeAnalyzer::isCancelledResult(umbrellaResult))
+					return; // Partial result: must not be cached or reported
+
+				const bool bHasErrors = std::any_of(umbrellaResult.vIssues.begin(), umbrellaResult.vIssues.end(), [](const rg3::llvm::AnalyzerResult::CompilerIssue& issue) -> bool {
+					return issue.kind == rg3::llvm::AnalyzerResult::CompilerIssue::IssueKind::IK_ERROR;
+				});
+
+				if (bHasErrors)
+				{
+					// Error in one header could hide types of others (fatal errors stop whole TU) or be caused by neighbour header.
+					// Re-analyze each header alone to get exactly same results as without umbrella.
+					for (const auto& header : vHeaders)
+					{
+						if (pOwner->isCancelled())
+							return;
+
+						analyzeHeaderAndStore(header, analyzeUmbrella.compilerConfig);
+					}
+
+					return;
+				}
+
+				// Split results are not cached: types of shared includes are attributed to first header of batch,
+				// so result of header differs from result of same header analyzed alone (or inside another batch)
+				auto vResults = rg3::llvm::CodeAnalyzer::splitUmbrellaResult(std::move(umbrellaResult), vHeaders);
+				for (size_t i = 0; i < vResults.size(); ++i)
+				{
+					storeResult(vHeaders[i], std::move(vResults[i]));
+				}
+			}
+
+			/**
+			 * @brief Headers could have own configs (compilation database): cached result is valid only for same config
+			 */
+			std::string getConfigDigest(const rg3::llvm::CompilerConfig& compilerConfig) const
+			{
+				return rg3::llvm::IncrementalCache::makeConfigDigest(compilerConfig, sCompilerEnv.value_or(rg3::llvm::CompilerEnvironment {}));
+			}
+
+			std::optional<rg3::llvm::AnalyzerResult> findCachedResult(const std::filesystem::path& header, const rg3::llvm::CompilerConfig& compilerConfig)
+			{
+				if (!pIncrementalCache)
+					return std::nullopt;
+
+				return pIncrementalCache->find(header, getConfigDigest(compilerConfig));
+			}
+
+			void analyzeHeaderAndStore(const std::filesystem::path& header, const rg3::llvm::CompilerConfig& compilerConfig)
+			{
+				rg3::llvm::AnalyzerResult analyzeResult = analyzeSource(rg3::llvm::CodeAnalyzer { header, compilerConfig });
+				pOwner->addTranslationUnitStats(TranslationUnitStats { { header }, analyzeResult.stats, false });
+
+				if (rg3::llvm::CodeAnalyzer::isCancelledResult(analyzeResult))
+					return; // Partial result: must not be cached or reported
+
+				if (pIncrementalCache)
+				{
+					pIncrementalCache->store(header, getConfigDigest(compilerConfig), analyzeResult);
+				}
+
+				storeResult(header, std::move(analyzeResult));
+			}
+
+			rg3::llvm::AnalyzerResult analyzeSource(rg3::llvm::CodeAnalyzer codeAnalyzer)
+			{
+				if (sCompilerEnv.has_value())
+				{
+					// set environment from cache
+					codeAnalyzer.setCompilerEnvironment(sCompilerEnv.value());
+				}
+
+				if (pFileCache)
+				{
+					// share stat & file content cache between all workers
+					codeAnalyzer.setSharedFileCache(pFileCache);
+				}
+
+				// incremental cache validates result by all files which were read, watch mode subscribes to them
+				codeAnalyzer.setCollectDependencies(pIncrementalCache != nullptr || pSnapshots != nullptr);
+
+				// cancel() aborts compiler in the middle of translation unit
+				codeAnalyzer.setCancellationFlag(&pOwner->bCancelled);
+
+				return codeAnalyzer.analyze();
+			}
+
+			void storeResult(const std::filesystem::path& header, rg3::llvm::AnalyzerResult&& analyzeResult)
+			{
+				if (pSnapshots)
+				{
+					pSnapshots->emplace_back(makeSnapshot(header, analyzeResult));
+				}
+
+				// Own buffer of worker: no locks & no GIL here, python objects are made once after all workers are done (or by consumer of stream)
+				analyzeResult.vDependencies.clear();
+				const size_t iTypes = analyzeResult.vFoundTypes.size();
+
+				if (bStream)
+				{
+					// Consumer takes results while others are parsed
+					pOwner->resultQueue.push(HeaderResult { header, std::move(analyzeResult) });
+				}
+				else
+				{
+					pResults->emplace_back(HeaderResult { header, std::move(analyzeResult) });
+				}
+
+				pOwner->onHeaderCompleted(iTypes);
+			}
+		};
+
+
+		const bool bStream = resultQueue.isEnabled();
+		std::vector<WatchedHeader>* pSnapshots = bCollectSnapshots && !bStream ? &workersSnapshots[iWorkerId] : nullptr;
+
+		Visitor v { &workersResults[iWorkerId], pSnapshots, sCompilerEnvironment, m_pFileCache, m_pIncrementalCache, this, bStream };
+
+		// Block until task arrived. Leave when queue closed & drained
+		while (auto task = waitTask(iWorkerId))
+		{
+			std::visit(v, task.value());
+		}
+
+		{
+			std::lock_guard<std::mutex> guard { progressMtx };
+			++iFinishedWorkers;
+		}
+
+		progressCV.notify_all();
+	}
+}
\ No newline at end of file
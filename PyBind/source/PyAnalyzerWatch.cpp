@@ -0,0 +1,356 @@
+#include <RG3/PyBind/PyAnalyzerContext.h>
+#include <RG3/PyBind/PyAnalyzerRuntimeContext.h>
+#include <RG3/Cpp/TypeSerializer.h>
+#include <RG3/Cpp/FileUtils.h>
+#include <fmt/format.h>
+#include <unordered_map>
+#include <algorithm>
+#include <numeric>
+#include <variant>
+#include <chrono>
+
+
+namespace rg3::pybind
+{
+	boost::python::object PyAnalyzerContext::waitChanges(double fTimeoutSeconds)
+	{
+		if (m_bInProgress.exchange(true))
+		{
+			PyErr_SetString(PyExc_RuntimeError, "Analyze in progress");
+			boost::python::throw_error_already_set();
+			return {};
+		}
+
+		if (!m_pWatchState)
+		{
+			m_bInProgress = false;
+
+			PyErr_SetString(PyExc_RuntimeError, "Watch is not active: enable watch_mode and run analyze first");
+			boost::python::throw_error_already_set();
+			return {};
+		}
+
+		joinAsyncThread();
+
+		rg3::llvm::FileChanges changes {};
+		std::vector<std::size_t> vAffected {};
+
+		{
+			PyGuard pyGuard {};
+
+			const auto timeout = fTimeoutSeconds < 0.0 ? std::chrono::milliseconds(-1) : std::chrono::milliseconds(static_cast<std::int64_t>(fTimeoutSeconds * 1000.0));
+			changes = m_pWatchState->pWatcher->waitChanges(timeout);
+			vAffected = collectAffectedHeaders(changes);
+		}
+
+		if (changes.empty())
+		{
+			m_bInProgress = false;
+			return {};
+		}
+
+		m_pWatchState->vReanalyzedHeaders.clear();
+		m_pWatchState->vAddedTypes.clear();
+		m_pWatchState->vRemovedTypes.clear();
+		m_pWatchState->vChangedTypes.clear();
+
+		if (!vAffected.empty())
+		{
+			// Changed file is not read by any header (temporary file of editor, unrelated file): results are same
+			beginRun();
+
+			bool bNativeResult = false;
+			{
+				PyGuard pyGuard {};
+				bNativeResult = runWatchedHeaders(vAffected);
+			}
+
+			m_bLastRunResult = finishRun(bNativeResult);
+		}
+
+		auto delta = makeWatchDelta(changes);
+		m_bInProgress = false;
+
+		return delta;
+	}
+
+	void PyAnalyzerContext::startWatch()
+	{
+		auto pState = std::make_unique<WatchState>();
+
+		auto watcherResult = rg3::llvm::FileWatcher::create();
+		if (auto* pError = std::get_if<rg3::llvm::FileWatcherError>(&watcherResult))
+		{
+			rg3::llvm::AnalyzerResult::CompilerIssue issue;
+			issue.kind = rg3::llvm::AnalyzerResult::CompilerIssue::IssueKind::IK_WARNING;
+			issue.sSourceFile = "RG3_GLOBAL_SCOPE";
+			issue.sMessage = fmt::format("RG3|Start watch failed: {}", pError->message);
+
+			m_vRunIssues.emplace_back(std::move(issue));
+			return;
+		}
+
+		pState->pWatcher = std::move(std::get<std::unique_ptr<rg3::llvm::FileWatcher>>(watcherResult));
+		pState->vHeaders.resize(m_headersToPrepare.size());
+
+		std::unordered_map<std::string, std::size_t> headerIds {};
+		for (std::size_t i = 0; i < m_headersToPrepare.size(); ++i)
+		{
+			headerIds.try_emplace(m_headersToPrepare[i].string(), i);
+			pState->vHeaders[i].header = m_headersToPrepare[i];
+		}
+
+		for (auto& snapshot : m_pContext->takeSnapshots())
+		{
+			auto it = headerIds.find(snapshot.header.string());
+			if (it != headerIds.end())
+			{
+				pState->vHeaders[it->second] = std::move(snapshot);
+			}
+		}
+
+		// New files in include directories could shadow included files
+		for (const auto& include : m_compilerConfig.vIncludes)
+		{
+			pState->pWatcher->watchDirectory(include.sFsLocation);
+		}
+
+		m_pWatchState = std::move(pState);
+
+		for (std::size_t i = 0; i < m_headersToPrepare.size(); ++i)
+		{
+			// Header is watched even when it was not read (removed or renamed): it could appear again
+			m_pWatchState->dependents[rg3::cpp::utils::normalizePath(m_headersToPrepare[i]).string()].push_back(i);
+			m_pWatchState->pWatcher->watchDirectory(std::filesystem::absolute(m_headersToPrepare[i]).parent_path());
+		}
+
+		for (std::size_t i = 0; i < m_pWatchState->vHeaders.size(); ++i)
+		{
+			for (const auto& sDependency : m_pWatchState->vHeaders[i].vDependencies)
+			{
+				auto& vDependents = m_pWatchState->dependents[sDependency];
+				if (vDependents.empty() || vDependents.back() != i)
+				{
+					vDependents.push_back(i);
+				}
+
+				m_pWatchState->pWatcher->watchDirectory(std::filesystem::path(sDependency).parent_path());
+			}
+		}
+	}
+
+	std::vector<std::size_t> PyAnalyzerContext::collectAffectedHeaders(const rg3::llvm::FileChanges& changes) const
+	{
+		std::vector<std::size_t> vAffected {};
+
+		if (changes.bOverflow)
+		{
+			// Lost events: anything could be changed
+			vAffected.resize(m_headersToPrepare.size());
+			std::iota(vAffected.begin(), vAffected.end(), 0);
+			return vAffected;
+		}
+
+		for (const auto& file : changes.vFiles)
+		{
+			auto it = m_pWatchState->dependents.find(file.lexically_normal().string());
+			if (it != m_pWatchState->dependents.end())
+			{
+				vAffected.insert(vAffected.end(), it->second.begin(), it->second.end());
+			}
+		}
+
+		for (const auto& file : changes.vCreatedFiles)
+		{
+			// New file could be found by include search before file which was read ('#include "X.h"' resolved
+			// in other include directory or directory of includer). Match by file name: every header which read
+			// file with same name is analyzed again, even when relative path of include differs (rare & cheap).
+			const std::string sSuffix = "/" + file.filename().string();
+
+			for (const auto& [sDependency, vDependents] : m_pWatchState->dependents)
+			{
+				if (sDependency.ends_with(sSuffix))
+				{
+					vAffected.insert(vAffected.end(), vDependents.begin(), vDependents.end());
+				}
+			}
+		}
+
+		// Keep order of headers: merged results don't depend on order of changes
+		std::sort(vAffected.begin(), vAffected.end());
+		vAffected.erase(std::unique(vAffected.begin(), vAffected.end()), vAffected.end());
+
+		return vAffected;
+	}
+
+	bool PyAnalyzerContext::runWatchedHeaders(const std::vector<std::size_t>& vAffected)
+	{
+		auto& state = *m_pWatchState;
+
+		// Types before change: same merge rules as mergeWorkersResults (order of headers, first type with same name wins)
+		auto mergeWatchedTypes = [&state]() {
+			std::unordered_map<std::string, const std::string*> types {};
+			std::vector<std::string> vNames {};
+
+			for (const auto& watchedHeader : state.vHeaders)
+			{
+				for (const auto& [sPrettyName, sData] : watchedHeader.vTypes)
+				{
+					if (types.try_emplace(sPrettyName, &sData).second)
+					{
+						vNames.push_back(sPrettyName);
+					}
+				}
+			}
+
+			return std::make_pair(std::move(types), std::move(vNames));
+		};
+
+		std::unordered_map<std::string, std::string> previousTypes {};
+		for (const auto& [sPrettyName, pData] : mergeWatchedTypes().first)
+		{
+			previousTypes.emplace(sPrettyName, *pData);
+		}
+
+		std::vector<std::filesystem::path> vHeaders {};
+		vHeaders.reserve(vAffected.size());
+
+		for (const std::size_t iHeaderId : vAffected)
+		{
+			vHeaders.push_back(m_headersToPrepare[iHeaderId]);
+		}
+
+		m_pContext->setCollectSnapshots(true);
+		const bool bResult = runNativeOn(vHeaders, nullptr);
+		m_pContext->setCollectSnapshots(false);
+
+		state.vReanalyzedHeaders = vHeaders;
+
+		if (!bResult || m_pContext->isCancelled())
+		{
+			// Keep known results: next change will retry
+			m_pContext->takeSnapshots();
+			return bResult;
+		}
+
+		std::unordered_map<std::string, std::size_t> headerIds {};
+		for (const std::size_t iHeaderId : vAffected)
+		{
+			headerIds.try_emplace(m_headersToPrepare[iHeaderId].string(), iHeaderId);
+		}
+
+		for (auto& snapshot : m_pContext->takeSnapshots())
+		{
+			auto it = headerIds.find(snapshot.header.string());
+			if (it == headerIds.end())
+				continue;
+
+			// Subscribe to new includes of header (old subscriptions are kept: they are cheap and file could be included again)
+			for (const auto& sDependency : snapshot.vDependencies)
+			{
+				auto& vDependents = state.dependents[sDependency];
+				if (std::find(vDependents.begin(), vDependents.end(), it->second) == vDependents.end())
+				{
+					vDependents.push_back(it->second);
+				}
+
+				state.pWatcher->watchDirectory(std::filesystem::path(sDependency).parent_path());
+			}
+
+			state.vHeaders[it->second] = std::move(snapshot);
+		}
+
+		// Results of context are results of all headers: re-analyzed & kept ones
+		const auto [currentTypes, vCurrentNames] = mergeWatchedTypes();
+
+		rg3::llvm::AnalyzerResult::CompilerIssuesVector vIssues {};
+		std::vector<cpp::TypeBasePtr> vTypes {};
+		vTypes.reserve(vCurrentNames.size());
+
+		for (const auto& watchedHeader : state.vHeaders)
+		{
+			vIssues.insert(vIssues.end(), watchedHeader.vIssues.begin(), watchedHeader.vIssues.end());
+		}
+
+		for (const auto& sPrettyName : vCurrentNames)
+		{
+			const std::string& sData = *currentTypes.at(sPrettyName);
+
+			cpp::BinaryReader reader { sData };
+			if (auto pType = cpp::TypeSerializer::readType(reader))
+			{
+				vTypes.emplace_back(std::move(pType));
+			}
+
+			auto it = previousTypes.find(sPrettyName);
+			if (it == previousTypes.end())
+			{
+				state.vAddedTypes.push_back(sPrettyName);
+			}
+			else
+			{
+				if (it->second != sData)
+				{
+					state.vChangedTypes.push_back(sPrettyName);
+				}
+
+				previousTypes.erase(it);
+			}
+		}
+
+		for (const auto& [sPrettyName, sData] : previousTypes)
+		{
+			state.vRemovedTypes.push_back(sPrettyName);
+		}
+
+		std::sort(state.vRemovedTypes.begin(), state.vRemovedTypes.end());
+
+		m_pContext->setMergedResults(std::move(vIssues), std::move(vTypes));
+		return true;
+	}
+
+	boost::python::dict PyAnalyzerContext::makeWatchDelta(const rg3::llvm::FileChanges& changes) const
+	{
+		auto makeTypesList = [this](const std::vector<std::string>& vNames) {
+			boost::python::list result {};
+
+			for (const auto& sPrettyName : vNames)
+			{
+				auto it = m_pySubjects.vFoundTypeInstances.find(sPrettyName);
+				if (it != m_pySubjects.vFoundTypeInstances.end())
+				{
+					result.append(it->second);
+				}
+			}
+
+			return result;
+		};
+
+		boost::python::list changedFiles {};
+		for (const auto& file : changes.vFiles)
+		{
+			changedFiles.append(file.string());
+		}
+
+		boost::python::list reanalyzedHeaders {};
+		for (const auto& header : m_pWatchState->vReanalyzedHeaders)
+		{
+			reanalyzedHeaders.append(header.string());
+		}
+
+		boost::python::list removedTypes {};
+		for (const auto& sPrettyName : m_pWatchState->vRemovedTypes)
+		{
+			removedTypes.append(sPrettyName);
+		}
+
+		boost::python::dict result {};
+		result["changed_files"] = changedFiles;
+		result["reanalyzed_headers"] = reanalyzedHeaders;
+		result["added"] = makeTypesList(m_pWatchState->vAddedTypes);
+		result["removed"] = removedTypes;
+		result["changed"] = makeTypesList(m_pWatchState->vChangedTypes);
+
+		return result;
+	}
+}
\ No newline at end of file
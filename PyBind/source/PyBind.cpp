@@ -14,13 +14,17 @@
 
 #include <RG3/LLVM/CodeEvaluator.h>
 
+#include <RG3/Daemon/DaemonClient.h>
+
 #include <RG3/PyBind/PyCodeAnalyzerBuilder.h>
 #include <RG3/PyBind/PyTypeBase.h>
 #include <RG3/PyBind/PyTypeEnum.h>
 #include <RG3/PyBind/PyTypeClass.h>
 #include <RG3/PyBind/PyAnalyzerContext.h>
+#include <RG3/PyBind/PyAnalyzeStream.h>
 #include <RG3/PyBind/PyClangRuntime.h>
 #include <RG3/PyBind/PyClassParent.h>
+#include <RG3/PyBind/PyTypeDatabase.h>
 
 
 using namespace boost::python;
@@ -166,7 +170,7 @@ namespace rg3::pybind::wrappers
 		return boost::python::str(sInfo.sPrettyName);
 	}
 
-	static boost::python::object CodeEvaluator_eval(rg3::llvm::CodeEvaluator& sEval, const std::string& sCode, const boost::python::list& aCapture)
+	static std::vector<std::string> CodeEvaluator_makeCaptureList(const boost::python::list& aCapture)
 	{
 		std::vector<std::string> aCaptureList {};
 		aCaptureList.reserve(len(aCapture));
@@ -176,8 +180,11 @@ namespace rg3::pybind::wrappers
 			aCaptureList.push_back(boost::python::extract<std::string>(aCapture[i]));
 		}
 
-		// Invoke originals
-		auto sEvalResult = sEval.evaluateCode(sCode, aCaptureList);
+		return aCaptureList;
+	}
+
+	static boost::python::object CodeEvaluator_makeResult(const rg3::llvm::CodeEvaluateResult& sEvalResult)
+	{
 		if (!sEvalResult)
 		{
 			// Error!
@@ -204,6 +211,12 @@ namespace rg3::pybind::wrappers
 		return result;
 	}
 
+	static boost::python::object CodeEvaluator_eval(rg3::llvm::CodeEvaluator& sEval, const std::string& sCode, const boost::python::list& aCapture)
+	{
+		// Invoke originals
+		return CodeEvaluator_makeResult(sEval.evaluateCode(sCode, CodeEvaluator_makeCaptureList(aCapture)));
+	}
+
 	static void CodeEvaluator_setCppStandard(rg3::llvm::CodeEvaluator& sEval, rg3::llvm::CxxStandard eStandard)
 	{
 		sEval.getCompilerConfig().cppStandard = eStandard;
@@ -325,6 +338,95 @@ namespace rg3::pybind::wrappers
 	{
 		return boost::shared_ptr<rg3::llvm::CodeEvaluator>(new rg3::llvm::CodeEvaluator(sContext.getCompilerConfig()));
 	}
+
+	static void DaemonClient_raiseError(const rg3::daemon::DaemonError& error)
+	{
+		PyErr_SetString(PyExc_RuntimeError, error.message.c_str());
+		boost::python::throw_error_already_set();
+	}
+
+	static boost::shared_ptr<rg3::daemon::DaemonClient> DaemonClient_connect(const std::string& sSocketPath)
+	{
+		rg3::daemon::DaemonClientResult connectResult {};
+
+		{
+			// Daemon could be busy with analyze of another client: don't block other python threads
+			PyThreadState* pState = PyEval_SaveThread();
+			connectResult = rg3::daemon::DaemonClient::connect(sSocketPath);
+			PyEval_RestoreThread(pState);
+		}
+
+		if (auto* pError = std::get_if<rg3::daemon::DaemonError>(&connectResult))
+		{
+			DaemonClient_raiseError(rg3::daemon::DaemonError { fmt::format("Failed to connect to rg3d: {}", pError->message) });
+			return nullptr;
+		}
+
+		return boost::shared_ptr<rg3::daemon::DaemonClient>(std::get<std::unique_ptr<rg3::daemon::DaemonClient>>(connectResult).release());
+	}
+
+	static boost::shared_ptr<rg3::daemon::DaemonClient> DaemonClient_connectDefault()
+	{
+		return DaemonClient_connect({});
+	}
+
+	static boost::python::object DaemonClient_eval(rg3::daemon::DaemonClient& sClient, const rg3::llvm::CodeEvaluator& sEval, const std::string& sCode, const boost::python::list& aCapture)
+	{
+		rg3::daemon::EvaluateRequest request {};
+		request.compilerConfig = sEval.getCompilerConfig();
+		request.sCode = sCode;
+		request.vCapture = CodeEvaluator_makeCaptureList(aCapture);
+
+		rg3::daemon::DaemonResponse<rg3::llvm::CodeEvaluateResult> response {};
+
+		{
+			PyThreadState* pState = PyEval_SaveThread();
+			response = sClient.evaluate(request);
+			PyEval_RestoreThread(pState);
+		}
+
+		if (auto* pError = std::get_if<rg3::daemon::DaemonError>(&response))
+		{
+			DaemonClient_raiseError(*pError);
+			return boost::python::object();
+		}
+
+		return CodeEvaluator_makeResult(std::get<rg3::llvm::CodeEvaluateResult>(response));
+	}
+
+	static boost::python::dict DaemonClient_getStats(rg3::daemon::DaemonClient& sClient)
+	{
+		auto response = sClient.getStats();
+		if (auto* pError = std::get_if<rg3::daemon::DaemonError>(&response))
+		{
+			DaemonClient_raiseError(*pError);
+			return {};
+		}
+
+		const auto& stats = std::get<rg3::daemon::StatsResponse>(response);
+
+		boost::python::dict result {};
+		result["requests"] = stats.iRequests;
+		result["reused_headers"] = stats.iReusedHeaders;
+		result["analyzed_headers"] = stats.iAnalyzedHeaders;
+		result["cached_results"] = stats.iCachedResults;
+		result["uptime_ms"] = std::chrono::duration<double, std::milli>(stats.uptime).count();
+		return result;
+	}
+
+	static void DaemonClient_shutdown(rg3::daemon::DaemonClient& sClient)
+	{
+		auto response = sClient.shutdown();
+		if (auto* pError = std::get_if<rg3::daemon::DaemonError>(&response))
+		{
+			DaemonClient_raiseError(*pError);
+		}
+	}
+
+	static boost::python::str DaemonClient_getDefaultSocketPath()
+	{
+		return boost::python::str(rg3::daemon::UnixSocket::getDefaultSocketPath().string());
+	}
 }
 
 
@@ -494,6 +596,14 @@ BOOST_PYTHON_MODULE(rg3py)
 		.value("IK_DEFAULT", rg3::llvm::IncludeKind::IK_DEFAULT)
 	;
 
+	enum_<rg3::llvm::SourceFilter>("SourceFilter", "Which files are allowed to produce types (main file is always allowed)")
+		.value("SF_ALL", rg3::llvm::SourceFilter::SF_ALL)
+		.value("SF_SKIP_SYSTEM_HEADERS", rg3::llvm::SourceFilter::SF_SKIP_SYSTEM_HEADERS)
+		.value("SF_PROJECT_INCLUDES", rg3::llvm::SourceFilter::SF_PROJECT_INCLUDES)
+		.value("SF_MAIN_FILE", rg3::llvm::SourceFilter::SF_MAIN_FILE)
+		.value("SF_DEFAULT", rg3::llvm::SourceFilter::SF_DEFAULT)
+	;
+
 	class_<rg3::llvm::IncludeInfo>("CppIncludeInfo", "Information about include (location and kind)")
 		.def(init<std::string, rg3::llvm::IncludeKind>(args("path", "kind")))
 		.add_property("path", &rg3::pybind::wrappers::CppIncludeInfo_getPath, "Path to C/C++ source header")
@@ -554,6 +664,7 @@ BOOST_PYTHON_MODULE(rg3py)
 
 		.add_property("types", make_function(&rg3::pybind::PyCodeAnalyzerBuilder::getFoundTypes, return_value_policy<copy_const_reference>()), "A list of found types")
 		.add_property("issues", make_function(&rg3::pybind::PyCodeAnalyzerBuilder::getFoundIssues, return_value_policy<copy_const_reference>()), "A list of found issues")
+		.add_property("stats", &rg3::pybind::PyCodeAnalyzerBuilder::getStats, "Phase times (ms) & counters of last analyze")
 		.add_property("ignore_runtime",
 					  &rg3::pybind::PyCodeAnalyzerBuilder::isNonRuntimeTypesAllowedToBeCollected,
 					  &rg3::pybind::PyCodeAnalyzerBuilder::setAllowToCollectNonRuntimeTypes,
@@ -598,6 +709,31 @@ BOOST_PYTHON_MODULE(rg3py)
 		.add_property("ignore_runtime_tag", &rg3::pybind::PyAnalyzerContext::isRuntimeTagIgnored, &rg3::pybind::PyAnalyzerContext::setIgnoreRuntimeTag, "Should context ignore @runtime tag on 'collect types' stage")
 		.add_property("deep_analysis", &rg3::pybind::PyAnalyzerContext::isDeepAnalysisEnabled, &rg3::pybind::PyAnalyzerContext::setEnableDeepAnalysis, "Should rg3py use deep analysis (extract more information, but use more analysis time)")
 		.add_property("compiler_defs", &rg3::pybind::PyAnalyzerContext::getCompilerDefs, "Compiler definitions")
+		.add_property("in_process_env_detection", &rg3::pybind::PyAnalyzerContext::isInProcessEnvDetectionUsed, &rg3::pybind::PyAnalyzerContext::setUseInProcessEnvDetection, "Detect compiler environment via clang Driver inside current process instead of running system compiler")
+		.add_property("gcc_toolchain", &rg3::pybind::PyAnalyzerContext::getGccToolchain, &rg3::pybind::PyAnalyzerContext::setGccToolchain, "GCC installation used by in-process environment detection (same as --gcc-toolchain)")
+		.add_property("shared_file_cache", &rg3::pybind::PyAnalyzerContext::isSharedFileCacheUsed, &rg3::pybind::PyAnalyzerContext::setUseSharedFileCache, "Share stat & file content cache between all workers of single analyze run")
+		.add_property("file_cache_stats", &rg3::pybind::PyAnalyzerContext::getFileCacheStats, "Hits & misses of shared file cache of last analyze")
+		.add_property("umbrella_mode", &rg3::pybind::PyAnalyzerContext::isUmbrellaModeUsed, &rg3::pybind::PyAnalyzerContext::setUseUmbrellaMode, "Analyze batches of headers inside single translation unit: shared includes are parsed once per batch")
+		.add_property("umbrella_batch_size", &rg3::pybind::PyAnalyzerContext::getUmbrellaBatchSize, &rg3::pybind::PyAnalyzerContext::setUmbrellaBatchSize, "Headers per umbrella translation unit. 0 - pick batches by size of headers & amount of workers")
+		.add_property("incremental_cache_dir", &rg3::pybind::PyAnalyzerContext::getIncrementalCacheDir, &rg3::pybind::PyAnalyzerContext::setIncrementalCacheDir, "Directory of incremental cache: unchanged headers (content, includes & config) are reused from previous runs. Empty - disabled")
+		.add_property("compile_commands", &rg3::pybind::PyAnalyzerContext::getCompileCommandsFile, &rg3::pybind::PyAnalyzerContext::setCompileCommandsFile, "Path to compile_commands.json: each header gets include dirs, definitions & standard of its owning translation unit (over common config). Empty - same config for every header")
+		.add_property("cost_history_file", &rg3::pybind::PyAnalyzerContext::getCostHistoryFile, &rg3::pybind::PyAnalyzerContext::setCostHistoryFile, "File of measured analyze time of headers: used to schedule expensive headers first and updated after each run. Empty - costs are estimated by size & includes")
+		.add_property("daemon_socket", &rg3::pybind::PyAnalyzerContext::getDaemonSocket, &rg3::pybind::PyAnalyzerContext::setDaemonSocket, "Socket of running rg3d: headers are analyzed by daemon which keeps results, environments & preambles warm between runs. Empty - analyze inside current process")
+		.add_property("cost_aware_scheduling", &rg3::pybind::PyAnalyzerContext::isCostAwareSchedulingUsed, &rg3::pybind::PyAnalyzerContext::setUseCostAwareScheduling, "Run most expensive headers (umbrellas) first to shrink tail of analyze. Order of results is not affected")
+		.add_property("watch_mode", &rg3::pybind::PyAnalyzerContext::isWatchModeUsed, &rg3::pybind::PyAnalyzerContext::setUseWatchMode, "Keep results & dependencies of headers after analyze and watch their files: wait_changes re-analyzes only headers affected by changes")
+		.add_property("reused_headers", &rg3::pybind::PyAnalyzerContext::getReusedHeaders, "Headers which results were taken from incremental cache during last analyze")
+		.add_property("recomputed_headers", &rg3::pybind::PyAnalyzerContext::getRecomputedHeaders, "Headers which were analyzed during last analyze when incremental cache enabled")
+		.add_property("preamble_headers", &rg3::pybind::PyAnalyzerContext::getPreambleHeaders, &rg3::pybind::PyAnalyzerContext::setPreambleHeaders, "Headers (like '<vector>') which will be precompiled once and loaded by each compiler instance whose header includes all of them. Types of these headers are not collected")
+		.add_property("source_filter", &rg3::pybind::PyAnalyzerContext::getSourceFilter, &rg3::pybind::PyAnalyzerContext::setSourceFilter, "Which files are allowed to produce types: declarations of other files are skipped before any processing")
+		.add_property("source_allow_globs", &rg3::pybind::PyAnalyzerContext::getSourceAllowGlobs, &rg3::pybind::PyAnalyzerContext::setSourceAllowGlobs, "When not empty: included file must match at least one glob (like '*/src/*') to produce types")
+		.add_property("source_deny_globs", &rg3::pybind::PyAnalyzerContext::getSourceDenyGlobs, &rg3::pybind::PyAnalyzerContext::setSourceDenyGlobs, "Included files which match any glob (like '*/third_party/*') do not produce types")
+		.add_property("auto_preamble", &rg3::pybind::PyAnalyzerContext::isAutoPreambleUsed, &rg3::pybind::PyAnalyzerContext::setUseAutoPreamble, "Precompile angled includes which are used by at least half of headers (headers which don't include all of them are parsed without preamble)")
+		.add_property("preamble_stats", &rg3::pybind::PyAnalyzerContext::getPreambleStats, "Precompiled preamble report of last analyze (built & rebuilt PCH files, uses, build time & estimated saved parse time)")
+		.add_property("scheduler_stats", &rg3::pybind::PyAnalyzerContext::getSchedulerStats, "Scheduler counters of last analyze (queue depth, idle time & wake ups of workers, order & estimated cost of tasks)")
+		.add_property("progress", &rg3::pybind::PyAnalyzerContext::getProgress, "Progress of current (or last) analyze: completed_headers, total_headers, types_found, elapsed_ms, cancelled & finished")
+		.add_property("finished", &rg3::pybind::PyAnalyzerContext::isFinished, "True when analyze is not running")
+		.add_property("succeeded", &rg3::pybind::PyAnalyzerContext::isLastAnalyzeSucceeded, "Result of last finished analyze")
+		.add_property("stats", &rg3::pybind::PyAnalyzerContext::getStats, "Cost of last analyze: wall time, phase times (ms) & counters, conversion time, peak memory and stats of each translation unit")
 
 		// Functions
 		.def("set_workers_count", &rg3::pybind::PyAnalyzerContext::setWorkersCount)
@@ -605,19 +741,56 @@ BOOST_PYTHON_MODULE(rg3py)
 		.def("set_include_directories", &rg3::pybind::PyAnalyzerContext::setCompilerIncludeDirs)
 		.def("set_compiler_args", &rg3::pybind::PyAnalyzerContext::setCompilerArgs)
 		.def("set_compiler_defs", &rg3::pybind::PyAnalyzerContext::setCompilerDefs)
+		.def("set_preamble_headers", &rg3::pybind::PyAnalyzerContext::setPreambleHeaders)
 		.def("analyze", &rg3::pybind::PyAnalyzerContext::analyze)
+		.def("analyze_async", &rg3::pybind::PyAnalyzerContext::analyzeAsync, (arg("self"), arg("progress_callback") = object()), "Start analyze in background and return immediately (False when analyze already in progress)")
+		.def("stream", &rg3::pybind::PyAnalyzerContext::stream, (arg("self"), arg("max_pending") = 16), "Start analyze in background and iterate over results of headers as soon as they are ready (None when analyze already in progress)")
+		.def("wait", &rg3::pybind::PyAnalyzerContext::wait, (arg("self"), arg("timeout") = -1.0), "Wait for analyze started by analyze_async. Returns True when analyze is done")
+		.def("wait_changes", &rg3::pybind::PyAnalyzerContext::waitChanges, (arg("self"), arg("timeout") = -1.0), "Wait for changes of watched files and re-analyze affected headers. Returns delta (changed_files, reanalyzed_headers, added, removed & changed types) or None on timeout")
+		.def("cancel", &rg3::pybind::PyAnalyzerContext::cancel, "Drop queued headers and abort running compilers")
 		.def("make_evaluator", &rg3::pybind::wrappers::PyAnalyzerContext_makeEvaluator)
 
 		// Resolvers
 		.def("get_type_by_reference", &rg3::pybind::PyAnalyzerContext::pyGetTypeOfTypeReference)
 	;
 
+	class_<rg3::pybind::PyAnalyzeStream, boost::noncopyable, boost::shared_ptr<rg3::pybind::PyAnalyzeStream>>("AnalyzeStream", "Iterator over results of headers of running analyze (dict: header, types & issues). Dropped iterator cancels analyze", no_init)
+		.def("__iter__", &rg3::pybind::PyAnalyzeStream::__iter__)
+		.def("__next__", &rg3::pybind::PyAnalyzeStream::__next__)
+	;
+
+	class_<rg3::pybind::PyTypeDatabase, boost::noncopyable, boost::shared_ptr<rg3::pybind::PyTypeDatabase>>("TypeDatabase", "Compact binary database of analyze result (types & issues). Opened file is memory-mapped: types are deserialized on first access", no_init)
+		.def("open", &rg3::pybind::PyTypeDatabase::open)
+		.staticmethod("open")
+
+		.def("write", &rg3::pybind::PyTypeDatabase::write)
+		.staticmethod("write")
+
+		.add_property("types_count", &rg3::pybind::PyTypeDatabase::getTypesCount, "Count of types in database")
+		.add_property("type_names", &rg3::pybind::PyTypeDatabase::getTypeNames, "Pretty names of types (without deserialization of types)")
+		.add_property("issues", &rg3::pybind::PyTypeDatabase::getIssues, "Stored compiler issues")
+
+		.def("find_type", &rg3::pybind::PyTypeDatabase::findType)
+		.def("get_type", &rg3::pybind::PyTypeDatabase::getType)
+		.def("get_parent_types", &rg3::pybind::PyTypeDatabase::getParentTypes)
+		.def("load_types", &rg3::pybind::PyTypeDatabase::loadTypes)
+	;
+
 	class_<rg3::pybind::PyClangRuntime, boost::noncopyable>("ClangRuntime", "Technical information about bundled Clang, LLVM and detected system paths")
 	    .def("get_version", &rg3::pybind::PyClangRuntime::getRuntimeInfo)
 		.staticmethod("get_version")
 
 		.def("detect_system_include_sources", &rg3::pybind::PyClangRuntime::detectSystemIncludeSources)
 		.staticmethod("detect_system_include_sources")
+
+		.def("detect_system_include_sources_in_process", &rg3::pybind::PyClangRuntime::detectSystemIncludeSourcesInProcess)
+		.staticmethod("detect_system_include_sources_in_process")
+
+		.def("invalidate_compiler_env_cache", &rg3::pybind::PyClangRuntime::invalidateCompilerEnvironmentCache)
+		.staticmethod("invalidate_compiler_env_cache")
+
+		.def("get_compiler_env_cache_stats", &rg3::pybind::PyClangRuntime::getCompilerEnvironmentCacheStats)
+		.staticmethod("get_compiler_env_cache_stats")
 	;
 
 	class_<rg3::llvm::CodeEvaluator, boost::noncopyable, boost::shared_ptr<rg3::llvm::CodeEvaluator>>("CodeEvaluator", "Eval constexpr C++ code and provide access to result values", boost::python::init<>())
@@ -629,4 +802,17 @@ BOOST_PYTHON_MODULE(rg3py)
 		.def("make_from_system_env", &rg3::pybind::wrappers::CodeEvaluator_makeFromSystemEnv)
 		.staticmethod("make_from_system_env")
 	;
+	class_<rg3::daemon::DaemonClient, boost::noncopyable, boost::shared_ptr<rg3::daemon::DaemonClient>>("DaemonClient", "Connection to resident analysis daemon (rg3d)", no_init)
+		.def("connect", &rg3::pybind::wrappers::DaemonClient_connect)
+		.def("connect", &rg3::pybind::wrappers::DaemonClient_connectDefault)
+		.staticmethod("connect")
+
+		.def("default_socket_path", &rg3::pybind::wrappers::DaemonClient_getDefaultSocketPath)
+		.staticmethod("default_socket_path")
+
+		.add_property("stats", &rg3::pybind::wrappers::DaemonClient_getStats, "Counters of daemon: requests, reused & analyzed headers, cached results and uptime (ms)")
+
+		.def("eval", &rg3::pybind::wrappers::DaemonClient_eval, "Same as CodeEvaluator.eval (config of evaluator is used) but evaluated by daemon")
+		.def("shutdown", &rg3::pybind::wrappers::DaemonClient_shutdown, "Stop daemon. Client is not usable after that")
+	;
 }
\ No newline at end of file
@@ -1,6 +1,7 @@
 #include <RG3/PyBind/PyClangRuntime.h>
 
 #include <RG3/LLVM/CompilerConfigDetector.h>
+#include <RG3/LLVM/CompilerEnvironmentCache.h>
 #include <RG3/LLVM/Compiler.h>
 
 
@@ -34,4 +35,51 @@ namespace rg3::pybind
 
 		return {};
 	}
+
+	boost::python::object PyClangRuntime::detectSystemIncludeSourcesInProcess(const std::string& sGccToolchain)
+	{
+		rg3::llvm::InProcessDetectorOptions options {};
+		options.sGccToolchain = sGccToolchain;
+
+		auto envResult = rg3::llvm::CompilerConfigDetector::detectCompilerEnvironmentInProcess(options);
+		if (auto pEnv = std::get_if<rg3::llvm::CompilerEnvironment>(&envResult))
+		{
+			boost::python::list result;
+
+			for (const auto& inc : pEnv->config.vSystemIncludes)
+			{
+				result.append(inc.sFsLocation.string());
+			}
+
+			return result;
+		}
+
+		if (auto pError = std::get_if<rg3::llvm::CompilerEnvError>(&envResult))
+		{
+			return boost::python::str(pError->message);
+		}
+
+		return {};
+	}
+
+	void PyClangRuntime::invalidateCompilerEnvironmentCache()
+	{
+		rg3::llvm::CompilerEnvironmentCache::getInstance().invalidate();
+	}
+
+	boost::python::dict PyClangRuntime::getCompilerEnvironmentCacheStats()
+	{
+		const auto& cache = rg3::llvm::CompilerEnvironmentCache::getInstance();
+		const auto stats = cache.getStats();
+		const auto diskCacheDir = cache.getDiskCacheDirectory();
+
+		boost::python::dict result {};
+		result["memory_hits"] = stats.iMemoryHits;
+		result["disk_hits"] = stats.iDiskHits;
+		result["misses"] = stats.iMisses;
+		result["invalidated"] = stats.iInvalidated;
+		result["disk_cache_dir"] = diskCacheDir.has_value() ? boost::python::object(diskCacheDir->string()) : boost::python::object();
+
+		return result;
+	}
 }
\ No newline at end of file
@@ -3,6 +3,7 @@
 #include <RG3/PyBind/PyTypeClass.h>
 #include <RG3/PyBind/PyTypeBase.h>
 #include <RG3/PyBind/PyTypeEnum.h>
+#include <RG3/PyBind/PyAnalyzeStats.h>
 #include <RG3/Cpp/TypeClass.h>
 #include <RG3/Cpp/TypeEnum.h>
 
@@ -111,7 +112,9 @@ namespace rg3::pybind
 	void PyCodeAnalyzerBuilder::analyze()
 	{
 		auto analyzeInfo = m_pAnalyzerInstance->analyze();
+		const auto conversionStartedAt = std::chrono::steady_clock::now();
 
+		m_lastStats = analyzeInfo.stats;
 		m_foundIssues = {};
 		m_foundTypes = {};
 
@@ -159,29 +162,30 @@ namespace rg3::pybind
 				{
 					// ok, need cast
 					auto pAsClass = boost::static_pointer_cast<PyTypeClass>(pType);
+					const auto* pNativeClass = static_cast<const cpp::TypeClass*>(pAsClass->getNative().get()); // NOLINT(*-pro-type-static-cast-downcast)
 
-					const boost::python::list& parents = pAsClass->pyGetClassParentTypeRefs();
-					const size_t amountOfParents = boost::python::len(parents);
+					const auto& vParents = pNativeClass->getParentTypes();
+					if (vParents.empty())
+						continue;
 
-					for (size_t parentId = 0; parentId < amountOfParents; ++parentId)
+					std::vector<boost::shared_ptr<PyTypeClass>> vResolvedParents(vParents.size());
+
+					for (size_t parentId = 0; parentId < vParents.size(); ++parentId)
 					{
-						boost::python::object parentObj = parents[parentId];
-						boost::python::extract<boost::shared_ptr<PyClassParent>> classParentExtraction(parentObj);
-						if (classParentExtraction.check())
+						auto it = m_mFoundTypesMap.find(vParents[parentId].sTypeBaseInfo.sPrettyName);
+						if (it != m_mFoundTypesMap.end() && it->second->pyGetTypeKind() == cpp::TypeKind::TK_STRUCT_OR_CLASS)
 						{
-							boost::shared_ptr<PyClassParent> pClassParent = classParentExtraction();
-
-							auto it = m_mFoundTypesMap.find(pClassParent->getBaseInfo().sPrettyName);
-							if (it != m_mFoundTypesMap.end())
-							{
-								// Resolved!
-								pClassParent->setParentClassDataReference(boost::static_pointer_cast<PyTypeClass>(it->second));
-							}
+							// Resolved!
+							vResolvedParents[parentId] = boost::static_pointer_cast<PyTypeClass>(it->second);
 						}
 					}
+
+					pAsClass->setResolvedParentClasses(std::move(vResolvedParents));
 				}
 			}
 		}
+
+		m_conversionTime = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - conversionStartedAt);
 	}
 
 	const boost::python::list& PyCodeAnalyzerBuilder::getFoundTypes() const
@@ -194,6 +198,16 @@ namespace rg3::pybind
 		return m_foundIssues;
 	}
 
+	boost::python::dict PyCodeAnalyzerBuilder::getStats() const
+	{
+		boost::python::dict result {};
+
+		fillAnalyzeStatsDict(result, m_lastStats);
+		result["conversion_ms"] = std::chrono::duration<double, std::milli>(m_conversionTime).count();
+
+		return result;
+	}
+
 	const rg3::llvm::CompilerConfig& PyCodeAnalyzerBuilder::getCompilerConfig() const
 	{
 		return m_pAnalyzerInstance->getCompilerConfig();
@@ -9,12 +9,16 @@ namespace rg3::pybind
 	PyTypeBase::PyTypeBase(cpp::TypeBasePtr&& base)
 		: m_base(std::move(base))
 	{
-		if (m_base)
+	}
+
+	const boost::python::str& PyTypeBase::__str__() const
+	{
+		if (!m_str.has_value())
 		{
-			// Repr & str
-			{
-				std::string str;
+			std::string str = "null";
 
+			if (m_base)
+			{
 				switch (m_base->getKind())
 				{
 				case cpp::TypeKind::TK_NONE:
@@ -30,22 +34,17 @@ namespace rg3::pybind
 					str = fmt::format("{} [CLASS/STRUCT]", m_base->getPrettyName());
 					break;
 				}
-
-				m_str = { str.c_str(), str.length() };
 			}
 
-			m_repr = m_str;
+			m_str.emplace(str.c_str(), str.length());
 		}
-	}
 
-	const boost::python::str& PyTypeBase::__str__() const
-	{
-		return m_str;
+		return m_str.value();
 	}
 
 	const boost::python::str& PyTypeBase::__repr__() const
 	{
-		return m_repr;
+		return __str__();
 	}
 
 	bool PyTypeBase::__eq__(const PyTypeBase& another) const
@@ -9,27 +9,6 @@ namespace rg3::pybind
 	PyTypeClass::PyTypeClass(std::unique_ptr<cpp::TypeBase>&& base)
 		: PyTypeBase(std::move(base))
 	{
-		// Precache
-		if (auto self = getBase())
-		{
-			// Functions
-			for (const auto& function : self->getFunctions())
-			{
-				m_functions.append(function);
-			}
-
-			// Properties
-			for (const auto& property : self->getProperties())
-			{
-				m_properties.append(property);
-			}
-
-			// Parents
-			for (const auto& parent : self->getParentTypes())
-			{
-				m_parents.append(boost::shared_ptr<PyClassParent>(new PyClassParent(parent)));
-			}
-		}
 	}
 
 	cpp::TypeClass* PyTypeClass::getBase()
@@ -44,17 +23,93 @@ namespace rg3::pybind
 
 	const boost::python::list& PyTypeClass::pyGetClassProperties() const
 	{
-		return m_properties;
+		if (!m_properties.has_value())
+		{
+			boost::python::list properties {};
+
+			if (auto self = getBase())
+			{
+				for (const auto& property : self->getProperties())
+				{
+					properties.append(property);
+				}
+			}
+
+			m_properties.emplace(std::move(properties));
+		}
+
+		return m_properties.value();
 	}
 
 	const boost::python::list& PyTypeClass::pyGetClassFunctions() const
 	{
-		return m_functions;
+		if (!m_functions.has_value())
+		{
+			boost::python::list functions {};
+
+			if (auto self = getBase())
+			{
+				for (const auto& function : self->getFunctions())
+				{
+					functions.append(function);
+				}
+			}
+
+			m_functions.emplace(std::move(functions));
+		}
+
+		return m_functions.value();
 	}
 
 	const boost::python::list& PyTypeClass::pyGetClassParentTypeRefs() const
 	{
-		return m_parents;
+		if (!m_parents.has_value())
+		{
+			boost::python::list parents {};
+
+			if (auto self = getBase())
+			{
+				const auto& vParents = self->getParentTypes();
+
+				for (size_t i = 0; i < vParents.size(); ++i)
+				{
+					auto pParent = boost::shared_ptr<PyClassParent>(new PyClassParent(vParents[i]));
+
+					if (i < m_vResolvedParents.size() && m_vResolvedParents[i])
+					{
+						pParent->setParentClassDataReference(m_vResolvedParents[i]);
+					}
+
+					parents.append(pParent);
+				}
+			}
+
+			m_parents.emplace(std::move(parents));
+		}
+
+		return m_parents.value();
+	}
+
+	void PyTypeClass::setResolvedParentClasses(std::vector<boost::shared_ptr<PyTypeClass>>&& vParentClasses)
+	{
+		m_vResolvedParents = std::move(vParentClasses);
+
+		if (!m_parents.has_value())
+		{
+			// Will be applied on first access
+			return;
+		}
+
+		const size_t amountOfParents = boost::python::len(m_parents.value());
+
+		for (size_t parentId = 0; parentId < amountOfParents && parentId < m_vResolvedParents.size(); ++parentId)
+		{
+			boost::python::extract<boost::shared_ptr<PyClassParent>> classParentExtraction(m_parents.value()[parentId]);
+			if (classParentExtraction.check() && m_vResolvedParents[parentId])
+			{
+				classParentExtraction()->setParentClassDataReference(m_vResolvedParents[parentId]);
+			}
+		}
 	}
 
 	bool PyTypeClass::pyIsStruct() const
@@ -0,0 +1,151 @@
+#include <RG3/PyBind/PyTypeDatabase.h>
+#include <RG3/PyBind/PyTypeClass.h>
+#include <RG3/PyBind/PyTypeBase.h>
+#include <RG3/PyBind/PyTypeEnum.h>
+#include <RG3/LLVM/CodeAnalyzer.h>
+
+
+namespace rg3::pybind
+{
+	PyTypeDatabase::PyTypeDatabase(std::unique_ptr<cpp::TypeDatabase>&& pDatabase) : m_pDatabase(std::move(pDatabase))
+	{
+	}
+
+	boost::python::object PyTypeDatabase::open(const std::string& sPath)
+	{
+		auto pDatabase = cpp::TypeDatabase::open(sPath);
+		if (!pDatabase)
+			return boost::python::object {};
+
+		return boost::python::object { boost::shared_ptr<PyTypeDatabase>(new PyTypeDatabase(std::move(pDatabase))) };
+	}
+
+	bool PyTypeDatabase::write(const std::string& sPath, const boost::python::list& types, const boost::python::list& issues)
+	{
+		cpp::TypeDatabaseWriter writer {};
+
+		for (int i = 0; i < boost::python::len(types); i++)
+		{
+			boost::python::extract<boost::shared_ptr<PyTypeBase>> typeExtraction(types[i]);
+			if (!typeExtraction.check())
+				return false;
+
+			writer.addType(typeExtraction()->getNative().get());
+		}
+
+		for (int i = 0; i < boost::python::len(issues); i++)
+		{
+			boost::python::extract<rg3::llvm::AnalyzerResult::CompilerIssue> issueExtraction(issues[i]);
+			if (!issueExtraction.check())
+				return false;
+
+			const rg3::llvm::AnalyzerResult::CompilerIssue issue = issueExtraction();
+			writer.addIssue(cpp::TypeDatabaseIssue { static_cast<std::uint8_t>(issue.kind), issue.sSourceFile, issue.iLine, issue.iColumn, issue.sMessage });
+		}
+
+		return writer.writeToFile(sPath);
+	}
+
+	std::uint32_t PyTypeDatabase::getTypesCount() const
+	{
+		return m_pDatabase->getTypesCount();
+	}
+
+	boost::python::list PyTypeDatabase::getTypeNames() const
+	{
+		boost::python::list names {};
+
+		for (std::uint32_t i = 0; i < m_pDatabase->getTypesCount(); ++i)
+		{
+			names.append(std::string { m_pDatabase->getTypePrettyName(i) });
+		}
+
+		return names;
+	}
+
+	boost::python::list PyTypeDatabase::getIssues() const
+	{
+		boost::python::list issues {};
+
+		for (std::uint32_t i = 0; i < m_pDatabase->getIssuesCount(); ++i)
+		{
+			if (auto issue = m_pDatabase->getIssue(i); issue.has_value())
+			{
+				rg3::llvm::AnalyzerResult::CompilerIssue compilerIssue {};
+				compilerIssue.kind = static_cast<rg3::llvm::AnalyzerResult::CompilerIssue::IssueKind>(issue->iKind);
+				compilerIssue.sSourceFile = std::move(issue->sSourceFile);
+				compilerIssue.iLine = issue->iLine;
+				compilerIssue.iColumn = issue->iColumn;
+				compilerIssue.sMessage = std::move(issue->sMessage);
+
+				issues.append(compilerIssue);
+			}
+		}
+
+		return issues;
+	}
+
+	boost::python::object PyTypeDatabase::findType(const std::string& sPrettyName)
+	{
+		if (auto iIndex = m_pDatabase->findType(sPrettyName); iIndex.has_value())
+			return getType(iIndex.value());
+
+		return boost::python::object {};
+	}
+
+	boost::python::object PyTypeDatabase::getType(std::uint32_t iIndex)
+	{
+		if (auto it = m_loadedTypes.find(iIndex); it != m_loadedTypes.end())
+			return it->second;
+
+		auto pType = m_pDatabase->loadType(iIndex);
+		if (!pType)
+			return boost::python::object {};
+
+		boost::python::object object {};
+
+		switch (pType->getKind())
+		{
+			case cpp::TypeKind::TK_NONE:
+			case cpp::TypeKind::TK_TRIVIAL:
+				object = boost::python::object { boost::shared_ptr<PyTypeBase>(new PyTypeBase(std::move(pType))) };
+				break;
+			case cpp::TypeKind::TK_ENUM:
+				object = boost::python::object { boost::shared_ptr<PyTypeEnum>(new PyTypeEnum(std::move(pType))) };
+				break;
+			case cpp::TypeKind::TK_STRUCT_OR_CLASS:
+				object = boost::python::object { boost::shared_ptr<PyTypeClass>(new PyTypeClass(std::move(pType))) };
+				break;
+		}
+
+		m_loadedTypes[iIndex] = object;
+		return object;
+	}
+
+	boost::python::list PyTypeDatabase::getParentTypes(std::uint32_t iIndex)
+	{
+		boost::python::list parents {};
+
+		for (const auto iParent : m_pDatabase->getParentTypes(iIndex))
+		{
+			parents.append(getType(iParent));
+		}
+
+		return parents;
+	}
+
+	boost::python::list PyTypeDatabase::loadTypes()
+	{
+		boost::python::list types {};
+
+		for (std::uint32_t i = 0; i < m_pDatabase->getTypesCount(); ++i)
+		{
+			if (auto object = getType(i); !object.is_none())
+			{
+				types.append(object);
+			}
+		}
+
+		return types;
+	}
+}
\ No newline at end of file
@@ -8,24 +8,26 @@ namespace rg3::pybind
 	PyTypeEnum::PyTypeEnum(std::unique_ptr<cpp::TypeBase>&& base)
 		: PyTypeBase(std::move(base))
 	{
-		// Precache
-		if (auto self = getBase())
+	}
+
+	const boost::python::list& PyTypeEnum::pyGetEnumEntries() const
+	{
+		if (!m_entries.has_value())
 		{
-			for (const auto& entry : self->getEntries())
+			boost::python::list entries {};
+
+			if (auto self = getBase())
 			{
-				m_entries.append(entry);
+				for (const auto& entry : self->getEntries())
+				{
+					entries.append(entry);
+				}
 			}
 
-			// Underlying type
-			const auto& ut = self->getUnderlyingType();
-			const auto& utr = ut.getRefName();
-			m_underlyingType = { utr.c_str(), utr.length() };
+			m_entries.emplace(std::move(entries));
 		}
-	}
 
-	const boost::python::list& PyTypeEnum::pyGetEnumEntries() const
-	{
-		return m_entries;
+		return m_entries.value();
 	}
 
 	bool PyTypeEnum::pyIsScoped() const
@@ -38,7 +40,20 @@ namespace rg3::pybind
 
 	const boost::python::str& PyTypeEnum::pyGetUnderlyingTypeStr() const
 	{
-		return m_underlyingType;
+		if (!m_underlyingType.has_value())
+		{
+			if (auto self = getBase())
+			{
+				const auto& utr = self->getUnderlyingType().getRefName();
+				m_underlyingType.emplace(utr.c_str(), utr.length());
+			}
+			else
+			{
+				m_underlyingType.emplace();
+			}
+		}
+
+		return m_underlyingType.value();
 	}
 
 	cpp::TypeEnum* PyTypeEnum::getBase()
@@ -0,0 +1,87 @@
+#include <Benchmark.h>
+
+#include <RG3/LLVM/CodeAnalyzer.h>
+#include <RG3/LLVM/CompilerConfig.h>
+
+#include <fmt/format.h>
+
+#include <unordered_set>
+#include <string>
+
+
+namespace
+{
+	/**
+	 * @brief Header with iDepth levels of nested non-runtime structs. Every level owns fields, methods with local types & runtime types
+	 */
+	std::string makeNestedHeader(int iDepth, int& iRuntimeTypes)
+	{
+		std::string sSource {};
+		iRuntimeTypes = 0;
+
+		for (int i = 0; i < iDepth; ++i)
+		{
+			sSource += fmt::format("struct Level{0}\n{{\n\tint field{0}_a; float field{0}_b;\n\tvoid method{0}() {{ struct Local{0} {{ int x; }}; }}\n", i);
+			sSource += fmt::format("\t/// @runtime\n\tstruct Runtime{0} {{ int value; void get() const; }};\n", i);
+			sSource += fmt::format("\t/// @runtime\n\tenum class EKind{0} {{ K_A, K_B, K_C }};\n", i);
+			iRuntimeTypes += 2;
+		}
+
+		for (int i = 0; i < iDepth; ++i)
+		{
+			sSource += "};\n";
+		}
+
+		return sSource;
+	}
+}
+
+RG3_BENCHMARK(NestedHeaders)
+{
+	constexpr int kDepth = 48;
+	constexpr int kRepeats = 3;
+
+	int iExpectedTypes = 0;
+	const std::string sSource = makeNestedHeader(kDepth, iExpectedTypes);
+
+	rg3::llvm::CodeAnalyzer analyzer {};
+	analyzer.getCompilerConfig().cppStandard = rg3::llvm::CxxStandard::CC_17;
+	analyzer.setSourceCode(sSource);
+
+	rg3::llvm::AnalyzerResult result {};
+
+	const std::int64_t iAnalyzeNs = rg3::benchmark::measureBestOf(kRepeats, [&analyzer, &result]() {
+		result = analyzer.analyze();
+	});
+
+	if (!result.vIssues.empty())
+	{
+		fmt::print("  unexpected issue: {}\n", result.vIssues[0].sMessage);
+		return false;
+	}
+
+	// Every runtime type must be emitted once regardless of depth
+	std::unordered_set<std::string> knownTypes {};
+	for (const auto& pType : result.vFoundTypes)
+	{
+		if (!knownTypes.insert(pType->getPrettyName()).second)
+		{
+			fmt::print("  duplicated type: {}\n", pType->getPrettyName());
+			return false;
+		}
+	}
+
+	if (knownTypes.size() != static_cast<std::size_t>(iExpectedTypes))
+	{
+		fmt::print("  expected {} types, got {}\n", iExpectedTypes, knownTypes.size());
+		return false;
+	}
+
+	fmt::print("  depth: {}, types: {}, best of {} runs\n", kDepth, knownTypes.size(), kRepeats);
+	fmt::print("  analyze       : {:>10.3f} ms\n", static_cast<double>(iAnalyzeNs) / 1'000'000.0);
+	fmt::print("  visit         : {:>10.3f} ms\n", static_cast<double>(result.stats.visitTime.count()) / 1'000'000.0);
+	fmt::print("  decls visited : {:>10}\n", result.stats.iDeclsVisited);
+	fmt::print("  types emitted : {:>10}\n", result.stats.iTypesEmitted);
+
+	return true;
+}
\ No newline at end of file
@@ -0,0 +1,182 @@
+#include <Benchmark.h>
+
+#include <RG3/Cpp/Tag.h>
+
+#include <fmt/format.h>
+
+#include <algorithm>
+#include <sstream>
+#include <random>
+#include <string>
+#include <vector>
+#include <regex>
+
+
+namespace
+{
+	/**
+	 * @brief Former std::regex based implementation of Tag::parseFromCommentString (baseline)
+	 */
+	rg3::cpp::Tags parseWithRegex(std::string_view commentText)
+	{
+		using namespace rg3::cpp;
+
+		std::vector<Tag> tags;
+		std::regex tagRegex("@([a-zA-Z_]{1}[a-zA-Z_.0-9]+)(\\([^)]*\\))?");
+
+		auto commentBegin = std::cregex_iterator(commentText.data(), commentText.data() + commentText.size(), tagRegex);
+		auto commentEnd = std::cregex_iterator();
+		for (std::cregex_iterator regexIterator = commentBegin; regexIterator != commentEnd; ++regexIterator)
+		{
+			auto tagName = std::string((*regexIterator)[1]);
+			auto unprocessedArguments = std::string((*regexIterator)[2]);
+
+			std::vector<TagArgument> tagArguments {};
+
+			if (!unprocessedArguments.empty())
+			{
+				unprocessedArguments.erase(std::remove(unprocessedArguments.begin(), unprocessedArguments.end(), '('), unprocessedArguments.end());
+				unprocessedArguments.erase(std::remove(unprocessedArguments.begin(), unprocessedArguments.end(), ')'), unprocessedArguments.end());
+
+				std::vector<std::string> argumentStrings;
+				std::istringstream argumentsStream(unprocessedArguments);
+				std::string argumentString;
+
+				while (std::getline(argumentsStream, argumentString, ','))
+				{
+					argumentStrings.push_back(argumentString);
+				}
+
+				for (auto& argument : argumentStrings)
+				{
+					while (!argument.empty() && argument[0] == ' ')
+						argument.erase(0, 1);
+
+					argument.erase(std::remove(argument.begin(), argument.end(), '\"'), argument.end());
+
+					if (argument.empty())
+						continue;
+
+					try
+					{
+						size_t pos;
+						int64_t intValue = std::stoll(argument, &pos);
+						if (pos == argument.size())
+						{
+							tagArguments.emplace_back(intValue);
+							continue;
+						}
+					} catch (const std::invalid_argument&) {}
+
+					try
+					{
+						size_t pos;
+						float floatValue = std::stof(argument, &pos);
+						if (pos == argument.size())
+						{
+							tagArguments.emplace_back(floatValue);
+							continue;
+						}
+					} catch (const std::invalid_argument&) {}
+
+					if (argument == "true") { tagArguments.emplace_back(true); continue; }
+					if (argument == "false") { tagArguments.emplace_back(false); continue; }
+
+					if (argument[0] == '@')
+					{
+						tagArguments.emplace_back(TypeReference(argument.substr(1)));
+						continue;
+					}
+
+					tagArguments.emplace_back(argument);
+				}
+			}
+
+			tags.emplace_back(std::move(tagName), std::move(tagArguments));
+		}
+
+		return Tags(tags);
+	}
+
+	/**
+	 * @brief Comments like visitors see: most of them are plain documentation without tags
+	 */
+	std::vector<std::string> makeCommentsCorpus(std::size_t iCount)
+	{
+		static constexpr std::string_view kPlainComments[] = {
+			"/// Returns amount of registered entities",
+			"/**\n * @brief Update state of component\n * @param dt - delta time in seconds\n * @return true when state changed\n **/",
+			"// NOTE: this structure is aligned by 16 bytes because of SIMD usage in physics module",
+			"/**\n * Simple POD which describes vertex of mesh. Positions are stored in object space,\n * normals are normalized and tangents are optional.\n **/",
+			"/// Contact e-mail: someone at example dot com",
+		};
+
+		static constexpr std::string_view kTaggedComments[] = {
+			"/**\n * @runtime\n **/",
+			"/// @property(Speed)",
+			"/**\n * @runtime\n * @serialize(@engine::Mode)\n * @priority(10)\n * @range(0.5, 100.0)\n **/",
+			"/**\n * @brief Player controller\n * @runtime\n * @category(\"Gameplay\", true)\n **/",
+			"/// @function @editor.hidden @tooltip(\"Move player\", -1, false)",
+		};
+
+		std::mt19937 rng { 42 };
+		std::vector<std::string> vComments {};
+		vComments.reserve(iCount);
+
+		for (std::size_t i = 0; i < iCount; ++i)
+		{
+			// ~70% of comments have no tags
+			if (rng() % 10 < 7)
+			{
+				vComments.emplace_back(kPlainComments[rng() % std::size(kPlainComments)]);
+			}
+			else
+			{
+				vComments.emplace_back(kTaggedComments[rng() % std::size(kTaggedComments)]);
+			}
+		}
+
+		return vComments;
+	}
+}
+
+RG3_BENCHMARK(TagParser)
+{
+	constexpr std::size_t kCommentsCount = 20000;
+	constexpr int kRepeats = 5;
+
+	const auto vComments = makeCommentsCorpus(kCommentsCount);
+
+	// Same results on whole corpus
+	for (const auto& sComment : vComments)
+	{
+		if (parseWithRegex(sComment).getTags() != rg3::cpp::Tag::parseFromCommentString(sComment).getTags())
+		{
+			fmt::print("Results differ for comment: {}\n", sComment);
+			return false;
+		}
+	}
+
+	const std::int64_t iRegexNs = rg3::benchmark::measureBestOf(kRepeats, [&vComments]() {
+		for (const auto& sComment : vComments)
+		{
+			auto tags = parseWithRegex(sComment);
+			rg3::benchmark::doNotOptimize(&tags);
+		}
+	});
+
+	const std::int64_t iScannerNs = rg3::benchmark::measureBestOf(kRepeats, [&vComments]() {
+		for (const auto& sComment : vComments)
+		{
+			auto tags = rg3::cpp::Tag::parseFromCommentString(sComment);
+			rg3::benchmark::doNotOptimize(&tags);
+		}
+	});
+
+	fmt::print("  comments: {}, best of {} runs\n", kCommentsCount, kRepeats);
+	fmt::print("  std::regex : {:>10.1f} ns/comment\n", static_cast<double>(iRegexNs) / kCommentsCount);
+	fmt::print("  scanner    : {:>10.1f} ns/comment\n", static_cast<double>(iScannerNs) / kCommentsCount);
+	fmt::print("  speedup    : {:>10.1f}x\n", static_cast<double>(iRegexNs) / static_cast<double>(std::max<std::int64_t>(iScannerNs, 1)));
+
+	return true;
+}
\ No newline at end of file
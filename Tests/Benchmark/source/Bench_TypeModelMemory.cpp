@@ -0,0 +1,127 @@
+#include <Benchmark.h>
+
+#include <RG3/Cpp/DefinitionLocation.h>
+#include <RG3/Cpp/CppNamespace.h>
+
+#include <fmt/format.h>
+
+#include <filesystem>
+#include <cstddef>
+#include <string>
+#include <vector>
+
+#if defined(__GLIBC__)
+#include <malloc.h>
+#endif
+
+
+namespace
+{
+	/**
+	 * @brief Layout of location & namespace before interning: every member owns copy of path and namespace parts
+	 */
+	struct LegacyMember
+	{
+		std::filesystem::path fsLocation {};
+		int iLine { 0 };
+		int iOffset { 0 };
+		std::string sNamespace {};
+		std::vector<std::string> vNamespace {};
+	};
+
+	struct InternedMember
+	{
+		rg3::cpp::DefinitionLocation location {};
+		rg3::cpp::CppNamespace nameSpace {};
+	};
+
+	/**
+	 * @brief Bytes allocated on heap right now (0 when allocator does not report it)
+	 */
+	std::size_t getHeapInUse()
+	{
+#if defined(__GLIBC__)
+		return mallinfo2().uordblks;
+#else
+		return 0;
+#endif
+	}
+}
+
+RG3_BENCHMARK(TypeModelMemory)
+{
+	constexpr int kMembers = 100'000;
+	constexpr int kFiles = 64;
+	constexpr int kNamespaces = 16;
+	constexpr int kRepeats = 3;
+
+	std::vector<std::filesystem::path> vFiles {};
+	std::vector<std::string> vNamespaces {};
+
+	for (int i = 0; i < kFiles; ++i)
+	{
+		vFiles.emplace_back(fmt::format("/home/developer/projects/engine/source/include/Engine/Subsystem{}/Component{}.h", i % 8, i));
+	}
+
+	for (int i = 0; i < kNamespaces; ++i)
+	{
+		vNamespaces.emplace_back(fmt::format("engine::subsystem{}::detail::", i));
+	}
+
+	std::size_t iLegacyBytes = 0;
+	std::size_t iInternedBytes = 0;
+
+	const std::int64_t iLegacyNs = rg3::benchmark::measureBestOf(kRepeats, [&]() {
+		const std::size_t iBefore = getHeapInUse();
+		std::vector<LegacyMember> vMembers {};
+		vMembers.reserve(kMembers);
+
+		for (int i = 0; i < kMembers; ++i)
+		{
+			rg3::cpp::CppNamespace ns { vNamespaces[i % kNamespaces] };
+			LegacyMember& member = vMembers.emplace_back();
+			member.fsLocation = vFiles[i % kFiles];
+			member.iLine = i;
+			member.iOffset = 1;
+			member.sNamespace = ns.asString();
+			member.vNamespace = { ns[0], ns[1], ns[2] };
+		}
+
+		iLegacyBytes = getHeapInUse() - iBefore;
+		rg3::benchmark::doNotOptimize(vMembers.data());
+	});
+
+	std::size_t iInternedPaths = 0;
+	std::size_t iInternedNamespaces = 0;
+
+	const std::int64_t iInternedNs = rg3::benchmark::measureBestOf(kRepeats, [&]() {
+		const std::size_t iBefore = getHeapInUse();
+		std::vector<InternedMember> vMembers {};
+		vMembers.reserve(kMembers);
+
+		for (int i = 0; i < kMembers; ++i)
+		{
+			InternedMember& member = vMembers.emplace_back();
+			member.location = rg3::cpp::DefinitionLocation { vFiles[i % kFiles], i, 1 };
+			member.nameSpace = rg3::cpp::CppNamespace { vNamespaces[i % kNamespaces] };
+		}
+
+		iInternedBytes = getHeapInUse() - iBefore;
+		iInternedPaths = rg3::cpp::DefinitionLocation::getInternedPathsCount();
+		iInternedNamespaces = rg3::cpp::CppNamespace::getInternedNamespacesCount();
+		rg3::benchmark::doNotOptimize(vMembers.data());
+	});
+
+	if (iInternedPaths < kFiles || iInternedNamespaces < kNamespaces)
+	{
+		fmt::print("  expected at least {} paths & {} namespaces, got {} & {}\n", kFiles, kNamespaces, iInternedPaths, iInternedNamespaces);
+		return false;
+	}
+
+	fmt::print("  members: {}, files: {}, namespaces: {}, best of {} runs\n", kMembers, kFiles, kNamespaces, kRepeats);
+	fmt::print("  legacy build   : {:>10.3f} ms, heap {:>10} KiB\n", static_cast<double>(iLegacyNs) / 1'000'000.0, iLegacyBytes / 1024);
+	fmt::print("  interned build : {:>10.3f} ms, heap {:>10} KiB\n", static_cast<double>(iInternedNs) / 1'000'000.0, iInternedBytes / 1024);
+	fmt::print("  interned paths : {:>10}, namespaces: {}\n", iInternedPaths, iInternedNamespaces);
+
+	return true;
+}
\ No newline at end of file
@@ -0,0 +1,63 @@
+#pragma once
+
+#include <functional>
+#include <string_view>
+#include <cstdint>
+#include <chrono>
+#include <vector>
+
+
+#define RG3_BENCHMARK_CONCAT_IMPL(a, b) a##b
+#define RG3_BENCHMARK_CONCAT(a, b) RG3_BENCHMARK_CONCAT_IMPL(a, b)
+#define RG3_BENCHMARK(name) \
+	static bool RG3_BENCHMARK_CONCAT(rg3Benchmark_, name)(); \
+	static ::rg3::benchmark::BenchmarkRegistrator RG3_BENCHMARK_CONCAT(g_rg3BenchmarkRegistrator_, name) { #name, &RG3_BENCHMARK_CONCAT(rg3Benchmark_, name) }; \
+	static bool RG3_BENCHMARK_CONCAT(rg3Benchmark_, name)()
+
+
+namespace rg3::benchmark
+{
+	/**
+	 * @brief Registered benchmark. Function returns false when benchmark detected wrong results
+	 */
+	struct BenchmarkEntry
+	{
+		std::string_view sName {};
+		std::function<bool()> fnRun {};
+	};
+
+	std::vector<BenchmarkEntry>& getRegisteredBenchmarks();
+
+	struct BenchmarkRegistrator
+	{
+		BenchmarkRegistrator(std::string_view sName, std::function<bool()> fnRun)
+		{
+			getRegisteredBenchmarks().emplace_back(BenchmarkEntry { sName, std::move(fnRun) });
+		}
+	};
+
+	/**
+	 * @brief Best (minimal) time of iRepeats runs of function, in nanoseconds
+	 */
+	template <typename TFunction>
+	std::int64_t measureBestOf(int iRepeats, TFunction&& fn)
+	{
+		std::int64_t iBest = INT64_MAX;
+
+		for (int i = 0; i < iRepeats; ++i)
+		{
+			const auto start = std::chrono::steady_clock::now();
+			fn();
+			const auto elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count();
+
+			iBest = elapsed < iBest ? elapsed : iBest;
+		}
+
+		return iBest;
+	}
+
+	/**
+	 * @brief Keep value alive: compiler is not allowed to throw away computation of benchmarked code
+	 */
+	void doNotOptimize(const void* pValue);
+}
\ No newline at end of file
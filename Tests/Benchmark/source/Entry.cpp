@@ -0,0 +1,50 @@
+#include <Benchmark.h>
+
+#include <fmt/format.h>
+
+#include <string_view>
+
+
+namespace rg3::benchmark
+{
+	std::vector<BenchmarkEntry>& getRegisteredBenchmarks()
+	{
+		static std::vector<BenchmarkEntry> g_vBenchmarks {};
+		return g_vBenchmarks;
+	}
+
+	void doNotOptimize(const void* pValue)
+	{
+		static const void* volatile g_pSink { nullptr };
+		g_pSink = pValue;
+	}
+}
+
+/**
+ * Usage: RG3_Benchmark [name filter]
+ */
+int main(int argc, char** argv)
+{
+	const std::string_view sFilter = argc > 1 ? argv[1] : "";
+	int iFailed = 0;
+
+	for (const auto& benchmark : rg3::benchmark::getRegisteredBenchmarks())
+	{
+		if (!sFilter.empty() && benchmark.sName.find(sFilter) == std::string_view::npos)
+			continue;
+
+		fmt::print("[ RUN  ] {}\n", benchmark.sName);
+
+		if (benchmark.fnRun())
+		{
+			fmt::print("[  OK  ] {}\n", benchmark.sName);
+		}
+		else
+		{
+			fmt::print("[ FAIL ] {}\n", benchmark.sName);
+			++iFailed;
+		}
+	}
+
+	return iFailed == 0 ? 0 : 1;
+}
\ No newline at end of file
@@ -3,6 +3,10 @@ from dataclasses import dataclass
 import pytest
 import rg3py
 import os
+import sys
+import shutil
+import tempfile
+import json
 
 
 @dataclass
@@ -453,6 +457,19 @@ def test_check_clang_runtime():
     assert len(found_inc_paths) > 1  # NOTE: In windows it usually 8, on macOS and Linux could be less/more.
 
 
+def test_check_compiler_env_cache():
+    rg3py.ClangRuntime.invalidate_compiler_env_cache()
+    stats_before = rg3py.ClangRuntime.get_compiler_env_cache_stats()
+
+    first_paths: List[str] = rg3py.ClangRuntime.detect_system_include_sources()
+    second_paths: List[str] = rg3py.ClangRuntime.detect_system_include_sources()
+    assert first_paths == second_paths
+
+    # Second detection must be served from memory
+    stats_after = rg3py.ClangRuntime.get_compiler_env_cache_stats()
+    assert stats_after["memory_hits"] == stats_before["memory_hits"] + 1
+
+
 def test_check_type_inside_type():
     analyzer: rg3py.CodeAnalyzer = rg3py.CodeAnalyzer.make()
 
@@ -1054,3 +1071,821 @@ def test_check_parent_types_resolver_but_with_deep_analysis():
     assert c2.parent_types[0].class_type.tags.has_tag("serializer") is False
     assert c2.parent_types[0].class_type.kind == rg3py.CppTypeKind.TK_STRUCT_OR_CLASS
     assert c2.parent_types[0].class_type.is_struct is True
+
+
+def test_analyzer_context_scheduler_stats():
+    analyzer_context: rg3py.AnalyzerContex = rg3py.AnalyzerContext.make()
+
+    analyzer_context.set_headers(["samples/Header1.h", "samples/HeaderWithMultipleInheritance.h"])
+    analyzer_context.set_include_directories([rg3py.CppIncludeInfo("samples", rg3py.CppIncludeKind.IK_PROJECT)])
+
+    analyzer_context.cpp_standard = rg3py.CppStandard.CXX_20
+    analyzer_context.set_compiler_args(["-x", "c++-header"])
+    analyzer_context.set_workers_count(4)
+
+    assert analyzer_context.analyze()
+
+    stats = analyzer_context.scheduler_stats
+    assert stats["queue_depth"] == 0
+    assert stats["queue_depth_peak"] == 2
+    assert len(stats["workers"]) == 4
+    assert sum([w["tasks"] for w in stats["workers"]]) == 2
+
+    # Idle workers must be blocked, not spinning: each worker wakes up only few times (new tasks + close)
+    for worker in stats["workers"]:
+        assert worker["wakeups"] <= 2
+
+
+def test_analyzer_context_shared_file_cache():
+    analyzer_context: rg3py.AnalyzerContex = rg3py.AnalyzerContext.make()
+
+    # Same header twice: second worker must take content from shared cache
+    analyzer_context.set_headers(["samples/Header1.h", "samples/Header1.h"])
+    analyzer_context.set_include_directories([rg3py.CppIncludeInfo("samples", rg3py.CppIncludeKind.IK_PROJECT)])
+
+    analyzer_context.cpp_standard = rg3py.CppStandard.CXX_20
+    analyzer_context.set_compiler_args(["-x", "c++-header"])
+    analyzer_context.set_workers_count(2)
+
+    assert analyzer_context.shared_file_cache is True
+    assert analyzer_context.analyze()
+    assert len(analyzer_context.issues) == 0
+    assert len(analyzer_context.types) == 2  # types are deduplicated
+
+    stats = analyzer_context.file_cache_stats
+    assert stats["read_misses"] >= 1
+    assert stats["read_hits"] >= 1
+    assert stats["cached_bytes"] > 0
+
+    analyzer_context.shared_file_cache = False
+    assert analyzer_context.analyze()
+    assert len(analyzer_context.file_cache_stats) == 0
+
+
+def test_analyzer_context_preamble_headers():
+    with tempfile.TemporaryDirectory() as work_dir:
+        including_header = os.path.join(work_dir, "IncludingHeader.h")
+        plain_header = os.path.join(work_dir, "PlainHeader.h")
+
+        with open(including_header, "w") as f:
+            f.write("#pragma once\n#include <vector>\n#include <string>\n/** @runtime **/ struct Including { std::vector<std::string> vNames; };\n")
+
+        with open(plain_header, "w") as f:
+            f.write("#pragma once\n/** @runtime **/ struct Plain { int iValue; };\n")
+
+        analyzer_context: rg3py.AnalyzerContex = rg3py.AnalyzerContext.make()
+
+        analyzer_context.set_headers([including_header, plain_header])
+        analyzer_context.cpp_standard = rg3py.CppStandard.CXX_20
+        analyzer_context.set_compiler_args(["-x", "c++-header"])
+        analyzer_context.set_workers_count(2)
+        analyzer_context.set_preamble_headers(["<vector>", "<string>"])
+
+        assert analyzer_context.preamble_headers == ["<vector>", "<string>"]
+        assert analyzer_context.analyze()
+        assert len(analyzer_context.issues) == 0
+        assert sorted([t.pretty_name for t in analyzer_context.types]) == ["Including", "Plain"]  # types from preamble are not collected
+
+        # Header which does not include preamble headers is parsed without PCH
+        stats = analyzer_context.preamble_stats
+        assert stats["headers"] == ["<vector>", "<string>"]
+        assert stats["failed"] == 0
+        assert stats["built"] <= 1  # PCH may be built by previous run
+        assert stats["uses"] == 1
+
+
+def test_analyzer_context_preamble_rebuilt_on_change():
+    with tempfile.TemporaryDirectory() as work_dir:
+        preamble = os.path.join(work_dir, "rg3_preamble_test.h")
+        header = os.path.join(work_dir, "Header.h")
+
+        with open(preamble, "w") as f:
+            f.write("#pragma once\n#define RG3_PREAMBLE_VERSION 1\n")
+
+        with open(header, "w") as f:
+            f.write("#include <rg3_preamble_test.h>\n#if RG3_PREAMBLE_VERSION == 22\n/** @runtime **/ struct UpdatedType {};\n#endif\n/** @runtime **/ struct CommonType {};\n")
+
+        def run_analyze():
+            analyzer_context: rg3py.AnalyzerContex = rg3py.AnalyzerContext.make()
+            analyzer_context.set_headers([header])
+            analyzer_context.set_include_directories([rg3py.CppIncludeInfo(work_dir, rg3py.CppIncludeKind.IK_PROJECT)])
+            analyzer_context.cpp_standard = rg3py.CppStandard.CXX_20
+            analyzer_context.set_compiler_args(["-x", "c++-header"])
+            analyzer_context.set_preamble_headers(["<rg3_preamble_test.h>"])
+
+            assert analyzer_context.analyze()
+            assert len(analyzer_context.issues) == 0
+            return analyzer_context
+
+        first_run = run_analyze()
+        assert sorted([t.pretty_name for t in first_run.types]) == ["CommonType"]
+        assert first_run.preamble_stats["built"] == 1
+        assert first_run.preamble_stats["rebuilt"] == 0
+
+        # Preamble header changed: stale PCH must not be used
+        with open(preamble, "w") as f:
+            f.write("#pragma once\n#define RG3_PREAMBLE_VERSION 22\n")
+
+        second_run = run_analyze()
+        assert sorted([t.pretty_name for t in second_run.types]) == ["CommonType", "UpdatedType"]
+        assert second_run.preamble_stats["built"] == 1
+        assert second_run.preamble_stats["rebuilt"] == 1
+
+
+def test_analyzer_context_umbrella_mode():
+    headers = ["samples/Header1.h", "samples/HeaderWithMultipleInheritance.h", "samples/HeaderWithUsingDecls.h"]
+
+    def run_analyze(umbrella_mode: bool, batch_size: int):
+        analyzer_context: rg3py.AnalyzerContex = rg3py.AnalyzerContext.make()
+        analyzer_context.set_headers(headers)
+        analyzer_context.set_include_directories([rg3py.CppIncludeInfo("samples", rg3py.CppIncludeKind.IK_PROJECT)])
+        analyzer_context.cpp_standard = rg3py.CppStandard.CXX_20
+        analyzer_context.set_compiler_args(["-x", "c++-header"])
+        analyzer_context.set_workers_count(2)
+        analyzer_context.umbrella_mode = umbrella_mode
+        analyzer_context.umbrella_batch_size = batch_size
+
+        assert analyzer_context.umbrella_mode == umbrella_mode
+        assert analyzer_context.umbrella_batch_size == batch_size
+        assert analyzer_context.analyze()
+        assert len(analyzer_context.issues) == 0
+
+        return sorted([(t.pretty_name, t.location.path, t.location.line) for t in analyzer_context.types])
+
+    per_header = run_analyze(False, 0)
+    assert len(per_header) > 0
+
+    # Same types & locations in any batching mode
+    assert run_analyze(True, 0) == per_header
+    assert run_analyze(True, 2) == per_header
+    assert run_analyze(True, 16) == per_header
+
+
+def test_analyzer_context_umbrella_mode_with_error():
+    analyzer_context: rg3py.AnalyzerContex = rg3py.AnalyzerContext.make()
+    analyzer_context.set_headers(["samples/Header1.h", "samples/HeaderWithError.h"])
+    analyzer_context.set_include_directories([rg3py.CppIncludeInfo("samples", rg3py.CppIncludeKind.IK_PROJECT)])
+    analyzer_context.cpp_standard = rg3py.CppStandard.CXX_20
+    analyzer_context.set_compiler_args(["-x", "c++-header"])
+    analyzer_context.set_workers_count(2)
+    analyzer_context.umbrella_mode = True
+    analyzer_context.umbrella_batch_size = 2
+
+    # Broken header must not hide types of its neighbour: batch falls back to one TU per header
+    assert analyzer_context.analyze()
+    assert len(analyzer_context.issues) == 1
+    assert analyzer_context.issues[0].message == 'He he error here))'
+    assert any(t.pretty_name == "samples::my_cool_sample::Type1" for t in analyzer_context.types)
+
+
+def test_analyzer_context_incremental_cache():
+    with tempfile.TemporaryDirectory() as work_dir:
+        header1 = os.path.join(work_dir, "Header1.h")
+        header2 = os.path.join(work_dir, "HeaderWithUsingDecls.h")
+        shutil.copy("samples/Header1.h", header1)
+        shutil.copy("samples/HeaderWithUsingDecls.h", header2)
+
+        def run_analyze():
+            analyzer_context: rg3py.AnalyzerContex = rg3py.AnalyzerContext.make()
+            analyzer_context.set_headers([header1, header2])
+            analyzer_context.set_include_directories([rg3py.CppIncludeInfo(work_dir, rg3py.CppIncludeKind.IK_PROJECT)])
+            analyzer_context.cpp_standard = rg3py.CppStandard.CXX_20
+            analyzer_context.set_compiler_args(["-x", "c++-header"])
+            analyzer_context.set_workers_count(2)
+            analyzer_context.incremental_cache_dir = os.path.join(work_dir, "cache")
+
+            assert analyzer_context.analyze()
+            assert len(analyzer_context.issues) == 0
+            return analyzer_context
+
+        first_run = run_analyze()
+        assert sorted(first_run.recomputed_headers) == sorted([header1, header2])
+        assert len(first_run.reused_headers) == 0
+        first_types = sorted([t.pretty_name for t in first_run.types])
+
+        # Nothing changed: everything reused
+        second_run = run_analyze()
+        assert sorted(second_run.reused_headers) == sorted([header1, header2])
+        assert len(second_run.recomputed_headers) == 0
+        assert sorted([t.pretty_name for t in second_run.types]) == first_types
+
+        # Only changed header re-analyzed
+        with open(header1, "a") as f:
+            f.write("\nnamespace samples::my_cool_sample { /** @runtime **/ struct NewType {}; }\n")
+
+        third_run = run_analyze()
+        assert third_run.recomputed_headers == [header1]
+        assert third_run.reused_headers == [header2]
+        assert "samples::my_cool_sample::NewType" in [t.pretty_name for t in third_run.types]
+
+
+def test_analyzer_context_incremental_cache_umbrella_mode():
+    with tempfile.TemporaryDirectory() as work_dir:
+        shared = os.path.join(work_dir, "Shared.h")
+        header1 = os.path.join(work_dir, "Header1.h")
+        header2 = os.path.join(work_dir, "Header2.h")
+
+        with open(shared, "w") as f:
+            f.write("#pragma once\n/** @runtime **/ struct SharedType {};\n")
+
+        with open(header1, "w") as f:
+            f.write("#pragma once\n#include \"Shared.h\"\n/** @runtime **/ struct Type1 {};\n")
+
+        with open(header2, "w") as f:
+            f.write("#pragma once\n#include \"Shared.h\"\n/** @runtime **/ struct Type2 {};\n")
+
+        def run_analyze(umbrella_mode: bool):
+            analyzer_context: rg3py.AnalyzerContex = rg3py.AnalyzerContext.make()
+            analyzer_context.set_headers([header1, header2])
+            analyzer_context.set_include_directories([rg3py.CppIncludeInfo(work_dir, rg3py.CppIncludeKind.IK_PROJECT)])
+            analyzer_context.cpp_standard = rg3py.CppStandard.CXX_20
+            analyzer_context.set_compiler_args(["-x", "c++-header"])
+            analyzer_context.set_workers_count(1)
+            analyzer_context.umbrella_mode = umbrella_mode
+            analyzer_context.umbrella_batch_size = 2
+            analyzer_context.incremental_cache_dir = os.path.join(work_dir, "cache")
+
+            assert analyzer_context.analyze()
+            assert len(analyzer_context.issues) == 0
+            return analyzer_context
+
+        expected_types = ["SharedType", "Type1", "Type2"]
+
+        # Results of umbrella batch are split by definition location: they are not results of standalone headers
+        umbrella_run = run_analyze(True)
+        assert sorted([t.pretty_name for t in umbrella_run.types]) == expected_types
+        assert len(umbrella_run.reused_headers) == 0
+
+        standalone_run = run_analyze(False)
+        assert len(standalone_run.reused_headers) == 0
+        assert sorted([t.pretty_name for t in standalone_run.types]) == expected_types
+
+        # Standalone results are exact: umbrella run reuses them
+        second_umbrella_run = run_analyze(True)
+        assert sorted(second_umbrella_run.reused_headers) == sorted([header1, header2])
+        assert sorted([t.pretty_name for t in second_umbrella_run.types]) == expected_types
+
+
+def test_type_database_write_and_open():
+    analyzer: rg3py.CodeAnalyzer = rg3py.CodeAnalyzer.make()
+
+    analyzer.set_code("""
+    namespace engine {
+        /// @runtime
+        enum class Mode : int { M_NONE = 0, M_FAST = 1 };
+
+        /// @runtime
+        struct Base {};
+
+        /**
+         * @runtime
+         * @priority(10)
+         **/
+        struct Component : Base
+        {
+            /// @property(Speed)
+            float fSpeed { 0.f };
+
+            /// @property
+            Mode eMode { Mode::M_NONE };
+        };
+    }
+    """)
+    analyzer.set_cpp_standard(rg3py.CppStandard.CXX_20)
+    analyzer.analyze()
+
+    assert len(analyzer.issues) == 0
+    assert len(analyzer.types) == 3
+
+    with tempfile.TemporaryDirectory() as work_dir:
+        db_path = os.path.join(work_dir, "types.rg3db")
+        assert rg3py.TypeDatabase.write(db_path, analyzer.types, analyzer.issues)
+
+        db: Optional[rg3py.TypeDatabase] = rg3py.TypeDatabase.open(db_path)
+        assert db is not None
+        assert db.types_count == 3
+        assert sorted(db.type_names) == sorted([t.pretty_name for t in analyzer.types])
+        assert len(db.issues) == 0
+
+        assert db.find_type("engine::Unknown") is None
+
+        component: rg3py.CppClass = db.find_type("engine::Component")
+        assert component is not None
+        assert component.kind == rg3py.CppTypeKind.TK_STRUCT_OR_CLASS
+        assert component.tags.get_tag("priority").arguments[0].as_i64(0) == 10
+        assert [p.name for p in component.properties] == ["fSpeed", "eMode"]
+        assert component.properties[0].alias == "Speed"
+
+        component_index = db.type_names.index("engine::Component")
+        assert [t.pretty_name for t in db.get_parent_types(component_index)] == ["engine::Base"]
+
+        mode: rg3py.CppEnum = db.find_type("engine::Mode")
+        assert mode.kind == rg3py.CppTypeKind.TK_ENUM
+        assert [e.name for e in mode.entries] == ["M_NONE", "M_FAST"]
+
+        assert sorted([t.pretty_name for t in db.load_types()]) == sorted([t.pretty_name for t in analyzer.types])
+
+        broken_path = os.path.join(work_dir, "broken.rg3db")
+        with open(broken_path, "wb") as f:
+            f.write(b"RG3D")
+
+        assert rg3py.TypeDatabase.open(broken_path) is None
+
+def test_analyzer_context_stats():
+    analyzer_context: rg3py.AnalyzerContex = rg3py.AnalyzerContext.make()
+
+    analyzer_context.set_headers(["samples/Header1.h", "samples/HeaderWithMultipleInheritance.h"])
+    analyzer_context.set_include_directories([rg3py.CppIncludeInfo("samples", rg3py.CppIncludeKind.IK_PROJECT)])
+
+    analyzer_context.cpp_standard = rg3py.CppStandard.CXX_20
+    analyzer_context.set_compiler_args(["-x", "c++-header"])
+    analyzer_context.set_workers_count(2)
+
+    assert analyzer_context.analyze()
+
+    stats = analyzer_context.stats
+    assert stats["translation_units"] == 2
+    assert stats["types_emitted"] >= len(analyzer_context.types)
+    assert stats["decls_visited"] >= stats["types_emitted"]
+    assert stats["total_ms"] > 0
+    assert stats["conversion_ms"] >= 0
+    assert stats["cached_headers"] == 0
+    assert stats["peak_rss_bytes"] > 0
+
+    units = stats["translation_units_stats"]
+    assert len(units) == 2
+    assert sorted([u["headers"][0] for u in units]) == sorted(analyzer_context.headers)
+    assert units[0]["total_ms"] >= units[1]["total_ms"]  # most expensive first
+
+    for unit in units:
+        assert unit["from_cache"] is False
+        assert unit["translation_units"] == 1
+        assert unit["parse_ms"] + unit["visit_ms"] <= unit["total_ms"]
+
+
+def test_code_analyzer_stats():
+    analyzer: rg3py.CodeAnalyzer = rg3py.CodeAnalyzer.make()
+    analyzer.set_code("""
+    /// @runtime
+    struct Simple { int a; };
+    """)
+    analyzer.set_cpp_standard(rg3py.CppStandard.CXX_20)
+    analyzer.analyze()
+
+    assert len(analyzer.types) == 1
+
+    stats = analyzer.stats
+    assert stats["translation_units"] == 1
+    assert stats["types_emitted"] == 1
+    assert stats["total_ms"] > 0
+    assert "conversion_ms" in stats
+
+def test_lazy_type_members():
+    analyzer: rg3py.CodeAnalyzer = rg3py.CodeAnalyzer.make()
+    analyzer.set_code("""
+    /// @runtime
+    struct Base { int iBase; };
+
+    /// @runtime
+    struct Child : Base { float fValue; void update(); };
+
+    /// @runtime
+    enum class Mode : unsigned char { M_A, M_B };
+    """)
+    analyzer.set_cpp_standard(rg3py.CppStandard.CXX_20)
+    analyzer.deep_analysis = True
+    analyzer.analyze()
+
+    assert len(analyzer.issues) == 0
+    assert len(analyzer.types) == 3
+
+    base: rg3py.CppClass = analyzer.types[0]
+    child: rg3py.CppClass = analyzer.types[1]
+    mode: rg3py.CppEnum = analyzer.types[2]
+
+    # Members are made on first access and same object returned after that
+    assert str(child) == "Child [CLASS/STRUCT]"
+    assert repr(child) == str(child)
+    assert child.properties is child.properties
+    assert [p.name for p in child.properties] == ["fValue"]
+    assert [f.name for f in child.functions] == ["update"]
+
+    # Parents resolved by deep analysis before parent_types list was made
+    assert len(child.parent_types) == 1
+    assert child.parent_types[0].class_type is not None
+    assert child.parent_types[0].class_type.pretty_name == base.pretty_name
+    assert len(base.parent_types) == 0
+
+    assert str(mode) == "Mode [ENUM]"
+    assert mode.underlying_type == "unsigned char"
+    assert [e.name for e in mode.entries] == ["M_A", "M_B"]
+
+def test_analyzer_context_results_follow_headers_order():
+    headers = ["samples/HeaderWithMultipleInheritance.h", "samples/Header1.h", "samples/HeaderWithUsingDecls.h"]
+
+    # Expected: results of each header alone, in order of headers, duplicates dropped
+    expected_types = []
+    for header in headers:
+        analyzer: rg3py.CodeAnalyzer = rg3py.CodeAnalyzer.make()
+        analyzer.set_file(header)
+        analyzer.add_project_include_dir("samples")
+        analyzer.set_cpp_standard(rg3py.CppStandard.CXX_20)
+        analyzer.set_compiler_args(["-x", "c++-header"])
+        analyzer.analyze()
+
+        for t in analyzer.types:
+            if t.pretty_name not in expected_types:
+                expected_types.append(t.pretty_name)
+
+    # Workers keep results natively and merge them once: order must not depend on scheduling
+    for workers_count in [2, 8]:
+        analyzer_context: rg3py.AnalyzerContex = rg3py.AnalyzerContext.make()
+
+        analyzer_context.set_headers(headers)
+        analyzer_context.set_include_directories([rg3py.CppIncludeInfo("samples", rg3py.CppIncludeKind.IK_PROJECT)])
+
+        analyzer_context.cpp_standard = rg3py.CppStandard.CXX_20
+        analyzer_context.set_compiler_args(["-x", "c++-header"])
+        analyzer_context.set_workers_count(workers_count)
+
+        assert analyzer_context.analyze()
+        assert [t.pretty_name for t in analyzer_context.types] == expected_types
+
+def test_analyzer_context_analyze_async():
+    analyzer_context: rg3py.AnalyzerContex = rg3py.AnalyzerContext.make()
+
+    analyzer_context.set_headers(["samples/Header1.h", "samples/HeaderWithMultipleInheritance.h"])
+    analyzer_context.set_include_directories([rg3py.CppIncludeInfo("samples", rg3py.CppIncludeKind.IK_PROJECT)])
+
+    analyzer_context.cpp_standard = rg3py.CppStandard.CXX_20
+    analyzer_context.set_compiler_args(["-x", "c++-header"])
+    analyzer_context.set_workers_count(2)
+
+    reports = []
+    assert analyzer_context.analyze_async(lambda progress: reports.append(progress))
+    assert analyzer_context.analyze_async() is False  # already in progress
+    assert analyzer_context.analyze() is False
+
+    assert analyzer_context.wait()
+    assert analyzer_context.finished
+    assert analyzer_context.succeeded
+    assert len(analyzer_context.issues) == 0
+    assert len(analyzer_context.types) > 0
+
+    # Last report is made when everything is done
+    assert len(reports) >= 1
+    assert reports[-1]["completed_headers"] == 2
+    assert reports[-1]["total_headers"] == 2
+    assert reports[-1]["types_found"] >= len(analyzer_context.types)
+    assert reports[-1]["cancelled"] is False
+    assert [r["completed_headers"] for r in reports] == sorted([r["completed_headers"] for r in reports])
+
+    # Results are same as results of blocking analyze
+    async_types = [t.pretty_name for t in analyzer_context.types]
+    assert analyzer_context.analyze()
+    assert [t.pretty_name for t in analyzer_context.types] == async_types
+
+
+def test_analyzer_context_cancel():
+    analyzer_context: rg3py.AnalyzerContex = rg3py.AnalyzerContext.make()
+
+    analyzer_context.set_headers(["samples/Header1.h"] * 64)
+    analyzer_context.set_include_directories([rg3py.CppIncludeInfo("samples", rg3py.CppIncludeKind.IK_PROJECT)])
+
+    analyzer_context.cpp_standard = rg3py.CppStandard.CXX_20
+    analyzer_context.set_compiler_args(["-x", "c++-header"])
+    analyzer_context.set_workers_count(2)
+
+    assert analyzer_context.analyze_async()
+    analyzer_context.cancel()
+    assert analyzer_context.wait(60.0)
+
+    assert analyzer_context.succeeded is False
+    assert analyzer_context.progress["cancelled"] is True
+    assert analyzer_context.progress["completed_headers"] < 64
+    assert any(issue.message == "RG3|Analyze cancelled" for issue in analyzer_context.issues)
+
+def test_analyzer_context_stream():
+    headers = ["samples/Header1.h", "samples/HeaderWithMultipleInheritance.h", "samples/HeaderWithUsingDecls.h"]
+
+    analyzer_context: rg3py.AnalyzerContex = rg3py.AnalyzerContext.make()
+
+    analyzer_context.set_headers(headers)
+    analyzer_context.set_include_directories([rg3py.CppIncludeInfo("samples", rg3py.CppIncludeKind.IK_PROJECT)])
+
+    analyzer_context.cpp_standard = rg3py.CppStandard.CXX_20
+    analyzer_context.set_compiler_args(["-x", "c++-header"])
+    analyzer_context.set_workers_count(2)
+
+    streamed_headers = []
+    streamed_types = []
+
+    # Only 1 result could wait for consumer: workers are blocked until it's taken
+    for item in analyzer_context.stream(max_pending=1):
+        streamed_headers.append(item["header"])
+        streamed_types.extend([t.pretty_name for t in item["types"]])
+        assert len(item["issues"]) == 0
+
+    assert sorted(streamed_headers) == sorted(headers)
+    assert analyzer_context.finished
+    assert analyzer_context.succeeded
+
+    # Each type reported once, context contains everything after stream is drained
+    assert len(streamed_types) == len(set(streamed_types))
+    assert sorted(streamed_types) == sorted([t.pretty_name for t in analyzer_context.types])
+
+    # Dropped stream cancels analyze
+    stream = analyzer_context.stream()
+    assert stream is not None
+    del stream
+    assert analyzer_context.wait(60.0)
+    assert analyzer_context.finished
+
+def test_analyzer_context_cost_aware_scheduling():
+    headers = ["samples/Header1.h", "samples/HeaderWithUsingDecls.h", "samples/HeaderWithMultipleInheritance.h"]
+
+    with tempfile.TemporaryDirectory() as work_dir:
+        history_file = os.path.join(work_dir, "history", "costs.txt")
+
+        def run_analyze(cost_aware: bool):
+            analyzer_context: rg3py.AnalyzerContex = rg3py.AnalyzerContext.make()
+            analyzer_context.set_headers(headers)
+            analyzer_context.set_include_directories([rg3py.CppIncludeInfo("samples", rg3py.CppIncludeKind.IK_PROJECT)])
+            analyzer_context.cpp_standard = rg3py.CppStandard.CXX_20
+            analyzer_context.set_compiler_args(["-x", "c++-header"])
+            analyzer_context.set_workers_count(2)
+            analyzer_context.cost_history_file = history_file
+            analyzer_context.cost_aware_scheduling = cost_aware
+
+            assert analyzer_context.analyze()
+            return analyzer_context
+
+        # No history yet: costs are estimated, most expensive first
+        first_run = run_analyze(True)
+        stats = first_run.scheduler_stats
+        assert stats["cost_aware"]
+        assert stats["history_hits"] == 0
+        assert sorted([task["headers"][0] for task in stats["schedule"]]) == sorted(headers)
+        costs = [task["estimated_ms"] for task in stats["schedule"]]
+        assert costs == sorted(costs, reverse=True)
+        assert os.path.exists(history_file)
+
+        # Measured time of previous run is used
+        second_run = run_analyze(True)
+        stats = second_run.scheduler_stats
+        assert stats["history_hits"] == len(headers)
+        costs = [task["estimated_ms"] for task in stats["schedule"]]
+        assert costs == sorted(costs, reverse=True)
+
+        # Order of results doesn't depend on scheduling
+        assert [t.pretty_name for t in second_run.types] == [t.pretty_name for t in first_run.types]
+
+        # Disabled: tasks follow order of headers
+        third_run = run_analyze(False)
+        assert [task["headers"][0] for task in third_run.scheduler_stats["schedule"]] == headers
+
+def test_analyzer_context_compile_commands():
+    with tempfile.TemporaryDirectory() as work_dir:
+        # Two 'targets' with own include directory & definitions: same header code gives different types
+        for target, define in [("first", "USE_FIRST"), ("second", "USE_SECOND")]:
+            os.makedirs(os.path.join(work_dir, target, "include"))
+
+            with open(os.path.join(work_dir, target, "include", "Config.h"), "w") as f:
+                f.write(f"#pragma once\n#define TARGET_NAME {target}\n")
+
+            with open(os.path.join(work_dir, target, f"{target}.h"), "w") as f:
+                f.write("#pragma once\n#include <Config.h>\n"
+                        f"#ifdef {define}\n"
+                        "namespace TARGET_NAME { /** @runtime **/ struct Enabled {}; }\n"
+                        "#endif\n")
+
+            with open(os.path.join(work_dir, target, f"{target}.cpp"), "w") as f:
+                f.write(f'#include "{target}.h"\n')
+
+        compile_commands = [
+            {
+                "directory": os.path.join(work_dir, target),
+                "command": f"/usr/bin/c++ -Iinclude -D{define} -std=c++20 -O2 -o {target}.o -c {target}.cpp",
+                "file": f"{target}.cpp"
+            }
+            for target, define in [("first", "USE_FIRST"), ("second", "USE_SECOND")]
+        ]
+
+        database_file = os.path.join(work_dir, "compile_commands.json")
+        with open(database_file, "w") as f:
+            json.dump(compile_commands, f)
+
+        for umbrella_mode in [False, True]:
+            analyzer_context: rg3py.AnalyzerContex = rg3py.AnalyzerContext.make()
+            analyzer_context.set_headers([os.path.join(work_dir, "first", "first.h"), os.path.join(work_dir, "second", "second.h")])
+            analyzer_context.set_workers_count(2)
+            analyzer_context.umbrella_mode = umbrella_mode
+            analyzer_context.compile_commands = database_file
+
+            assert analyzer_context.analyze()
+            assert len(analyzer_context.issues) == 0
+            assert [t.pretty_name for t in analyzer_context.types] == ["first::Enabled", "second::Enabled"]
+            assert analyzer_context.scheduler_stats["configs"] == 2
+
+        # Broken database is reported as issue
+        analyzer_context: rg3py.AnalyzerContex = rg3py.AnalyzerContext.make()
+        analyzer_context.set_headers([os.path.join(work_dir, "first", "first.h")])
+        analyzer_context.compile_commands = os.path.join(work_dir, "not_exists.json")
+
+        assert not analyzer_context.analyze()
+        assert len(analyzer_context.issues) == 1
+        assert analyzer_context.issues[0].message.startswith("RG3|Load compilation database failed")
+
+def test_analyzer_context_daemon_unavailable():
+    with tempfile.TemporaryDirectory() as work_dir:
+        header_path = os.path.join(work_dir, "header.h")
+        with open(header_path, "w") as f:
+            f.write("/** @runtime **/ struct Simple {};\n")
+
+        analyzer_context: rg3py.AnalyzerContex = rg3py.AnalyzerContext.make()
+        analyzer_context.set_headers([header_path])
+        analyzer_context.daemon_socket = os.path.join(work_dir, "not_exists.sock")
+        assert analyzer_context.daemon_socket == os.path.join(work_dir, "not_exists.sock")
+
+        assert not analyzer_context.analyze()
+        assert len(analyzer_context.issues) == 1
+        assert analyzer_context.issues[0].message.startswith("RG3|Connect to daemon failed")
+        assert "daemon" not in analyzer_context.stats
+
+        with pytest.raises(RuntimeError):
+            rg3py.DaemonClient.connect(os.path.join(work_dir, "not_exists.sock"))
+
+def test_analyzer_context_watch_mode():
+    if not sys.platform.startswith("linux"):
+        pytest.skip("Watch mode is supported only on Linux")
+
+    with tempfile.TemporaryDirectory() as work_dir:
+        with open(os.path.join(work_dir, "Common.h"), "w") as f:
+            f.write("#pragma once\nnamespace watch { /** @runtime **/ struct Common { int iValue; }; }\n")
+
+        with open(os.path.join(work_dir, "First.h"), "w") as f:
+            f.write('#pragma once\n#include "Common.h"\nnamespace watch { /** @runtime **/ struct First { Common common; }; }\n')
+
+        with open(os.path.join(work_dir, "Second.h"), "w") as f:
+            f.write("#pragma once\nnamespace watch { /** @runtime **/ struct Second {}; }\n")
+
+        analyzer_context: rg3py.AnalyzerContex = rg3py.AnalyzerContext.make()
+        analyzer_context.set_headers([os.path.join(work_dir, "First.h"), os.path.join(work_dir, "Second.h")])
+        analyzer_context.set_include_directories([work_dir])
+        analyzer_context.set_workers_count(2)
+
+        with pytest.raises(RuntimeError):
+            analyzer_context.wait_changes(0.0)
+
+        analyzer_context.watch_mode = True
+        assert analyzer_context.analyze()
+        assert [t.pretty_name for t in analyzer_context.types] == ["watch::Common", "watch::First", "watch::Second"]
+
+        # Nothing changed yet
+        assert analyzer_context.wait_changes(0.1) is None
+
+        # Only header which includes changed file is analyzed again
+        with open(os.path.join(work_dir, "Common.h"), "w") as f:
+            f.write("#pragma once\nnamespace watch { /** @runtime **/ struct Common { float fValue; }; /** @runtime **/ struct Extra {}; }\n")
+
+        delta = analyzer_context.wait_changes(5.0)
+        assert delta is not None
+        assert os.path.join(work_dir, "Common.h") in delta["changed_files"]
+        assert delta["reanalyzed_headers"] == [os.path.join(work_dir, "First.h")]
+        assert [t.pretty_name for t in delta["added"]] == ["watch::Extra"]
+        assert [t.pretty_name for t in delta["changed"]] == ["watch::Common"]
+        assert delta["removed"] == []
+        assert [t.pretty_name for t in analyzer_context.types] == ["watch::Common", "watch::Extra", "watch::First", "watch::Second"]
+
+        # Removed type is reported by name
+        with open(os.path.join(work_dir, "Second.h"), "w") as f:
+            f.write("#pragma once\nnamespace watch {}\n")
+
+        delta = analyzer_context.wait_changes(5.0)
+        assert delta is not None
+        assert delta["reanalyzed_headers"] == [os.path.join(work_dir, "Second.h")]
+        assert delta["removed"] == ["watch::Second"]
+        assert [t.pretty_name for t in analyzer_context.types] == ["watch::Common", "watch::Extra", "watch::First"]
+
+def test_analyzer_context_watch_mode_shadowing_header():
+    if not sys.platform.startswith("linux"):
+        pytest.skip("Watch mode is supported only on Linux")
+
+    with tempfile.TemporaryDirectory() as work_dir:
+        os.makedirs(os.path.join(work_dir, "first"))
+        os.makedirs(os.path.join(work_dir, "second"))
+
+        with open(os.path.join(work_dir, "second", "Dep.h"), "w") as f:
+            f.write("#pragma once\nnamespace shadow { /** @runtime **/ struct Original {}; }\n")
+
+        with open(os.path.join(work_dir, "Main.h"), "w") as f:
+            f.write("#pragma once\n#include <Dep.h>\nnamespace shadow { /** @runtime **/ struct Main {}; }\n")
+
+        with open(os.path.join(work_dir, "Other.h"), "w") as f:
+            f.write("#pragma once\nnamespace shadow { /** @runtime **/ struct Other {}; }\n")
+
+        analyzer_context: rg3py.AnalyzerContex = rg3py.AnalyzerContext.make()
+        analyzer_context.set_headers([os.path.join(work_dir, "Main.h"), os.path.join(work_dir, "Other.h")])
+        analyzer_context.set_include_directories([os.path.join(work_dir, "first"), os.path.join(work_dir, "second")])
+        analyzer_context.set_workers_count(2)
+        analyzer_context.watch_mode = True
+
+        assert analyzer_context.analyze()
+        assert [t.pretty_name for t in analyzer_context.types] == ["shadow::Original", "shadow::Main", "shadow::Other"]
+
+        # New header in earlier include directory is found instead of included one
+        with open(os.path.join(work_dir, "first", "Dep.h"), "w") as f:
+            f.write("#pragma once\nnamespace shadow { /** @runtime **/ struct Shadowing {}; }\n")
+
+        delta = analyzer_context.wait_changes(5.0)
+        assert delta is not None
+        assert delta["reanalyzed_headers"] == [os.path.join(work_dir, "Main.h")]
+        assert [t.pretty_name for t in delta["added"]] == ["shadow::Shadowing"]
+        assert delta["removed"] == ["shadow::Original"]
+        assert [t.pretty_name for t in analyzer_context.types] == ["shadow::Shadowing", "shadow::Main", "shadow::Other"]
+
+def test_analyzer_context_source_filter():
+    with tempfile.TemporaryDirectory() as work_dir:
+        os.makedirs(os.path.join(work_dir, "project"))
+        os.makedirs(os.path.join(work_dir, "third_party"))
+
+        with open(os.path.join(work_dir, "third_party", "Library.h"), "w") as f:
+            f.write("#pragma once\nnamespace lib { /** @runtime **/ struct LibraryType {}; }\n")
+
+        with open(os.path.join(work_dir, "project", "Main.h"), "w") as f:
+            f.write("#pragma once\n#include <Library.h>\n/** @runtime **/ struct MainType { lib::LibraryType l; };\n")
+
+        analyzer_context: rg3py.AnalyzerContex = rg3py.AnalyzerContext.make()
+        analyzer_context.set_headers([os.path.join(work_dir, "project", "Main.h")])
+        analyzer_context.set_include_directories([
+            rg3py.CppIncludeInfo(os.path.join(work_dir, "project"), rg3py.CppIncludeKind.IK_PROJECT),
+            rg3py.CppIncludeInfo(os.path.join(work_dir, "third_party"), rg3py.CppIncludeKind.IK_THIRD_PARTY)
+        ])
+        analyzer_context.set_compiler_args(["-x", "c++-header"])
+
+        assert analyzer_context.source_filter == rg3py.SourceFilter.SF_ALL
+        assert analyzer_context.analyze()
+        assert sorted([t.pretty_name for t in analyzer_context.types]) == ["MainType", "lib::LibraryType"]
+
+        analyzer_context.source_filter = rg3py.SourceFilter.SF_PROJECT_INCLUDES
+        assert analyzer_context.analyze()
+        assert [t.pretty_name for t in analyzer_context.types] == ["MainType"]
+        assert analyzer_context.stats["decls_pruned"] > 0
+
+        analyzer_context.source_filter = rg3py.SourceFilter.SF_ALL
+        analyzer_context.source_deny_globs = ["*/third_party/*"]
+        assert analyzer_context.source_deny_globs == ["*/third_party/*"]
+        assert analyzer_context.analyze()
+        assert [t.pretty_name for t in analyzer_context.types] == ["MainType"]
+
+def test_analyzer_context_native_reference_resolution():
+    with tempfile.TemporaryDirectory() as work_dir:
+        with open(os.path.join(work_dir, "Refs.h"), "w") as f:
+            f.write("#pragma once\nnamespace math { /** @runtime **/ struct Vec { float x; }; }\n"
+                    "/** @runtime **/ struct User { math::Vec v; math::Vec get() const; void set(const math::Vec& a); };\n")
+
+        analyzer_context: rg3py.AnalyzerContex = rg3py.AnalyzerContext.make()
+        analyzer_context.set_headers([os.path.join(work_dir, "Refs.h")])
+        analyzer_context.set_compiler_args(["-x", "c++-header"])
+        analyzer_context.set_workers_count(2)
+
+        assert analyzer_context.analyze()
+        assert analyzer_context.stats["references"] == 0  # Native resolution is part of deep analysis
+
+        analyzer_context.deep_analysis = True
+        assert analyzer_context.analyze()
+
+        stats = analyzer_context.stats
+        assert stats["references"] >= 4
+        assert stats["references_resolved"] >= 3  # Property, result & argument of type math::Vec
+        assert stats["reference_resolution_ms"] >= 0
+
+def test_analyzer_context_stream_native_reference_resolution():
+    with tempfile.TemporaryDirectory() as work_dir:
+        with open(os.path.join(work_dir, "Vec.h"), "w") as f:
+            f.write("#pragma once\nnamespace math { /** @runtime **/ struct Vec { float x; }; }\n")
+
+        with open(os.path.join(work_dir, "User.h"), "w") as f:
+            f.write('#pragma once\n#include "Vec.h"\n/** @runtime **/ struct User { math::Vec v; math::Vec get() const; };\n')
+
+        analyzer_context: rg3py.AnalyzerContex = rg3py.AnalyzerContext.make()
+        analyzer_context.set_headers([os.path.join(work_dir, "Vec.h"), os.path.join(work_dir, "User.h")])
+        analyzer_context.set_include_directories([work_dir])
+        analyzer_context.set_compiler_args(["-x", "c++-header"])
+        analyzer_context.set_workers_count(2)
+        analyzer_context.deep_analysis = True
+
+        streamed_types = {}
+        for item in analyzer_context.stream(max_pending=1):
+            streamed_types.update({t.pretty_name: t for t in item["types"]})
+
+        assert analyzer_context.succeeded
+        assert sorted(streamed_types.keys()) == ["User", "math::Vec"]
+
+        # Streamed types are published before types of other headers are known: they are linked when run is finished
+        assert analyzer_context.stats["references_resolved"] >= 2
+
+        resolved = analyzer_context.get_type_by_reference(streamed_types["User"].properties[0].type_info.type_ref)
+        assert resolved is not None
+        assert resolved.pretty_name == "math::Vec"
+        assert resolved.hash == streamed_types["math::Vec"].hash
\ No newline at end of file
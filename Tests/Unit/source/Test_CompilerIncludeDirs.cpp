@@ -4,6 +4,7 @@
 #include <RG3/Cpp/TypeClass.h>
 #include <RG3/LLVM/Compiler.h>
 #include <RG3/LLVM/CodeAnalyzer.h>
+#include <RG3/LLVM/CompilerConfigDetector.h>
 #include "CommonHelpers.h"
 
 class Tests_CompilerIncludeDirs : public ::testing::Test
@@ -125,4 +126,39 @@ struct Sample
 	ASSERT_EQ(asClass->getProperties()[0].sTypeInfo.sTypeRef.getRefName(), "bool");
 	ASSERT_EQ(asClass->getProperties()[1].sName, "sz");
 	ASSERT_EQ(asClass->getProperties()[1].sTypeInfo.sTypeRef.getRefName(), "size_t");
+}
+
+TEST_F(Tests_CompilerIncludeDirs, CheckInProcessEnvironmentDetection)
+{
+	auto envResult = rg3::llvm::CompilerConfigDetector::detectCompilerEnvironmentInProcess();
+	if (auto pError = std::get_if<rg3::llvm::CompilerEnvError>(&envResult))
+	{
+		FAIL() << "In-process detection failed: " << pError->message;
+	}
+
+	const auto& env = std::get<rg3::llvm::CompilerEnvironment>(envResult);
+	ASSERT_FALSE(env.triple.empty()) << "Triple must be computed by driver";
+	ASSERT_FALSE(env.config.vSystemIncludes.empty()) << "System includes must be computed by toolchain";
+
+	g_Analyzer->setCompilerEnvironment(env);
+	g_Analyzer->getCompilerConfig().cppStandard = rg3::llvm::CxxStandard::CC_20;
+	g_Analyzer->setSourceCode(MS_WORKAROUND_FOR_LEGACY_CLANG R"(
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+/// @runtime
+struct Sample
+{
+	std::size_t sz;
+	std::uint32_t u32;
+	std::string str;
+};
+)");
+
+	auto analyzeResult = g_Analyzer->analyze();
+	CommonHelpers::printCompilerIssues(analyzeResult.vIssues);
+
+	ASSERT_TRUE(analyzeResult.vIssues.empty()) << "Environment from driver must be enough to parse std headers";
+	ASSERT_EQ(analyzeResult.vFoundTypes.size(), 1);
 }
\ No newline at end of file
@@ -0,0 +1,108 @@
+#include <gtest/gtest.h>
+
+#include <RG3/LLVM/AnalyzeCostHistory.h>
+
+#include <fmt/format.h>
+
+#include <filesystem>
+#include <fstream>
+#include <thread>
+#include <vector>
+
+
+class Tests_AnalyzeCostHistory : public ::testing::Test
+{
+ protected:
+	void SetUp() override
+	{
+		m_tempDir = std::filesystem::temp_directory_path() / "rg3_cost_history_test";
+
+		std::filesystem::remove_all(m_tempDir);
+		std::filesystem::create_directories(m_tempDir);
+	}
+
+	void TearDown() override
+	{
+		std::filesystem::remove_all(m_tempDir);
+	}
+
+ protected:
+	std::filesystem::path m_tempDir {};
+};
+
+TEST_F(Tests_AnalyzeCostHistory, RecordSaveAndLoad)
+{
+	const auto historyFile = m_tempDir / "history" / "costs.txt";
+	const auto header = m_tempDir / "Header.h";
+
+	{
+		rg3::llvm::AnalyzeCostHistory history { historyFile };
+		ASSERT_FALSE(history.load()) << "History file must not exist yet";
+		ASSERT_FALSE(history.find(header).has_value());
+
+		history.record(header, std::chrono::milliseconds(100));
+		history.record(header, std::chrono::milliseconds(300));
+		ASSERT_EQ(history.find(header).value(), std::chrono::milliseconds(200)) << "Known time must be averaged with new one";
+		ASSERT_TRUE(history.save());
+	}
+
+	rg3::llvm::AnalyzeCostHistory history { historyFile };
+	ASSERT_TRUE(history.load());
+	ASSERT_EQ(history.getEntriesCount(), 1);
+	ASSERT_EQ(history.find(header).value(), std::chrono::milliseconds(200));
+}
+
+TEST_F(Tests_AnalyzeCostHistory, MalformedHistoryIsDropped)
+{
+	const auto historyFile = m_tempDir / "costs.txt";
+	std::ofstream { historyFile } << "rg3-cost-history 1\nnot-a-number /some/header.h\n";
+
+	rg3::llvm::AnalyzeCostHistory history { historyFile };
+	ASSERT_FALSE(history.load());
+	ASSERT_EQ(history.getEntriesCount(), 0);
+}
+
+TEST_F(Tests_AnalyzeCostHistory, EstimateCountsIncludes)
+{
+	const auto simpleHeader = m_tempDir / "Simple.h";
+	const auto includingHeader = m_tempDir / "Including.h";
+
+	std::ofstream { simpleHeader } << "struct A {};\n";
+	std::ofstream { includingHeader } << "#include <vector>\n#  include \"Simple.h\"\nstruct B {};\n";
+
+	ASSERT_EQ(rg3::llvm::AnalyzeCostHistory::estimateCost(m_tempDir / "Missing.h"), rg3::llvm::AnalyzeCostHistory::kMinHeaderCost);
+	ASSERT_EQ(rg3::llvm::AnalyzeCostHistory::estimateCost(simpleHeader), rg3::llvm::AnalyzeCostHistory::kMinHeaderCost);
+	ASSERT_GE(rg3::llvm::AnalyzeCostHistory::estimateCost(includingHeader), 2 * rg3::llvm::AnalyzeCostHistory::kIncludeCost);
+}
+
+TEST_F(Tests_AnalyzeCostHistory, ConcurrentSavesKeepHistoryReadable)
+{
+	constexpr int kRuns = 4;
+	constexpr int kSavesPerRun = 32;
+
+	const auto historyFile = m_tempDir / "costs.txt";
+
+	// Every run has own history instance (like separate processes) and saves into same file
+	std::vector<std::thread> vRuns {};
+	for (int i = 0; i < kRuns; ++i)
+	{
+		vRuns.emplace_back([&historyFile, this, i]() {
+			rg3::llvm::AnalyzeCostHistory history { historyFile };
+
+			for (int j = 0; j < kSavesPerRun; ++j)
+			{
+				history.record(m_tempDir / fmt::format("Header_{}_{}.h", i, j), std::chrono::milliseconds(j + 1));
+				history.save();
+			}
+		});
+	}
+
+	for (auto& run : vRuns)
+	{
+		run.join();
+	}
+
+	rg3::llvm::AnalyzeCostHistory history { historyFile };
+	ASSERT_TRUE(history.load());
+	ASSERT_EQ(history.getEntriesCount(), kSavesPerRun) << "History of single run expected";
+}
\ No newline at end of file
@@ -289,4 +289,100 @@ struct SUPER_COOL : NotCool, Cool
 	ASSERT_TRUE(asClass1->getParentTypes()[1].vTags.hasTag("runtime"));
 	ASSERT_TRUE(asClass1->getParentTypes()[1].vTags.hasTag("test.case"));
 	ASSERT_EQ(asClass1->getParentTypes()[1].vTags.getTag("test.case").getArguments()[0].asI64(-1), 123);
+}
+
+TEST_F(Tests_Comments, SharedParentTagsAndAliasComments)
+{
+	g_Analyzer->setSourceCode(R"(
+/**
+ * @runtime
+ * @component(7)
+ **/
+struct Base
+{
+	/// @property(Value)
+	int iValue;
+};
+
+/// @runtime
+struct First : Base {};
+
+/// @runtime
+struct Second : Base {};
+
+/**
+ * @runtime
+ * @alias.tag
+ **/
+using BaseAlias = Base;
+)");
+
+	g_Analyzer->getCompilerConfig().cppStandard = rg3::llvm::CxxStandard::CC_14;
+
+	const auto analyzeResult = g_Analyzer->analyze();
+
+	ASSERT_TRUE(analyzeResult.vIssues.empty()) << "No issues should be here";
+	ASSERT_EQ(analyzeResult.vFoundTypes.size(), 4);
+
+	// Both derived types see same tags of parent (memoized comment must not be consumed by first lookup)
+	for (std::size_t i = 1; i <= 2; ++i)
+	{
+		const auto* pDerived = static_cast<const rg3::cpp::TypeClass*>(analyzeResult.vFoundTypes[i].get());
+		ASSERT_EQ(pDerived->getParentTypes().size(), 1);
+		ASSERT_TRUE(pDerived->getParentTypes()[0].vTags.hasTag("runtime"));
+		ASSERT_EQ(pDerived->getParentTypes()[0].vTags.getTag("component").getArguments()[0].asI64(-1), 7);
+	}
+
+	ASSERT_EQ(analyzeResult.vFoundTypes[3]->getName(), "BaseAlias");
+	ASSERT_TRUE(analyzeResult.vFoundTypes[3]->getTags().hasTag("alias.tag"));
+	ASSERT_FALSE(analyzeResult.vFoundTypes[3]->getTags().hasTag("component")) << "Alias has own comment";
+
+	const auto* pAlias = static_cast<const rg3::cpp::TypeClass*>(analyzeResult.vFoundTypes[3].get());
+	ASSERT_EQ(pAlias->getProperties().size(), 1);
+	ASSERT_EQ(pAlias->getProperties()[0].sAlias, "Value");
+}
+
+TEST_F(Tests_Comments, ParseTagsFromCommentString)
+{
+	using rg3::cpp::Tag;
+	using rg3::cpp::TagArgumentType;
+
+	ASSERT_TRUE(Tag::parseFromCommentString("").isEmpty());
+	ASSERT_TRUE(Tag::parseFromCommentString("/// Plain comment without tags").isEmpty());
+	ASSERT_TRUE(Tag::parseFromCommentString("/// @ @1abc @a").isEmpty()) << "Tag name starts with letter or '_' and has at least 2 symbols";
+
+	const auto tags = Tag::parseFromCommentString(R"(
+/**
+ * @runtime
+ * @editor.hidden@next
+ * @args(12, -3, 1.5, true, false, @engine::Mode, "Quoted text", ,Plain)
+ * @same(1)
+ * @same(2)
+ * @unclosed(1, 2
+ **/)");
+
+	ASSERT_TRUE(tags.hasTag("runtime"));
+	ASSERT_FALSE(tags.getTag("runtime").hasArguments());
+	ASSERT_TRUE(tags.hasTag("editor.hidden"));
+	ASSERT_TRUE(tags.hasTag("next"));
+	ASSERT_TRUE(tags.hasTag("unclosed"));
+	ASSERT_FALSE(tags.getTag("unclosed").hasArguments()) << "Arguments without closing bracket are ignored";
+	ASSERT_EQ(tags.getTag("same").getArguments()[0].asI64(0), 2) << "Last tag with same name wins";
+
+	const auto argsTag = tags.getTag("args");
+	const auto& vArgs = argsTag.getArguments();
+	ASSERT_EQ(vArgs.size(), 8) << "Empty argument must be skipped";
+	ASSERT_EQ(vArgs[0].getHoldedType(), TagArgumentType::AT_I64);
+	ASSERT_EQ(vArgs[0].asI64(0), 12);
+	ASSERT_EQ(vArgs[1].asI64(0), -3);
+	ASSERT_EQ(vArgs[2].getHoldedType(), TagArgumentType::AT_FLOAT);
+	ASSERT_FLOAT_EQ(vArgs[2].asFloat(0.f), 1.5f);
+	ASSERT_EQ(vArgs[3].getHoldedType(), TagArgumentType::AT_BOOL);
+	ASSERT_TRUE(vArgs[3].asBool(false));
+	ASSERT_FALSE(vArgs[4].asBool(true));
+	ASSERT_EQ(vArgs[5].getHoldedType(), TagArgumentType::AT_TYPEREF);
+	ASSERT_EQ(vArgs[5].asTypeRef({}).getRefName(), "engine::Mode");
+	ASSERT_EQ(vArgs[6].getHoldedType(), TagArgumentType::AT_STRING);
+	ASSERT_EQ(vArgs[6].asString(""), "Quoted text");
+	ASSERT_EQ(vArgs[7].asString(""), "Plain");
 }
\ No newline at end of file
@@ -0,0 +1,57 @@
+#include <gtest/gtest.h>
+
+#include <RG3/LLVM/CompileCommandsDatabase.h>
+
+#include <filesystem>
+#include <fstream>
+
+
+TEST(Tests_CompileCommandsDatabase, ApplyCommandLine)
+{
+	rg3::llvm::CompilerConfig config {};
+	config.vCompilerDefs = { "COMMON=1" };
+
+	rg3::llvm::CompileCommandsDatabase::applyCommandLine(config, {
+		"/usr/bin/c++", "-Iinclude", "-I", "/abs/include", "-isystem", "third_party",
+		"-DCOMMON=1", "-DTARGET", "-UNDEBUG", "-std=gnu++17", "-O2", "-Wall",
+		"-include", "pch.h", "-o", "out.o", "-c", "source.cpp"
+	}, "/project");
+
+	ASSERT_EQ(config.vIncludes.size(), 3);
+	ASSERT_EQ(config.vIncludes[0].sFsLocation, std::filesystem::path("/project/include"));
+	ASSERT_EQ(config.vIncludes[0].eKind, rg3::llvm::IncludeKind::IK_PROJECT);
+	ASSERT_EQ(config.vIncludes[1].sFsLocation, std::filesystem::path("/abs/include"));
+	ASSERT_EQ(config.vIncludes[2].sFsLocation, std::filesystem::path("/project/third_party"));
+	ASSERT_EQ(config.vIncludes[2].eKind, rg3::llvm::IncludeKind::IK_SYSTEM);
+
+	ASSERT_EQ(config.vCompilerDefs, (std::vector<std::string> { "COMMON=1", "TARGET" })) << "Known definitions must not be duplicated";
+	ASSERT_EQ(config.vCompilerArgs, (std::vector<std::string> { "-UNDEBUG", "-include", std::filesystem::path("/project/pch.h").string() })) << "Only flags which affect parsing are taken";
+	ASSERT_EQ(config.cppStandard, rg3::llvm::CxxStandard::CC_17);
+}
+
+TEST(Tests_CompileCommandsDatabase, HeaderTakesFlagsOfOwningTranslationUnit)
+{
+	const auto tempDir = std::filesystem::temp_directory_path() / "rg3_compile_commands_test";
+	std::filesystem::remove_all(tempDir);
+	std::filesystem::create_directories(tempDir / "lib");
+
+	std::ofstream { tempDir / "compile_commands.json" }
+		<< "[{\"directory\": \"" << (tempDir / "lib").generic_string() << "\", "
+		<< "\"command\": \"c++ -Iinclude -DLIB_BUILD -std=c++20 -c Lib.cpp\", \"file\": \"Lib.cpp\"}]";
+
+	auto result = rg3::llvm::CompileCommandsDatabase::loadFromFile(tempDir / "compile_commands.json");
+	ASSERT_TRUE(std::holds_alternative<std::shared_ptr<rg3::llvm::CompileCommandsDatabase>>(result));
+
+	const auto& pDatabase = std::get<std::shared_ptr<rg3::llvm::CompileCommandsDatabase>>(result);
+	ASSERT_EQ(pDatabase->getFilesCount(), 1);
+
+	const auto config = pDatabase->getConfigForFile(tempDir / "lib" / "Lib.h", {});
+	ASSERT_TRUE(config.has_value());
+	ASSERT_EQ(config->cppStandard, rg3::llvm::CxxStandard::CC_20);
+	ASSERT_EQ(config->vCompilerDefs, (std::vector<std::string> { "LIB_BUILD" }));
+	ASSERT_EQ(config->vIncludes.size(), 1);
+
+	ASSERT_TRUE(std::holds_alternative<rg3::llvm::CompileCommandsDatabaseError>(rg3::llvm::CompileCommandsDatabase::loadFromFile(tempDir / "missing.json")));
+
+	std::filesystem::remove_all(tempDir);
+}
\ No newline at end of file
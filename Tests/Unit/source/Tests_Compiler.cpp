@@ -1,9 +1,14 @@
 #include <gtest/gtest.h>
 
 #include <RG3/Cpp/TypeBase.h>
+#include <RG3/Cpp/TypeClass.h>
+#include <RG3/Cpp/TypeEnum.h>
 #include <RG3/LLVM/CodeAnalyzer.h>
 #include <RG3/LLVM/CompilerConfig.h>
 
+#include <atomic>
+#include <set>
+
 
 class Tests_Compiler : public ::testing::Test
 {
@@ -85,4 +90,137 @@ enum class EBoomer;
 
 	ASSERT_TRUE(result.vIssues.empty()) << "No issues in this test";
 	ASSERT_TRUE(result.vFoundTypes.empty()) << "No types expected to have here";
+}
+
+TEST_F(Tests_Compiler, CheckAnalyzeStats)
+{
+	g_Analyzer->getCompilerConfig().cppStandard = rg3::llvm::CxxStandard::CC_17;
+	g_Analyzer->setSourceCode(R"(
+/// @runtime
+struct First
+{
+	int a;
+	float b;
+};
+
+/// @runtime
+enum class Second { S_A, S_B };
+
+void someFunction(int x);
+)");
+
+	auto result = g_Analyzer->analyze();
+
+	ASSERT_TRUE(result.vIssues.empty()) << "No issues in this test";
+	ASSERT_EQ(result.vFoundTypes.size(), 2);
+
+	const auto& stats = result.stats;
+	ASSERT_EQ(stats.iTranslationUnits, 1);
+	ASSERT_EQ(stats.iTypesEmitted, result.vFoundTypes.size());
+	ASSERT_GE(stats.iDeclsVisited, 2) << "At least every emitted type must be visited";
+	ASSERT_GT(stats.totalTime.count(), 0);
+	ASSERT_GE(stats.parseTime.count(), 0);
+	ASSERT_GE(stats.visitTime.count(), 0);
+	ASSERT_LE(stats.parseTime + stats.visitTime, stats.totalTime) << "Phases are parts of total time";
+}
+
+TEST_F(Tests_Compiler, CheckNestedTypesEmittedOnce)
+{
+	g_Analyzer->getCompilerConfig().cppStandard = rg3::llvm::CxxStandard::CC_17;
+	g_Analyzer->setSourceCode(R"(
+struct Outer
+{
+	struct Middle
+	{
+		struct Inner
+		{
+			/// @runtime
+			struct Leaf
+			{
+				int a;
+				void method() { struct Local { int b; }; }
+			};
+
+			/// @runtime
+			enum class ELeaf { L_A, L_B };
+		};
+
+		Inner inner;
+	};
+
+	/// @runtime
+	struct Sibling
+	{
+		/// @runtime
+		struct Child { float c; };
+
+		Child child;
+	};
+};
+)");
+
+	auto result = g_Analyzer->analyze();
+
+	ASSERT_TRUE(result.vIssues.empty()) << "No issues in this test";
+	ASSERT_EQ(result.vFoundTypes.size(), 4) << "Every runtime type must be emitted exactly once";
+
+	std::set<std::string> knownTypes {};
+	for (const auto& pType : result.vFoundTypes)
+	{
+		ASSERT_TRUE(knownTypes.insert(pType->getPrettyName()).second) << "Duplicated type " << pType->getPrettyName();
+	}
+
+	ASSERT_TRUE(knownTypes.contains("Outer::Middle::Inner::Leaf"));
+	ASSERT_TRUE(knownTypes.contains("Outer::Middle::Inner::ELeaf"));
+	ASSERT_TRUE(knownTypes.contains("Outer::Sibling"));
+	ASSERT_TRUE(knownTypes.contains("Outer::Sibling::Child"));
+	ASSERT_EQ(result.stats.iTypesEmitted, knownTypes.size());
+	ASSERT_EQ(result.stats.iDeclsRevisited, 0) << "Every declaration must be routed once";
+
+	for (const auto& pType : result.vFoundTypes)
+	{
+		if (pType->getPrettyName() == "Outer::Middle::Inner::Leaf")
+		{
+			const auto* pLeaf = static_cast<const rg3::cpp::TypeClass*>(pType.get());
+			ASSERT_EQ(pLeaf->getProperties().size(), 1);
+			ASSERT_EQ(pLeaf->getFunctions().size(), 1);
+		}
+		else if (pType->getPrettyName() == "Outer::Middle::Inner::ELeaf")
+		{
+			const auto* pEnum = static_cast<const rg3::cpp::TypeEnum*>(pType.get());
+			ASSERT_EQ(pEnum->getEntries().size(), 2) << "Enum constants must be collected without traversal";
+		}
+	}
+}
+
+TEST_F(Tests_Compiler, CheckCancelledAnalyze)
+{
+	g_Analyzer->getCompilerConfig().cppStandard = rg3::llvm::CxxStandard::CC_17;
+	g_Analyzer->setSourceCode(R"(
+/// @runtime
+struct Simple
+{
+	int a;
+};
+)");
+
+	std::atomic_bool bCancelled { true };
+	g_Analyzer->setCancellationFlag(&bCancelled);
+
+	{
+		auto result = g_Analyzer->analyze();
+
+		ASSERT_TRUE(result.vFoundTypes.empty()) << "Cancelled analyze must not report types";
+		ASSERT_TRUE(rg3::llvm::CodeAnalyzer::isCancelledResult(result));
+		ASSERT_FALSE(static_cast<bool>(result));
+	}
+
+	bCancelled = false;
+	{
+		auto result = g_Analyzer->analyze();
+
+		ASSERT_TRUE(result.vIssues.empty()) << "No issues in this test";
+		ASSERT_EQ(result.vFoundTypes.size(), 1);
+		ASSERT_FALSE(rg3::llvm::CodeAnalyzer::isCancelledResult(result));
+	}
 }
\ No newline at end of file
@@ -0,0 +1,145 @@
+#include <gtest/gtest.h>
+
+#include <RG3/LLVM/CompilerConfigDetector.h>
+#include <RG3/LLVM/CompilerEnvironmentCache.h>
+
+#include <filesystem>
+#include <fstream>
+
+
+class Tests_CompilerEnvironmentCache : public ::testing::Test
+{
+ protected:
+	void SetUp() override
+	{
+		auto& cache = rg3::llvm::CompilerEnvironmentCache::getInstance();
+
+		m_oldDiskCacheDir = cache.getDiskCacheDirectory();
+		m_tempDir = std::filesystem::temp_directory_path() / "rg3_env_cache_test";
+
+		std::filesystem::remove_all(m_tempDir);
+		std::filesystem::create_directories(m_tempDir);
+
+		// Fake 'compiler' executable: key depends only on file status
+		m_fakeCompiler = m_tempDir / "fake-g++";
+		std::ofstream { m_fakeCompiler } << "#!/bin/sh";
+
+		cache.setDiskCacheDirectory(m_tempDir / "cache");
+		cache.invalidate();
+	}
+
+	void TearDown() override
+	{
+		auto& cache = rg3::llvm::CompilerEnvironmentCache::getInstance();
+		cache.invalidate();
+		cache.setDiskCacheDirectory(m_oldDiskCacheDir);
+
+		std::filesystem::remove_all(m_tempDir);
+	}
+
+	rg3::llvm::CompilerEnvironment makeEnvironment() const
+	{
+		rg3::llvm::CompilerEnvironment env {};
+		env.triple = "x86_64-unknown-linux-gnu";
+		env.versionString = "gcc version 13.2.0";
+		env.config.vSystemIncludes.emplace_back(m_tempDir.string(), rg3::llvm::IncludeKind::IK_SYSTEM);
+		return env;
+	}
+
+ protected:
+	std::optional<std::filesystem::path> m_oldDiskCacheDir {};
+	std::filesystem::path m_tempDir {};
+	std::filesystem::path m_fakeCompiler {};
+};
+
+TEST_F(Tests_CompilerEnvironmentCache, StoreAndFind)
+{
+	auto& cache = rg3::llvm::CompilerEnvironmentCache::getInstance();
+
+	const auto key = rg3::llvm::CompilerEnvironmentCache::Key::makeForCompiler(m_fakeCompiler);
+	ASSERT_TRUE(key.has_value()) << "Key must be created for existing file";
+	ASSERT_FALSE(cache.find(key.value()).has_value()) << "Cache must be empty";
+
+	cache.store(key.value(), makeEnvironment());
+
+	const auto found = cache.find(key.value());
+	ASSERT_TRUE(found.has_value()) << "Entry must be found after store";
+	ASSERT_EQ(found->triple, "x86_64-unknown-linux-gnu");
+	ASSERT_EQ(found->versionString, "gcc version 13.2.0");
+	ASSERT_EQ(found->config.vSystemIncludes.size(), 1);
+	ASSERT_EQ(cache.getStats().iMemoryHits, 1);
+}
+
+TEST_F(Tests_CompilerEnvironmentCache, LoadFromDisk)
+{
+	auto& cache = rg3::llvm::CompilerEnvironmentCache::getInstance();
+
+	const auto key = rg3::llvm::CompilerEnvironmentCache::Key::makeForCompiler(m_fakeCompiler);
+	ASSERT_TRUE(key.has_value());
+
+	cache.store(key.value(), makeEnvironment());
+
+	// Drop in-memory entry only: simulate next process
+	cache.setDiskCacheDirectory(std::nullopt);
+	cache.invalidate();
+	cache.setDiskCacheDirectory(m_tempDir / "cache");
+
+	const auto found = cache.find(key.value());
+	ASSERT_TRUE(found.has_value()) << "Entry must be loaded from disk";
+	ASSERT_EQ(found->triple, "x86_64-unknown-linux-gnu");
+	ASSERT_EQ(found->config.vSystemIncludes[0].sFsLocation, m_tempDir);
+	ASSERT_EQ(cache.getStats().iDiskHits, 1);
+}
+
+TEST_F(Tests_CompilerEnvironmentCache, InvalidateOnCompilerChange)
+{
+	auto& cache = rg3::llvm::CompilerEnvironmentCache::getInstance();
+
+	const auto oldKey = rg3::llvm::CompilerEnvironmentCache::Key::makeForCompiler(m_fakeCompiler);
+	ASSERT_TRUE(oldKey.has_value());
+	cache.store(oldKey.value(), makeEnvironment());
+
+	// 'Update' compiler
+	std::ofstream { m_fakeCompiler, std::ios::app } << "\necho updated";
+
+	const auto newKey = rg3::llvm::CompilerEnvironmentCache::Key::makeForCompiler(m_fakeCompiler);
+	ASSERT_TRUE(newKey.has_value());
+	ASSERT_FALSE(oldKey.value() == newKey.value()) << "Key must depend on compiler executable";
+	ASSERT_FALSE(cache.find(newKey.value()).has_value()) << "Entry of old compiler must not be used";
+}
+
+TEST_F(Tests_CompilerEnvironmentCache, InvalidateOnMissingIncludeDir)
+{
+	auto& cache = rg3::llvm::CompilerEnvironmentCache::getInstance();
+
+	const auto key = rg3::llvm::CompilerEnvironmentCache::Key::makeForCompiler(m_fakeCompiler);
+	ASSERT_TRUE(key.has_value());
+
+	auto env = makeEnvironment();
+	env.config.vSystemIncludes.emplace_back((m_tempDir / "removed_dir").string(), rg3::llvm::IncludeKind::IK_SYSTEM);
+	cache.store(key.value(), env);
+
+	cache.setDiskCacheDirectory(std::nullopt);
+	cache.invalidate();
+	cache.setDiskCacheDirectory(m_tempDir / "cache");
+
+	ASSERT_FALSE(cache.find(key.value()).has_value()) << "Entry with missing include dir must be invalidated";
+	ASSERT_TRUE(std::filesystem::is_empty(m_tempDir / "cache")) << "Invalid entry must be removed from disk";
+}
+
+TEST_F(Tests_CompilerEnvironmentCache, DetectedEnvironmentIsCached)
+{
+	const auto firstResult = rg3::llvm::CompilerConfigDetector::detectSystemCompilerEnvironment();
+	ASSERT_TRUE(std::holds_alternative<rg3::llvm::CompilerEnvironment>(firstResult)) << "System compiler must be detected";
+
+	const auto hitsBefore = rg3::llvm::CompilerEnvironmentCache::getInstance().getStats().iMemoryHits;
+	const auto secondResult = rg3::llvm::CompilerConfigDetector::detectSystemCompilerEnvironment();
+	ASSERT_TRUE(std::holds_alternative<rg3::llvm::CompilerEnvironment>(secondResult));
+	ASSERT_EQ(rg3::llvm::CompilerEnvironmentCache::getInstance().getStats().iMemoryHits, hitsBefore + 1) << "Second detection must hit cache";
+
+	const auto& first = std::get<rg3::llvm::CompilerEnvironment>(firstResult);
+	const auto& second = std::get<rg3::llvm::CompilerEnvironment>(secondResult);
+	ASSERT_EQ(first.triple, second.triple);
+	ASSERT_EQ(first.versionString, second.versionString);
+	ASSERT_EQ(first.config.vSystemIncludes.size(), second.config.vSystemIncludes.size());
+}
\ No newline at end of file
@@ -0,0 +1,144 @@
+#include <gtest/gtest.h>
+
+#include <RG3/Daemon/DaemonProtocol.h>
+#include <RG3/Daemon/DaemonServer.h>
+#include <RG3/Daemon/DaemonClient.h>
+#include <RG3/LLVM/IncrementalCache.h>
+
+#include <filesystem>
+#include <fstream>
+#include <thread>
+
+
+TEST(Tests_Daemon, AnalyzeRequestRoundTrip)
+{
+	rg3::daemon::AnalyzeRequest request {};
+	request.compilerConfig.cppStandard = rg3::llvm::CxxStandard::CC_17;
+	request.compilerConfig.vIncludes.emplace_back("/project/include", rg3::llvm::IncludeKind::IK_SYSTEM);
+	request.compilerConfig.vCompilerDefs = { "FIRST=1", "SECOND" };
+	request.compilerConfig.vCompilerArgs = { "-fms-extensions" };
+	request.compilerConfig.bSkipFunctionBodies = true;
+	request.compilerConfig.eSourceFilter = rg3::llvm::SourceFilter::SF_PROJECT_INCLUDES;
+	request.compilerConfig.vSourceDenyGlobs = { "*/third_party/*" };
+	request.vHeaders = { "/project/include/First.h", "/project/include/Second.h" };
+	request.iWorkers = 3;
+
+	const auto decoded = rg3::daemon::DaemonProtocol::readAnalyzeRequest(rg3::daemon::DaemonProtocol::writeAnalyzeRequest(request));
+	ASSERT_TRUE(decoded.has_value());
+	ASSERT_EQ(decoded->compilerConfig.cppStandard, rg3::llvm::CxxStandard::CC_17);
+	ASSERT_EQ(decoded->compilerConfig.vIncludes.size(), 1);
+	ASSERT_EQ(decoded->compilerConfig.vIncludes[0].sFsLocation, std::filesystem::path("/project/include"));
+	ASSERT_EQ(decoded->compilerConfig.vIncludes[0].eKind, rg3::llvm::IncludeKind::IK_SYSTEM);
+	ASSERT_EQ(decoded->compilerConfig.vCompilerDefs, request.compilerConfig.vCompilerDefs);
+	ASSERT_EQ(decoded->compilerConfig.vCompilerArgs, request.compilerConfig.vCompilerArgs);
+	ASSERT_TRUE(decoded->compilerConfig.bSkipFunctionBodies);
+	ASSERT_EQ(decoded->compilerConfig.eSourceFilter, rg3::llvm::SourceFilter::SF_PROJECT_INCLUDES);
+	ASSERT_TRUE(decoded->compilerConfig.vSourceAllowGlobs.empty());
+	ASSERT_EQ(decoded->compilerConfig.vSourceDenyGlobs, request.compilerConfig.vSourceDenyGlobs);
+	ASSERT_EQ(decoded->vHeaders, request.vHeaders);
+	ASSERT_EQ(decoded->iWorkers, 3);
+
+	// Truncated payload must be rejected
+	const auto payload = rg3::daemon::DaemonProtocol::writeAnalyzeRequest(request);
+	ASSERT_FALSE(rg3::daemon::DaemonProtocol::readAnalyzeRequest(std::string_view { payload }.substr(0, payload.size() / 2)).has_value());
+}
+
+TEST(Tests_Daemon, EvaluateResponseRoundTrip)
+{
+	rg3::llvm::CodeEvaluateResult response {};
+	response.mOutputs["bValue"] = true;
+	response.mOutputs["iValue"] = std::int64_t { -42 };
+	response.mOutputs["sValue"] = std::string { "text" };
+	response.vIssues.push_back({ rg3::llvm::AnalyzerResult::CompilerIssue::IssueKind::IK_WARNING, "eval.cpp", 1, 2, "unused" });
+
+	const auto decoded = rg3::daemon::DaemonProtocol::readEvaluateResponse(rg3::daemon::DaemonProtocol::writeEvaluateResponse(response));
+	ASSERT_TRUE(decoded.has_value());
+	ASSERT_EQ(decoded->mOutputs, response.mOutputs);
+	ASSERT_EQ(decoded->vIssues.size(), 1);
+	ASSERT_EQ(decoded->vIssues[0].kind, rg3::llvm::AnalyzerResult::CompilerIssue::IssueKind::IK_WARNING);
+	ASSERT_EQ(decoded->vIssues[0].iLine, 1);
+	ASSERT_EQ(decoded->vIssues[0].iColumn, 2);
+	ASSERT_EQ(decoded->vIssues[0].sMessage, "unused");
+}
+
+TEST(Tests_Daemon, ResultsCacheEvictsLeastRecentlyUsed)
+{
+	const auto tempDir = std::filesystem::temp_directory_path() / "rg3_daemon_cache_test";
+	std::filesystem::remove_all(tempDir);
+	std::filesystem::create_directories(tempDir);
+
+	const std::filesystem::path vHeaders[3] = { tempDir / "A.h", tempDir / "B.h", tempDir / "C.h" };
+	for (const auto& header : vHeaders)
+	{
+		std::ofstream { header } << "struct Empty {};";
+	}
+
+	rg3::llvm::IncrementalCache cache { {}, "digest" };
+	cache.store(vHeaders[0], rg3::llvm::AnalyzerResult {});
+
+	const std::size_t iEntrySize = cache.getMemoryUsage();
+	ASSERT_GT(iEntrySize, 0);
+
+	cache.setMemoryLimit(iEntrySize * 2);
+	cache.store(vHeaders[1], rg3::llvm::AnalyzerResult {});
+	ASSERT_TRUE(cache.find(vHeaders[0]).has_value()) << "Lookup makes entry most recently used";
+
+	cache.store(vHeaders[2], rg3::llvm::AnalyzerResult {});
+	ASSERT_EQ(cache.getEntriesCount(), 2);
+	ASSERT_EQ(cache.getMemoryUsage(), iEntrySize * 2);
+	ASSERT_TRUE(cache.find(vHeaders[0]).has_value());
+	ASSERT_FALSE(cache.find(vHeaders[1]).has_value()) << "Least recently used entry must be evicted";
+	ASSERT_TRUE(cache.find(vHeaders[2]).has_value());
+
+	std::filesystem::remove_all(tempDir);
+}
+
+#if !defined(_WIN32)
+TEST(Tests_Daemon, SecondAnalyzeReusesResults)
+{
+	const auto tempDir = std::filesystem::temp_directory_path() / "rg3_daemon_test";
+	std::filesystem::remove_all(tempDir);
+	std::filesystem::create_directories(tempDir);
+
+	const auto headerPath = tempDir / "Header.h";
+	std::ofstream { headerPath } << "namespace daemon_test { /** @runtime **/ struct Simple { int iValue; }; }";
+
+	rg3::daemon::DaemonServer server { rg3::daemon::DaemonServer::Options { tempDir / "rg3d.sock", 1 } };
+	ASSERT_FALSE(server.start().has_value());
+
+	std::thread serverThread { [&server]() { server.run(); } };
+
+	{
+		auto clientResult = rg3::daemon::DaemonClient::connect(tempDir / "rg3d.sock");
+		ASSERT_TRUE(std::holds_alternative<std::unique_ptr<rg3::daemon::DaemonClient>>(clientResult));
+		auto& pClient = std::get<std::unique_ptr<rg3::daemon::DaemonClient>>(clientResult);
+
+		rg3::daemon::AnalyzeRequest request {};
+		request.compilerConfig.cppStandard = rg3::llvm::CxxStandard::CC_20;
+		request.vHeaders = { headerPath.string() };
+
+		for (int iRun = 0; iRun < 2; ++iRun)
+		{
+			auto response = pClient->analyze(request);
+			ASSERT_TRUE(std::holds_alternative<rg3::daemon::AnalyzeResponse>(response));
+
+			const auto& result = std::get<rg3::daemon::AnalyzeResponse>(response);
+			ASSERT_TRUE(result.vIssues.empty());
+			ASSERT_EQ(result.vFoundTypes.size(), 1);
+			ASSERT_EQ(result.vFoundTypes[0]->getPrettyName(), "daemon_test::Simple");
+			ASSERT_EQ(result.iReusedHeaders, iRun == 0 ? 0 : 1) << "Second run must take result from memory of daemon";
+		}
+
+		auto stats = pClient->getStats();
+		ASSERT_TRUE(std::holds_alternative<rg3::daemon::StatsResponse>(stats));
+		ASSERT_EQ(std::get<rg3::daemon::StatsResponse>(stats).iAnalyzedHeaders, 1);
+		ASSERT_EQ(std::get<rg3::daemon::StatsResponse>(stats).iReusedHeaders, 1);
+	}
+
+	server.stop();
+	serverThread.join();
+
+	ASSERT_FALSE(std::filesystem::exists(tempDir / "rg3d.sock")) << "Socket file must be removed on exit";
+	std::filesystem::remove_all(tempDir);
+}
+#endif
\ No newline at end of file
@@ -0,0 +1,106 @@
+#include <gtest/gtest.h>
+
+#include <RG3/Cpp/FileUtils.h>
+
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+
+class Tests_FileUtils : public ::testing::Test
+{
+ protected:
+	void SetUp() override
+	{
+		m_tempDir = std::filesystem::temp_directory_path() / "rg3_file_utils_test";
+
+		std::filesystem::remove_all(m_tempDir);
+		std::filesystem::create_directories(m_tempDir);
+	}
+
+	void TearDown() override
+	{
+		std::filesystem::remove_all(m_tempDir);
+	}
+
+	static std::string readFile(const std::filesystem::path& path)
+	{
+		std::ifstream file { path, std::ios::binary };
+		std::stringstream content {};
+		content << file.rdbuf();
+		return content.str();
+	}
+
+ protected:
+	std::filesystem::path m_tempDir {};
+};
+
+TEST_F(Tests_FileUtils, WriteFileAtomic)
+{
+	const auto path = m_tempDir / "data.bin";
+
+	ASSERT_TRUE(rg3::cpp::utils::writeFileAtomic(path, "first"));
+	ASSERT_EQ(readFile(path), "first");
+
+	ASSERT_TRUE(rg3::cpp::utils::writeFileAtomic(path, "second"));
+	ASSERT_EQ(readFile(path), "second");
+
+	ASSERT_FALSE(rg3::cpp::utils::writeFileAtomic(m_tempDir / "not_exists" / "data.bin", "data"));
+}
+
+TEST_F(Tests_FileUtils, ConcurrentWritersNeverMixContent)
+{
+	constexpr int kWriters = 8;
+	constexpr int kWritesPerWriter = 32;
+
+	const auto path = m_tempDir / "shared.txt";
+
+	std::vector<std::string> vContents {};
+	for (int i = 0; i < kWriters; ++i)
+	{
+		vContents.emplace_back(64 * 1024, static_cast<char>('a' + i));
+	}
+
+	std::vector<std::thread> vWriters {};
+	for (int i = 0; i < kWriters; ++i)
+	{
+		vWriters.emplace_back([&path, &vContents, i]() {
+			for (int j = 0; j < kWritesPerWriter; ++j)
+			{
+				rg3::cpp::utils::writeFileAtomic(path, vContents[i]);
+			}
+		});
+	}
+
+	for (auto& writer : vWriters)
+	{
+		writer.join();
+	}
+
+	// Whole content of single writer, no temporary files left
+	const std::string sResult = readFile(path);
+	ASSERT_NE(std::find(vContents.begin(), vContents.end(), sResult), vContents.end());
+	ASSERT_EQ(std::distance(std::filesystem::directory_iterator(m_tempDir), std::filesystem::directory_iterator {}), 1);
+}
+
+TEST_F(Tests_FileUtils, CollectIncludeDirectives)
+{
+	const std::string sSource =
+		"#pragma once\n"
+		"#include <vector>\n"
+		"  #  include \"my/header.h\" // comment\r\n"
+		"#define VALUE 1\n"
+		"#include MACRO_HEADER\n"
+		"#include <broken\n"
+		"#include<map>";
+
+	const auto vIncludes = rg3::cpp::utils::collectIncludeDirectives(sSource);
+	ASSERT_EQ(vIncludes.size(), 3);
+	ASSERT_EQ(vIncludes[0], "<vector>");
+	ASSERT_EQ(vIncludes[1], "\"my/header.h\"");
+	ASSERT_EQ(vIncludes[2], "<map>");
+}
\ No newline at end of file
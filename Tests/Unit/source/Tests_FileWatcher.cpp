@@ -0,0 +1,55 @@
+#include <gtest/gtest.h>
+
+#include <RG3/LLVM/FileWatcher.h>
+
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+
+
+#if defined(__linux__)
+TEST(Tests_FileWatcher, ReportsChangedFilesOfWatchedDirectory)
+{
+	const auto tempDir = std::filesystem::temp_directory_path() / "rg3_file_watcher_test";
+	std::filesystem::remove_all(tempDir);
+	std::filesystem::create_directories(tempDir / "include");
+
+	auto watcherResult = rg3::llvm::FileWatcher::create();
+	ASSERT_TRUE(std::holds_alternative<std::unique_ptr<rg3::llvm::FileWatcher>>(watcherResult));
+
+	auto& pWatcher = std::get<std::unique_ptr<rg3::llvm::FileWatcher>>(watcherResult);
+	ASSERT_TRUE(pWatcher->watchDirectory(tempDir / "include"));
+	ASSERT_TRUE(pWatcher->watchDirectory(tempDir / "include")) << "Second watch of same directory is fine";
+	ASSERT_EQ(pWatcher->getWatchedDirectoriesCount(), 1);
+	ASSERT_FALSE(pWatcher->watchDirectory(tempDir / "not_exists"));
+
+	ASSERT_TRUE(pWatcher->waitChanges(std::chrono::milliseconds(10)).empty()) << "No changes expected";
+
+	// Write & save via rename (like editors do)
+	std::ofstream { tempDir / "include" / "Header.h" } << "struct A {};";
+	std::ofstream { tempDir / "include" / "Header.h" } << "struct B {};";
+	std::ofstream { tempDir / "include" / "Other.h.tmp" } << "struct C {};";
+	std::filesystem::rename(tempDir / "include" / "Other.h.tmp", tempDir / "include" / "Other.h");
+
+	const auto changes = pWatcher->waitChanges(std::chrono::milliseconds(1000));
+	ASSERT_FALSE(changes.bOverflow);
+
+	auto hasFile = [&changes](const std::filesystem::path& path) {
+		return std::find(changes.vFiles.begin(), changes.vFiles.end(), std::filesystem::absolute(path).lexically_normal()) != changes.vFiles.end();
+	};
+
+	ASSERT_TRUE(hasFile(tempDir / "include" / "Header.h"));
+	ASSERT_TRUE(hasFile(tempDir / "include" / "Other.h"));
+	ASSERT_EQ(std::count(changes.vFiles.begin(), changes.vFiles.end(), std::filesystem::absolute(tempDir / "include" / "Header.h").lexically_normal()), 1) << "Paths must be unique";
+	ASSERT_EQ(std::count(changes.vCreatedFiles.begin(), changes.vCreatedFiles.end(), std::filesystem::absolute(tempDir / "include" / "Other.h").lexically_normal()), 1) << "Renamed file must be reported as created";
+
+	// Modification of existing file is not a creation
+	std::ofstream { tempDir / "include" / "Header.h" } << "struct D {};";
+
+	const auto modifyChanges = pWatcher->waitChanges(std::chrono::milliseconds(1000));
+	ASSERT_EQ(modifyChanges.vFiles.size(), 1);
+	ASSERT_TRUE(modifyChanges.vCreatedFiles.empty());
+
+	std::filesystem::remove_all(tempDir);
+}
+#endif
\ No newline at end of file
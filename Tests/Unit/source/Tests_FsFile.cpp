@@ -39,4 +39,44 @@ TEST_F(Tests_FsFile, CheckAnalyzeFromFile)
 	ASSERT_FALSE(analyzeResult.vFoundTypes[0]->getTags().getTag("runtime").hasArguments()) << "runtime must have 0 args";
 	ASSERT_TRUE(analyzeResult.vFoundTypes[0]->getTags().hasTag("serialize")) << "Expected to have 'serialize' tag";
 	ASSERT_EQ(analyzeResult.vFoundTypes[0]->getTags().getTag("serialize").getArgumentsCount(), 1) << "runtime must have 1 args";
+}
+
+TEST_F(Tests_FsFile, CheckAnalyzeUmbrellaOfFiles)
+{
+	const std::vector<std::filesystem::path> vHeaders { "Unit/test_headers/TestDefs.h", "Unit/test_headers/Test.h", "Unit/test_headers/Test.h" };
+
+	g_Analyzer->getCompilerConfig().cppStandard = rg3::llvm::CxxStandard::CC_20;
+	g_Analyzer->setSourceCode(rg3::llvm::CodeAnalyzer::makeUmbrellaSource(vHeaders));
+	g_Analyzer->getCompilerConfig().vCompilerArgs.emplace_back("-x");
+	g_Analyzer->getCompilerConfig().vCompilerArgs.emplace_back("c++-header");
+	auto analyzeResult = g_Analyzer->analyze();
+
+	ASSERT_TRUE(analyzeResult.vIssues.empty()) << "No issues should be here";
+	ASSERT_EQ(analyzeResult.vFoundTypes.size(), 1) << "Duplicated header must be included once";
+
+	auto vResults = rg3::llvm::CodeAnalyzer::splitUmbrellaResult(std::move(analyzeResult), vHeaders);
+	ASSERT_EQ(vResults.size(), 3) << "Expected result per header";
+	ASSERT_TRUE(vResults[0].vFoundTypes.empty()) << "TestDefs.h has no types";
+	ASSERT_EQ(vResults[1].vFoundTypes.size(), 1) << "Type must be attributed to Test.h";
+	ASSERT_EQ(vResults[1].vFoundTypes[0]->getPrettyName(), "my_cool_namespace::MyRuntimeClass") << "Bad thing pretty name";
+	ASSERT_EQ(vResults[1].vFoundTypes[0]->getDefinition().getFsLocation(), std::filesystem::absolute("Unit/test_headers/Test.h")) << "Definition must point to header, not to umbrella";
+	ASSERT_TRUE(vResults[2].vFoundTypes.empty()) << "Duplicated header has no own results";
+}
+
+TEST_F(Tests_FsFile, CheckUmbrellaIssueAttribution)
+{
+	const std::vector<std::filesystem::path> vHeaders { "Unit/test_headers/Test.h", "Unit/test_headers/NotExists.h" };
+
+	g_Analyzer->getCompilerConfig().cppStandard = rg3::llvm::CxxStandard::CC_20;
+	g_Analyzer->setSourceCode(rg3::llvm::CodeAnalyzer::makeUmbrellaSource(vHeaders));
+	auto analyzeResult = g_Analyzer->analyze();
+
+	ASSERT_FALSE(analyzeResult.vIssues.empty()) << "Missing header must be reported";
+
+	auto vResults = rg3::llvm::CodeAnalyzer::splitUmbrellaResult(std::move(analyzeResult), vHeaders);
+	ASSERT_EQ(vResults.size(), 2) << "Expected result per header";
+	ASSERT_TRUE(vResults[0].vIssues.empty()) << "Test.h is fine";
+	ASSERT_EQ(vResults[1].vIssues.size(), 1) << "Issue must be attributed to missing header";
+	ASSERT_EQ(vResults[1].vIssues[0].sSourceFile, "Unit/test_headers/NotExists.h");
+	ASSERT_EQ(vResults[1].vIssues[0].kind, rg3::llvm::AnalyzerResult::CompilerIssue::IssueKind::IK_ERROR);
 }
\ No newline at end of file
@@ -0,0 +1,107 @@
+#include <gtest/gtest.h>
+
+#include <RG3/Cpp/TypeBase.h>
+#include <RG3/LLVM/CodeAnalyzer.h>
+#include <RG3/LLVM/CompilerConfig.h>
+#include "CommonHelpers.h"
+
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <vector>
+
+
+class Tests_SourceFileFilter : public ::testing::Test
+{
+ protected:
+	void SetUp() override
+	{
+		m_tempDir = std::filesystem::temp_directory_path() / "rg3_source_filter_test";
+
+		std::filesystem::remove_all(m_tempDir);
+		std::filesystem::create_directories(m_tempDir / "project");
+		std::filesystem::create_directories(m_tempDir / "third_party");
+
+		std::ofstream { m_tempDir / "project" / "Project.h" } << "#pragma once\n/// @runtime\nstruct ProjectType { int a; };\n";
+		std::ofstream { m_tempDir / "third_party" / "Library.h" } << "#pragma once\nnamespace lib {\n/// @runtime\nstruct LibraryType { int b; };\n}\n";
+
+		g_Analyzer = std::make_unique<rg3::llvm::CodeAnalyzer>();
+		g_Analyzer->getCompilerConfig().cppStandard = rg3::llvm::CxxStandard::CC_17;
+		g_Analyzer->getCompilerConfig().vIncludes.emplace_back((m_tempDir / "project").string(), rg3::llvm::IncludeKind::IK_PROJECT);
+		g_Analyzer->getCompilerConfig().vIncludes.emplace_back((m_tempDir / "third_party").string(), rg3::llvm::IncludeKind::IK_THIRD_PARTY);
+		g_Analyzer->setSourceCode(R"(
+#include <Project.h>
+#include <Library.h>
+
+/// @runtime
+struct MainType { ProjectType p; lib::LibraryType l; };
+)");
+	}
+
+	void TearDown() override
+	{
+		g_Analyzer = nullptr;
+		std::filesystem::remove_all(m_tempDir);
+	}
+
+	std::vector<std::string> analyzeTypeNames(rg3::llvm::AnalyzeStats* pOutStats = nullptr)
+	{
+		auto result = g_Analyzer->analyze();
+		CommonHelpers::printCompilerIssues(result.vIssues);
+		EXPECT_TRUE(result.vIssues.empty());
+
+		std::vector<std::string> vNames {};
+		for (const auto& pType : result.vFoundTypes)
+		{
+			vNames.emplace_back(pType->getPrettyName());
+		}
+
+		std::sort(vNames.begin(), vNames.end());
+
+		if (pOutStats)
+			*pOutStats = result.stats;
+
+		return vNames;
+	}
+
+ protected:
+	std::filesystem::path m_tempDir {};
+	std::unique_ptr<rg3::llvm::CodeAnalyzer> g_Analyzer { nullptr };
+};
+
+TEST_F(Tests_SourceFileFilter, AllFilesAccepted)
+{
+	ASSERT_EQ(g_Analyzer->getCompilerConfig().eSourceFilter, rg3::llvm::SourceFilter::SF_ALL) << "Filtering must be opt-in";
+
+	rg3::llvm::AnalyzeStats stats {};
+	ASSERT_EQ(analyzeTypeNames(&stats), (std::vector<std::string> { "MainType", "ProjectType", "lib::LibraryType" }));
+	ASSERT_EQ(stats.iDeclsPruned, 0);
+}
+
+TEST_F(Tests_SourceFileFilter, ProjectIncludesOnly)
+{
+	g_Analyzer->getCompilerConfig().eSourceFilter = rg3::llvm::SourceFilter::SF_PROJECT_INCLUDES;
+
+	rg3::llvm::AnalyzeStats stats {};
+	ASSERT_EQ(analyzeTypeNames(&stats), (std::vector<std::string> { "MainType", "ProjectType" }));
+	ASSERT_GT(stats.iDeclsPruned, 0) << "Namespace of third party header must be pruned";
+}
+
+TEST_F(Tests_SourceFileFilter, MainFileOnly)
+{
+	g_Analyzer->getCompilerConfig().eSourceFilter = rg3::llvm::SourceFilter::SF_MAIN_FILE;
+
+	ASSERT_EQ(analyzeTypeNames(), (std::vector<std::string> { "MainType" }));
+}
+
+TEST_F(Tests_SourceFileFilter, DenyAndAllowGlobs)
+{
+	g_Analyzer->getCompilerConfig().eSourceFilter = rg3::llvm::SourceFilter::SF_SKIP_SYSTEM_HEADERS;
+	g_Analyzer->getCompilerConfig().vSourceDenyGlobs = { "*/third_party/*" };
+	ASSERT_EQ(analyzeTypeNames(), (std::vector<std::string> { "MainType", "ProjectType" }));
+
+	g_Analyzer->getCompilerConfig().vSourceDenyGlobs.clear();
+	g_Analyzer->getCompilerConfig().vSourceAllowGlobs = { "*/third_party/*" };
+	ASSERT_EQ(analyzeTypeNames(), (std::vector<std::string> { "MainType", "lib::LibraryType" })) << "Main file is accepted regardless of globs";
+}
\ No newline at end of file
@@ -0,0 +1,64 @@
+#include <gtest/gtest.h>
+
+#include <RG3/Cpp/TypeClass.h>
+#include <RG3/Cpp/TypeEnum.h>
+
+
+namespace
+{
+	rg3::cpp::TypeClass makeClass(const std::string& sPropertyName)
+	{
+		rg3::cpp::ClassPropertyVector vProperties {};
+		vProperties.emplace_back().sName = sPropertyName;
+
+		return rg3::cpp::TypeClass {
+			"Vector", "engine::Vector", rg3::cpp::CppNamespace { "engine" }, {}, {},
+			std::move(vProperties), {}, {},
+			true, true, true, true, true, true,
+			{}
+		};
+	}
+
+	rg3::cpp::TypeEnum makeEnum(bool bIsScoped)
+	{
+		rg3::cpp::EnumEntryVector vEntries {};
+		vEntries.emplace_back("EK_FIRST", 0);
+		vEntries.emplace_back("EK_SECOND", 1);
+
+		return rg3::cpp::TypeEnum { "EKind", "engine::EKind", rg3::cpp::CppNamespace { "engine" }, {}, {}, std::move(vEntries), bIsScoped, rg3::cpp::TypeReference {} };
+	}
+}
+
+// doAreSame of TypeClass & TypeEnum called virtual areSame of base instead of TypeBase::doAreSame and never returned
+TEST(Tests_TypeComparison, CompareClasses)
+{
+	const rg3::cpp::TypeClass first = makeClass("x");
+	const rg3::cpp::TypeClass same = makeClass("x");
+	const rg3::cpp::TypeClass another = makeClass("y");
+
+	ASSERT_TRUE(first.areSame(&same));
+	ASSERT_TRUE(first == same);
+	ASSERT_FALSE(first.areSame(&another));
+	ASSERT_TRUE(first != another);
+	ASSERT_FALSE(first.areSame(nullptr));
+}
+
+TEST(Tests_TypeComparison, CompareEnums)
+{
+	const rg3::cpp::TypeEnum first = makeEnum(true);
+	const rg3::cpp::TypeEnum same = makeEnum(true);
+	const rg3::cpp::TypeEnum unscoped = makeEnum(false);
+
+	ASSERT_TRUE(first.areSame(&same));
+	ASSERT_TRUE(first == same);
+	ASSERT_FALSE(first.areSame(&unscoped));
+}
+
+TEST(Tests_TypeComparison, CompareDifferentKinds)
+{
+	const rg3::cpp::TypeClass aClass = makeClass("x");
+	const rg3::cpp::TypeEnum anEnum = makeEnum(true);
+
+	ASSERT_FALSE(aClass.areSame(&anEnum));
+	ASSERT_FALSE(anEnum.areSame(&aClass));
+}
\ No newline at end of file
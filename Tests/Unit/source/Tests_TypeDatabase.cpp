@@ -0,0 +1,141 @@
+#include <gtest/gtest.h>
+
+#include <RG3/Cpp/TypeBase.h>
+#include <RG3/Cpp/TypeEnum.h>
+#include <RG3/Cpp/TypeClass.h>
+#include <RG3/Cpp/TypeDatabase.h>
+#include <RG3/LLVM/CodeAnalyzer.h>
+
+#include <filesystem>
+
+
+class Tests_TypeDatabase : public ::testing::Test
+{
+ protected:
+	void SetUp() override
+	{
+		g_Analyzer = std::make_unique<rg3::llvm::CodeAnalyzer>();
+	}
+
+	void TearDown() override
+	{
+		g_Analyzer = nullptr;
+	}
+
+ protected:
+	std::unique_ptr<rg3::llvm::CodeAnalyzer> g_Analyzer { nullptr };
+};
+
+
+TEST_F(Tests_TypeDatabase, WriteOpenAndQuery)
+{
+	g_Analyzer->setSourceCode(R"(
+namespace engine {
+	/// @runtime
+	enum class Mode : int { M_NONE = 0, M_FAST = 1 };
+
+	/// @runtime
+	struct Base {};
+
+	/**
+	 * @runtime
+	 * @priority(10)
+	 **/
+	class Component : public Base
+	{
+	 public:
+		/// @property(Speed)
+		float fSpeed { 0.f };
+
+		/// @property
+		Mode eMode { Mode::M_NONE };
+	};
+}
+)");
+	g_Analyzer->getCompilerConfig().cppStandard = rg3::llvm::CxxStandard::CC_20;
+
+	auto analyzeResult = g_Analyzer->analyze();
+	ASSERT_TRUE(analyzeResult.vIssues.empty()) << "No issues should be here";
+	ASSERT_EQ(analyzeResult.vFoundTypes.size(), 3);
+
+	rg3::cpp::TypeDatabaseWriter writer {};
+	writer.addTypes(analyzeResult.vFoundTypes);
+	writer.addIssue(rg3::cpp::TypeDatabaseIssue { 3, "engine.h", 12, 4, "Some error" });
+
+	const auto dbPath = std::filesystem::temp_directory_path() / "rg3_tests_type_database.rg3db";
+	ASSERT_TRUE(writer.writeToFile(dbPath));
+
+	auto pDatabase = rg3::cpp::TypeDatabase::open(dbPath);
+	ASSERT_NE(pDatabase, nullptr);
+	ASSERT_EQ(pDatabase->getTypesCount(), 3);
+	ASSERT_EQ(pDatabase->getIssuesCount(), 1);
+
+	// Queries without deserialization
+	const auto iComponent = pDatabase->findType("engine::Component");
+	const auto iBase = pDatabase->findType("engine::Base");
+	const auto iMode = pDatabase->findType("engine::Mode");
+	ASSERT_TRUE(iComponent.has_value());
+	ASSERT_TRUE(iBase.has_value());
+	ASSERT_TRUE(iMode.has_value());
+	ASSERT_FALSE(pDatabase->findType("engine::Unknown").has_value());
+
+	ASSERT_EQ(pDatabase->getTypeKind(iComponent.value()), rg3::cpp::TypeKind::TK_STRUCT_OR_CLASS);
+	ASSERT_EQ(pDatabase->getTypeKind(iMode.value()), rg3::cpp::TypeKind::TK_ENUM);
+	ASSERT_EQ(pDatabase->getTypeName(iComponent.value()), "Component");
+	ASSERT_EQ(pDatabase->getTypeNamespace(iComponent.value()), "engine");
+	ASSERT_EQ(pDatabase->getParentTypes(iComponent.value()), std::vector<std::uint32_t> { iBase.value() });
+	ASSERT_EQ(pDatabase->getReferencedTypes(iComponent.value()), std::vector<std::uint32_t> { iMode.value() });
+
+	// Full deserialization
+	std::vector<rg3::cpp::TypeBasePtr> vTypes {};
+	ASSERT_TRUE(pDatabase->loadTypes(vTypes));
+	ASSERT_EQ(vTypes.size(), analyzeResult.vFoundTypes.size());
+
+	for (size_t i = 0; i < vTypes.size(); ++i)
+	{
+		ASSERT_EQ(*vTypes[i], *analyzeResult.vFoundTypes[i]) << "Type " << i << " differs after round trip";
+		ASSERT_EQ(vTypes[i]->getDefinition(), analyzeResult.vFoundTypes[i]->getDefinition());
+	}
+
+	auto pComponent = pDatabase->loadType(iComponent.value());
+	ASSERT_NE(pComponent, nullptr);
+	ASSERT_EQ(pComponent->getTags().getTag("priority").getArguments()[0].asI64(0), 10);
+	ASSERT_EQ(static_cast<const rg3::cpp::TypeClass*>(pComponent.get())->getProperties()[0].sAlias, "Speed");
+
+	const auto issue = pDatabase->getIssue(0);
+	ASSERT_TRUE(issue.has_value());
+	ASSERT_EQ(issue->iKind, 3);
+	ASSERT_EQ(issue->sSourceFile, "engine.h");
+	ASSERT_EQ(issue->iLine, 12);
+	ASSERT_EQ(issue->iColumn, 4);
+	ASSERT_EQ(issue->sMessage, "Some error");
+	ASSERT_FALSE(pDatabase->getIssue(1).has_value());
+
+	pDatabase = nullptr;
+	std::filesystem::remove(dbPath);
+}
+
+TEST_F(Tests_TypeDatabase, RejectTruncatedBuffer)
+{
+	g_Analyzer->setSourceCode(R"(
+/**
+ * @runtime
+ **/
+struct Simple { int iValue { 0 }; };
+)");
+	g_Analyzer->getCompilerConfig().cppStandard = rg3::llvm::CxxStandard::CC_20;
+
+	auto analyzeResult = g_Analyzer->analyze();
+	ASSERT_EQ(analyzeResult.vFoundTypes.size(), 1);
+
+	rg3::cpp::TypeDatabaseWriter writer {};
+	writer.addTypes(analyzeResult.vFoundTypes);
+
+	const std::string buffer = writer.build();
+	ASSERT_NE(rg3::cpp::TypeDatabase::fromBuffer(buffer), nullptr);
+
+	for (size_t iSize = 0; iSize < buffer.size(); ++iSize)
+	{
+		ASSERT_EQ(rg3::cpp::TypeDatabase::fromBuffer(buffer.substr(0, iSize)), nullptr) << "Truncated buffer (" << iSize << " bytes) must be rejected";
+	}
+}
\ No newline at end of file
@@ -0,0 +1,105 @@
+#include <gtest/gtest.h>
+
+#include <RG3/Cpp/DefinitionLocation.h>
+#include <RG3/Cpp/CppNamespace.h>
+#include <RG3/Cpp/TypeBaseInfo.h>
+
+#include <filesystem>
+#include <stdexcept>
+#include <vector>
+
+
+TEST(Tests_TypeModelInterning, NamespacesAreShared)
+{
+	rg3::cpp::CppNamespace first { "engine::core::" };
+	rg3::cpp::CppNamespace second { "engine::core::" };
+
+	ASSERT_EQ(first, second);
+	ASSERT_EQ(&first.asString(), &second.asString()) << "Equal namespaces must share one string";
+
+	rg3::cpp::CppNamespace built {};
+	built / "engine" / "core";
+	ASSERT_EQ(built.asString(), "engine::core");
+	ASSERT_EQ(built[0], "engine");
+	ASSERT_EQ(built[1], "core");
+
+	rg3::cpp::CppNamespace prepended { built };
+	prepended.prepend("game");
+	ASSERT_EQ(prepended.asString(), "game::engine::core");
+	ASSERT_EQ(built.asString(), "engine::core") << "Copy must not be affected by prepend";
+
+	rg3::cpp::CppNamespace global {};
+	ASSERT_TRUE(global.isEmpty());
+	ASSERT_EQ(global.asString(), "");
+	ASSERT_EQ(global, rg3::cpp::CppNamespace { "" });
+}
+
+TEST(Tests_TypeModelInterning, SetPartDetachesNamespace)
+{
+	rg3::cpp::CppNamespace first {};
+	first / "engine" / "core";
+	rg3::cpp::CppNamespace second { first };
+
+	const std::string& sFirstPart = second[0];
+	const std::string& sSecondPart = second[1];
+
+	second.setPart(1, "render");
+	ASSERT_EQ(second[1], "render");
+	ASSERT_EQ(second.asString(), "engine::render");
+	ASSERT_EQ(first[1], "core") << "Shared parts must not be changed through another namespace";
+	ASSERT_EQ(first.asString(), "engine::core");
+
+	// Parts of namespace which was not changed are still alive
+	ASSERT_EQ(sFirstPart, "engine");
+	ASSERT_EQ(sSecondPart, "core");
+
+	ASSERT_THROW(second.setPart(2, "extra"), std::out_of_range);
+}
+
+TEST(Tests_TypeModelInterning, ReleasedValuesLeavePool)
+{
+	const std::size_t iNamespacesBefore = rg3::cpp::CppNamespace::getInternedNamespacesCount();
+
+	{
+		rg3::cpp::CppNamespace first { "rg3::interning::released::" };
+		rg3::cpp::CppNamespace second { "rg3::interning::released::" };
+		ASSERT_EQ(rg3::cpp::CppNamespace::getInternedNamespacesCount(), iNamespacesBefore + 1);
+	}
+
+	ASSERT_EQ(rg3::cpp::CppNamespace::getInternedNamespacesCount(), iNamespacesBefore);
+
+	// Same value interned again after release
+	rg3::cpp::CppNamespace again { "rg3::interning::released::" };
+	ASSERT_EQ(again.asString(), "rg3::interning::released::");
+	ASSERT_EQ(again[2], "released");
+	ASSERT_EQ(rg3::cpp::CppNamespace::getInternedNamespacesCount(), iNamespacesBefore + 1);
+}
+
+TEST(Tests_TypeModelInterning, LocationPathsAreShared)
+{
+	const std::filesystem::path header { "/rg3/interning/test/Header.h" };
+	const std::size_t iPathsBefore = rg3::cpp::DefinitionLocation::getInternedPathsCount();
+
+	{
+		std::vector<rg3::cpp::DefinitionLocation> vLocations {};
+		for (int i = 0; i < 100; ++i)
+		{
+			vLocations.emplace_back(header, i, 1);
+		}
+
+		ASSERT_EQ(rg3::cpp::DefinitionLocation::getInternedPathsCount(), iPathsBefore + 1) << "All locations of one file share path";
+		ASSERT_EQ(&vLocations[0].getFsLocation(), &vLocations[99].getFsLocation());
+		ASSERT_EQ(vLocations[42].getPath(), header.string());
+		ASSERT_EQ(vLocations[42].getLine(), 42);
+
+		// Spelling is kept
+		rg3::cpp::DefinitionLocation other { "/rg3/interning//test/Header.h", 1, 1 };
+		ASSERT_EQ(other.getPath(), "/rg3/interning//test/Header.h");
+	}
+
+	ASSERT_EQ(rg3::cpp::DefinitionLocation::getInternedPathsCount(), iPathsBefore) << "Path must be released with last location";
+
+	rg3::cpp::DefinitionLocation empty {};
+	ASSERT_TRUE(empty.getFsLocation().empty());
+	ASSERT_EQ(empty, rg3::cpp::DefinitionLocation {});
+}
\ No newline at end of file
@@ -0,0 +1,132 @@
+#include <gtest/gtest.h>
+
+#include <RG3/Cpp/TypeClass.h>
+#include <RG3/Cpp/TypeEnum.h>
+#include <RG3/Cpp/Tag.h>
+
+#include <fmt/format.h>
+
+#include <string>
+#include <vector>
+
+
+namespace
+{
+	constexpr int kMembersCount = 256;
+
+	/**
+	 * @brief Collected members of class (like CxxClassTypeVisitor produces): every entry owns heap data (names, tags & statements)
+	 */
+	struct CollectedClass
+	{
+		std::string sName { "CollectedClassWithLongEnoughNameToBeOnHeap" };
+		std::string sPrettyName { "engine::CollectedClassWithLongEnoughNameToBeOnHeap" };
+		rg3::cpp::Tags vTags { rg3::cpp::Tag::parseFromCommentString("@runtime @serialize") };
+		rg3::cpp::ClassPropertyVector vProperties {};
+		rg3::cpp::ClassFunctionVector vFunctions {};
+		rg3::cpp::ClassFriendVector vFriends {};
+		std::vector<rg3::cpp::ClassParent> vParents {};
+
+		CollectedClass()
+		{
+			for (int i = 0; i < kMembersCount; ++i)
+			{
+				rg3::cpp::ClassProperty& property = vProperties.emplace_back();
+				property.sName = fmt::format("property_with_long_name_{}", i);
+				property.vTags = rg3::cpp::Tag::parseFromCommentString("@property(\"value\")");
+
+				rg3::cpp::ClassFunction& function = vFunctions.emplace_back();
+				function.sName = fmt::format("function_with_long_name_{}", i);
+				function.vArguments.resize(2);
+			}
+
+			vFriends.resize(4);
+			vParents.resize(2);
+		}
+	};
+
+	/**
+	 * @brief Amount of heap buffers of collected data which were not reused by type (deep copies)
+	 */
+	int countCopies(const void* pName, const void* pTagsNode, const void* pProperties, const void* pFunctions, const void* pFriends, const void* pParents, const rg3::cpp::TypeClass& type)
+	{
+		int iCopies = 0;
+
+		iCopies += type.getName().data() != pName;
+		iCopies += &type.getTags().getTags().begin()->second != pTagsNode;
+		iCopies += static_cast<const void*>(type.getProperties().data()) != pProperties;
+		iCopies += static_cast<const void*>(type.getFunctions().data()) != pFunctions;
+		iCopies += static_cast<const void*>(type.getClassFriends().data()) != pFriends;
+		iCopies += static_cast<const void*>(type.getParentTypes().data()) != pParents;
+
+		return iCopies;
+	}
+}
+
+TEST(Tests_TypeMoveConstruction, CountCopiesOfMovedClassData)
+{
+	CollectedClass collected {};
+
+	const void* pName = collected.sName.data();
+	const void* pTagsNode = &collected.vTags.getTags().begin()->second;
+	const void* pProperties = collected.vProperties.data();
+	const void* pFunctions = collected.vFunctions.data();
+	const void* pFriends = collected.vFriends.data();
+	const void* pParents = collected.vParents.data();
+
+	// Lvalues: every member is copied, source stays intact
+	rg3::cpp::TypeClass copied {
+		collected.sName, collected.sPrettyName, rg3::cpp::CppNamespace { "engine" }, {}, collected.vTags,
+		collected.vProperties, collected.vFunctions, collected.vFriends,
+		false, true, true, true, true, true,
+		collected.vParents
+	};
+
+	ASSERT_EQ(countCopies(pName, pTagsNode, pProperties, pFunctions, pFriends, pParents, copied), 6);
+	ASSERT_EQ(collected.vProperties.size(), kMembersCount);
+
+	// Rvalues: collected data is moved through, nothing is copied
+	rg3::cpp::TypeClass moved {
+		std::move(collected.sName), std::move(collected.sPrettyName), rg3::cpp::CppNamespace { "engine" }, {}, std::move(collected.vTags),
+		std::move(collected.vProperties), std::move(collected.vFunctions), std::move(collected.vFriends),
+		false, true, true, true, true, true,
+		std::move(collected.vParents)
+	};
+
+	ASSERT_EQ(countCopies(pName, pTagsNode, pProperties, pFunctions, pFriends, pParents, moved), 0);
+	ASSERT_EQ(moved.getProperties().size(), kMembersCount);
+	ASSERT_EQ(moved.getFunctions().size(), kMembersCount);
+	ASSERT_EQ(moved.getProperties()[42].sName, "property_with_long_name_42");
+	ASSERT_TRUE(moved.getTags().hasTag("serialize"));
+	ASSERT_EQ(moved.getPrettyName(), "engine::CollectedClassWithLongEnoughNameToBeOnHeap");
+	ASSERT_TRUE(moved.areSame(&copied));
+}
+
+TEST(Tests_TypeMoveConstruction, MoveEnumAndOverrideData)
+{
+	rg3::cpp::EnumEntryVector vEntries {};
+	for (int i = 0; i < kMembersCount; ++i)
+	{
+		vEntries.emplace_back(fmt::format("ENTRY_WITH_LONG_NAME_{}", i), i);
+	}
+
+	const void* pEntries = vEntries.data();
+	rg3::cpp::Tags vTags = rg3::cpp::Tag::parseFromCommentString("@runtime");
+	const void* pTagsNode = &vTags.getTags().begin()->second;
+
+	rg3::cpp::TypeEnum type { "EKind", "engine::EKind", rg3::cpp::CppNamespace { "engine" }, {}, std::move(vTags), std::move(vEntries), true, rg3::cpp::TypeReference {} };
+
+	ASSERT_EQ(static_cast<const void*>(type.getEntries().data()), pEntries) << "Entries must be moved";
+	ASSERT_EQ(&type.getTags().getTags().begin()->second, pTagsNode) << "Tags must be moved";
+	ASSERT_EQ(type.getEntries().size(), kMembersCount);
+
+	std::string sName = "EKindRenamedWithLongEnoughNameToBeOnHeap";
+	std::string sPrettyName = "engine::EKindRenamedWithLongEnoughNameToBeOnHeap";
+	const void* pName = sName.data();
+	const void* pPrettyName = sPrettyName.data();
+
+	type.overrideTypeData(std::move(sName), std::move(sPrettyName));
+	ASSERT_EQ(type.getName().data(), pName);
+	ASSERT_EQ(type.getPrettyName().data(), pPrettyName);
+	ASSERT_EQ(type.getName(), "EKindRenamedWithLongEnoughNameToBeOnHeap");
+}
\ No newline at end of file
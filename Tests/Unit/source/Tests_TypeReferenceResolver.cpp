@@ -0,0 +1,163 @@
+#include <gtest/gtest.h>
+
+#include <RG3/Cpp/TypeReferenceResolver.h>
+#include <RG3/Cpp/TypeClass.h>
+#include <RG3/Cpp/TypeEnum.h>
+
+#include <fmt/format.h>
+
+#include <memory>
+#include <vector>
+
+
+namespace
+{
+	rg3::cpp::TypeStatement makeStatement(const std::string& sRefName, const rg3::cpp::TypeBase* pTarget)
+	{
+		rg3::cpp::TypeStatement stmt {};
+		stmt.sTypeRef = rg3::cpp::TypeReference { sRefName };
+
+		if (pTarget)
+		{
+			stmt.sBaseInfo.eKind = pTarget->getKind();
+			stmt.sBaseInfo.sName = pTarget->getName();
+			stmt.sBaseInfo.sPrettyName = pTarget->getPrettyName();
+			stmt.sBaseInfo.sNameSpace = pTarget->getNamespace();
+			stmt.sBaseInfo.sDefLocation = pTarget->getDefinition();
+		}
+
+		return stmt;
+	}
+
+	rg3::cpp::TypeBasePtr makeClass(const std::string& sName, const rg3::cpp::TypeBase* pTarget)
+	{
+		rg3::cpp::ClassPropertyVector vProperties {};
+		rg3::cpp::ClassFunctionVector vFunctions {};
+
+		if (pTarget)
+		{
+			rg3::cpp::ClassProperty& byName = vProperties.emplace_back();
+			byName.sName = "byName";
+			byName.sTypeInfo = makeStatement(pTarget->getPrettyName(), nullptr);
+
+			// Unqualified spelling: resolved by base info of statement
+			rg3::cpp::ClassProperty& bySpelling = vProperties.emplace_back();
+			bySpelling.sName = "bySpelling";
+			bySpelling.sTypeInfo = makeStatement(pTarget->getName(), pTarget);
+			bySpelling.vTags.getTags()["ref"] = rg3::cpp::Tag { "ref", { rg3::cpp::TagArgument { rg3::cpp::TypeReference { pTarget->getPrettyName() } } } };
+
+			rg3::cpp::ClassFunction& function = vFunctions.emplace_back();
+			function.sName = "get";
+			function.sReturnType = makeStatement(pTarget->getName(), pTarget);
+			function.sReturnType.sBaseInfo.sPrettyName = "alias_of_target"; // only ID matches
+			function.vArguments.emplace_back().sType = makeStatement("float", nullptr);
+		}
+
+		return std::make_unique<rg3::cpp::TypeClass>(
+			sName, fmt::format("engine::{}", sName), rg3::cpp::CppNamespace { "engine" }, rg3::cpp::DefinitionLocation { "/engine/Types.h", 1, 1 }, rg3::cpp::Tags {},
+			std::move(vProperties), std::move(vFunctions), rg3::cpp::ClassFriendVector {},
+			true, true, true, true, true, true,
+			std::vector<rg3::cpp::ClassParent> {});
+	}
+}
+
+TEST(Tests_TypeReferenceResolver, ResolveByNameAndID)
+{
+	std::vector<rg3::cpp::TypeBasePtr> vTypes {};
+	vTypes.emplace_back(makeClass("Target", nullptr));
+	vTypes.emplace_back(makeClass("User", vTypes[0].get()));
+
+	rg3::cpp::TypeReferenceResolver resolver {};
+	resolver.addTypes(vTypes);
+
+	ASSERT_EQ(resolver.getIndexedCount(), 2);
+	ASSERT_EQ(resolver.findByName("engine::Target"), vTypes[0].get());
+	ASSERT_EQ(resolver.findByID(vTypes[1]->getID()), vTypes[1].get());
+	ASSERT_EQ(resolver.findByName("Target"), nullptr);
+
+	const rg3::cpp::TypeReferenceResolver::Stats stats = resolver.resolve(vTypes);
+	ASSERT_EQ(stats.iReferences, 5) << "Two properties, tag argument, result & argument";
+	ASSERT_EQ(stats.iResolved, 4) << "Only builtin argument is not resolved";
+
+	const auto* pUser = static_cast<const rg3::cpp::TypeClass*>(vTypes[1].get());
+	const rg3::cpp::TypeBase* pTarget = vTypes[0].get();
+
+	ASSERT_EQ(pUser->getProperties()[0].sTypeInfo.sTypeRef.get(), pTarget);
+	ASSERT_EQ(pUser->getProperties()[1].sTypeInfo.sTypeRef.get(), pTarget);
+	ASSERT_EQ(pUser->getProperties()[1].sTypeInfo.sTypeRef.getRefName(), "Target") << "Spelling is kept";
+	ASSERT_EQ(pUser->getProperties()[1].vTags.getTag("ref").getArguments()[0].asTypeRef({}).get(), pTarget);
+	ASSERT_EQ(pUser->getFunctions()[0].sReturnType.sTypeRef.get(), pTarget);
+	ASSERT_EQ(pUser->getFunctions()[0].vArguments[0].sType.sTypeRef.get(), nullptr);
+}
+
+TEST(Tests_TypeReferenceResolver, ResolveEnumUnderlyingType)
+{
+	std::vector<rg3::cpp::TypeBasePtr> vTypes {};
+	vTypes.emplace_back(std::make_unique<rg3::cpp::TypeBase>(
+		rg3::cpp::TypeKind::TK_TRIVIAL, "u16", "engine::u16", rg3::cpp::CppNamespace { "engine" }, rg3::cpp::DefinitionLocation { "/engine/Types.h", 1, 1 }, rg3::cpp::Tags {}));
+	vTypes.emplace_back(std::make_unique<rg3::cpp::TypeEnum>(
+		"EMode", "engine::EMode", rg3::cpp::CppNamespace { "engine" }, rg3::cpp::DefinitionLocation { "/engine/Types.h", 2, 1 }, rg3::cpp::Tags {},
+		rg3::cpp::EnumEntryVector { rg3::cpp::EnumEntry { "M_NONE", 0 } }, true, rg3::cpp::TypeReference { "engine::u16" }));
+	vTypes.emplace_back(std::make_unique<rg3::cpp::TypeEnum>(
+		"EBuiltin", "engine::EBuiltin", rg3::cpp::CppNamespace { "engine" }, rg3::cpp::DefinitionLocation { "/engine/Types.h", 3, 1 }, rg3::cpp::Tags {},
+		rg3::cpp::EnumEntryVector {}, false, rg3::cpp::TypeReference { "int" }));
+
+	rg3::cpp::TypeReferenceResolver resolver {};
+	resolver.addTypes(vTypes);
+
+	const rg3::cpp::TypeReferenceResolver::Stats stats = resolver.resolve(vTypes);
+	ASSERT_EQ(stats.iReferences, 2) << "Underlying types of both enums";
+	ASSERT_EQ(stats.iResolved, 1) << "Builtin underlying type is not resolved";
+
+	const auto* pMode = static_cast<const rg3::cpp::TypeEnum*>(vTypes[1].get());
+	const auto* pBuiltin = static_cast<const rg3::cpp::TypeEnum*>(vTypes[2].get());
+
+	ASSERT_EQ(pMode->getUnderlyingType().get(), vTypes[0].get());
+	ASSERT_EQ(pMode->getUnderlyingType().getRefName(), "engine::u16");
+	ASSERT_EQ(pBuiltin->getUnderlyingType().get(), nullptr);
+}
+
+TEST(Tests_TypeReferenceResolver, ParallelResolveMatchesSerial)
+{
+	constexpr int kTypes = 2048;
+
+	auto fnMakeTypes = []() {
+		std::vector<rg3::cpp::TypeBasePtr> vTypes {};
+		vTypes.reserve(kTypes);
+		vTypes.emplace_back(makeClass("Type0", nullptr));
+
+		for (int i = 1; i < kTypes; ++i)
+		{
+			// Every type refers previous one
+			vTypes.emplace_back(makeClass(fmt::format("Type{}", i), vTypes.back().get()));
+		}
+
+		return vTypes;
+	};
+
+	std::vector<rg3::cpp::TypeBasePtr> vSerialTypes = fnMakeTypes();
+	std::vector<rg3::cpp::TypeBasePtr> vParallelTypes = fnMakeTypes();
+
+	rg3::cpp::TypeReferenceResolver serialResolver {};
+	serialResolver.addTypes(vSerialTypes);
+
+	rg3::cpp::TypeReferenceResolver parallelResolver {};
+	parallelResolver.addTypes(vParallelTypes);
+
+	const auto serialStats = serialResolver.resolve(vSerialTypes, 1);
+	const auto parallelStats = parallelResolver.resolve(vParallelTypes, 8);
+
+	ASSERT_EQ(serialStats.iReferences, parallelStats.iReferences);
+	ASSERT_EQ(serialStats.iResolved, parallelStats.iResolved);
+	ASSERT_EQ(parallelStats.iResolved, static_cast<std::uint64_t>(kTypes - 1) * 4);
+
+	for (int i = 1; i < kTypes; ++i)
+	{
+		const auto* pType = static_cast<const rg3::cpp::TypeClass*>(vParallelTypes[i].get());
+		ASSERT_EQ(pType->getFunctions()[0].sReturnType.sTypeRef.get(), vParallelTypes[i - 1].get());
+	}
+
+	// Second pass keeps links & counts them as resolved
+	const auto repeatStats = parallelResolver.resolve(vParallelTypes, 3);
+	ASSERT_EQ(repeatStats.iResolved, parallelStats.iResolved);
+}
\ No newline at end of file
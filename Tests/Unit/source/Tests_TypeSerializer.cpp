@@ -0,0 +1,119 @@
+#include <gtest/gtest.h>
+
+#include <RG3/Cpp/TypeBase.h>
+#include <RG3/Cpp/TypeEnum.h>
+#include <RG3/Cpp/TypeClass.h>
+#include <RG3/Cpp/TypeSerializer.h>
+#include <RG3/LLVM/CodeAnalyzer.h>
+
+
+class Tests_TypeSerializer : public ::testing::Test
+{
+ protected:
+	void SetUp() override
+	{
+		g_Analyzer = std::make_unique<rg3::llvm::CodeAnalyzer>();
+	}
+
+	void TearDown() override
+	{
+		g_Analyzer = nullptr;
+	}
+
+ protected:
+	std::unique_ptr<rg3::llvm::CodeAnalyzer> g_Analyzer { nullptr };
+};
+
+
+TEST_F(Tests_TypeSerializer, WriteAndReadTypes)
+{
+	g_Analyzer->setSourceCode(R"(
+namespace engine {
+	/**
+	 * @runtime
+	 **/
+	enum class Mode : int { M_NONE = 0, M_FAST = -5 };
+
+	struct Base {};
+
+	/**
+	 * @runtime
+	 * @serialize(@engine::Mode)
+	 * @priority(10)
+	 **/
+	class Component : public Base
+	{
+	 public:
+		/// @property(Speed)
+		float fSpeed { 0.f };
+
+		/// @property
+		const Mode* pMode { nullptr };
+
+		/// @function
+		bool update(float dt, const Component& other) const noexcept;
+
+		/// @function
+		static int count();
+	};
+}
+)");
+	g_Analyzer->getCompilerConfig().cppStandard = rg3::llvm::CxxStandard::CC_20;
+
+	auto analyzeResult = g_Analyzer->analyze();
+	ASSERT_TRUE(analyzeResult.vIssues.empty()) << "No issues should be here";
+	ASSERT_EQ(analyzeResult.vFoundTypes.size(), 2);
+
+	rg3::cpp::BinaryWriter writer {};
+	rg3::cpp::TypeSerializer::writeTypes(writer, analyzeResult.vFoundTypes);
+
+	std::vector<rg3::cpp::TypeBasePtr> vTypes {};
+	rg3::cpp::BinaryReader reader { writer.getBuffer() };
+	ASSERT_TRUE(rg3::cpp::TypeSerializer::readTypes(reader, vTypes));
+	ASSERT_TRUE(reader.isEOF()) << "Whole buffer must be consumed";
+	ASSERT_EQ(vTypes.size(), analyzeResult.vFoundTypes.size());
+
+	for (size_t i = 0; i < vTypes.size(); ++i)
+	{
+		ASSERT_EQ(*vTypes[i], *analyzeResult.vFoundTypes[i]) << "Type " << i << " differs after round trip";
+		ASSERT_EQ(vTypes[i]->getDefinition(), analyzeResult.vFoundTypes[i]->getDefinition());
+	}
+
+	const size_t iClassIndex = analyzeResult.vFoundTypes[0]->getKind() == rg3::cpp::TypeKind::TK_STRUCT_OR_CLASS ? 0 : 1;
+	auto* pOriginal = static_cast<const rg3::cpp::TypeClass*>(analyzeResult.vFoundTypes[iClassIndex].get());
+	auto* pLoaded = static_cast<const rg3::cpp::TypeClass*>(vTypes[iClassIndex].get());
+	ASSERT_EQ(pOriginal->getKind(), rg3::cpp::TypeKind::TK_STRUCT_OR_CLASS);
+	ASSERT_EQ(pLoaded->getKind(), rg3::cpp::TypeKind::TK_STRUCT_OR_CLASS);
+	ASSERT_EQ(pLoaded->getParentTypes().size(), 1);
+	ASSERT_EQ(pLoaded->getParentTypes()[0].sTypeBaseInfo.sPrettyName, pOriginal->getParentTypes()[0].sTypeBaseInfo.sPrettyName);
+	ASSERT_EQ(pLoaded->getFunctions()[0].bIsNoExcept, pOriginal->getFunctions()[0].bIsNoExcept);
+	ASSERT_EQ(pLoaded->getTags().getTag("serialize").getArguments(), pOriginal->getTags().getTag("serialize").getArguments());
+	ASSERT_EQ(pLoaded->getTags().getTag("priority").getArguments()[0].asI64(0), 10);
+}
+
+TEST_F(Tests_TypeSerializer, RejectTruncatedBuffer)
+{
+	g_Analyzer->setSourceCode(R"(
+/**
+ * @runtime
+ **/
+struct Simple { int iValue { 0 }; };
+)");
+	g_Analyzer->getCompilerConfig().cppStandard = rg3::llvm::CxxStandard::CC_20;
+
+	auto analyzeResult = g_Analyzer->analyze();
+	ASSERT_EQ(analyzeResult.vFoundTypes.size(), 1);
+
+	rg3::cpp::BinaryWriter writer {};
+	rg3::cpp::TypeSerializer::writeTypes(writer, analyzeResult.vFoundTypes);
+
+	const std::string_view buffer { writer.getBuffer() };
+	for (size_t iSize = 0; iSize < buffer.size(); ++iSize)
+	{
+		std::vector<rg3::cpp::TypeBasePtr> vTypes {};
+		rg3::cpp::BinaryReader reader { buffer.substr(0, iSize) };
+
+		ASSERT_FALSE(rg3::cpp::TypeSerializer::readTypes(reader, vTypes)) << "Truncated buffer (" << iSize << " bytes) must be rejected";
+		ASSERT_TRUE(vTypes.empty());
+	}
+}
\ No newline at end of file